@@ -0,0 +1,639 @@
+/*
+//
+// Copyright (c) 1993-2018 Robert McNeel & Associates. All rights reserved.
+// OpenNURBS, Rhinoceros, and Rhino3D are registered trademarks of Robert
+// McNeel & Assoicates.
+//
+// THIS SOFTWARE IS PROVIDED "AS IS" WITHOUT EXPRESS OR IMPLIED WARRANTY.
+// ALL IMPLIED WARRANTIES OF FITNESS FOR ANY PARTICULAR PURPOSE AND OF
+// MERCHANTABILITY ARE HEREBY DISCLAIMED.
+//				
+// For complete openNURBS copyright information see <http://www.opennurbs.org>.
+//
+////////////////////////////////////////////////////////////////
+*/		
+
+////////////////////////////////////////////////////////////////
+//
+//  example_benchmark.cpp  
+// 
+//  Benchmarks for the opennurbs file IO toolkit. Each measurement is
+//  printed as one JSON object per line so results can be collected
+//  and compared between builds.
+//
+//    example_benchmark [-crc32] [-sha1] [-archive [file.3dm ...]]
+//
+//  With no options, every benchmark is run. The -archive benchmark
+//  writes and reads generated models with large meshes, many small
+//  breps, SubDs, annotations and point clouds, and any 3dm files
+//  listed after -archive. It reports the read and write throughput,
+//  the peak resident memory, and the time spent parsing chunks,
+//  in the storage device, computing CRCs, inflating, deflating and
+//  constructing objects.
+//
+////////////////////////////////////////////////////////////////////////
+
+#include "../opennurbs_public_examples.h"
+
+#if defined(ON_RUNTIME_WIN)
+#include <psapi.h>
+#pragma comment(lib, "psapi.lib")
+#elif defined(ON_RUNTIME_APPLE) || defined(ON_RUNTIME_LINUX)
+#include <sys/resource.h>
+#endif
+
+static double Internal_Seconds()
+{
+  return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Minimum time spent on one measurement.
+static const double Internal_MinimumSeconds = 0.25;
+
+/*
+Description:
+  Byte-at-a-time CRC32 with the zlib polynomial. This is how ON_CRC32()
+  worked before slice-by-16 and PCLMULQDQ folding were added and is the
+  reference for both the values and the speed.
+*/
+static ON__UINT32 Internal_ReferenceCRC32(ON__UINT32 current_remainder, size_t count, const unsigned char* b)
+{
+  static ON__UINT32 table[256];
+  static bool bTable = false;
+  if (false == bTable)
+  {
+    for (ON__UINT32 n = 0; n < 256; n++)
+    {
+      ON__UINT32 r = n;
+      for (int k = 0; k < 8; k++)
+        r = (0 != (r & 1)) ? (0xedb88320 ^ (r >> 1)) : (r >> 1);
+      table[n] = r;
+    }
+    bTable = true;
+  }
+  current_remainder ^= 0xffffffff;
+  while (count--)
+    current_remainder = table[(current_remainder ^ (*b++)) & 0xff] ^ (current_remainder >> 8);
+  return current_remainder ^ 0xffffffff;
+}
+
+static void Internal_PrintCRC32Result(
+  const char* implementation,
+  size_t sizeof_buffer,
+  unsigned int repeat_count,
+  double seconds
+  )
+{
+  const double megabytes = ((double)sizeof_buffer)*((double)repeat_count)/(1024.0*1024.0);
+  printf(
+    "{\"benchmark\":\"crc32\",\"implementation\":\"%s\",\"buffer_bytes\":%llu,\"repeat\":%u,\"seconds\":%.6f,\"MBps\":%.1f}\n",
+    implementation,
+    (unsigned long long)sizeof_buffer,
+    repeat_count,
+    seconds,
+    (seconds > 0.0) ? megabytes/seconds : 0.0
+    );
+}
+
+/*
+Description:
+  Compares ON_CRC32() to the byte-at-a-time reference on buffer sizes
+  from the few bytes ON_BinaryArchive checks when reading a single value
+  to the size of large compressed buffers.
+Returns:
+  Number of buffers where ON_CRC32() and the reference disagree.
+*/
+static unsigned int Internal_BenchmarkCRC32()
+{
+  const size_t sizes[] = { 4, 16, 64, 256, 4096, 65536, 1024*1024, 16*1024*1024, 0 };
+
+  const size_t sizeof_buffer = 16*1024*1024 + 16;
+  unsigned char* buffer = (unsigned char*)onmalloc(sizeof_buffer);
+  ON_RandomNumberGenerator rng;
+  rng.Seed(0x5EEDu);
+  for (size_t i = 0; i < sizeof_buffer; i++)
+    buffer[i] = (unsigned char)(rng.RandomNumber() & 0xff);
+
+  unsigned int error_count = 0;
+  for (int i = 0; 0 != sizes[i]; i++)
+  {
+    // An odd offset so nothing is aligned.
+    const unsigned char* b = buffer + 3;
+    const size_t count = sizes[i];
+    // Reading the clock is expensive compared to a CRC of a few bytes.
+    const unsigned int clock_interval = (count >= 4096) ? 1 : 64;
+
+    ON__UINT32 reference_crc = 0;
+    unsigned int repeat_count = 0;
+    double t0 = Internal_Seconds();
+    double t1 = t0;
+    do
+    {
+      reference_crc = Internal_ReferenceCRC32(reference_crc, count, b);
+      repeat_count++;
+      if (0 == (repeat_count % clock_interval))
+        t1 = Internal_Seconds();
+    } while (t1 - t0 < Internal_MinimumSeconds);
+    Internal_PrintCRC32Result("reference", count, repeat_count, t1 - t0);
+
+    ON__UINT32 crc = 0;
+    const unsigned int reference_repeat_count = repeat_count;
+    repeat_count = 0;
+    t0 = Internal_Seconds();
+    t1 = t0;
+    do
+    {
+      crc = ON_CRC32(crc, count, b);
+      repeat_count++;
+      if (0 == (repeat_count % clock_interval))
+        t1 = Internal_Seconds();
+    } while (t1 - t0 < Internal_MinimumSeconds);
+    Internal_PrintCRC32Result("ON_CRC32", count, repeat_count, t1 - t0);
+
+    // Chained values agree when both ran the same number of times.
+    crc = 0;
+    for (unsigned int j = 0; j < reference_repeat_count; j++)
+      crc = ON_CRC32(crc, count, b);
+    if (crc != reference_crc)
+    {
+      printf("{\"benchmark\":\"crc32\",\"error\":\"ON_CRC32() value differs from the reference\",\"buffer_bytes\":%llu}\n", (unsigned long long)count);
+      error_count++;
+    }
+  }
+
+  onfree(buffer);
+  return error_count;
+}
+
+static void Internal_PrintSHA1Result(
+  const char* implementation,
+  size_t buffer_count,
+  size_t sizeof_buffers,
+  unsigned int repeat_count,
+  double seconds
+  )
+{
+  const double megabytes = ((double)sizeof_buffers)*((double)repeat_count)/(1024.0*1024.0);
+  const double buffers = ((double)buffer_count)*((double)repeat_count);
+  printf(
+    "{\"benchmark\":\"sha1\",\"implementation\":\"%s\",\"buffer_count\":%llu,\"total_bytes\":%llu,\"repeat\":%u,\"seconds\":%.6f,\"MBps\":%.1f,\"buffers_per_second\":%.0f}\n",
+    implementation,
+    (unsigned long long)buffer_count,
+    (unsigned long long)sizeof_buffers,
+    repeat_count,
+    seconds,
+    (seconds > 0.0) ? megabytes/seconds : 0.0,
+    (seconds > 0.0) ? buffers/seconds : 0.0
+    );
+}
+
+/*
+Description:
+  Compares hashing buffers one at a time with ON_SHA1 to
+  ON_SHA1_Hash::BufferContentHashes() on many short buffers the size
+  of component names and on a few large buffers.
+Returns:
+  Number of buffers where the hashes disagree.
+*/
+static unsigned int Internal_BenchmarkSHA1()
+{
+  ON_RandomNumberGenerator rng;
+  rng.Seed(0x5EEDu);
+
+  unsigned int error_count = 0;
+  for (int test = 0; test < 2; test++)
+  {
+    // 100000 names with 4 to 64 bytes or 8 buffers with 1 MB.
+    const size_t buffer_count = (0 == test) ? 100000 : 8;
+    ON_SimpleArray<size_t> sizes(buffer_count);
+    size_t sizeof_buffers = 0;
+    for (size_t i = 0; i < buffer_count; i++)
+    {
+      const size_t sizeof_buffer = (0 == test) ? (4 + rng.RandomNumber()%61) : (1024*1024);
+      sizes.Append(sizeof_buffer);
+      sizeof_buffers += sizeof_buffer;
+    }
+    unsigned char* bytes = (unsigned char*)onmalloc(sizeof_buffers);
+    for (size_t i = 0; i < sizeof_buffers; i++)
+      bytes[i] = (unsigned char)(rng.RandomNumber() & 0xff);
+    ON_SimpleArray<const void*> buffers(buffer_count);
+    for (size_t i = 0, offset = 0; i < buffer_count; offset += sizes[(int)i], i++)
+      buffers.Append(bytes + offset);
+
+    ON_SimpleArray<ON_SHA1_Hash> hashes(buffer_count);
+    ON_SimpleArray<ON_SHA1_Hash> multiple_hashes(buffer_count);
+    hashes.SetCount((int)buffer_count);
+    multiple_hashes.SetCount((int)buffer_count);
+
+    unsigned int repeat_count = 0;
+    double t0 = Internal_Seconds();
+    double t1 = t0;
+    do
+    {
+      for (size_t i = 0; i < buffer_count; i++)
+      {
+        ON_SHA1 sha1;
+        sha1.AccumulateBytes(buffers[(int)i], sizes[(int)i]);
+        hashes[(int)i] = sha1.Hash();
+      }
+      repeat_count++;
+      t1 = Internal_Seconds();
+    } while (t1 - t0 < Internal_MinimumSeconds);
+    Internal_PrintSHA1Result("ON_SHA1", buffer_count, sizeof_buffers, repeat_count, t1 - t0);
+
+    repeat_count = 0;
+    t0 = Internal_Seconds();
+    t1 = t0;
+    do
+    {
+      ON_SHA1_Hash::BufferContentHashes(buffer_count, buffers.Array(), sizes.Array(), multiple_hashes.Array());
+      repeat_count++;
+      t1 = Internal_Seconds();
+    } while (t1 - t0 < Internal_MinimumSeconds);
+    Internal_PrintSHA1Result("BufferContentHashes", buffer_count, sizeof_buffers, repeat_count, t1 - t0);
+
+    for (size_t i = 0; i < buffer_count; i++)
+    {
+      if (hashes[(int)i] != multiple_hashes[(int)i])
+      {
+        printf("{\"benchmark\":\"sha1\",\"error\":\"BufferContentHashes() value differs from ON_SHA1\",\"buffer_bytes\":%llu}\n", (unsigned long long)sizes[(int)i]);
+        error_count++;
+      }
+    }
+
+    onfree(bytes);
+  }
+
+  return error_count;
+}
+
+/*
+Description:
+  Resets the peak resident memory of this process to the current
+  resident memory when the operating system supports it.
+Returns:
+  True if the peak was reset. When false, the peak reported by
+  Internal_PeakResidentBytes() is the peak since the process started.
+*/
+static bool Internal_ResetPeakResidentBytes()
+{
+#if defined(ON_RUNTIME_LINUX)
+  // Writing 5 to clear_refs resets the peak resident set size (Linux 4.0 and later).
+  FILE* fp = ON::OpenFile("/proc/self/clear_refs", "w");
+  if (nullptr == fp)
+    return false;
+  const bool rc = (fputs("5", fp) >= 0);
+  return (0 == ON::CloseFile(fp)) && rc;
+#else
+  return false;
+#endif
+}
+
+static unsigned long long Internal_PeakResidentBytes()
+{
+#if defined(ON_RUNTIME_WIN)
+  PROCESS_MEMORY_COUNTERS counters;
+  memset(&counters, 0, sizeof(counters));
+  if (::GetProcessMemoryInfo(::GetCurrentProcess(), &counters, sizeof(counters)))
+    return (unsigned long long)counters.PeakWorkingSetSize;
+  return 0;
+#elif defined(ON_RUNTIME_APPLE) || defined(ON_RUNTIME_LINUX)
+  struct rusage usage;
+  memset(&usage, 0, sizeof(usage));
+  if (0 != getrusage(RUSAGE_SELF, &usage))
+    return 0;
+#if defined(ON_RUNTIME_APPLE)
+  // bytes
+  return (unsigned long long)usage.ru_maxrss;
+#else
+  // kilobytes
+  return 1024ULL*((unsigned long long)usage.ru_maxrss);
+#endif
+#else
+  return 0;
+#endif
+}
+
+static ON_Mesh* Internal_CreateGridMesh(int vertex_count, double x, double y)
+{
+  ON_Mesh* mesh = new ON_Mesh((vertex_count-1)*(vertex_count-1), vertex_count*vertex_count, false, false);
+  for (int i = 0; i < vertex_count; i++)
+  {
+    for (int j = 0; j < vertex_count; j++)
+    {
+      const double z = 0.25*sin(0.1*i)*cos(0.1*j);
+      mesh->SetVertex(i*vertex_count + j, ON_3dPoint(x + i, y + j, z));
+    }
+  }
+  for (int i = 0; i + 1 < vertex_count; i++)
+  {
+    for (int j = 0; j + 1 < vertex_count; j++)
+    {
+      const int vi = i*vertex_count + j;
+      mesh->SetQuad(mesh->m_F.Count(), vi, vi + vertex_count, vi + vertex_count + 1, vi + 1);
+    }
+  }
+  mesh->ComputeVertexNormals();
+  return mesh;
+}
+
+/*
+Description:
+  Creates the generated models used by the archive benchmark.
+Parameters:
+  model_index - [in]
+  model - [out]
+Returns:
+  Name of the model or nullptr when model_index is past the last one.
+*/
+static const char* Internal_CreateBenchmarkModel(int model_index, ONX_Model& model)
+{
+  switch (model_index)
+  {
+  case 0:
+    {
+      // Two large meshes with 250000 vertices each
+      for (int i = 0; i < 2; i++)
+        model.AddManagedModelGeometryComponent(Internal_CreateGridMesh(500, 600.0*i, 0.0), nullptr);
+    }
+    return "large_meshes";
+
+  case 1:
+    {
+      // Many small breps
+      for (int i = 0; i < 2000; i++)
+      {
+        const double x = 2.0*(i % 50);
+        const double y = 2.0*(i / 50);
+        const ON_3dPoint corners[8] =
+        {
+          ON_3dPoint(x, y, 0.0), ON_3dPoint(x + 1.0, y, 0.0), ON_3dPoint(x + 1.0, y + 1.0, 0.0), ON_3dPoint(x, y + 1.0, 0.0),
+          ON_3dPoint(x, y, 1.0), ON_3dPoint(x + 1.0, y, 1.0), ON_3dPoint(x + 1.0, y + 1.0, 1.0), ON_3dPoint(x, y + 1.0, 1.0)
+        };
+        ON_Brep* brep = ON_BrepBox(corners);
+        if (nullptr != brep)
+          model.AddManagedModelGeometryComponent(brep, nullptr);
+      }
+    }
+    return "many_breps";
+
+  case 2:
+    {
+      // SubDs
+      for (int i = 0; i < 100; i++)
+      {
+        ON_Mesh* mesh = Internal_CreateGridMesh(12, 15.0*(i % 10), 15.0*(i / 10));
+        ON_SubD* subd = ON_SubD::CreateFromMesh(mesh, nullptr, nullptr);
+        delete mesh;
+        if (nullptr != subd)
+          model.AddManagedModelGeometryComponent(subd, nullptr);
+      }
+    }
+    return "subds";
+
+  case 3:
+    {
+      // Text and dimensions
+      const ON_DimStyle& dimstyle = ON_DimStyle::Default;
+      for (int i = 0; i < 1000; i++)
+      {
+        const double x = 10.0*(i % 40);
+        const double y = 10.0*(i / 40);
+        ON_Text* text = new ON_Text();
+        ON_Plane plane(ON_xy_plane);
+        plane.SetOrigin(ON_3dPoint(x, y, 0.0));
+        ON_wString s;
+        s.Format(L"Annotation %d", i);
+        if (text->Create(static_cast<const wchar_t*>(s), &dimstyle, plane))
+          model.AddManagedModelGeometryComponent(text, nullptr);
+        else
+          delete text;
+        ON_DimLinear* dim = ON_DimLinear::CreateAligned(
+          ON_3dPoint(x, y + 2.0, 0.0),
+          ON_3dPoint(x + 5.0, y + 2.0, 0.0),
+          ON_3dPoint(x + 2.5, y + 4.0, 0.0),
+          ON_3dVector::ZAxis,
+          dimstyle.Id(),
+          nullptr
+        );
+        if (nullptr != dim)
+          model.AddManagedModelGeometryComponent(dim, nullptr);
+      }
+    }
+    return "annotations";
+
+  case 4:
+    {
+      // Point clouds with colors
+      ON_RandomNumberGenerator rng;
+      rng.Seed(0x5EEDu);
+      for (int i = 0; i < 2; i++)
+      {
+        const int point_count = 500000;
+        ON_PointCloud* point_cloud = new ON_PointCloud(point_count);
+        point_cloud->m_C.Reserve(point_count);
+        for (int j = 0; j < point_count; j++)
+        {
+          point_cloud->m_P.Append(ON_3dPoint(rng.RandomDouble(0.0, 100.0), rng.RandomDouble(0.0, 100.0), rng.RandomDouble(0.0, 10.0)));
+          point_cloud->m_C.Append(ON_Color((int)(rng.RandomNumber() & 0xff), (int)(rng.RandomNumber() & 0xff), (int)(rng.RandomNumber() & 0xff)));
+        }
+        model.AddManagedModelGeometryComponent(point_cloud, nullptr);
+      }
+    }
+    return "point_clouds";
+  }
+  return nullptr;
+}
+
+static unsigned int Internal_ModelGeometryCount(const ONX_Model& model)
+{
+  return model.ActiveComponentCount(ON_ModelComponent::Type::ModelGeometry);
+}
+
+static void Internal_PrintArchiveResult(
+  const char* model_name,
+  const char* operation,
+  unsigned int object_count,
+  unsigned long long sizeof_file,
+  double seconds,
+  bool bPeakReset,
+  const ON_BinaryArchiveProfile& profile
+  )
+{
+  const double megabytes = ((double)sizeof_file)/(1024.0*1024.0);
+  printf(
+    "{\"benchmark\":\"archive\",\"model\":\"%s\",\"operation\":\"%s\",\"objects\":%u,\"file_bytes\":%llu,\"seconds\":%.6f,\"MBps\":%.1f,\"peak_rss_bytes\":%llu,\"peak_rss_reset\":%s",
+    model_name,
+    operation,
+    object_count,
+    sizeof_file,
+    seconds,
+    (seconds > 0.0) ? megabytes/seconds : 0.0,
+    Internal_PeakResidentBytes(),
+    bPeakReset ? "true" : "false"
+    );
+  for (unsigned int i = 0; i < ON_BinaryArchiveProfile::TaskCount; i++)
+  {
+    const ON_BinaryArchiveProfile::Task task = static_cast<ON_BinaryArchiveProfile::Task>(i);
+    printf(",\"%s_seconds\":%.6f", ON_BinaryArchiveProfile::TaskName(task), profile.Seconds(task));
+  }
+  printf("}\n");
+}
+
+/*
+Description:
+  Writes model to file_path and reads it back with profiles attached
+  to the archives.
+Returns:
+  0 if the model was written and read and the object counts agree,
+  1 otherwise.
+*/
+static unsigned int Internal_BenchmarkArchive(
+  const char* model_name,
+  const ONX_Model& model,
+  const char* file_path
+  )
+{
+  const unsigned int object_count = Internal_ModelGeometryCount(model);
+  const char* error = nullptr;
+
+  // Write
+  unsigned long long sizeof_file = 0;
+  FILE* fp = ON::OpenFile(file_path, "wb");
+  if (nullptr == fp)
+    error = "unable to create the file";
+  else
+  {
+    ON_BinaryArchiveProfile profile;
+    const bool bPeakReset = Internal_ResetPeakResidentBytes();
+    ON_BinaryFile archive(ON::archive_mode::write3dm, fp);
+    archive.EnableWriteBehind();
+    archive.SetProfile(&profile);
+    const double t0 = Internal_Seconds();
+    bool rc = model.Write(archive, 0, nullptr);
+    if (false == archive.EndWriteBehind())
+      rc = false;
+    const double t1 = Internal_Seconds();
+    archive.SetProfile(nullptr);
+    sizeof_file = archive.CurrentPosition();
+    ON::CloseFile(fp);
+    if (rc)
+      Internal_PrintArchiveResult(model_name, "write", object_count, sizeof_file, t1 - t0, bPeakReset, profile);
+    else
+      error = "ONX_Model::Write() failed";
+  }
+
+  // Read
+  if (nullptr == error)
+  {
+    fp = ON::OpenFile(file_path, "rb");
+    if (nullptr == fp)
+      error = "unable to open the file";
+    else
+    {
+      ON_BinaryArchiveProfile profile;
+      const bool bPeakReset = Internal_ResetPeakResidentBytes();
+      ONX_Model read_model;
+      ON_BinaryFile archive(ON::archive_mode::read3dm, fp);
+      archive.SetProfile(&profile);
+      const double t0 = Internal_Seconds();
+      const bool rc = read_model.Read(archive, nullptr);
+      const double t1 = Internal_Seconds();
+      archive.SetProfile(nullptr);
+      ON::CloseFile(fp);
+      if (false == rc)
+        error = "ONX_Model::Read() failed";
+      else if (Internal_ModelGeometryCount(read_model) != object_count)
+        error = "ONX_Model::Read() object count differs from the written model";
+      else
+        Internal_PrintArchiveResult(model_name, "read", object_count, sizeof_file, t1 - t0, bPeakReset, profile);
+    }
+  }
+
+  ON_FileSystem::RemoveFile(file_path);
+
+  if (nullptr == error)
+    return 0;
+  printf("{\"benchmark\":\"archive\",\"model\":\"%s\",\"error\":\"%s\"}\n", model_name, error);
+  return 1;
+}
+
+/*
+Description:
+  Benchmarks writing and reading the generated models and the
+  3dm files in file_paths[].
+Returns:
+  Number of models that could not be written or read.
+*/
+static unsigned int Internal_BenchmarkArchives(const ON_ClassArray<ON_String>& file_paths)
+{
+  const char* temporary_file_path = "example_benchmark_temporary.3dm";
+  unsigned int error_count = 0;
+
+  for (int model_index = 0; true; model_index++)
+  {
+    ONX_Model model;
+    const char* model_name = Internal_CreateBenchmarkModel(model_index, model);
+    if (nullptr == model_name)
+      break;
+    error_count += Internal_BenchmarkArchive(model_name, model, temporary_file_path);
+  }
+
+  for (int i = 0; i < file_paths.Count(); i++)
+  {
+    const char* file_path = static_cast<const char*>(file_paths[i]);
+    ONX_Model model;
+    if (false == model.Read(file_path, nullptr))
+    {
+      printf("{\"benchmark\":\"archive\",\"model\":\"%s\",\"error\":\"unable to read the file\"}\n", file_path);
+      error_count++;
+      continue;
+    }
+    error_count += Internal_BenchmarkArchive(file_path, model, temporary_file_path);
+  }
+
+  return error_count;
+}
+
+int main( int argc, const char *argv[] )
+{
+  ON::Begin();
+
+  bool bCRC32 = (argc <= 1);
+  bool bSHA1 = (argc <= 1);
+  bool bArchive = (argc <= 1);
+  ON_ClassArray<ON_String> archive_file_paths;
+  for (int argi = 1; argi < argc; argi++)
+  {
+    const ON_String arg(argv[argi]);
+    if (arg.EqualOrdinal("-crc32", true))
+      bCRC32 = true;
+    else if (arg.EqualOrdinal("-sha1", true))
+      bSHA1 = true;
+    else if (arg.EqualOrdinal("-archive", true))
+    {
+      bArchive = true;
+      // 3dm files to benchmark follow -archive
+      while (argi + 1 < argc && '-' != argv[argi + 1][0])
+        archive_file_paths.Append(ON_String(argv[++argi]));
+    }
+    else
+    {
+      printf("Invalid option: %s\nUsage: example_benchmark [-crc32] [-sha1] [-archive [file.3dm ...]]\n", argv[argi]);
+      ON::End();
+      return 1;
+    }
+  }
+
+  unsigned int error_count = 0;
+  if (bCRC32)
+    error_count += Internal_BenchmarkCRC32();
+  if (bSHA1)
+    error_count += Internal_BenchmarkSHA1();
+  if (bArchive)
+    error_count += Internal_BenchmarkArchives(archive_file_paths);
+
+  ON::End();
+
+  return (0 == error_count) ? 0 : 1;
+}
@@ -31,6 +31,13 @@
 #include "opennurbs_internal_V2_annotation.h"
 #include "opennurbs_internal_V5_annotation.h"
 
+#if !defined(ON_RUNTIME_WIN)
+// ON_Read3dmMappedFileArchive uses mmap()
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 const ON_String Internal_RuntimeEnvironmentToString(
   ON::RuntimeEnvironment runtime_environment
 )
@@ -4549,7 +4556,11 @@ bool ON_BinaryArchive::Internal_WriteObject(
     // TCODE_OPENNURBS_CLASS_DATA chunk contains definition of class
     if (false == BeginWrite3dmChunk(TCODE_OPENNURBS_CLASS_DATA, 0))
       break;
-    bool bChunkDataOk = model_object.Write(*this) ? true : false;
+    bool bChunkDataOk;
+    {
+      const ProfileTask profile_task(*this, ON_BinaryArchiveProfile::Task::ObjectConstruction);
+      bChunkDataOk = model_object.Write(*this) ? true : false;
+    }
     if (false == bChunkDataOk)
     {
       ON_ERROR("archive_object->Write() failed.");
@@ -4996,6 +5007,7 @@ int ON_BinaryArchive::ReadObjectHelper( ON_Object** ppObject )
       }
       else 
       {
+        const ProfileTask profile_task(*this, ON_BinaryArchiveProfile::Task::ObjectConstruction);
         if ( nullptr == pObject )
         {
           pObject = pID->Create();
@@ -7052,6 +7064,84 @@ bool ON_BinaryArchive::UseBufferCompression() const
 {
   return m_bUseBufferCompression;
 }
+
+ON_BinaryArchive::BufferCompressionLevel ON_BinaryArchive::BufferCompressionLevelFromUnsigned(
+  unsigned int buffer_compression_level_as_unsigned
+  )
+{
+  switch (buffer_compression_level_as_unsigned)
+  {
+  ON_ENUM_FROM_UNSIGNED_CASE(ON_BinaryArchive::BufferCompressionLevel::None);
+  ON_ENUM_FROM_UNSIGNED_CASE(ON_BinaryArchive::BufferCompressionLevel::Fast);
+  ON_ENUM_FROM_UNSIGNED_CASE(ON_BinaryArchive::BufferCompressionLevel::Default);
+  ON_ENUM_FROM_UNSIGNED_CASE(ON_BinaryArchive::BufferCompressionLevel::Best);
+  }
+
+  ON_ERROR("Invalid buffer_compression_level_as_unsigned parameter.");
+  return ON_BinaryArchive::BufferCompressionLevel::Best;
+}
+
+ON_BinaryArchive::BufferCompressionCodec ON_BinaryArchive::BufferCompressionCodecFromUnsigned(
+  unsigned int buffer_compression_codec_as_unsigned
+  )
+{
+  switch (buffer_compression_codec_as_unsigned)
+  {
+  ON_ENUM_FROM_UNSIGNED_CASE(ON_BinaryArchive::BufferCompressionCodec::Deflate);
+  ON_ENUM_FROM_UNSIGNED_CASE(ON_BinaryArchive::BufferCompressionCodec::FastLZ);
+  ON_ENUM_FROM_UNSIGNED_CASE(ON_BinaryArchive::BufferCompressionCodec::BlockDeflate);
+  }
+
+  ON_ERROR("Invalid buffer_compression_codec_as_unsigned parameter.");
+  return ON_BinaryArchive::BufferCompressionCodec::Deflate;
+}
+
+void ON_BinaryArchive::SetBufferCompressionLevel(
+  ON_BinaryArchive::BufferCompressionLevel level
+)
+{
+  if (ON_BinaryArchive::BufferCompressionLevel::None == level)
+  {
+    m_bUseBufferCompression = false;
+  }
+  else
+  {
+    m_bUseBufferCompression = true;
+    m_buffer_compression_level = level;
+  }
+}
+
+ON_BinaryArchive::BufferCompressionLevel ON_BinaryArchive::GetBufferCompressionLevel() const
+{
+  return
+    m_bUseBufferCompression
+    ? m_buffer_compression_level
+    : ON_BinaryArchive::BufferCompressionLevel::None;
+}
+
+void ON_BinaryArchive::SetBufferCompressionCodec(
+  ON_BinaryArchive::BufferCompressionCodec codec
+)
+{
+  m_buffer_compression_codec = codec;
+}
+
+ON_BinaryArchive::BufferCompressionCodec ON_BinaryArchive::GetBufferCompressionCodec() const
+{
+  return m_buffer_compression_codec;
+}
+
+void ON_BinaryArchive::SetBufferCompressionThreadCount(
+  unsigned int thread_count
+)
+{
+  m_buffer_compression_thread_count = (unsigned char)((thread_count < 255) ? thread_count : 255);
+}
+
+unsigned int ON_BinaryArchive::BufferCompressionThreadCount() const
+{
+  return m_buffer_compression_thread_count;
+}
   
 void ON_BinaryArchive::SetSave3dmPreviewImage(
   bool bSave3dmPreviewImage
@@ -15433,6 +15523,33 @@ int ON_BinaryArchive::Read3dmModelGeometry(
   );
 }
 
+/*
+Returns:
+  True if records with this ON::object_type value can be read
+  without the annotation and dimension style state of the archive.
+*/
+static bool Internal_IsIndependentObjectRecordType(
+  ON__UINT64 object_type
+)
+{
+  switch (object_type)
+  {
+  case ON::object_type::point_object:
+  case ON::object_type::pointset_object:
+  case ON::object_type::curve_object:
+  case ON::object_type::surface_object:
+  case ON::object_type::brep_object:
+  case ON::object_type::mesh_object:
+  case ON::object_type::subd_object:
+  case ON::object_type::cage_object:
+  case ON::object_type::extrusion_object:
+    return true;
+  default:
+    break;
+  }
+  return false;
+}
+
 int ON_BinaryArchive::Read3dmModelGeometryForExperts(
   bool bManageGeometry,
   bool bManageAttributes,
@@ -15485,110 +15602,200 @@ int ON_BinaryArchive::Read3dmObject(
   }
   else 
   {
-    ON__UINT32 tcode = 0;
-    ON__INT64 length_TCODE_OBJECT_RECORD = 0;
-    ON__INT64 value_TCODE_OBJECT_RECORD_TYPE = 0;
-    ON__INT64 length_TCODE_OBJECT_RECORD_ATTRIBUTES = 0;
-    if ( BeginRead3dmBigChunk( &tcode, &length_TCODE_OBJECT_RECORD ) ) 
+    rc = Internal_Read3dmObjectRecord(ppObject,pAttributes,object_filter,true,nullptr);
+  }
+
+  if ( 1 == rc )
+    Internal_Read3dmObjectFinish(ppObject,pAttributes);
+
+  return rc;
+}
+
+int ON_BinaryArchive::Read3dmObjectOrDeferGeometry(
+  ON_Object** ppObject,
+  ON_3dmObjectAttributes* pAttributes,
+  unsigned int object_filter,
+  ON_3dmArchiveTableOfContentsItem& deferred_object
+  )
+{
+  deferred_object = ON_3dmArchiveTableOfContentsItem::Unset;
+
+  if ( m_3dm_version == 1 || nullptr == ppObject || nullptr == pAttributes )
+    return Read3dmObject(ppObject,pAttributes,object_filter);
+
+  *ppObject = nullptr;
+  pAttributes->Default();
+
+  if ( false == Read3dmTableRecord(ON_3dmArchiveTableType::object_table, (void**)ppObject))
+    return 0;
+
+  if ( 0 == object_filter ) // default filter (0) reads every object
+    object_filter = 0xFFFFFFFF;
+
+  const ON__UINT64 offset = CurrentPosition();
+  bool bDeferredObject = false;
+  const int rc = Internal_Read3dmObjectRecord(ppObject,pAttributes,object_filter,true,&bDeferredObject);
+  if ( 1 == rc )
+  {
+    if (bDeferredObject)
     {
-      if ( tcode == TCODE_OBJECT_RECORD ) 
-      {
+      deferred_object.m_component_id = pAttributes->m_uuid;
+      deferred_object.m_component_type = ON_ModelComponent::Type::ModelGeometry;
+      deferred_object.m_offset = offset;
+      deferred_object.m_length = CurrentPosition() - offset;
+      Internal_Read3dmObjectFinish(nullptr,pAttributes);
+    }
+    else
+      Internal_Read3dmObjectFinish(ppObject,pAttributes);
+  }
+
+  return rc;
+}
+
+int ON_BinaryArchive::Internal_Read3dmObjectRecord(
+  ON_Object** ppObject,
+  ON_3dmObjectAttributes* pAttributes,
+  unsigned int object_filter,
+  bool bIncrementTableItemCount,
+  bool* bDeferredObject
+  )
+{
+  // returns -1: failure
+  //          0: end of geometry table
+  //          1: success
+  //          2: skipped filtered objects
+  //          3: skipped new object (object's class UUID wasn't found in class list)
+  int rc = -1;
+  ON__UINT32 tcode = 0;
+  ON__INT64 length_TCODE_OBJECT_RECORD = 0;
+  ON__INT64 value_TCODE_OBJECT_RECORD_TYPE = 0;
+  ON__INT64 length_TCODE_OBJECT_RECORD_ATTRIBUTES = 0;
+  if ( BeginRead3dmBigChunk( &tcode, &length_TCODE_OBJECT_RECORD ) ) 
+  {
+    if ( tcode == TCODE_OBJECT_RECORD ) 
+    {
+      if (bIncrementTableItemCount)
         Internal_Increment3dmTableItemCount();
-        if (BeginRead3dmBigChunk( &tcode, &value_TCODE_OBJECT_RECORD_TYPE )) 
+      if (BeginRead3dmBigChunk( &tcode, &value_TCODE_OBJECT_RECORD_TYPE )) 
+      {
+        if ( tcode != TCODE_OBJECT_RECORD_TYPE ) {
+          rc = -1;
+          ON_ERROR("ON_BinaryArchive::Read3dmObject() - missing TCODE_OBJECT_RECORD_TYPE chunk.");
+        }
+        else if ( 0 != value_TCODE_OBJECT_RECORD_TYPE && 0 == (value_TCODE_OBJECT_RECORD_TYPE & object_filter) )
+          rc = 2; // skip reading this object
+        else
+          rc = 1; // need to read this object
+
+        if ( !EndRead3dmChunk() )
+          rc = -1;
+
+        if ( 1 == rc
+          && nullptr != bDeferredObject
+          && Internal_IsIndependentObjectRecordType((ON__UINT64)value_TCODE_OBJECT_RECORD_TYPE)
+          )
         {
-          if ( tcode != TCODE_OBJECT_RECORD_TYPE ) {
+          // Skip the object. The record CRC cannot be checked without
+          // reading every byte, so it is checked when the object is read.
+          ON_3DM_BIG_CHUNK* c = m_chunk.Last();
+          c->m_do_crc16 = false;
+          c->m_do_crc32 = false;
+          m_bDoChunkCRC = false;
+          ON__UINT32 object_tcode = 0;
+          ON__INT64 length_object_chunk = 0;
+          if (!BeginRead3dmBigChunk( &object_tcode, &length_object_chunk ))
             rc = -1;
-            ON_ERROR("ON_BinaryArchive::Read3dmObject() - missing TCODE_OBJECT_RECORD_TYPE chunk.");
-          }
-          else if ( 0 != value_TCODE_OBJECT_RECORD_TYPE && 0 == (value_TCODE_OBJECT_RECORD_TYPE & object_filter) )
-            rc = 2; // skip reading this object
-          else
-            rc = 1; // need to read this object
-
-          if ( !EndRead3dmChunk() )
+          else if (!EndRead3dmChunk(true))
             rc = -1;
-
-          if ( 1 == rc )
+          else
+            *bDeferredObject = true;
+        }
+        else if ( 1 == rc )
+        {
+          switch(ReadObject(ppObject))
           {
-            switch(ReadObject(ppObject))
-            {
-            case 1:
-              rc = 1; // successfully read this object
-              break;
-            case 3:
-              rc = 3; // skipped object - assume it's just a newer object than this code reads
-              break;
-            default:
-              rc = -1; // serious failure
-              break;
-            }
+          case 1:
+            rc = 1; // successfully read this object
+            break;
+          case 3:
+            rc = 3; // skipped object - assume it's just a newer object than this code reads
+            break;
+          default:
+            rc = -1; // serious failure
+            break;
           }
         }
-        else
-          rc = -1;
-      }
-      else if ( tcode != TCODE_ENDOFTABLE ) {
-        ON_ERROR("ON_BinaryArchive::Read3dmObject() - corrupt object table");
-        rc = -1;
       }
       else
-        rc = 0;
+        rc = -1;
+    }
+    else if ( tcode != TCODE_ENDOFTABLE ) {
+      ON_ERROR("ON_BinaryArchive::Read3dmObject() - corrupt object table");
+      rc = -1;
+    }
+    else
+      rc = 0;
 
-      while(rc==1)
+    while(rc==1)
+    {
+      tcode = 0;
+      if (!BeginRead3dmBigChunk( &tcode, &length_TCODE_OBJECT_RECORD_ATTRIBUTES )) {
+        rc = -1;
+        break;
+      }
+      if ( tcode == TCODE_OBJECT_RECORD_ATTRIBUTES ) 
       {
-        tcode = 0;
-        if (!BeginRead3dmBigChunk( &tcode, &length_TCODE_OBJECT_RECORD_ATTRIBUTES )) {
-          rc = -1;
-          break;
-        }
-        if ( tcode == TCODE_OBJECT_RECORD_ATTRIBUTES ) 
+        if ( 0 != pAttributes )
         {
-          if ( 0 != pAttributes )
-          {
-            if ( !pAttributes->Read( *this ) )
-              rc = -1;
-          }
+          if ( !pAttributes->Read( *this ) )
+            rc = -1;
         }
-        else if ( tcode == TCODE_OBJECT_RECORD_ATTRIBUTES_USERDATA )
+      }
+      else if ( tcode == TCODE_OBJECT_RECORD_ATTRIBUTES_USERDATA )
+      {
+        if ( 0 != pAttributes )
         {
-          if ( 0 != pAttributes )
+          // 19 October 2004
+          //   Added support for saving user data on object attributes
+          if ( !ReadObjectUserData(*pAttributes))
+            rc = -1;
+          else
           {
-            // 19 October 2004
-            //   Added support for saving user data on object attributes
-            if ( !ReadObjectUserData(*pAttributes))
-              rc = -1;
-            else
-            {
 #if 1
-              // 3 March 2011 - convert obsolete user data
-              ON_OBSOLETE_CCustomMeshUserData* ud = ON_OBSOLETE_CCustomMeshUserData::Cast(pAttributes->GetUserData(ON_CLASS_ID(ON_OBSOLETE_CCustomMeshUserData)));
-              if ( ud )
-              {
-                ud->m_mp.SetCustomSettingsEnabled(ud->m_bInUse);
-                pAttributes->SetCustomRenderMeshParameters(ud->m_mp);
-                delete ud;
-              }
-#endif
+            // 3 March 2011 - convert obsolete user data
+            ON_OBSOLETE_CCustomMeshUserData* ud = ON_OBSOLETE_CCustomMeshUserData::Cast(pAttributes->GetUserData(ON_CLASS_ID(ON_OBSOLETE_CCustomMeshUserData)));
+            if ( ud )
+            {
+              ud->m_mp.SetCustomSettingsEnabled(ud->m_bInUse);
+              pAttributes->SetCustomRenderMeshParameters(ud->m_mp);
+              delete ud;
             }
+#endif
           }
         }
-
-        if ( !EndRead3dmChunk() ) 
-        {
-          rc = -1;
-        }
-        if ( tcode == TCODE_OBJECT_RECORD_END )
-          break;
       }
 
-      if ( !EndRead3dmChunk() )
+      if ( !EndRead3dmChunk() ) 
+      {
         rc = -1;
+      }
+      if ( tcode == TCODE_OBJECT_RECORD_END )
+        break;
     }
+
+    if ( !EndRead3dmChunk() )
+      rc = -1;
   }
 
-  if ( 1 == rc 
-    && nullptr != ppObject
-    && nullptr != *ppObject
+  return rc;
+}
+
+void ON_BinaryArchive::Internal_Read3dmObjectFinish(
+  ON_Object** ppObject,
+  ON_3dmObjectAttributes* pAttributes
+  )
+{
+  if ( (nullptr == ppObject || nullptr != *ppObject)
     && nullptr != pAttributes
     )
   {
@@ -15609,7 +15816,7 @@ int ON_BinaryArchive::Read3dmObject(
     // Examples include reading obsolete objects and converting them into their 
     // current counterpart, converting WIP objects into a proxy for a commercial build, 
     // and converting a proxy object into a WIP object for a WIP build.
-    ON_Object* updated_object = Internal_ConvertObject(*ppObject, pAttributes);
+    ON_Object* updated_object = (nullptr != ppObject) ? Internal_ConvertObject(*ppObject, pAttributes) : nullptr;
 
     if (nullptr != updated_object && updated_object != *ppObject)
     {
@@ -15624,65 +15831,406 @@ int ON_BinaryArchive::Read3dmObject(
       pAttributes->m_name
       );
   }
+}
 
-  return rc;
+// Limits of the records copied by one scan in Read3dmModelGeometryListForExperts().
+#define ON_ObjectRecordBatch_max_count 4096
+#define ON_ObjectRecordBatch_max_size 0x4000000
+// Smaller batches are decoded on the calling thread.
+#define ON_ObjectRecordBatch_min_parallel_size 0x10000
+
+class ON_Internal_ObjectRecordBatch
+{
+public:
+  ON_Internal_ObjectRecordBatch() = default;
+  ~ON_Internal_ObjectRecordBatch();
+
+  void Reset();
+  unsigned char* AppendRecord(size_t sizeof_record);
+
+  const ON_BinaryArchive* m_source_archive = nullptr;
+  const ON_ManifestMap* m_manifest_map = nullptr;
+  unsigned int m_object_filter = 0;
+
+  // Copies of TCODE_OBJECT_RECORD chunks in archive order.
+  unsigned char* m_buffer = nullptr;
+  size_t m_sizeof_buffer = 0;
+  size_t m_buffer_capacity = 0;
+  ON_SimpleArray<size_t> m_record_offset;
+
+  // Results of Internal_Read3dmObjectRecord() for each record.
+  ON_SimpleArray<int> m_rc;
+  ON_SimpleArray<ON_Object*> m_object;
+  ON_SimpleArray<ON_3dmObjectAttributes*> m_attributes;
+
+  std::atomic<unsigned int> m_next_record;
+  std::atomic<unsigned int> m_crc_error_count;
+
+  // Times of the decoding threads when the source archive has a profile.
+#if !defined(OPENNURBS_NO_STD_MUTEX)
+  std::mutex m_profile_mutex;
+#endif
+  ON_BinaryArchiveProfile m_profile;
+
+private:
+  ON_Internal_ObjectRecordBatch(const ON_Internal_ObjectRecordBatch&) = delete;
+  ON_Internal_ObjectRecordBatch& operator=(const ON_Internal_ObjectRecordBatch&) = delete;
+};
+
+ON_Internal_ObjectRecordBatch::~ON_Internal_ObjectRecordBatch()
+{
+  Reset();
+  if (nullptr != m_buffer)
+    onfree(m_buffer);
 }
 
-bool ON_BinaryArchive::EndRead3dmObjectTable()
+void ON_Internal_ObjectRecordBatch::Reset()
 {
-  bool rc = EndRead3dmTable( TCODE_OBJECT_TABLE );
+  for (int i = 0; i < m_object.Count(); i++)
+  {
+    delete m_object[i];
+    delete m_attributes[i];
+  }
+  m_sizeof_buffer = 0;
+  m_record_offset.SetCount(0);
+  m_rc.SetCount(0);
+  m_object.SetCount(0);
+  m_attributes.SetCount(0);
+  m_next_record = 0;
+  m_crc_error_count = 0;
+}
 
-  if ( 0 != m_V1_layer_list )
+unsigned char* ON_Internal_ObjectRecordBatch::AppendRecord(size_t sizeof_record)
+{
+  if (m_sizeof_buffer + sizeof_record > m_buffer_capacity)
   {
-    struct ON__3dmV1LayerIndex* next = m_V1_layer_list;
-    m_V1_layer_list = 0;
-    for ( int i = 0; 0 != next && i < 1000; i++ )
-    {
-      struct ON__3dmV1LayerIndex* p = next;
-      next = p->m_next;
-      onfree(p);
-    }
+    size_t capacity = (m_buffer_capacity > 0) ? 2*m_buffer_capacity : 0x10000;
+    while (capacity < m_sizeof_buffer + sizeof_record)
+      capacity *= 2;
+    unsigned char* buffer = (unsigned char*)onrealloc(m_buffer, capacity);
+    if (nullptr == buffer)
+      return nullptr;
+    m_buffer = buffer;
+    m_buffer_capacity = capacity;
   }
+  unsigned char* record = m_buffer + m_sizeof_buffer;
+  m_record_offset.Append(m_sizeof_buffer);
+  m_sizeof_buffer += sizeof_record;
+  return record;
+}
 
-  return rc;
+static ON__UINT64 Internal_LittleEndianValue(
+  const unsigned char* bytes,
+  size_t sizeof_value
+)
+{
+  ON__UINT64 value = 0;
+  for (size_t i = sizeof_value; i > 0; i--)
+    value = (value << 8) | bytes[i-1];
+  return value;
 }
 
-bool ON_BinaryArchive::BeginWrite3dmUserTable( const ON_UUID& usertable_uuid )
+void ON_BinaryArchive::Internal_CopyObjectRecordReadContext(
+  const ON_BinaryArchive& source_archive,
+  const ON_ManifestMap& manifest_map
+  )
 {
-  return BeginWrite3dmUserTable(usertable_uuid, false, 0, 0 );
+  m_archive_runtime_environment = source_archive.m_archive_runtime_environment;
+  m_error_message_mask = source_archive.m_error_message_mask;
+  m_user_data_filter = source_archive.m_user_data_filter;
+  m_manifest_map = manifest_map;
+  m_bReferencedComponentIndexMapping = source_archive.m_bReferencedComponentIndexMapping;
+  m_bReferencedComponentIdMapping = source_archive.m_bReferencedComponentIdMapping;
+  m_model_serial_number = source_archive.m_model_serial_number;
+  m_reference_model_serial_number = source_archive.m_reference_model_serial_number;
+  m_instance_definition_model_serial_number = source_archive.m_instance_definition_model_serial_number;
+  m_text_style_to_dim_style_archive_index_map = source_archive.m_text_style_to_dim_style_archive_index_map;
 }
 
-bool ON_BinaryArchive::BeginWrite3dmUserTable(
-    ON_UUID plugin_id,
-    bool bSavingGoo,
-    int goo_3dm_version,
-    unsigned int goo_opennurbs_version
-    )
+void ON_BinaryArchive::Internal_DecodeObjectRecords(
+  ON_Internal_ObjectRecordBatch* batch
+  )
 {
-  if ( m_3dm_active_table != ON_3dmArchiveTableType::Unset ) 
+  const ON_BinaryArchive& source_archive = *batch->m_source_archive;
+  ON_Read3dmBufferArchive buffer_archive(
+    batch->m_sizeof_buffer,
+    batch->m_buffer,
+    false,
+    source_archive.Archive3dmVersion(),
+    source_archive.ArchiveOpenNURBSVersion()
+    );
+  ON_BinaryArchive& archive = buffer_archive;
+  archive.Internal_CopyObjectRecordReadContext(source_archive, *batch->m_manifest_map);
+  ON_BinaryArchiveProfile profile;
+  if (nullptr != source_archive.m_profile)
+    archive.SetProfile(&profile);
+
+  const unsigned int record_count = batch->m_record_offset.UnsignedCount();
+  for (unsigned int i = batch->m_next_record++; i < record_count; i = batch->m_next_record++)
   {
-    ON_ERROR("ON_BinaryArchive::BeginWrite3dmUserTable() - m_active_table != no_active_table");
-  }
-  if ( !ON_UuidCompare( &ON_nil_uuid, &plugin_id ) ) {
-    ON_ERROR("ON_BinaryArchive::BeginWrite3dmUserTable() - nil usertable_uuid not permitted.");
-    return false;
+    int rc = -1;
+    batch->m_attributes[i] = new ON_3dmObjectAttributes();
+    if (archive.SeekFromStart(batch->m_record_offset[i]))
+      rc = archive.Internal_Read3dmObjectRecord(&batch->m_object[i], batch->m_attributes[i], batch->m_object_filter, false, nullptr);
+    batch->m_rc[i] = rc;
+    if (rc < 0)
+      break; // the archive chunk state is not reliable after a failure
   }
 
-  if (false == ArchiveContains3dmTable(ON_3dmArchiveTableType::user_table))
-    return false;
-  
-  if (false == ShouldSerializeUserDataItem(plugin_id, plugin_id))
-    return false;
+  batch->m_crc_error_count += archive.BadCRCCount();
 
-  if ( bSavingGoo )
+  if (nullptr != source_archive.m_profile)
   {
-    if ( goo_3dm_version <= 3 )
-      return false;
-    if ( goo_opennurbs_version < 200601010 )
-      return false;
-    if ( goo_3dm_version >= 50 && Archive3dmVersion() < 50 )
-    {
-      // goo with 8 byte chunk lengths cannot be saved 
+    archive.SetProfile(nullptr);
+#if !defined(OPENNURBS_NO_STD_MUTEX)
+    std::lock_guard<std::mutex> lock(batch->m_profile_mutex);
+#endif
+    batch->m_profile.Add(profile);
+  }
+}
+
+int ON_BinaryArchive::Read3dmModelGeometryListForExperts(
+  bool bManageGeometry,
+  bool bManageAttributes,
+  unsigned int object_filter,
+  unsigned int thread_count,
+  ON_SimpleArray<ON_ModelGeometryComponent*>& model_geometry_list
+  )
+{
+#if defined(OPENNURBS_NO_STD_THREAD)
+  thread_count = 1;
+#else
+  if (0 == thread_count)
+    thread_count = std::thread::hardware_concurrency();
+#endif
+
+  if (m_3dm_version == 1 || thread_count <= 1)
+  {
+    for (;;)
+    {
+      ON_ModelGeometryComponent* model_geometry = nullptr;
+      const int rc = Read3dmModelGeometryForExperts(bManageGeometry, bManageAttributes, &model_geometry, object_filter);
+      if (rc <= 0)
+        return rc;
+      if (nullptr != model_geometry)
+        model_geometry_list.Append(model_geometry);
+    }
+  }
+
+  if (0 == object_filter) // default filter (0) reads every object
+    object_filter = 0xFFFFFFFF;
+
+  // The map is not changed while the list is read.
+  const ON_ManifestMap manifest_map(ManifestMap());
+
+  ON_Internal_ObjectRecordBatch batch;
+  batch.m_source_archive = this;
+  batch.m_manifest_map = &manifest_map;
+  batch.m_object_filter = object_filter;
+
+  const size_t sizeof_chunk_header = 4 + SizeofChunkLength();
+#if !defined(OPENNURBS_NO_STD_THREAD)
+  std::thread* workers = new std::thread[thread_count];
+#endif
+
+  int rc = 0;
+  for (;;)
+  {
+    if (false == Internal_Begin3dmTableRecord(ON_3dmArchiveTableType::object_table))
+      break;
+
+    // Copy the records that can be decoded independently.
+    batch.Reset();
+    bool bReadError = false;
+    while (batch.m_record_offset.UnsignedCount() < ON_ObjectRecordBatch_max_count
+      && batch.m_sizeof_buffer < ON_ObjectRecordBatch_max_size
+      )
+    {
+      ON__UINT32 tcode = 0;
+      ON__INT64 length_TCODE_OBJECT_RECORD = 0;
+      if (false == PeekAt3dmBigChunkType(&tcode, &length_TCODE_OBJECT_RECORD))
+        break;
+      if (TCODE_OBJECT_RECORD != tcode || length_TCODE_OBJECT_RECORD < (ON__INT64)sizeof_chunk_header)
+        break;
+      const size_t sizeof_record = sizeof_chunk_header + (size_t)length_TCODE_OBJECT_RECORD;
+      unsigned char* record = batch.AppendRecord(sizeof_record);
+      if (nullptr == record || false == ReadByte(sizeof_record, record))
+      {
+        bReadError = true;
+        break;
+      }
+
+      const ON__UINT64 type_tcode = Internal_LittleEndianValue(record + sizeof_chunk_header, 4);
+      const ON__UINT64 object_type = Internal_LittleEndianValue(record + sizeof_chunk_header + 4, SizeofChunkLength());
+      if (TCODE_OBJECT_RECORD_TYPE != type_tcode || false == Internal_IsIndependentObjectRecordType(object_type))
+      {
+        // Read3dmModelGeometryForExperts() reads this record.
+        batch.m_record_offset.Remove();
+        batch.m_sizeof_buffer -= sizeof_record;
+        bReadError = (false == SeekBackward(sizeof_record));
+        break;
+      }
+
+      Internal_Increment3dmTableItemCount();
+      if (0 == (object_type & object_filter))
+      {
+        // skip reading this object
+        batch.m_record_offset.Remove();
+        batch.m_sizeof_buffer -= sizeof_record;
+      }
+    }
+
+    const unsigned int record_count = batch.m_record_offset.UnsignedCount();
+    if (0 == record_count)
+    {
+      if (bReadError)
+      {
+        rc = -1;
+        break;
+      }
+      ON_ModelGeometryComponent* model_geometry = nullptr;
+      rc = Read3dmModelGeometryForExperts(bManageGeometry, bManageAttributes, &model_geometry, object_filter);
+      if (rc <= 0)
+        break;
+      if (nullptr != model_geometry)
+        model_geometry_list.Append(model_geometry);
+      rc = 0;
+      continue;
+    }
+
+    // Decode the records.
+    batch.m_rc.SetCount(0);
+    batch.m_rc.Reserve(record_count);
+    for (unsigned int i = 0; i < record_count; i++)
+      batch.m_rc.Append(-1);
+    batch.m_object.Reserve(record_count);
+    batch.m_object.SetCount(record_count);
+    batch.m_object.Zero();
+    batch.m_attributes.Reserve(record_count);
+    batch.m_attributes.SetCount(record_count);
+    batch.m_attributes.Zero();
+
+    unsigned int worker_count = (thread_count < record_count) ? thread_count : record_count;
+    if (batch.m_sizeof_buffer < ON_ObjectRecordBatch_min_parallel_size)
+      worker_count = 1;
+#if defined(OPENNURBS_NO_STD_MUTEX)
+    // The profiles of the decoding threads cannot be merged without std::mutex.
+    if (nullptr != m_profile)
+      worker_count = 1;
+#endif
+    {
+      // The decoding threads measure their own time.
+      const ProfileTask profile_task(*this, static_cast<ON_BinaryArchiveProfile::Task>(ON_BinaryArchiveProfile::TaskCount));
+#if !defined(OPENNURBS_NO_STD_THREAD)
+      for (unsigned int i = 1; i < worker_count; i++)
+        workers[i] = std::thread(ON_BinaryArchive::Internal_DecodeObjectRecords, &batch);
+#endif
+      Internal_DecodeObjectRecords(&batch);
+#if !defined(OPENNURBS_NO_STD_THREAD)
+      for (unsigned int i = 1; i < worker_count; i++)
+        workers[i].join();
+#endif
+    }
+    if (nullptr != m_profile)
+    {
+      m_profile->Add(batch.m_profile);
+      batch.m_profile = ON_BinaryArchiveProfile();
+    }
+
+    for (unsigned int i = batch.m_crc_error_count; i > 0; i--)
+      Internal_ReportCRCError();
+
+    // Assign ids and update the manifest in archive order.
+    for (unsigned int i = 0; i < record_count && 0 == rc; i++)
+    {
+      if (batch.m_rc[i] < 0)
+      {
+        ON_ERROR("ON_BinaryArchive::Read3dmModelGeometryListForExperts() - corrupt object record");
+        rc = -1;
+        break;
+      }
+      if (1 != batch.m_rc[i])
+        continue;
+      Internal_Read3dmObjectFinish(&batch.m_object[i], batch.m_attributes[i]);
+      ON_Geometry* geometry = ON_Geometry::Cast(batch.m_object[i]);
+      if (nullptr == geometry)
+        continue;
+      ON_ModelGeometryComponent* model_geometry = ON_ModelGeometryComponent::CreateForExperts(bManageGeometry, geometry, bManageAttributes, batch.m_attributes[i], nullptr);
+      if (nullptr != model_geometry)
+      {
+        model_geometry_list.Append(model_geometry);
+        batch.m_object[i] = nullptr;
+        batch.m_attributes[i] = nullptr;
+      }
+    }
+    if (0 != rc || bReadError)
+    {
+      rc = -1;
+      break;
+    }
+  }
+
+#if !defined(OPENNURBS_NO_STD_THREAD)
+  delete[] workers;
+#endif
+  return rc;
+}
+
+bool ON_BinaryArchive::EndRead3dmObjectTable()
+{
+  bool rc = EndRead3dmTable( TCODE_OBJECT_TABLE );
+
+  if ( 0 != m_V1_layer_list )
+  {
+    struct ON__3dmV1LayerIndex* next = m_V1_layer_list;
+    m_V1_layer_list = 0;
+    for ( int i = 0; 0 != next && i < 1000; i++ )
+    {
+      struct ON__3dmV1LayerIndex* p = next;
+      next = p->m_next;
+      onfree(p);
+    }
+  }
+
+  return rc;
+}
+
+bool ON_BinaryArchive::BeginWrite3dmUserTable( const ON_UUID& usertable_uuid )
+{
+  return BeginWrite3dmUserTable(usertable_uuid, false, 0, 0 );
+}
+
+bool ON_BinaryArchive::BeginWrite3dmUserTable(
+    ON_UUID plugin_id,
+    bool bSavingGoo,
+    int goo_3dm_version,
+    unsigned int goo_opennurbs_version
+    )
+{
+  if ( m_3dm_active_table != ON_3dmArchiveTableType::Unset ) 
+  {
+    ON_ERROR("ON_BinaryArchive::BeginWrite3dmUserTable() - m_active_table != no_active_table");
+  }
+  if ( !ON_UuidCompare( &ON_nil_uuid, &plugin_id ) ) {
+    ON_ERROR("ON_BinaryArchive::BeginWrite3dmUserTable() - nil usertable_uuid not permitted.");
+    return false;
+  }
+
+  if (false == ArchiveContains3dmTable(ON_3dmArchiveTableType::user_table))
+    return false;
+  
+  if (false == ShouldSerializeUserDataItem(plugin_id, plugin_id))
+    return false;
+
+  if ( bSavingGoo )
+  {
+    if ( goo_3dm_version <= 3 )
+      return false;
+    if ( goo_opennurbs_version < 200601010 )
+      return false;
+    if ( goo_3dm_version >= 50 && Archive3dmVersion() < 50 )
+    {
+      // goo with 8 byte chunk lengths cannot be saved 
       // in files expecting 4 byte chunk lengths.
       return false;
     }
@@ -16080,6 +16628,311 @@ bool ON_BinaryArchive::Read3dmEndMark( size_t* file_length )
   return End3dmTable(ON_3dmArchiveTableType::end_mark,rc);
 }
 
+void ON_3dmArchiveTableOfContents::Clear()
+{
+  m_items.SetCount(0);
+  m_id_index.RemoveAll();
+}
+
+void ON_3dmArchiveTableOfContents::Append(
+  const ON_3dmArchiveTableOfContentsItem& item
+  )
+{
+  m_id_index.AddUuidIndex(item.m_component_id, m_items.Count(), false);
+  m_items.Append(item);
+}
+
+unsigned int ON_3dmArchiveTableOfContents::ItemCount() const
+{
+  return m_items.UnsignedCount();
+}
+
+const ON_3dmArchiveTableOfContentsItem& ON_3dmArchiveTableOfContents::Item(
+  unsigned int item_index
+  ) const
+{
+  return (item_index < m_items.UnsignedCount()) ? m_items[item_index] : ON_3dmArchiveTableOfContentsItem::Unset;
+}
+
+const ON_3dmArchiveTableOfContentsItem& ON_3dmArchiveTableOfContents::ItemFromId(
+  ON_UUID component_id
+  ) const
+{
+  int item_index = -1;
+  if (ON_UuidIsNotNil(component_id) && m_id_index.FindUuid(component_id, &item_index))
+    return Item((unsigned int)item_index);
+  return ON_3dmArchiveTableOfContentsItem::Unset;
+}
+
+unsigned int ON_3dmArchiveTableOfContents::GetItemsFromName(
+  ON_ModelComponent::Type component_type,
+  const wchar_t* name,
+  ON_SimpleArray<const ON_3dmArchiveTableOfContentsItem*>& items
+  ) const
+{
+  const ON_SHA1_Hash name_hash = ON_NameHash::Create(name).MappedNameSha1Hash();
+  const unsigned int count0 = items.UnsignedCount();
+  for (unsigned int i = 0; i < m_items.UnsignedCount(); i++)
+  {
+    if (component_type == m_items[i].m_component_type && name_hash == m_items[i].m_name_hash)
+      items.Append(&m_items[i]);
+  }
+  return items.UnsignedCount() - count0;
+}
+
+unsigned int ON_3dmArchiveTableOfContents::GetItemsFromLayerId(
+  ON_UUID layer_id,
+  ON_SimpleArray<const ON_3dmArchiveTableOfContentsItem*>& items
+  ) const
+{
+  const unsigned int count0 = items.UnsignedCount();
+  for (unsigned int i = 0; i < m_items.UnsignedCount(); i++)
+  {
+    if (ON_ModelComponent::Type::ModelGeometry == m_items[i].m_component_type && layer_id == m_items[i].m_layer_id)
+      items.Append(&m_items[i]);
+  }
+  return items.UnsignedCount() - count0;
+}
+
+bool ON_3dmArchiveTableOfContents::Write(
+  ON_BinaryArchive& archive
+  ) const
+{
+  // version 1.1 adds m_bbox
+  if (!archive.BeginWrite3dmChunk(TCODE_ANONYMOUS_CHUNK, 1, 1))
+    return false;
+
+  bool rc = false;
+  for (;;)
+  {
+    const unsigned int count = m_items.UnsignedCount();
+    if (!archive.WriteInt(count))
+      break;
+    unsigned int i;
+    for (i = 0; i < count; i++)
+    {
+      const ON_3dmArchiveTableOfContentsItem& item = m_items[i];
+      if (!archive.WriteUuid(item.m_component_id))
+        break;
+      if (!archive.WriteChar(static_cast<unsigned char>(item.m_component_type)))
+        break;
+      if (!archive.WriteByte(sizeof(item.m_name_hash.m_digest), item.m_name_hash.m_digest))
+        break;
+      if (!archive.WriteUuid(item.m_layer_id))
+        break;
+      if (!archive.WriteBigInt(item.m_offset))
+        break;
+      if (!archive.WriteBigInt(item.m_length))
+        break;
+      if (!archive.WriteBoundingBox(item.m_bbox))
+        break;
+    }
+    if (i < count)
+      break;
+    rc = true;
+    break;
+  }
+
+  if (!archive.EndWrite3dmChunk())
+    rc = false;
+  return rc;
+}
+
+bool ON_3dmArchiveTableOfContents::Read(
+  ON_BinaryArchive& archive
+  )
+{
+  Clear();
+
+  int major_version = 0;
+  int minor_version = 0;
+  if (!archive.BeginRead3dmChunk(TCODE_ANONYMOUS_CHUNK, &major_version, &minor_version))
+    return false;
+
+  bool rc = false;
+  for (;;)
+  {
+    if (1 != major_version)
+      break;
+    unsigned int count = 0;
+    if (!archive.ReadInt(&count))
+      break;
+    m_items.Reserve(count);
+    unsigned int i;
+    for (i = 0; i < count; i++)
+    {
+      ON_3dmArchiveTableOfContentsItem item;
+      if (!archive.ReadUuid(item.m_component_id))
+        break;
+      unsigned char component_type = 0;
+      if (!archive.ReadChar(&component_type))
+        break;
+      item.m_component_type = ON_ModelComponent::ComponentTypeFromUnsigned(component_type);
+      if (!archive.ReadByte(sizeof(item.m_name_hash.m_digest), item.m_name_hash.m_digest))
+        break;
+      if (!archive.ReadUuid(item.m_layer_id))
+        break;
+      if (!archive.ReadBigInt(&item.m_offset))
+        break;
+      if (!archive.ReadBigInt(&item.m_length))
+        break;
+      if (minor_version >= 1 && !archive.ReadBoundingBox(item.m_bbox))
+        break;
+      Append(item);
+    }
+    if (i < count)
+      break;
+    rc = true;
+    break;
+  }
+
+  if (!archive.EndRead3dmChunk())
+    rc = false;
+
+  m_id_index.ImproveSearchSpeed();
+
+  return rc;
+}
+
+bool ON_BinaryArchive::Read3dmTableOfContents(
+  ON_3dmArchiveTableOfContents& table_of_contents
+  )
+{
+  table_of_contents.Clear();
+
+  if (!ReadMode() || m_3dm_version <= 1 || 0 != m_chunk.Count())
+    return false;
+
+  const ON__UINT64 pos0 = CurrentPosition();
+  const unsigned int saved_error_message_mask = m_error_message_mask;
+  m_error_message_mask |= 0x0001; // disable v1 ReadByte() error message at EOF
+
+  bool rc = false;
+  for (;;)
+  {
+    // Every table is a single top level chunk.
+    ON__UINT32 tcode = 0;
+    ON__INT64 big_value = 0;
+    if (!PeekAt3dmBigChunkType(&tcode, &big_value))
+      break;
+    if (TCODE_ENDOFFILE == tcode || 0 != (TCODE_SHORT & tcode) || big_value < 0)
+      break;
+
+    if (TCODE_USER_TABLE != tcode)
+    {
+      if (!SeekForward(4 + SizeofChunkLength() + (ON__UINT64)big_value))
+        break;
+      continue;
+    }
+
+    if (!BeginRead3dmBigChunk(&tcode, &big_value))
+      break;
+    ON_UUID plugin_id = ON_nil_uuid;
+    bool bChunkOk = BeginRead3dmBigChunk(&tcode, &big_value);
+    if (bChunkOk)
+    {
+      if (TCODE_USER_TABLE_UUID != tcode || !ReadUuid(plugin_id))
+        plugin_id = ON_nil_uuid;
+      bChunkOk = EndRead3dmChunk(true);
+    }
+    if (bChunkOk && ON_3dmArchiveTableOfContents::UserTableId == plugin_id)
+    {
+      bChunkOk = BeginRead3dmBigChunk(&tcode, &big_value);
+      if (bChunkOk)
+      {
+        rc = (TCODE_USER_RECORD == tcode && table_of_contents.Read(*this));
+        if (!EndRead3dmChunk(true))
+          rc = false;
+      }
+    }
+    if (!EndRead3dmChunk(true))
+      bChunkOk = false;
+    if (rc || !bChunkOk)
+      break;
+  }
+
+  m_error_message_mask = saved_error_message_mask;
+
+  if (!rc)
+    table_of_contents.Clear();
+
+  if (CurrentPosition() != pos0 && !SeekFromStart(pos0))
+    rc = false;
+
+  return rc;
+}
+
+bool ON_BinaryArchive::Read3dmModelGeometryFromTableOfContents(
+  const ON_3dmArchiveTableOfContentsItem& item,
+  bool bManageGeometry,
+  bool bManageAttributes,
+  ON_ModelGeometryComponent** model_geometry
+  )
+{
+  if (nullptr == model_geometry)
+    return false;
+  *model_geometry = nullptr;
+
+  if (ON_ModelComponent::Type::ModelGeometry != item.m_component_type)
+    return false;
+  if (!ReadMode() || m_3dm_version <= 1 || 0 != m_chunk.Count())
+    return false;
+
+  const ON__UINT64 pos0 = CurrentPosition();
+  if (!SeekFromStart(item.m_offset))
+    return false;
+
+  bool rc = false;
+  ON__UINT32 tcode = 0;
+  ON__INT64 length_TCODE_OBJECT_RECORD = 0;
+  if (PeekAt3dmBigChunkType(&tcode, &length_TCODE_OBJECT_RECORD)
+    && TCODE_OBJECT_RECORD == tcode
+    && length_TCODE_OBJECT_RECORD >= 0
+    && 4 + SizeofChunkLength() + (ON__UINT64)length_TCODE_OBJECT_RECORD == item.m_length
+    )
+  {
+    // The manifest map is empty because the tables were not read.
+    const bool bReferencedComponentIndexMapping = m_bReferencedComponentIndexMapping;
+    const bool bReferencedComponentIdMapping = m_bReferencedComponentIdMapping;
+    m_bReferencedComponentIndexMapping = false;
+    m_bReferencedComponentIdMapping = false;
+
+    ON_Object* p = nullptr;
+    ON_3dmObjectAttributes* attributes = new ON_3dmObjectAttributes();
+    if (1 == Internal_Read3dmObjectRecord(&p, attributes, 0xFFFFFFFF, false, nullptr)
+      && nullptr != p
+      && item.m_component_id == attributes->m_uuid
+      )
+    {
+      ON_Object* updated_object = Internal_ConvertObject(p, attributes);
+      if (nullptr != updated_object && updated_object != p)
+      {
+        delete p;
+        p = updated_object;
+      }
+      ON_Geometry* geometry = ON_Geometry::Cast(p);
+      if (nullptr != geometry)
+      {
+        *model_geometry = ON_ModelGeometryComponent::CreateForExperts(bManageGeometry, geometry, bManageAttributes, attributes, nullptr);
+        rc = (nullptr != *model_geometry);
+      }
+    }
+    if (!rc)
+    {
+      delete p;
+      delete attributes;
+    }
+
+    m_bReferencedComponentIndexMapping = bReferencedComponentIndexMapping;
+    m_bReferencedComponentIdMapping = bReferencedComponentIdMapping;
+  }
+
+  if (!SeekFromStart(pos0))
+    ON_ERROR("Unable to restore the archive position.");
+
+  return rc;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
@@ -16158,11 +17011,94 @@ bool ON_BinaryArchive::UnsetMode() const
   return (false == ReadMode() && false == WriteMode());
 }
 
+const char* ON_BinaryArchiveProfile::TaskName(
+  ON_BinaryArchiveProfile::Task task
+  )
+{
+  switch (task)
+  {
+  case ON_BinaryArchiveProfile::Task::ChunkParsing: return "chunk_parsing";
+  case ON_BinaryArchiveProfile::Task::StorageDevice: return "storage_device";
+  case ON_BinaryArchiveProfile::Task::CRC: return "crc";
+  case ON_BinaryArchiveProfile::Task::Inflate: return "inflate";
+  case ON_BinaryArchiveProfile::Task::Deflate: return "deflate";
+  case ON_BinaryArchiveProfile::Task::ObjectConstruction: return "object_construction";
+  }
+  return "";
+}
+
+double ON_BinaryArchiveProfile::Seconds(
+  ON_BinaryArchiveProfile::Task task
+  ) const
+{
+  const unsigned int i = static_cast<unsigned int>(task);
+  return (i < ON_BinaryArchiveProfile::TaskCount) ? m_seconds[i] : 0.0;
+}
+
+double ON_BinaryArchiveProfile::TotalSeconds() const
+{
+  double seconds = 0.0;
+  for (unsigned int i = 0; i < ON_BinaryArchiveProfile::TaskCount; i++)
+    seconds += m_seconds[i];
+  return seconds;
+}
+
+void ON_BinaryArchiveProfile::AddSeconds(
+  ON_BinaryArchiveProfile::Task task,
+  double seconds
+  )
+{
+  const unsigned int i = static_cast<unsigned int>(task);
+  if (i < ON_BinaryArchiveProfile::TaskCount && seconds > 0.0)
+    m_seconds[i] += seconds;
+}
+
+void ON_BinaryArchiveProfile::Add(
+  const ON_BinaryArchiveProfile& profile
+  )
+{
+  for (unsigned int i = 0; i < ON_BinaryArchiveProfile::TaskCount; i++)
+    m_seconds[i] += profile.m_seconds[i];
+}
+
+static double Internal_ProfileClockSeconds()
+{
+  return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void ON_BinaryArchive::SetProfile(
+  ON_BinaryArchiveProfile* profile
+  )
+{
+  if (nullptr != m_profile)
+    Internal_ProfileSwitchTask(static_cast<unsigned int>(ON_BinaryArchiveProfile::Task::ChunkParsing));
+  m_profile = profile;
+  m_profile_task = static_cast<unsigned int>(ON_BinaryArchiveProfile::Task::ChunkParsing);
+  m_profile_time = Internal_ProfileClockSeconds();
+}
+
+ON_BinaryArchiveProfile* ON_BinaryArchive::Profile() const
+{
+  return m_profile;
+}
+
+unsigned int ON_BinaryArchive::Internal_ProfileSwitchTask(unsigned int task)
+{
+  // Tasks >= ON_BinaryArchiveProfile::TaskCount are not measured.
+  const double t = Internal_ProfileClockSeconds();
+  m_profile->AddSeconds(static_cast<ON_BinaryArchiveProfile::Task>(m_profile_task), t - m_profile_time);
+  const unsigned int previous_task = m_profile_task;
+  m_profile_task = task;
+  m_profile_time = t;
+  return previous_task;
+}
+
 void ON_BinaryArchive::UpdateCRC( size_t count, const void* p )
 {
   if ( m_bDoChunkCRC ) {
     ON_3DM_BIG_CHUNK* c = m_chunk.Last();
     if (c) {
+      const ProfileTask profile_task(*this, ON_BinaryArchiveProfile::Task::CRC);
       if ( c->m_do_crc16 )
         c->m_crc16 = ON_CRC16( c->m_crc16, count, p ); // version 1 files had 16 bit CRC
       if ( c->m_do_crc32 )
@@ -16237,61 +17173,426 @@ bool ON_BinaryArchive::MaskReadError( ON__UINT64 sizeof_request, ON__UINT64 size
   if ( sizeof_request == sizeof_read )
     return true; // no error
 
-  if ( sizeof_read > sizeof_request )
-    return false; // something is seriously wrong
+  if ( sizeof_read > sizeof_request )
+    return false; // something is seriously wrong
+
+  if ( 0 != (0x04 & m_error_message_mask) )
+    return true;
+
+  if (0 != (0x01 & m_error_message_mask) && 4 == sizeof_request && 0 == sizeof_read)
+  {
+    // when reading v1 files, there are some situations where
+    // it is reasonable to attempt to read 4 bytes at the end
+    // of a file.
+    return true;
+  }
+
+  if (0 == m_3dm_version
+    && 0 == m_3dm_opennurbs_version
+    && 0 == m_3dm_start_section_offset
+    && ON_3dmArchiveTableType::Unset == m_3dm_previous_table
+    && ON_3dmArchiveTableType::Unset == m_3dm_active_table
+    && ON_3dmArchiveTableType::Unset == m_3dm_first_failed_table
+    && 0 == m_chunk
+    && ON::archive_mode::read3dm == m_mode
+    )
+  {
+    // In Read3dmStartSection(), we search for the string 
+    // "3D Geometry File Format ...".  When a non-.3dm file
+    // is searched, we eventually reach the end of the file.
+    // This error condition is reported by the returning
+    // false from ON_BinaryArchive::Read3dmStartSection().
+    // ON_ERROR is not called to prevent annoying everyone
+    // when the open file dialog is digging around looking
+    // for files.
+    return true;
+  }
+
+  return false; // parial read not permitted at this time.
+}
+
+ON__UINT64 ON_BinaryArchive::ReadBuffer( ON__UINT64 sizeof_buffer, void* buffer )
+{
+  // Expert user function to load a buffer with up to sizeof_buffer
+  // bytes but tolerate encountering the end of the file.
+  if ( 0 == buffer )
+    return 0;
+  unsigned int saved_error_mask = m_error_message_mask;
+  m_error_message_mask |= 0x04; // tell Read to tolerate hitting the end of the file
+  ON__UINT64 sizeof_read = Read((size_t)sizeof_buffer,buffer);
+  m_error_message_mask = saved_error_mask;
+  return sizeof_read;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+#if !defined(OPENNURBS_NO_STD_THREAD) && !defined(OPENNURBS_NO_STD_MUTEX)
+/*
+Description:
+  A range of bytes ON_BinaryFileWriteBehind hands to its background thread.
+*/
+class ON_BinaryFileWriteBehindItem
+{
+public:
+  ON__UINT64 m_offset; // file position of m_bytes[0]
+  unsigned char* m_bytes;
+  size_t m_size;
+  // true if m_bytes is one of the ring buffers,
+  // false if m_bytes was allocated with onmalloc().
+  bool m_bRingBuffer;
+};
+
+/*
+Description:
+  Background writer used by ON_BinaryFile::EnableWriteBehind().
+
+  The caller thread fills an active buffer. When it is full, or the
+  archive seeks past its end, the active buffer is queued and a free
+  ring buffer becomes the active buffer. Writes to positions before the
+  active buffer, like the chunk lengths EndWrite3dmChunk() fills in,
+  are copied and queued immediately. The background thread writes the
+  queued items in order, so later bytes overwrite earlier ones exactly
+  as they would with synchronous writes.
+*/
+class ON_BinaryFileWriteBehind
+{
+public:
+  ON_BinaryFileWriteBehind(
+    FILE* fp,
+    ON__UINT64 position,
+    size_t buffer_capacity,
+    unsigned int buffer_count
+    );
+  ~ON_BinaryFileWriteBehind();
+
+  // Returns number of bytes written.
+  size_t Write(size_t count, const void* p);
+
+  bool SeekFromCurrentPosition(ON__INT64 offset);
+  void SeekFromStart(ON__UINT64 position);
+  ON__UINT64 CurrentPosition() const;
+
+  /*
+  Description:
+    Queues the active buffer and waits until every queued
+    item is written.
+  Returns:
+    True if every write since construction succeeded.
+  */
+  bool Wait();
+
+  /*
+  Description:
+    Stops the background thread.
+  Parameters:
+    bFileIsOpen - [in]
+      true: waits until every queued item is written and sets the
+        file position to CurrentPosition().
+      false: the file may be closed; queued items are discarded
+        and the file is not used.
+  Returns:
+    True if every write since construction succeeded.
+  */
+  bool Stop(bool bFileIsOpen);
+
+  bool IsValid() const;
+
+private:
+  void Internal_QueueActiveBuffer();
+  bool Internal_GetActiveBuffer();
+  void Internal_Queue(const ON_BinaryFileWriteBehindItem& item);
+  static void Internal_WriterThread(ON_BinaryFileWriteBehind* write_behind);
+
+private:
+  FILE* m_fp = nullptr;
+  const size_t m_buffer_capacity;
+  const unsigned int m_buffer_count;
+  unsigned char* m_buffers = nullptr;
+
+  // Caller thread state
+  ON__UINT64 m_position = 0; // current position of the archive
+  unsigned char* m_active = nullptr;
+  ON__UINT64 m_active_offset = 0; // file position of m_active[0]
+  size_t m_active_size = 0;
+  bool m_bErrorReported = false;
+
+  // Background thread state
+  ON__UINT64 m_file_position = 0; // file position of m_fp
+
+  // Shared state; m_mutex protects m_queue, m_free_buffers and m_bStop.
+  std::mutex m_mutex;
+  std::condition_variable m_changed;
+  ON_SimpleArray<ON_BinaryFileWriteBehindItem> m_queue;
+  ON_SimpleArray<unsigned char*> m_free_buffers;
+  bool m_bStop = false;
+  std::atomic<bool> m_bError;
+  std::thread m_thread;
+
+private:
+  ON_BinaryFileWriteBehind() = delete;
+  ON_BinaryFileWriteBehind(const ON_BinaryFileWriteBehind&) = delete;
+  ON_BinaryFileWriteBehind& operator=(const ON_BinaryFileWriteBehind&) = delete;
+};
+
+ON_BinaryFileWriteBehind::ON_BinaryFileWriteBehind(
+  FILE* fp,
+  ON__UINT64 position,
+  size_t buffer_capacity,
+  unsigned int buffer_count
+  )
+  : m_fp(fp)
+  , m_buffer_capacity(buffer_capacity)
+  , m_buffer_count(buffer_count)
+  , m_position(position)
+  , m_file_position(position)
+  , m_bError(false)
+{
+  if (nullptr == fp || buffer_capacity <= 0 || buffer_count < 2)
+    return;
+  m_buffers = (unsigned char*)onmalloc(buffer_capacity*buffer_count);
+  if (nullptr == m_buffers)
+    return;
+  m_free_buffers.Reserve(buffer_count);
+  for (unsigned int i = 0; i < buffer_count; i++)
+    m_free_buffers.Append(m_buffers + i*buffer_capacity);
+  m_thread = std::thread(ON_BinaryFileWriteBehind::Internal_WriterThread, this);
+}
+
+ON_BinaryFileWriteBehind::~ON_BinaryFileWriteBehind()
+{
+  Stop(true);
+  onfree(m_buffers);
+  m_buffers = nullptr;
+}
+
+bool ON_BinaryFileWriteBehind::IsValid() const
+{
+  return m_thread.joinable();
+}
+
+void ON_BinaryFileWriteBehind::Internal_WriterThread(ON_BinaryFileWriteBehind* write_behind)
+{
+  for (;;)
+  {
+    ON_BinaryFileWriteBehindItem item;
+    {
+      std::unique_lock<std::mutex> lock(write_behind->m_mutex);
+      while (0 == write_behind->m_queue.Count() && false == write_behind->m_bStop)
+        write_behind->m_changed.wait(lock);
+      if (0 == write_behind->m_queue.Count())
+        break;
+      item = write_behind->m_queue[0];
+    }
+
+    // After an error the items are discarded so the caller never waits forever.
+    if (false == write_behind->m_bError)
+    {
+      bool rc = true;
+      if (item.m_offset != write_behind->m_file_position)
+        rc = ON_FileStream::SeekFromStart(write_behind->m_fp, (ON__INT64)item.m_offset);
+      if (rc)
+        rc = (item.m_size == fwrite(item.m_bytes, 1, item.m_size, write_behind->m_fp));
+      if (rc)
+        write_behind->m_file_position = item.m_offset + item.m_size;
+      else
+        write_behind->m_bError = true;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(write_behind->m_mutex);
+      write_behind->m_queue.Remove(0);
+      if (item.m_bRingBuffer)
+        write_behind->m_free_buffers.Append(item.m_bytes);
+      else
+        onfree(item.m_bytes);
+    }
+    write_behind->m_changed.notify_all();
+  }
+}
+
+void ON_BinaryFileWriteBehind::Internal_Queue(const ON_BinaryFileWriteBehindItem& item)
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_queue.Append(item);
+  }
+  m_changed.notify_all();
+}
+
+void ON_BinaryFileWriteBehind::Internal_QueueActiveBuffer()
+{
+  if (nullptr == m_active)
+    return;
+  ON_BinaryFileWriteBehindItem item;
+  item.m_offset = m_active_offset;
+  item.m_bytes = m_active;
+  item.m_size = m_active_size;
+  item.m_bRingBuffer = true;
+  m_active = nullptr;
+  m_active_size = 0;
+  if (item.m_size > 0)
+    Internal_Queue(item);
+  else
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_free_buffers.Append(item.m_bytes);
+  }
+}
+
+bool ON_BinaryFileWriteBehind::Internal_GetActiveBuffer()
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (0 == m_free_buffers.Count() && false == m_bError)
+    m_changed.wait(lock);
+  if (m_bError)
+    return false;
+  m_active = *m_free_buffers.Last();
+  m_free_buffers.Remove();
+  m_active_offset = m_position;
+  m_active_size = 0;
+  return true;
+}
+
+size_t ON_BinaryFileWriteBehind::Write(size_t count, const void* p)
+{
+  const unsigned char* b = (const unsigned char*)p;
+  size_t write_count = 0;
+  while (write_count < count && false == m_bError)
+  {
+    if (nullptr != m_active && m_position >= m_active_offset && m_position <= m_active_offset + m_active_size)
+    {
+      // copy to the active buffer
+      const size_t i = (size_t)(m_position - m_active_offset);
+      if (i >= m_buffer_capacity)
+      {
+        Internal_QueueActiveBuffer();
+        continue;
+      }
+      size_t n = m_buffer_capacity - i;
+      if (n > count - write_count)
+        n = count - write_count;
+      memcpy(m_active + i, b + write_count, n);
+      write_count += n;
+      m_position += n;
+      if (i + n > m_active_size)
+        m_active_size = i + n;
+    }
+    else if (nullptr != m_active && m_position < m_active_offset)
+    {
+      // Bytes before the active buffer overwrite bytes that are already queued.
+      size_t n = (size_t)(m_active_offset - m_position);
+      if (n > count - write_count)
+        n = count - write_count;
+      ON_BinaryFileWriteBehindItem item;
+      item.m_offset = m_position;
+      item.m_bytes = (unsigned char*)onmalloc(n);
+      item.m_size = n;
+      item.m_bRingBuffer = false;
+      if (nullptr == item.m_bytes)
+      {
+        m_bError = true;
+        break;
+      }
+      memcpy(item.m_bytes, b + write_count, n);
+      Internal_Queue(item);
+      write_count += n;
+      m_position += n;
+    }
+    else
+    {
+      // The position is past the end of the active buffer.
+      Internal_QueueActiveBuffer();
+      if (false == Internal_GetActiveBuffer())
+        break;
+    }
+  }
+
+  if (m_bError && false == m_bErrorReported)
+  {
+    m_bErrorReported = true;
+    ON_ERROR("fwrite() failed - write-behind.");
+  }
+
+  return write_count;
+}
+
+bool ON_BinaryFileWriteBehind::SeekFromCurrentPosition(ON__INT64 offset)
+{
+  if (offset < 0 && ((ON__UINT64)(-offset)) > m_position)
+    return false;
+  m_position = (ON__UINT64)(((ON__INT64)m_position) + offset);
+  return true;
+}
+
+void ON_BinaryFileWriteBehind::SeekFromStart(ON__UINT64 position)
+{
+  m_position = position;
+}
+
+ON__UINT64 ON_BinaryFileWriteBehind::CurrentPosition() const
+{
+  return m_position;
+}
+
+bool ON_BinaryFileWriteBehind::Wait()
+{
+  Internal_QueueActiveBuffer();
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (m_queue.Count() > 0)
+    m_changed.wait(lock);
+  return (false == m_bError);
+}
 
-  if ( 0 != (0x04 & m_error_message_mask) )
-    return true;
+bool ON_BinaryFileWriteBehind::Stop(bool bFileIsOpen)
+{
+  if (false == m_thread.joinable())
+    return (false == m_bError);
 
-  if (0 != (0x01 & m_error_message_mask) && 4 == sizeof_request && 0 == sizeof_read)
+  bool rc = false;
+  if (bFileIsOpen)
+    rc = Wait();
+  else
+    m_bError = true; // the background thread discards the queued items
   {
-    // when reading v1 files, there are some situations where
-    // it is reasonable to attempt to read 4 bytes at the end
-    // of a file.
-    return true;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_bStop = true;
   }
+  m_changed.notify_all();
+  m_thread.join();
 
-  if (0 == m_3dm_version
-    && 0 == m_3dm_opennurbs_version
-    && 0 == m_3dm_start_section_offset
-    && ON_3dmArchiveTableType::Unset == m_3dm_previous_table
-    && ON_3dmArchiveTableType::Unset == m_3dm_active_table
-    && ON_3dmArchiveTableType::Unset == m_3dm_first_failed_table
-    && 0 == m_chunk
-    && ON::archive_mode::read3dm == m_mode
-    )
+  if (bFileIsOpen && rc && m_file_position != m_position)
   {
-    // In Read3dmStartSection(), we search for the string 
-    // "3D Geometry File Format ...".  When a non-.3dm file
-    // is searched, we eventually reach the end of the file.
-    // This error condition is reported by the returning
-    // false from ON_BinaryArchive::Read3dmStartSection().
-    // ON_ERROR is not called to prevent annoying everyone
-    // when the open file dialog is digging around looking
-    // for files.
-    return true;
+    if (ON_FileStream::SeekFromStart(m_fp, (ON__INT64)m_position))
+      m_file_position = m_position;
+    else
+      rc = false;
   }
-
-  return false; // parial read not permitted at this time.
+  return rc;
 }
 
-ON__UINT64 ON_BinaryArchive::ReadBuffer( ON__UINT64 sizeof_buffer, void* buffer )
-{
-  // Expert user function to load a buffer with up to sizeof_buffer
-  // bytes but tolerate encountering the end of the file.
-  if ( 0 == buffer )
-    return 0;
-  unsigned int saved_error_mask = m_error_message_mask;
-  m_error_message_mask |= 0x04; // tell Read to tolerate hitting the end of the file
-  ON__UINT64 sizeof_read = Read((size_t)sizeof_buffer,buffer);
-  m_error_message_mask = saved_error_mask;
-  return sizeof_read;
-}
+#else
 
+/*
+Description:
+  Write-behind needs std::thread and std::mutex. Without them
+  ON_BinaryFile::EnableWriteBehind() fails and m_write_behind
+  is always nullptr.
+*/
+class ON_BinaryFileWriteBehind
+{
+public:
+  size_t Write(size_t, const void*) { return 0; }
+  bool SeekFromCurrentPosition(ON__INT64) { return false; }
+  void SeekFromStart(ON__UINT64) {}
+  ON__UINT64 CurrentPosition() const { return 0; }
+  bool Wait() { return false; }
+  bool Stop(bool) { return false; }
+};
 
-///////////////////////////////////////////////////////////////////////////////
-///////////////////////////////////////////////////////////////////////////////
-///////////////////////////////////////////////////////////////////////////////
+#endif
 
 ON_BinaryFile::ON_BinaryFile( ON::archive_mode archive_mode ) 
   : ON_BinaryArchive( archive_mode )
@@ -16359,6 +17660,12 @@ ON_BinaryFile::~ON_BinaryFile()
 {
   if ( m_bCloseFileInDestructor )
     CloseFile();
+  else if ( nullptr != m_write_behind )
+  {
+    // The caller owns m_fp and may have closed it already.
+    ON_ERROR("EndWriteBehind() was not called before the file was closed.");
+    Internal_EndWriteBehind(false);
+  }
   EnableMemoryBuffer(0);
 }
 
@@ -16369,6 +17676,7 @@ bool ON_BinaryFile::FileIsOpen() const
 
 void ON_BinaryFile::CloseFile()
 {
+  EndWriteBehind();
   FILE* fp = m_fp;
   if (nullptr != fp)
   {
@@ -16378,6 +17686,78 @@ void ON_BinaryFile::CloseFile()
   m_bCloseFileInDestructor = false;
 }
 
+bool ON_BinaryFile::EnableWriteBehind(
+  size_t buffer_capacity,
+  unsigned int buffer_count
+  )
+{
+  if (nullptr != m_write_behind)
+    return true;
+  if (nullptr == m_fp || false == WriteMode() || nullptr != m_memory_buffer)
+  {
+    ON_ERROR("EnableWriteBehind() requires an open file being written without a memory buffer.");
+    return false;
+  }
+  if (buffer_capacity <= 0 || buffer_count < 2)
+  {
+    ON_ERROR("Invalid buffer_capacity or buffer_count.");
+    return false;
+  }
+
+#if defined(OPENNURBS_NO_STD_THREAD) || defined(OPENNURBS_NO_STD_MUTEX)
+  // The file is written synchronously.
+  return false;
+#else
+  const ON__INT64 position = ON_FileStream::CurrentPosition(m_fp);
+  if (position < 0)
+  {
+    ON_ERROR("ON_FileStream::CurrentPosition(m_fp) failed.");
+    return false;
+  }
+
+  ON_BinaryFileWriteBehind* write_behind = new ON_BinaryFileWriteBehind(m_fp, (ON__UINT64)position, buffer_capacity, buffer_count);
+  if (false == write_behind->IsValid())
+  {
+    delete write_behind;
+    ON_ERROR("Unable to start the write-behind thread.");
+    return false;
+  }
+  m_write_behind = write_behind;
+  return true;
+#endif
+}
+
+bool ON_BinaryFile::WriteBehindIsEnabled() const
+{
+  return (nullptr != m_write_behind);
+}
+
+bool ON_BinaryFile::EndWriteBehind()
+{
+  return Internal_EndWriteBehind(true);
+}
+
+bool ON_BinaryFile::Internal_EndWriteBehind(
+  bool bFileIsOpen
+  )
+{
+  ON_BinaryFileWriteBehind* write_behind = m_write_behind;
+  if (nullptr == write_behind)
+    return true;
+  m_write_behind = nullptr;
+  bool rc = write_behind->Stop(bFileIsOpen);
+  delete write_behind;
+  if (false == bFileIsOpen)
+    return false;
+  if (rc && nullptr != m_fp && false == ON_FileStream::Sync(m_fp))
+    rc = false;
+  if (false == rc)
+  {
+    ON_ERROR("Write-behind failed to write the file.");
+  }
+  return rc;
+}
+
 
 size_t ON_BinaryArchive::Read( size_t count, void* p )
 {
@@ -16420,7 +17800,10 @@ size_t ON_BinaryArchive::Read( size_t count, void* p )
 
       if (count > 0)
       {
-        readcount = Internal_ReadOverride(count, p);
+        {
+          const ProfileTask profile_task(*this, ON_BinaryArchiveProfile::Task::StorageDevice);
+          readcount = Internal_ReadOverride(count, p);
+        }
 
         if (readcount == count)
         {
@@ -16490,7 +17873,10 @@ size_t ON_BinaryArchive::Write( size_t count, const void* p )
 
       if (count > 0)
       {
-        writecount = (size_t)Internal_WriteOverride(count, p);
+        {
+          const ProfileTask profile_task(*this, ON_BinaryArchiveProfile::Task::StorageDevice);
+          writecount = (size_t)Internal_WriteOverride(count, p);
+        }
 
         if (writecount == count)
         {
@@ -16598,7 +17984,11 @@ size_t ON_BinaryFile::Internal_WriteOverride( size_t count, const void* p )
   size_t rc = 0;
   if ( m_fp ) 
   {
-    if ( m_memory_buffer ) 
+    if ( m_write_behind )
+    {
+      rc = m_write_behind->Write( count, p );
+    }
+    else if ( m_memory_buffer ) 
     {
       if ( count+m_memory_buffer_ptr >= m_memory_buffer_capacity ) {
         if ( !Flush() ) // flush existing memory buffer to disk
@@ -16636,7 +18026,32 @@ bool ON_BinaryFile::Flush()
   bool rc = true;
   if ( m_fp ) 
   {
-    if ( m_memory_buffer && m_memory_buffer_size > 0 ) 
+    if ( m_write_behind )
+    {
+      // ON_BinaryArchive calls Flush() after every object. Waiting for the
+      // background thread is limited to calls outside of any chunk, which
+      // happen at the end of each table.
+      ON_3DM_BIG_CHUNK chunk;
+      if (0 == GetCurrentChunk(chunk))
+      {
+        if (ON_3dmArchiveTableType::end_mark == Active3dmTable())
+        {
+          // Write3dmEndMark() finished the archive. Later writes are synchronous
+          // and the caller can close the file stream.
+          rc = EndWriteBehind();
+        }
+        else
+        {
+          rc = m_write_behind->Wait();
+          if (rc && false == ON_FileStream::Sync(m_fp))
+          {
+            ON_ERROR("ON_FileStream::Sync(m_fp) failed.");
+            rc = false;
+          }
+        }
+      }
+    }
+    else if ( m_memory_buffer && m_memory_buffer_size > 0 ) 
     {
       // Put all of m_memory_buffer on "disk".
       rc = ( m_memory_buffer_size == fwrite( m_memory_buffer, 1, m_memory_buffer_size, m_fp ));   
@@ -16668,7 +18083,11 @@ ON__UINT64 ON_BinaryFile::Internal_CurrentPositionOverride() const
 {
   ON__UINT64 offset = 0;
 
-  if ( 0 != m_fp ) 
+  if ( 0 != m_fp && 0 != m_write_behind )
+  {
+    offset = m_write_behind->CurrentPosition();
+  }
+  else if ( 0 != m_fp ) 
   {
 
 #if defined(ON_COMPILER_MSC)
@@ -16748,7 +18167,15 @@ bool ON_BinaryFile::Internal_SeekFromCurrentPositionOverride( int offset )
   // it's own buffer for buffered I/O instead of relying on fwrite()
   // and the OS to handle this.
   bool rc = false;
-  if ( m_fp ) 
+  if ( m_fp && m_write_behind )
+  {
+    rc = m_write_behind->SeekFromCurrentPosition(offset);
+    if (false == rc)
+    {
+      ON_ERROR("Write-behind seek before the start of the file.");
+    }
+  }
+  else if ( m_fp ) 
   {
     if ( nullptr != m_memory_buffer
       && ((ON__INT_PTR)m_memory_buffer_ptr)+((ON__INT_PTR)offset) >= 0
@@ -16777,7 +18204,12 @@ bool ON_BinaryFile::Internal_SeekFromCurrentPositionOverride( int offset )
 bool ON_BinaryFile::Internal_SeekToStartOverride()
 {
   bool rc = false;
-  if ( m_fp ) 
+  if ( m_fp && m_write_behind )
+  {
+    m_write_behind->SeekFromStart(0);
+    rc = true;
+  }
+  else if ( m_fp ) 
   {
     Flush(); // don't deal with memory buffer I/O in rare seek from start
     if ( ON_FileStream::SeekFromStart(m_fp,0) )
@@ -18120,6 +19552,199 @@ const void* ON_Read3dmBufferArchive::Buffer() const
   return (const void*)m_buffer;
 }
 
+ON_Read3dmMappedFileArchive::ON_Read3dmMappedFileArchive(
+  const wchar_t* file_path
+)
+  : ON_BinaryArchive(ON::archive_mode::read3dm)
+{
+  Internal_MapFile(file_path);
+}
+
+ON_Read3dmMappedFileArchive::ON_Read3dmMappedFileArchive(
+  const char* file_path
+)
+  : ON_BinaryArchive(ON::archive_mode::read3dm)
+{
+  const ON_wString wide_file_path(file_path);
+  Internal_MapFile(wide_file_path);
+}
+
+ON_Read3dmMappedFileArchive::~ON_Read3dmMappedFileArchive()
+{
+  Internal_UnmapFile();
+}
+
+void ON_Read3dmMappedFileArchive::Internal_MapFile(const wchar_t* file_path)
+{
+  if (nullptr == file_path || 0 == file_path[0])
+    return;
+
+#if defined(ON_RUNTIME_WIN)
+  HANDLE file = ::CreateFileW(file_path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+  if (INVALID_HANDLE_VALUE == file)
+    return;
+  LARGE_INTEGER file_size;
+  file_size.QuadPart = 0;
+  if (::GetFileSizeEx(file, &file_size) && file_size.QuadPart > 0 && (ON__UINT64)file_size.QuadPart <= (ON__UINT64)((size_t)-1))
+  {
+    // The mapping keeps the file open.
+    HANDLE mapping = ::CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (nullptr != mapping)
+    {
+      const void* view = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+      if (nullptr != view)
+      {
+        m_mapping = mapping;
+        m_buffer = (const unsigned char*)view;
+        m_sizeof_buffer = (size_t)file_size.QuadPart;
+      }
+      else
+        ::CloseHandle(mapping);
+    }
+  }
+  ::CloseHandle(file);
+#else
+  const ON_String utf8_file_path(file_path);
+  const int fd = ::open(static_cast<const char*>(utf8_file_path), O_RDONLY);
+  if (fd < 0)
+    return;
+  struct stat file_status;
+  if (0 == ::fstat(fd, &file_status) && S_ISREG(file_status.st_mode) && file_status.st_size > 0 && (ON__UINT64)file_status.st_size <= (ON__UINT64)((size_t)-1))
+  {
+    // The mapping keeps the file open.
+    void* view = ::mmap(nullptr, (size_t)file_status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (MAP_FAILED != view)
+    {
+      // 3dm archives are mostly read front to back.
+      ::posix_madvise(view, (size_t)file_status.st_size, POSIX_MADV_SEQUENTIAL);
+      m_buffer = (const unsigned char*)view;
+      m_sizeof_buffer = (size_t)file_status.st_size;
+    }
+  }
+  ::close(fd);
+#endif
+}
+
+void ON_Read3dmMappedFileArchive::Internal_UnmapFile()
+{
+  if (nullptr != m_buffer)
+  {
+#if defined(ON_RUNTIME_WIN)
+    ::UnmapViewOfFile(m_buffer);
+    ::CloseHandle((HANDLE)m_mapping);
+#else
+    ::munmap((void*)m_buffer, m_sizeof_buffer);
+#endif
+  }
+  m_mapping = nullptr;
+  m_buffer = nullptr;
+  m_sizeof_buffer = 0;
+  m_buffer_position = 0;
+}
+
+bool ON_Read3dmMappedFileArchive::FileIsMapped() const
+{
+  return (nullptr != m_buffer);
+}
+
+const void* ON_Read3dmMappedFileArchive::ReadView(size_t sizeof_view)
+{
+  if (0 == sizeof_view || nullptr == m_buffer || m_buffer_position >= m_sizeof_buffer)
+    return nullptr;
+  if (sizeof_view > m_sizeof_buffer - m_buffer_position)
+    return nullptr;
+
+  // Read() checks chunk boundaries, updates CRCs and the position.
+  // Internal_ReadOverride() does not copy when the destination is the source.
+  const unsigned char* view = m_buffer + m_buffer_position;
+  return ReadByte(sizeof_view, (void*)view) ? view : nullptr;
+}
+
+// ON_BinaryArchive overrides
+ON__UINT64 ON_Read3dmMappedFileArchive::Internal_CurrentPositionOverride() const
+{
+  return (ON__UINT64)m_buffer_position;
+}
+
+bool ON_Read3dmMappedFileArchive::Internal_SeekFromCurrentPositionOverride( int offset )
+{
+  bool rc = false;
+  if ( m_buffer )
+  {
+    if (offset >= 0 )
+    {
+      m_buffer_position += offset;
+      rc = true;
+    }
+    else if ( size_t(-offset) <= m_buffer_position )
+    {
+      m_buffer_position -= (size_t(-offset));
+      rc = true;
+    }
+  }
+  return rc;
+}
+
+bool ON_Read3dmMappedFileArchive::Internal_SeekToStartOverride()
+{
+  bool rc = false;
+  if ( m_buffer ) 
+  {
+    m_buffer_position = 0;
+    rc = true;
+  }
+  return rc;
+}
+
+bool ON_Read3dmMappedFileArchive::AtEnd() const
+{
+  return (m_buffer_position >= m_sizeof_buffer) ? true : false;
+}
+
+size_t ON_Read3dmMappedFileArchive::Internal_ReadOverride( size_t count, void* buffer )
+{
+  if ( count <= 0 || 0 == buffer )
+    return 0;
+
+  size_t maxcount = ( m_sizeof_buffer > m_buffer_position ) 
+                  ? (m_sizeof_buffer - m_buffer_position)
+                  : 0;
+  if ( count > maxcount )
+    count = maxcount;
+
+  if ( count > 0 ) 
+  {
+    const unsigned char* source = m_buffer + m_buffer_position;
+    if (buffer != source) // ReadView() reads in place
+      memcpy( buffer, source, count );
+    m_buffer_position += count;
+  }
+
+  return count;
+}
+
+size_t ON_Read3dmMappedFileArchive::Internal_WriteOverride( size_t, const void* )
+{
+  // ON_Read3dmMappedFileArchive does not support Write() and Flush()
+  return 0;
+}
+
+bool ON_Read3dmMappedFileArchive::Flush()
+{
+  // ON_Read3dmMappedFileArchive does not support Write() and Flush()
+  return false;
+}
+
+size_t ON_Read3dmMappedFileArchive::SizeOfBuffer() const
+{
+  return m_sizeof_buffer;
+}
+
+const void* ON_Read3dmMappedFileArchive::Buffer() const
+{
+  return (const void*)m_buffer;
+}
+
 ON_Write3dmBufferArchive::ON_Write3dmBufferArchive( 
           size_t initial_sizeof_buffer, 
           size_t max_sizeof_buffer, 
@@ -1893,6 +1893,196 @@ public:
   ON_3dmArchiveTableStatus::TableState m_state = ON_3dmArchiveTableStatus::TableState::Unset;
 };
 
+class ON_CLASS ON_3dmArchiveTableOfContentsItem
+{
+public:
+  ON_3dmArchiveTableOfContentsItem() = default;
+  ~ON_3dmArchiveTableOfContentsItem() = default;
+  ON_3dmArchiveTableOfContentsItem(const ON_3dmArchiveTableOfContentsItem&) = default;
+  ON_3dmArchiveTableOfContentsItem& operator=(const ON_3dmArchiveTableOfContentsItem&) = default;
+
+  static const ON_3dmArchiveTableOfContentsItem Unset;
+
+  ON_UUID m_component_id = ON_nil_uuid;
+  ON_ModelComponent::Type m_component_type = ON_ModelComponent::Type::Unset;
+
+  // ON_NameHash::Create(name).MappedNameSha1Hash() of the component name.
+  // For model geometry, the name is ON_3dmObjectAttributes.m_name.
+  ON_SHA1_Hash m_name_hash = ON_SHA1_Hash::EmptyContentHash;
+
+  // For model geometry, the id of the layer. Otherwise nil.
+  ON_UUID m_layer_id = ON_nil_uuid;
+
+  // Offset from the start of the archive to the component's table
+  // record chunk and the size of the chunk in bytes, including the
+  // chunk typecode and length.
+  ON__UINT64 m_offset = 0;
+  ON__UINT64 m_length = 0;
+
+  // For model geometry, the bounding box of the geometry when the
+  // archive was written. Unset for other components and for tables
+  // of contents written before version 1.1.
+  ON_BoundingBox m_bbox = ON_BoundingBox::UnsetBoundingBox;
+};
+
+/*
+Description:
+  An ON_3dmArchiveTableOfContents locates the layer and object table
+  records of a 3dm archive so individual components can be read
+  without reading the tables that contain them.
+  ONX_Model::Write() saves a table of contents in a user table with
+  id ON_3dmArchiveTableOfContents::UserTableId. Applications that do
+  not know about the table of contents skip it like any other user table.
+See Also:
+  ON_BinaryArchive::Read3dmTableOfContents()
+  ON_BinaryArchive::Read3dmModelGeometryFromTableOfContents()
+*/
+class ON_CLASS ON_3dmArchiveTableOfContents
+{
+public:
+  ON_3dmArchiveTableOfContents() = default;
+  ~ON_3dmArchiveTableOfContents() = default;
+  ON_3dmArchiveTableOfContents(const ON_3dmArchiveTableOfContents&) = default;
+  ON_3dmArchiveTableOfContents& operator=(const ON_3dmArchiveTableOfContents&) = default;
+
+  // Plug-in id of the user table that contains the table of contents.
+  static const ON_UUID UserTableId;
+
+  void Clear();
+
+  void Append(
+    const ON_3dmArchiveTableOfContentsItem& item
+    );
+
+  unsigned int ItemCount() const;
+
+  /*
+  Returns:
+    The item or ON_3dmArchiveTableOfContentsItem::Unset if item_index is not valid.
+  */
+  const ON_3dmArchiveTableOfContentsItem& Item(
+    unsigned int item_index
+    ) const;
+
+  /*
+  Returns:
+    The item with the component id or ON_3dmArchiveTableOfContentsItem::Unset.
+  */
+  const ON_3dmArchiveTableOfContentsItem& ItemFromId(
+    ON_UUID component_id
+    ) const;
+
+  /*
+  Description:
+    Appends the items of a component type that have a name to items.
+    Names are compared ignoring case.
+  Returns:
+    Number of items appended.
+  */
+  unsigned int GetItemsFromName(
+    ON_ModelComponent::Type component_type,
+    const wchar_t* name,
+    ON_SimpleArray<const ON_3dmArchiveTableOfContentsItem*>& items
+    ) const;
+
+  /*
+  Description:
+    Appends the model geometry items on a layer to items.
+  Returns:
+    Number of items appended.
+  */
+  unsigned int GetItemsFromLayerId(
+    ON_UUID layer_id,
+    ON_SimpleArray<const ON_3dmArchiveTableOfContentsItem*>& items
+    ) const;
+
+  bool Write(
+    class ON_BinaryArchive& archive
+    ) const;
+
+  bool Read(
+    class ON_BinaryArchive& archive
+    );
+
+private:
+  ON_SimpleArray<ON_3dmArchiveTableOfContentsItem> m_items;
+  ON_UuidIndexList m_id_index;
+};
+
+/*
+Description:
+  Time an ON_BinaryArchive spends in each part of reading or writing.
+  See ON_BinaryArchive::SetProfile().
+*/
+class ON_CLASS ON_BinaryArchiveProfile
+{
+public:
+  ON_BinaryArchiveProfile() = default;
+  ~ON_BinaryArchiveProfile() = default;
+  ON_BinaryArchiveProfile(const ON_BinaryArchiveProfile&) = default;
+  ON_BinaryArchiveProfile& operator=(const ON_BinaryArchiveProfile&) = default;
+
+  enum class Task : unsigned int
+  {
+    // Reading and writing chunks, values and 3dm tables;
+    // everything that is not in one of the tasks below.
+    ChunkParsing = 0,
+
+    // Internal_ReadOverride() and Internal_WriteOverride().
+    StorageDevice = 1,
+
+    // Chunk and compressed buffer CRCs.
+    CRC = 2,
+
+    // Uncompressing buffers (zlib inflate, FastLZ and block deflate).
+    Inflate = 3,
+
+    // Compressing buffers.
+    Deflate = 4,
+
+    // ON_Object::Read() and ON_Object::Write(), including creating the object.
+    ObjectConstruction = 5
+  };
+
+  static const unsigned int TaskCount = 6;
+
+  /*
+  Returns:
+    Name of the task, like "chunk_parsing" or "crc".
+  */
+  static const char* TaskName(
+    ON_BinaryArchiveProfile::Task task
+    );
+
+  /*
+  Returns:
+    Seconds spent in the task. Tasks do not overlap; the time spent
+    in a task nested in another one, like computing the CRC of bytes
+    read by ON_Object::Read(), is only added to the nested task.
+  */
+  double Seconds(
+    ON_BinaryArchiveProfile::Task task
+    ) const;
+
+  /*
+  Returns:
+    Sum of the seconds spent in every task.
+  */
+  double TotalSeconds() const;
+
+  void AddSeconds(
+    ON_BinaryArchiveProfile::Task task,
+    double seconds
+    );
+
+  void Add(
+    const ON_BinaryArchiveProfile& profile
+    );
+
+private:
+  double m_seconds[ON_BinaryArchiveProfile::TaskCount] = {};
+};
+
 class ON_CLASS ON_BinaryArchive // use for generic serialization of binary data
 {
 public:
@@ -2887,6 +3077,137 @@ public:
   */
   bool UseBufferCompression() const;
 
+  /*
+  Description:
+    Compression effort used for buffers written by WriteCompressedBuffer().
+  */
+  enum class BufferCompressionLevel : unsigned char
+  {
+    ///<summary>
+    /// Buffers are stored uncompressed. Same as SetUseBufferCompression(false).
+    ///</summary>
+    None = 0,
+
+    ///<summary>
+    /// Fastest deflate (zlib level 1).
+    ///</summary>
+    Fast = 1,
+
+    ///<summary>
+    /// zlib default deflate level (6).
+    ///</summary>
+    Default = 2,
+
+    ///<summary>
+    /// Smallest deflate output (zlib level 9). This is the default and what earlier
+    /// versions of opennurbs always used.
+    ///</summary>
+    Best = 3
+  };
+
+  static ON_BinaryArchive::BufferCompressionLevel BufferCompressionLevelFromUnsigned(
+    unsigned int buffer_compression_level_as_unsigned
+    );
+
+  /*
+  Description:
+    Codec used for buffers written by WriteCompressedBuffer(). The codec is recorded
+    with each buffer, so ReadCompressedBuffer() reads buffers written with any codec.
+  */
+  enum class BufferCompressionCodec : unsigned char
+  {
+    ///<summary>
+    /// zlib deflate at the BufferCompressionLevel(). This is the default and
+    /// can be read by every opennurbs version.
+    ///</summary>
+    Deflate = 0,
+
+    ///<summary>
+    /// Byte oriented LZ77 codec. It compresses several times faster than deflate
+    /// at its fastest level and decompresses faster still, at the cost of larger output.
+    /// Buffers written with it can only be read by opennurbs versions that support it.
+    ///</summary>
+    FastLZ = 1,
+
+    ///<summary>
+    /// zlib deflate at the BufferCompressionLevel() in independent 256 KB blocks.
+    /// Blocks are compressed and decompressed in parallel, see SetBufferCompressionThreadCount(),
+    /// and the output is a fraction of a percent larger than Deflate.
+    /// Buffers written with it can only be read by opennurbs versions that support it.
+    ///</summary>
+    BlockDeflate = 2
+  };
+
+  static ON_BinaryArchive::BufferCompressionCodec BufferCompressionCodecFromUnsigned(
+    unsigned int buffer_compression_codec_as_unsigned
+    );
+
+  /*
+  Description:
+    Set the compression policy of buffers written by WriteCompressedBuffer(),
+    like mesh vertex, normal and texture coordinate arrays and bitmap pixels.
+    When writing large models, deflate at ON_BinaryArchive::BufferCompressionLevel::Best
+    can dominate the time to save; Fast or the FastLZ codec trade file size for speed.
+  Parameters:
+    level - [in]
+      ON_BinaryArchive::BufferCompressionLevel::None disables buffer compression.
+  Remarks:
+    The default is ON_BinaryArchive::BufferCompressionLevel::Best.
+  */
+  void SetBufferCompressionLevel(
+    ON_BinaryArchive::BufferCompressionLevel level
+  );
+
+  /*
+  Returns:
+    Compression level of buffers written by WriteCompressedBuffer().
+    ON_BinaryArchive::BufferCompressionLevel::None when UseBufferCompression() is false.
+  */
+  ON_BinaryArchive::BufferCompressionLevel GetBufferCompressionLevel() const;
+
+  /*
+  Description:
+    Set the codec of buffers written by WriteCompressedBuffer().
+  Parameters:
+    codec - [in]
+  Remarks:
+    The default is ON_BinaryArchive::BufferCompressionCodec::Deflate.
+    ON_BinaryArchive::BufferCompressionCodec::FastLZ and BlockDeflate are only used
+    when writing archives of version CurrentArchiveVersion(), because older applications
+    cannot read them; other archives use deflate.
+  */
+  void SetBufferCompressionCodec(
+    ON_BinaryArchive::BufferCompressionCodec codec
+  );
+
+  /*
+  Returns:
+    Codec of buffers written by WriteCompressedBuffer().
+  */
+  ON_BinaryArchive::BufferCompressionCodec GetBufferCompressionCodec() const;
+
+  /*
+  Description:
+    Set the maximum number of threads that compress or decompress the blocks
+    of a buffer written with ON_BinaryArchive::BufferCompressionCodec::BlockDeflate.
+  Parameters:
+    thread_count - [in]
+      0: use std::thread::hardware_concurrency() threads (default).
+      1: compress and decompress on the calling thread.
+      Values above 255 are treated as 255.
+  Remarks:
+    The thread count does not change the bytes written to the archive.
+  */
+  void SetBufferCompressionThreadCount(
+    unsigned int thread_count
+  );
+
+  /*
+  Returns:
+    Value set by SetBufferCompressionThreadCount().
+  */
+  unsigned int BufferCompressionThreadCount() const;
+
 
   /*
   Description:
@@ -3652,6 +3973,134 @@ public:
     unsigned int object_filter = 0
     );
 
+  /*
+  Description:
+    Reads the remaining records of the object table and appends them
+    to model_geometry_list in the order they appear in the archive.
+    Records of points, point clouds, curves, surfaces, breps, meshes,
+    SubDs, extrusions and cages are copied by a sequential scan and
+    then decoded by up to thread_count threads. All other records
+    are read by Read3dmModelGeometryForExperts().
+    Ids and manifest items are assigned in archive order, so the
+    result is identical to calling Read3dmModelGeometryForExperts()
+    until it returns 0.
+  Parameters:
+    bManageGeometry - [in]
+      true: model_geometry will reference count and delete the ON_Geometry pointer.
+      false: The caller must delete the ON_Geometry pointer.
+    bManageAttributes - [in]
+      true: model_geometry will reference count and delete the ON_3dmObjectAttributes pointer.
+      false: The caller must delete the ON_3dmObjectAttributes pointer.
+    object_filter - [in]
+      optional filter made by setting ON::object_type bits
+      0 = no filter.
+    thread_count - [in]
+      maximum number of threads used to decode records.
+      0 = std::thread::hardware_concurrency().
+    model_geometry_list - [out]
+      ON_ModelGeometryComponents are appended here. The caller
+      must delete them.
+  Returns:
+     0 at end of object table
+    -1 if file is corrupt. The components read before the
+       corrupt record are in model_geometry_list.
+  Remarks:
+    Version 1 archives, and all archives when OPENNURBS_NO_STD_THREAD
+    is defined, are read one record at a time.
+  */
+  int Read3dmModelGeometryListForExperts(
+    bool bManageGeometry,
+    bool bManageAttributes,
+    unsigned int object_filter,
+    unsigned int thread_count,
+    ON_SimpleArray<class ON_ModelGeometryComponent*>& model_geometry_list
+    );
+
+  /*
+  Description:
+    Expert user function used by ONX_Model to read the object table
+    without decoding points, point clouds, curves, surfaces, breps,
+    meshes, SubDs, extrusions and cages. The attributes of every
+    record are read. The objects listed above are skipped and located
+    by deferred_object so they can be read later with
+    Read3dmModelGeometryFromTableOfContents(). All other objects are
+    read as in Read3dmObject().
+  Parameters:
+    model_object - [out]
+      nullptr returned at end of the table and when the object is deferred.
+    attributes - [out]
+      Object attributes. When attributes is nullptr, no object is deferred.
+    object_filter - [in]
+      optional filter made by setting ON::object_type bits
+      0 = no filter.
+    deferred_object - [out]
+      If the object is deferred, the item's m_component_id is the id
+      saved in the archive, which can differ from attributes->m_uuid
+      when the archive has a missing or duplicate id, and m_offset and
+      m_length locate the object record. Otherwise deferred_object is
+      set to ON_3dmArchiveTableOfContentsItem::Unset.
+  Returns:
+     0 at end of object table
+     1 if object is read or deferred
+     2 if object is skipped because it does not match filter
+    -1 if file is corrupt
+  Remarks:
+    The CRC of a deferred record is checked when the object is read.
+  */
+  int Read3dmObjectOrDeferGeometry(
+    ON_Object** model_object,
+    ON_3dmObjectAttributes* attributes,
+    unsigned int object_filter,
+    ON_3dmArchiveTableOfContentsItem& deferred_object
+    );
+
+private:
+  /*
+  Description:
+    Reads a V2 or later TCODE_OBJECT_RECORD chunk.
+  Parameters:
+    bIncrementTableItemCount - [in]
+      false when the record is decoded from a copy that
+      was already counted by Read3dmModelGeometryListForExperts().
+    bDeferredObject - [out]
+      If not nullptr, objects that Read3dmObjectOrDeferGeometry()
+      defers are skipped and *bDeferredObject is set to true.
+  Returns:
+    Same as Read3dmObject().
+  */
+  int Internal_Read3dmObjectRecord(
+    ON_Object** ppObject,
+    ON_3dmObjectAttributes* pAttributes,
+    unsigned int object_filter,
+    bool bIncrementTableItemCount,
+    bool* bDeferredObject
+    );
+
+  /*
+  Description:
+    Assigns a unique id, converts obsolete objects and updates the
+    manifest after a record is read. When ppObject is nullptr,
+    the object was deferred and only the id and manifest are updated.
+  */
+  void Internal_Read3dmObjectFinish(
+    ON_Object** ppObject,
+    ON_3dmObjectAttributes* pAttributes
+    );
+
+  /*
+  Description:
+    Copies the archive version, manifest map and settings used by
+    object record readers from source_archive.
+  */
+  void Internal_CopyObjectRecordReadContext(
+    const ON_BinaryArchive& source_archive,
+    const class ON_ManifestMap& manifest_map
+    );
+
+  static void Internal_DecodeObjectRecords(
+    class ON_Internal_ObjectRecordBatch* batch
+    );
+
 private:
   /*
   Description:
@@ -3842,10 +4291,63 @@ public:
   // Returns:
   //   true if successful, false if unable to find or read
   //   a TCODE_ENDOFFILE chunk.
-  bool Read3dmEndMark( 
+  bool Read3dmEndMark(
            size_t* // sizeof_archive
            );
 
+  ///////////////////////////////////////////////////////////////////
+  // OPTIONAL - Random access reading with a table of contents
+  //
+
+  /*
+  Description:
+    Finds and reads the table of contents user table written by
+    ONX_Model::Write().
+  Parameters:
+    table_of_contents - [out]
+  Returns:
+    True if the archive contains a table of contents.
+  Remarks:
+    Call Read3dmStartSection() and Read3dmProperties() first.
+    The tables after the properties are skipped one chunk at a time,
+    so the number of seeks does not depend on the number of components
+    in the archive. The archive position is restored before returning.
+  */
+  bool Read3dmTableOfContents(
+    ON_3dmArchiveTableOfContents& table_of_contents
+    );
+
+  /*
+  Description:
+    Reads the model geometry record located by a table of contents item.
+  Parameters:
+    item - [in]
+      an item with m_component_type = ON_ModelComponent::Type::ModelGeometry
+      from Read3dmTableOfContents().
+    bManageGeometry - [in]
+      true: model_geometry will reference count and delete the ON_Geometry pointer.
+      false: The caller must delete the ON_Geometry pointer.
+    bManageAttributes - [in]
+      true: model_geometry will reference count and delete the ON_3dmObjectAttributes pointer.
+      false: The caller must delete the ON_3dmObjectAttributes pointer.
+    model_geometry - [out]
+      ON_ModelGeometryComponent returned here. The caller must delete it.
+  Returns:
+    True if the record was read and has the item's id. False if the
+    item is not model geometry, the archive is damaged, or the table of
+    contents does not match the archive.
+  Remarks:
+    Referenced component indices are not mapped, so attributes like
+    m_layer_index are archive indices. Use item.m_layer_id to identify
+    the layer. The archive position is restored before returning.
+  */
+  bool Read3dmModelGeometryFromTableOfContents(
+    const ON_3dmArchiveTableOfContentsItem& item,
+    bool bManageGeometry,
+    bool bManageAttributes,
+    class ON_ModelGeometryComponent** model_geometry
+    );
+
   ///////////////////////////////////////////////////////////////////
   ///////////////////////////////////////////////////////////////////
   // Low level tools to  Write/Read chunks. See opennurbs_3dm.h for details
@@ -4695,6 +5197,56 @@ public:
     ON_3dmArchiveTableType table_type
     );
 
+  /*
+  Description:
+    Measure the time spent in each part of reading or writing.
+  Parameters:
+    profile - [in]
+      The times are added to profile. Pass nullptr to stop measuring;
+      the time since the last task change is then added to the
+      previous profile.
+  Remarks:
+    Measuring reads the clock around every CRC calculation and
+    storage device access, which makes reading and writing slower.
+    When object records are read on several threads, the times of
+    all threads are added.
+  */
+  void SetProfile(
+    ON_BinaryArchiveProfile* profile
+    );
+
+  ON_BinaryArchiveProfile* Profile() const;
+
+private:
+  // Changes the task m_profile adds time to and returns the previous task.
+  unsigned int Internal_ProfileSwitchTask(unsigned int task);
+
+  // Adds the time between construction and destruction to a task of m_profile.
+  class ProfileTask
+  {
+  public:
+    ProfileTask(ON_BinaryArchive& archive, ON_BinaryArchiveProfile::Task task)
+      : m_archive((nullptr != archive.m_profile) ? &archive : nullptr)
+      , m_previous_task((nullptr != archive.m_profile) ? archive.Internal_ProfileSwitchTask((unsigned int)task) : 0)
+    {}
+    ~ProfileTask()
+    {
+      if (nullptr != m_archive && nullptr != m_archive->m_profile)
+        m_archive->Internal_ProfileSwitchTask(m_previous_task);
+    }
+  private:
+    ON_BinaryArchive* m_archive;
+    unsigned int m_previous_task;
+  private:
+    ProfileTask() = delete;
+    ProfileTask(const ProfileTask&) = delete;
+    ProfileTask& operator=(const ProfileTask&) = delete;
+  };
+
+  ON_BinaryArchiveProfile* m_profile = nullptr;
+  unsigned int m_profile_task = 0;
+  double m_profile_time = 0.0;
+
 private:
 
   ON_3dmArchiveTableType TableTypeFromTypecode( unsigned int ); // table type from tcode
@@ -4768,6 +5320,24 @@ private:
         size_t,  // sizeof uncompressed input data
         void* // buffer to hold uncompressed data
         );
+  // returns number of bytes written
+  size_t WriteFastLZ(
+        size_t,         // sizeof uncompressed input data
+        const void*  // uncompressed input data
+        );
+  bool ReadFastLZ(
+        size_t,  // sizeof uncompressed input data
+        void* // buffer to hold uncompressed data
+        );
+  // returns number of bytes written
+  size_t WriteBlockDeflate(
+        size_t,         // sizeof uncompressed input data
+        const void*  // uncompressed input data
+        );
+  bool ReadBlockDeflate(
+        size_t,  // sizeof uncompressed input data
+        void* // buffer to hold uncompressed data
+        );
   bool CompressionInit();
   void CompressionEnd();
 
@@ -4807,9 +5377,11 @@ private:
 
   bool m_bUseBufferCompression = true;
 
-  bool m_bReservedA = false;
-  bool m_bReservedB = false;
-  bool m_bReservedC = false;
+  // deflate level when m_bUseBufferCompression is true
+  ON_BinaryArchive::BufferCompressionLevel m_buffer_compression_level = ON_BinaryArchive::BufferCompressionLevel::Best;
+  ON_BinaryArchive::BufferCompressionCodec m_buffer_compression_codec = ON_BinaryArchive::BufferCompressionCodec::Deflate;
+  // maximum number of BlockDeflate threads, 0 = std::thread::hardware_concurrency()
+  unsigned char m_buffer_compression_thread_count = 0;
   bool m_bReservedD = false;
   bool m_bReservedE = false;
   bool m_bReservedF = false;
@@ -5377,6 +5949,64 @@ public:
          int=16384 // capacity of memory buffer
          );
 
+  /*
+  Description:
+    Write the file on a background thread. Filled buffers are handed
+    to the background thread so serializing and compressing the next
+    objects overlaps with writing the previous ones to disk.
+  Parameters:
+    buffer_capacity - [in]
+      number of bytes in each buffer.
+    buffer_count - [in]
+      number of buffers (>= 2). When every buffer is waiting to be
+      written, Write() waits for the background thread.
+  Returns:
+    True if write-behind is enabled.
+  Remarks:
+    Call EnableWriteBehind() immediately after constructing an
+    ON_BinaryFile for writing, before anything is written.
+    It cannot be combined with EnableMemoryBuffer().
+
+    Flush() waits until the background thread has written every
+    byte and synchronizes the file with ON_FileStream::Sync() when
+    it is called outside of any chunk. ON_BinaryArchive does this
+    at the end of every 3dm table. The flush at the end of
+    Write3dmEndMark() ends write-behind, like EndWriteBehind().
+
+    When the file stream is owned by the caller, write-behind must end
+    before the stream is closed: write the end mark or call
+    EndWriteBehind() before ON::CloseFile(fp). ~ON_BinaryFile() never
+    uses a file stream it does not own; bytes still queued are lost.
+    Bytes written to positions before the current buffer, like the
+    chunk lengths written by EndWrite3dmChunk(), are queued without
+    waiting for the background thread.
+
+    When OPENNURBS_NO_STD_THREAD or OPENNURBS_NO_STD_MUTEX is defined,
+    EnableWriteBehind() returns false and the file is written
+    synchronously.
+  */
+  bool EnableWriteBehind(
+    size_t buffer_capacity = 4*1024*1024,
+    unsigned int buffer_count = 2
+    );
+
+  /*
+  Returns:
+    True if EnableWriteBehind() was successfully called and the
+    file has not been closed.
+  */
+  bool WriteBehindIsEnabled() const;
+
+  /*
+  Description:
+    Waits until the background thread has written every byte,
+    stops it and synchronizes the file with ON_FileStream::Sync().
+    Subsequent writes are synchronous.
+  Returns:
+    True if every byte was written and synchronized.
+  */
+  bool EndWriteBehind();
+
   /*
   Returns:
     True if a file stream is open (nullptr != m_fp).
@@ -5390,6 +6020,15 @@ private:
   FILE* m_fp = nullptr;
   bool m_bCloseFileInDestructor = false;
 
+  // When m_write_behind is not nullptr, Write() hands buffers
+  // to a background thread that writes them to m_fp.
+  class ON_BinaryFileWriteBehind* m_write_behind = nullptr;
+
+  // bFileIsOpen is false when m_fp may have been closed by the caller.
+  bool Internal_EndWriteBehind(
+    bool bFileIsOpen
+    );
+
   // if m_memory_buffer_capacity is zero, then Write() uses
   // fwrite() directly.  If m_memory_buffer_capacity is
   // greater than zero, then Write() buffers its results
@@ -5549,6 +6188,115 @@ private:
   ON_Read3dmBufferArchive& operator=(const ON_Read3dmBufferArchive&);
 };
 
+/*
+Description:
+  ON_Read3dmMappedFileArchive reads a 3dm archive from a file that is mapped into
+  memory. Reading copies bytes straight from the mapped pages into the destination,
+  without fread() calls or a second copy in a FILE buffer, and ReadView() returns
+  pointers into the mapping without any copy. Large models open with fewer system
+  calls and the file is only cached once by the operating system.
+Example:
+
+          ON_Read3dmMappedFileArchive archive(L"C:/models/big.3dm");
+          ONX_Model model;
+          if ( archive.FileIsMapped() )
+            model.Read(archive);
+
+Remarks:
+  The whole file is mapped, so on 32 bit platforms files must fit in the address space.
+  The file should not be modified while it is mapped.
+*/
+class ON_CLASS ON_Read3dmMappedFileArchive : public ON_BinaryArchive
+{
+public:
+  /*
+  Parameters:
+    file_path - [in]
+      Path of the 3dm file. Use FileIsMapped() to check that the file was mapped.
+  */
+  ON_Read3dmMappedFileArchive(
+    const wchar_t* file_path
+    );
+
+  ON_Read3dmMappedFileArchive(
+    const char* file_path
+    );
+
+  ~ON_Read3dmMappedFileArchive();
+
+  /*
+  Returns:
+    True if the file was opened and mapped.
+  */
+  bool FileIsMapped() const;
+
+  /*
+  Returns:
+    Size of the file in bytes.
+  */
+  size_t SizeOfBuffer() const;
+
+  /*
+  Returns:
+    Start of the mapped file.
+  */
+  const void* Buffer() const;
+
+  /*
+  Description:
+    Zero copy version of ReadByte(). Chunk boundaries, CRC calculations and the
+    current position are handled exactly as if ReadByte(sizeof_view,...) was called.
+  Parameters:
+    sizeof_view - [in]
+      Number of bytes to read.
+  Returns:
+    A pointer to the sizeof_view bytes in the mapping, or nullptr if they could not be read.
+    The pointer is valid until this archive is destroyed.
+  Remarks:
+    The bytes are in the archive's byte order (little endian) and the pointer has no
+    particular alignment. Typically, arrays of uncompressed doubles, like ON_3dPoint
+    lists, are copied from the view with memcpy() when ON::Endian() is little_endian
+    and read with ReadDouble() otherwise.
+  */
+  const void* ReadView(
+    size_t sizeof_view
+    );
+
+protected:
+  // ON_BinaryArchive overrides
+  ON__UINT64 Internal_CurrentPositionOverride() const override;
+  bool Internal_SeekFromCurrentPositionOverride(int byte_offset) override;
+  bool Internal_SeekToStartOverride() override;
+
+public:
+  // ON_BinaryArchive overrides
+  bool AtEnd() const override;
+
+protected:
+  // ON_BinaryArchive overrides
+  size_t Internal_ReadOverride( size_t, void* ) override; // return actual number of bytes read (like fread())
+  size_t Internal_WriteOverride( size_t, const void* ) override;
+  bool Flush() override;
+
+private:
+  void Internal_MapFile(const wchar_t* file_path);
+  void Internal_UnmapFile();
+
+  // Windows: file mapping handle
+  void* m_mapping = nullptr;
+  const unsigned char* m_buffer = nullptr;
+  size_t m_sizeof_buffer = 0;
+  size_t m_buffer_position = 0;
+  ON__INT_PTR m_reserved1 = 0;
+  ON__INT_PTR m_reserved2 = 0;
+
+private:
+  // prohibit use - no implementation
+  ON_Read3dmMappedFileArchive(); 
+  ON_Read3dmMappedFileArchive( const ON_Read3dmMappedFileArchive& );
+  ON_Read3dmMappedFileArchive& operator=(const ON_Read3dmMappedFileArchive&);
+};
+
 class ON_CLASS ON_Write3dmBufferArchive : public ON_BinaryArchive
 {
 public:
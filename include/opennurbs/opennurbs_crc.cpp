@@ -24,6 +24,20 @@
 #error ON_COMPILING_OPENNURBS must be defined when compiling opennurbs
 #endif
 
+#if defined(ON_64BIT_RUNTIME) && (defined(__x86_64__) || defined(_M_X64)) && (defined(ON_COMPILER_MSC) || defined(ON_COMPILER_GNU) || defined(ON_COMPILER_CLANG))
+// PCLMULQDQ carry-less multiplication is used to fold 64 bytes at a time
+// when the cpu supports it. Support is tested at runtime.
+#define ON_CRC32_PCLMUL
+#if defined(ON_COMPILER_MSC)
+#include <intrin.h>
+#define ON_CRC32_PCLMUL_TARGET
+#else
+#include <cpuid.h>
+#include <wmmintrin.h>
+#define ON_CRC32_PCLMUL_TARGET __attribute__((target("pclmul,sse2")))
+#endif
+#endif
+
 ON__UINT16 ON_CRC16( ON__UINT16 current_remainder, size_t count, const void* p )
 {
   // 16 bit cyclic redundancy check using CCITT generator polynomial
@@ -115,6 +129,194 @@ ON__UINT16 ON_CRC16( ON__UINT16 current_remainder, size_t count, const void* p )
   return current_remainder;
 }
 
+/*
+Description:
+  Tables for the slice-by-16 CRC32. m_table[0] is the byte-wise zlib table
+  and m_table[k][n] is the remainder of byte n followed by k zero bytes.
+*/
+class ON_Internal_CRC32SliceTables
+{
+public:
+  ON_Internal_CRC32SliceTables(
+    const ON__UINT32* zlib_table
+    )
+  {
+    for (unsigned int n = 0; n < 256; n++)
+      m_table[0][n] = zlib_table[n];
+    for (unsigned int k = 1; k < 16; k++)
+    {
+      for (unsigned int n = 0; n < 256; n++)
+      {
+        const ON__UINT32 r = m_table[k - 1][n];
+        m_table[k][n] = (r >> 8) ^ m_table[0][r & 0xff];
+      }
+    }
+  }
+
+  ON__UINT32 m_table[16][256];
+
+private:
+  ON_Internal_CRC32SliceTables() = delete;
+};
+
+/*
+Description:
+  Slice-by-16 and slice-by-8 CRC32. Bytes are loaded one at a time so the
+  result does not depend on the cpu byte order.
+Parameters:
+  r - [in]
+    current remainder after the initial ^0xffffffff
+  count - [in/out]
+    Number of bytes. Returns the number of bytes that were not processed (< 8).
+  b - [in/out]
+    Returns a pointer to the bytes that were not processed.
+*/
+static ON__UINT32 Internal_CRC32Slice(
+  const ON_Internal_CRC32SliceTables& tables,
+  ON__UINT32 r,
+  size_t& count,
+  const unsigned char*& b
+  )
+{
+  const ON__UINT32 (*t)[256] = tables.m_table;
+  while (count >= 16)
+  {
+    r ^= ((ON__UINT32)b[0]) | (((ON__UINT32)b[1]) << 8) | (((ON__UINT32)b[2]) << 16) | (((ON__UINT32)b[3]) << 24);
+    r = t[15][r & 0xff] ^ t[14][(r >> 8) & 0xff] ^ t[13][(r >> 16) & 0xff] ^ t[12][r >> 24]
+      ^ t[11][b[4]] ^ t[10][b[5]] ^ t[9][b[6]] ^ t[8][b[7]]
+      ^ t[7][b[8]] ^ t[6][b[9]] ^ t[5][b[10]] ^ t[4][b[11]]
+      ^ t[3][b[12]] ^ t[2][b[13]] ^ t[1][b[14]] ^ t[0][b[15]];
+    b += 16;
+    count -= 16;
+  }
+  if (count >= 8)
+  {
+    r ^= ((ON__UINT32)b[0]) | (((ON__UINT32)b[1]) << 8) | (((ON__UINT32)b[2]) << 16) | (((ON__UINT32)b[3]) << 24);
+    r = t[7][r & 0xff] ^ t[6][(r >> 8) & 0xff] ^ t[5][(r >> 16) & 0xff] ^ t[4][r >> 24]
+      ^ t[3][b[4]] ^ t[2][b[5]] ^ t[1][b[6]] ^ t[0][b[7]];
+    b += 8;
+    count -= 8;
+  }
+  return r;
+}
+
+#if defined(ON_CRC32_PCLMUL)
+
+static bool Internal_CPUHasPCLMUL()
+{
+  // CPUID leaf 1, ECX bit 1 = PCLMULQDQ
+#if defined(ON_COMPILER_MSC)
+  int cpu_info[4] = { 0, 0, 0, 0 };
+  __cpuid(cpu_info, 1);
+  return 0 != (cpu_info[2] & 0x2);
+#else
+  unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+  if (0 == __get_cpuid(1, &eax, &ebx, &ecx, &edx))
+    return false;
+  return 0 != (ecx & 0x2);
+#endif
+}
+
+/*
+Description:
+  CRC32 of a buffer using PCLMULQDQ folding as described in Intel's
+  "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ Instruction".
+  The constants are for the bit reflected zlib polynomial 0x04C11DB7.
+Parameters:
+  r - [in]
+    current remainder after the initial ^0xffffffff
+  count - [in]
+    A multiple of 16 and at least 64.
+*/
+ON_CRC32_PCLMUL_TARGET
+static ON__UINT32 Internal_CRC32PCLMUL(
+  ON__UINT32 r,
+  size_t count,
+  const unsigned char* b
+  )
+{
+  // x^(4*128+32) mod P, x^(4*128-32) mod P
+  const __m128i k1k2 = _mm_set_epi64x(0x01c6e41596LL, 0x0154442bd4LL);
+  // x^(128+32) mod P, x^(128-32) mod P
+  const __m128i k3k4 = _mm_set_epi64x(0x00ccaa009eLL, 0x01751997d0LL);
+  // x^64 mod P
+  const __m128i k5k0 = _mm_set_epi64x(0x0000000000LL, 0x0163cd6124LL);
+  // Barrett reduction constants P' and mu
+  const __m128i poly = _mm_set_epi64x(0x01f7011641LL, 0x01db710641LL);
+  const __m128i mask32 = _mm_setr_epi32(~0, 0, ~0, 0);
+
+  __m128i x0, x1, x2, x3, x4, x5, x6, x7, x8;
+
+  x1 = _mm_loadu_si128((const __m128i*)(b + 0x00));
+  x2 = _mm_loadu_si128((const __m128i*)(b + 0x10));
+  x3 = _mm_loadu_si128((const __m128i*)(b + 0x20));
+  x4 = _mm_loadu_si128((const __m128i*)(b + 0x30));
+  x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128((int)r));
+  b += 64;
+  count -= 64;
+
+  // fold 64 bytes at a time
+  x0 = k1k2;
+  while (count >= 64)
+  {
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x6 = _mm_clmulepi64_si128(x2, x0, 0x00);
+    x7 = _mm_clmulepi64_si128(x3, x0, 0x00);
+    x8 = _mm_clmulepi64_si128(x4, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x2 = _mm_clmulepi64_si128(x2, x0, 0x11);
+    x3 = _mm_clmulepi64_si128(x3, x0, 0x11);
+    x4 = _mm_clmulepi64_si128(x4, x0, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), _mm_loadu_si128((const __m128i*)(b + 0x00)));
+    x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), _mm_loadu_si128((const __m128i*)(b + 0x10)));
+    x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), _mm_loadu_si128((const __m128i*)(b + 0x20)));
+    x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), _mm_loadu_si128((const __m128i*)(b + 0x30)));
+    b += 64;
+    count -= 64;
+  }
+
+  // fold the 4 lanes into 128 bits
+  x0 = k3k4;
+  x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+  x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+  x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+  x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+  x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+  x1 = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+  x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+  x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+  x1 = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+
+  // fold 16 bytes at a time
+  while (count >= 16)
+  {
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, _mm_loadu_si128((const __m128i*)b)), x5);
+    b += 16;
+    count -= 16;
+  }
+
+  // fold 128 bits to 64 bits
+  x2 = _mm_clmulepi64_si128(x1, x0, 0x10);
+  x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+  x2 = _mm_srli_si128(x1, 4);
+  x1 = _mm_and_si128(x1, mask32);
+  x1 = _mm_clmulepi64_si128(x1, k5k0, 0x00);
+  x1 = _mm_xor_si128(x1, x2);
+
+  // Barrett reduction to 32 bits
+  x2 = _mm_and_si128(x1, mask32);
+  x2 = _mm_clmulepi64_si128(x2, poly, 0x10);
+  x2 = _mm_and_si128(x2, mask32);
+  x2 = _mm_clmulepi64_si128(x2, poly, 0x00);
+  x1 = _mm_xor_si128(x1, x2);
+
+  return (ON__UINT32)_mm_cvtsi128_si32(_mm_srli_si128(x1, 4));
+}
+
+#endif
+
 ON__UINT32 ON_CRC32( ON__UINT32 current_remainder, size_t count, const void* p )
 {
   /*
@@ -251,6 +453,26 @@ ON__UINT32 ON_CRC32( ON__UINT32 current_remainder, size_t count, const void* p )
     ////    }
     ////#endif
 
+#if defined(ON_CRC32_PCLMUL)
+    if (count >= 64)
+    {
+      static const bool bHasPCLMUL = Internal_CPUHasPCLMUL();
+      if (bHasPCLMUL)
+      {
+        const size_t pclmul_count = count & ~((size_t)15);
+        current_remainder = Internal_CRC32PCLMUL(current_remainder, pclmul_count, b);
+        b += pclmul_count;
+        count -= pclmul_count;
+      }
+    }
+#endif
+
+    if (count >= 8)
+    {
+      static const ON_Internal_CRC32SliceTables slice_tables(ON_CRC32_ZLIB_TABLE);
+      current_remainder = Internal_CRC32Slice(slice_tables, current_remainder, count, b);
+    }
+
     while(count--) 
     {
       current_remainder = ON_CRC32_ZLIB_TABLE[((int)current_remainder ^ (*b++)) & 0xff] ^ (current_remainder >> 8);
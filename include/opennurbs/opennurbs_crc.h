@@ -85,6 +85,12 @@ Parameters:
   sizeof_buffer - [in]  number of bytes in buffer
   buffer - [in] 
 
+Remarks:
+  Buffers are processed 16 bytes at a time with slice-by-16 tables.
+  On x64 cpus that support PCLMULQDQ, buffers of 64 or more bytes are
+  folded with carry-less multiplication. Every method computes the 
+  same values as the byte-at-a-time zlib table.
+
 Example:
   32 bit CRC calculations are typically done something like this:
 
@@ -299,6 +299,143 @@ public:
   ONX_ModelComponentReferenceLink* m_prev = nullptr;
 };
 
+/*
+Description:
+  The mapped file and placeholders of an ONX_Model read with lazy
+  geometry loading. Loaded geometry is kept in a least recently used
+  list so ONX_Model can unload it when the memory budget is exceeded.
+*/
+class ONX_ModelLazyGeometry
+{
+public:
+  ONX_ModelLazyGeometry(
+    ON_Read3dmMappedFileArchive* file
+    );
+  ~ONX_ModelLazyGeometry();
+
+private:
+  ONX_ModelLazyGeometry() = delete;
+  ONX_ModelLazyGeometry(const ONX_ModelLazyGeometry&) = delete;
+  ONX_ModelLazyGeometry& operator=(const ONX_ModelLazyGeometry&) = delete;
+
+public:
+  class Placeholder
+  {
+  public:
+    // ON_ModelGeometryComponent.RuntimeSerialNumber()
+    ON__UINT64 m_component_sn = 0;
+
+    // Archive id, offset and length of the object record and the
+    // geometry bounding box when it is known.
+    ON_3dmArchiveTableOfContentsItem m_record;
+
+    size_t m_sizeof_geometry = 0;
+    bool m_bLoaded = false;
+    bool m_bReadFailed = false;
+
+    // Least recently used list of loaded geometry.
+    int m_lru_prev = -1; // more recently used
+    int m_lru_next = -1; // less recently used
+  };
+
+  void AddPlaceholder(
+    ON__UINT64 component_sn,
+    const ON_3dmArchiveTableOfContentsItem& record
+    );
+
+  /*
+  Returns:
+    Index of the placeholder in m_placeholders or -1.
+  */
+  int PlaceholderIndex(
+    ON__UINT64 component_sn
+    ) const;
+
+  void LruRemove(
+    int placeholder_index
+    );
+
+  void LruPushFront(
+    int placeholder_index
+    );
+
+  ON_Read3dmMappedFileArchive* m_file = nullptr;
+  ON_SimpleArray<Placeholder> m_placeholders;
+  // component runtime serial number -> m_placeholders[] index
+  ON_SerialNumberMap m_placeholder_sn_map;
+  int m_lru_first = -1; // most recently used
+  int m_lru_last = -1;  // least recently used
+  size_t m_sizeof_loaded_geometry = 0;
+};
+
+ONX_ModelLazyGeometry::ONX_ModelLazyGeometry(
+  ON_Read3dmMappedFileArchive* file
+  )
+  : m_file(file)
+{}
+
+ONX_ModelLazyGeometry::~ONX_ModelLazyGeometry()
+{
+  if (nullptr != m_file)
+  {
+    delete m_file;
+    m_file = nullptr;
+  }
+}
+
+void ONX_ModelLazyGeometry::AddPlaceholder(
+  ON__UINT64 component_sn,
+  const ON_3dmArchiveTableOfContentsItem& record
+  )
+{
+  struct ON_SerialNumberMap::SN_ELEMENT* e = m_placeholder_sn_map.AddSerialNumber(component_sn);
+  if (nullptr == e)
+    return;
+  e->m_value.m_u.i64 = m_placeholders.Count();
+  Placeholder& placeholder = m_placeholders.AppendNew();
+  placeholder.m_component_sn = component_sn;
+  placeholder.m_record = record;
+}
+
+int ONX_ModelLazyGeometry::PlaceholderIndex(
+  ON__UINT64 component_sn
+  ) const
+{
+  const struct ON_SerialNumberMap::SN_ELEMENT* e = m_placeholder_sn_map.FindSerialNumber(component_sn);
+  return (nullptr != e) ? ((int)e->m_value.m_u.i64) : -1;
+}
+
+void ONX_ModelLazyGeometry::LruRemove(
+  int placeholder_index
+  )
+{
+  Placeholder& placeholder = m_placeholders[placeholder_index];
+  if (placeholder.m_lru_prev >= 0)
+    m_placeholders[placeholder.m_lru_prev].m_lru_next = placeholder.m_lru_next;
+  else if (m_lru_first == placeholder_index)
+    m_lru_first = placeholder.m_lru_next;
+  if (placeholder.m_lru_next >= 0)
+    m_placeholders[placeholder.m_lru_next].m_lru_prev = placeholder.m_lru_prev;
+  else if (m_lru_last == placeholder_index)
+    m_lru_last = placeholder.m_lru_prev;
+  placeholder.m_lru_prev = -1;
+  placeholder.m_lru_next = -1;
+}
+
+void ONX_ModelLazyGeometry::LruPushFront(
+  int placeholder_index
+  )
+{
+  Placeholder& placeholder = m_placeholders[placeholder_index];
+  placeholder.m_lru_prev = -1;
+  placeholder.m_lru_next = m_lru_first;
+  if (m_lru_first >= 0)
+    m_placeholders[m_lru_first].m_lru_prev = placeholder_index;
+  m_lru_first = placeholder_index;
+  if (m_lru_last < 0)
+    m_lru_last = placeholder_index;
+}
+
 ONX_Model::ONX_Model()
 {
   for (unsigned int i = 0; i < ONX_MCR_LIST_COUNT; i++)
@@ -321,6 +458,12 @@ ONX_Model::~ONX_Model()
 
 void ONX_Model::Reset()
 {
+  if (nullptr != m_lazy_geometry)
+  {
+    delete m_lazy_geometry;
+    m_lazy_geometry = nullptr;
+  }
+
   m_3dm_file_version = 0;
   m_3dm_opennurbs_version = 0;
   m_sStartSectionComments = ON_String::EmptyString;
@@ -397,7 +540,11 @@ void ONX_Model::Internal_ComponentTypeBoundingBox(
 
       const ON_Geometry* geometry = model_geometry->Geometry(nullptr);
       if (nullptr == geometry)
+      {
+        // placeholders use the bounding box saved in the archive
+        local_bbox.Union(Internal_LazyGeometryBoundingBox(model_geometry));
         continue;
+      }
 
       local_bbox.Union(geometry->BoundingBox());
     }
@@ -603,9 +750,21 @@ const ON_ModelGeometryComponent& ONX_Model::ModelGeometryComponentFromId(
 ) const
 {
   const ON_ModelGeometryComponent* p = ON_ModelGeometryComponent::Cast(ModelGeometryFromId(model_object_id).ModelComponent());
+  Internal_LoadLazyGeometry(p);
   return (nullptr != p) ? *p : ON_ModelGeometryComponent::Unset;
 }
 
+ON_BoundingBox ONX_Model::ModelGeometryComponentBoundingBox(
+  ON_UUID model_object_id
+) const
+{
+  const ON_ModelGeometryComponent* p = ON_ModelGeometryComponent::Cast(ModelGeometryFromId(model_object_id).ModelComponent());
+  if (nullptr == p)
+    return ON_BoundingBox::UnsetBoundingBox;
+  const ON_Geometry* geometry = p->Geometry(nullptr);
+  return (nullptr != geometry) ? geometry->BoundingBox() : Internal_LazyGeometryBoundingBox(p);
+}
+
 ON_ModelComponentReference ONX_Model::ComponentFromName(
   ON_ModelComponent::Type component_type,
   ON_UUID component_parent_id,
@@ -1975,6 +2134,7 @@ void ONX_Model::DumpComponentList(
   {
     text_log.Print(L"%ls %d:\n",type_name,i);
     const ON_ModelComponent* model_component = link->m_mcr.ModelComponent();
+    Internal_LoadLazyGeometry(model_component);
   text_log.PushIndent();
     if ( nullptr == model_component )
       text_log.Print(L"nullptr\n");
@@ -2091,18 +2251,11 @@ bool ONX_Model::Read(
        ON_TextLog* error_log
        )
 {
-  bool rc = false;
-  if ( nullptr != filename )
-  {
-    FILE* fp = ON::OpenFile(filename,"rb");
-    if ( 0 != fp )
-    {
-      ON_BinaryFile file(ON::archive_mode::read3dm,fp);
-      rc = Read(file,error_log);
-      ON::CloseFile(fp);
-    }
-  }
-  return rc;
+  if (nullptr == filename)
+    return false;
+  const ON_wString wfilename_buffer(filename);
+  const wchar_t* wfilename = static_cast< const wchar_t* >(wfilename_buffer);
+  return Read(wfilename,error_log);
 }
 
 bool ONX_Model::Read( 
@@ -2110,18 +2263,10 @@ bool ONX_Model::Read(
        ON_TextLog* error_log
        )
 {
-  bool rc = false;
-  if ( nullptr != filename )
-  {
-    FILE* fp = ON::OpenFile(filename,L"rb");
-    if ( 0 != fp )
-    {
-      ON_BinaryFile file(ON::archive_mode::read3dm,fp);
-      rc = Read(file,error_log);
-      ON::CloseFile(fp);
-    }
-  }
-  return rc;
+  unsigned int table_filter = 0; // read every table
+  unsigned int model_object_type_filter = 0; // read every type of object
+  // A file that cannot be opened leaves the model unchanged.
+  return (nullptr != filename) ? Internal_ReadFile(filename,table_filter,model_object_type_filter,false,error_log) : false;
 }
 
 bool ONX_Model::IncrementalReadBegin( 
@@ -2626,17 +2771,10 @@ bool ONX_Model::IncrementalReadBegin(
   return (0 == archive.CriticalErrorCount());
 }
 
-bool ONX_Model::IncrementalReadModelGeometry(
-  ON_BinaryArchive& archive,
-  bool bManageModelGeometryComponent,
-  bool bManageGeometry,
-  bool bManageAttributes,
-  unsigned int object_filter,
-  ON_ModelComponentReference& model_component_reference
-  )
+bool ONX_Model::Internal_IncrementalReadBeginModelGeometry(
+  ON_BinaryArchive& archive
+  ) const
 {
-  model_component_reference = ON_ModelComponentReference::Empty;
-
   ON_3dmArchiveTableType active_table = archive.Active3dmTable();
   if (ON_3dmArchiveTableType::Unset == active_table)
   {
@@ -2698,6 +2836,47 @@ bool ONX_Model::IncrementalReadModelGeometry(
     }
   }
 
+  return true;
+}
+
+void ONX_Model::SetReadThreadCount(
+  unsigned int read_thread_count
+  )
+{
+  m_read_thread_count = read_thread_count;
+}
+
+unsigned int ONX_Model::ReadThreadCount() const
+{
+  return m_read_thread_count;
+}
+
+void ONX_Model::SetWriteTableOfContents(
+  bool bWriteTableOfContents
+  )
+{
+  m_bWriteTableOfContents = bWriteTableOfContents ? true : false;
+}
+
+bool ONX_Model::WriteTableOfContents() const
+{
+  return m_bWriteTableOfContents;
+}
+
+bool ONX_Model::IncrementalReadModelGeometry(
+  ON_BinaryArchive& archive,
+  bool bManageModelGeometryComponent,
+  bool bManageGeometry,
+  bool bManageAttributes,
+  unsigned int object_filter,
+  ON_ModelComponentReference& model_component_reference
+  )
+{
+  model_component_reference = ON_ModelComponentReference::Empty;
+
+  if (false == Internal_IncrementalReadBeginModelGeometry(archive))
+    return false;
+
   for(;;)
   {
     ON_ModelGeometryComponent* model_geometry = nullptr;
@@ -2818,7 +2997,11 @@ bool ONX_Model::IncrementalReadFinish(
       continue; // skip this bogus user table
     }
 
-    if ( 
+    if (ON_3dmArchiveTableOfContents::UserTableId == plugin_id)
+    {
+      // ONX_Model::Write() saves a new table of contents.
+    }
+    else if ( 
       nullptr == m_model_user_string_list
       && plugin_id == ON_CLASS_ID(ON_DocumentUserStringList) 
       )
@@ -2893,9 +3076,28 @@ bool ONX_Model::Read(
     ON_TextLog* error_log
     )
 {
-  bool bCallReset = true;
+  return Internal_ReadFile(filename,table_filter,model_object_type_filter,true,error_log);
+}
+
+bool ONX_Model::Internal_ReadFile( 
+    const wchar_t* filename,
+    unsigned int table_filter,
+    unsigned int model_object_type_filter,
+    bool bResetIfNotOpened,
+    ON_TextLog* error_log
+    )
+{
+  bool bCallReset = bResetIfNotOpened;
   bool rc = false;
 
+  if ( 0 != filename && m_bLazyGeometryLoading )
+  {
+    ON_Read3dmMappedFileArchive* file = new ON_Read3dmMappedFileArchive(filename);
+    if (file->FileIsMapped())
+      return Internal_ReadLazyGeometry(file, table_filter, model_object_type_filter, error_log);
+    delete file;
+  }
+
   if ( 0 != filename )
   {
     FILE* fp = ON::OpenFile(filename,L"rb");
@@ -2934,13 +3136,19 @@ bool ONX_Model::Read(
     // STEP 15: REQUIRED - Read object (geometry and annotation) table
     if ( 0 == (static_cast<unsigned int>(ON_3dmArchiveTableType::object_table) & table_filter) )
     {
-      for(;;) 
+      if ( Internal_IncrementalReadBeginModelGeometry(archive) )
       {
-        ON_ModelComponentReference model_geometry_reference;
-        if ( false == IncrementalReadModelGeometry(archive, bManageComponents, bManageGeometry, bManageAttributes, model_object_type_filter, model_geometry_reference) )
-          break; // catestrophic error
-        if (model_geometry_reference.IsEmpty())
-          break; // no more geometry;
+        // Geometry is decoded on m_read_thread_count threads and added in archive order.
+        ON_SimpleArray<ON_ModelGeometryComponent*> model_geometry_list;
+        if (archive.Read3dmModelGeometryListForExperts(bManageGeometry, bManageAttributes, model_object_type_filter, m_read_thread_count, model_geometry_list) < 0)
+        {
+          if (error_log) error_log->Print("ONX_Model::Read archive.Read3dmModelGeometryListForExperts() failed.\n");
+        }
+        for (int i = 0; i < model_geometry_list.Count(); i++)
+          AddModelComponentForExperts(model_geometry_list[i], bManageComponents, true, true);
+        // If BeginRead3dmObjectTable() returns true, 
+        // then you MUST call EndRead3dmObjectTable().
+        archive.EndRead3dmObjectTable();
       }
       if ( 0 != archive.CriticalErrorCount() )
         break;
@@ -2956,6 +3164,228 @@ bool ONX_Model::Read(
   return ( 0 == archive.CriticalErrorCount() && 0 == archive.BadCRCCount() );
 }
 
+bool ONX_Model::Internal_ReadLazyGeometry(
+  ON_Read3dmMappedFileArchive* file,
+  unsigned int table_filter,
+  unsigned int model_object_type_filter,
+  ON_TextLog* error_log
+  )
+{
+  const bool bManageComponents = true;
+  const bool bManageGeometry = true;
+  const bool bManageAttributes = true;
+
+  // IncrementalReadBegin() calls Reset().
+  IncrementalReadBegin(*file, bManageComponents, table_filter, error_log);
+  if ( 0 != file->CriticalErrorCount() )
+  {
+    delete file;
+    return false;
+  }
+
+  m_lazy_geometry = new ONX_ModelLazyGeometry(file);
+  ON_BinaryArchive& archive = *file;
+
+  for(;;)
+  {
+    if ( 0 == (static_cast<unsigned int>(ON_3dmArchiveTableType::object_table) & table_filter) )
+    {
+      // The table of contents has the bounding boxes of deferred geometry.
+      ON_3dmArchiveTableOfContents table_of_contents;
+      archive.Read3dmTableOfContents(table_of_contents);
+
+      if ( Internal_IncrementalReadBeginModelGeometry(archive) )
+      {
+        for(;;)
+        {
+          ON_Object* p = nullptr;
+          ON_3dmObjectAttributes* attributes = new ON_3dmObjectAttributes();
+          ON_3dmArchiveTableOfContentsItem deferred_object;
+          const int rc = archive.Read3dmObjectOrDeferGeometry(&p, attributes, model_object_type_filter, deferred_object);
+          const bool bDeferred = (1 == rc && ON_ModelComponent::Type::ModelGeometry == deferred_object.m_component_type);
+
+          ON_ModelGeometryComponent* model_geometry = nullptr;
+          if (bDeferred)
+          {
+            ON_ModelGeometryComponent* placeholder = new ON_ModelGeometryComponent(ON_ModelComponent::Type::ModelGeometry);
+            model_geometry = ON_ModelGeometryComponent::CreateForExperts(bManageGeometry, nullptr, bManageAttributes, attributes, placeholder);
+          }
+          else if (1 == rc && nullptr != ON_Geometry::Cast(p))
+            model_geometry = ON_ModelGeometryComponent::CreateForExperts(bManageGeometry, p, bManageAttributes, attributes, nullptr);
+
+          if (nullptr == model_geometry)
+          {
+            delete p;
+            delete attributes;
+            if (rc <= 0)
+              break; // end of object table or error reading
+            continue;
+          }
+
+          const ON_ModelComponentReference mcr = AddModelComponentForExperts(model_geometry, bManageComponents, true, true);
+          const ON_ModelComponent* model_component = mcr.ModelComponent();
+          if (bDeferred && nullptr != model_component)
+          {
+            const ON_3dmArchiveTableOfContentsItem& item = table_of_contents.ItemFromId(deferred_object.m_component_id);
+            if (item.m_offset == deferred_object.m_offset)
+              deferred_object.m_bbox = item.m_bbox;
+            m_lazy_geometry->AddPlaceholder(model_component->RuntimeSerialNumber(), deferred_object);
+          }
+        }
+        // If BeginRead3dmObjectTable() returns true, 
+        // then you MUST call EndRead3dmObjectTable().
+        archive.EndRead3dmObjectTable();
+      }
+      if ( 0 != archive.CriticalErrorCount() )
+        break;
+    }
+
+    IncrementalReadFinish(archive, bManageComponents, table_filter, error_log);
+    break;
+  }
+
+  const bool rc = ( 0 == archive.CriticalErrorCount() && 0 == archive.BadCRCCount() );
+
+  if ( 0 == m_lazy_geometry->m_placeholders.Count() )
+  {
+    // Nothing was deferred. Close the file.
+    delete m_lazy_geometry;
+    m_lazy_geometry = nullptr;
+  }
+
+  return rc;
+}
+
+void ONX_Model::SetLazyGeometryLoading(
+  bool bLazyGeometryLoading,
+  size_t geometry_memory_budget
+  )
+{
+  m_bLazyGeometryLoading = bLazyGeometryLoading;
+  m_lazy_geometry_memory_budget = geometry_memory_budget;
+}
+
+bool ONX_Model::LazyGeometryLoading() const
+{
+  return m_bLazyGeometryLoading;
+}
+
+size_t ONX_Model::LazyGeometryMemoryBudget() const
+{
+  return m_lazy_geometry_memory_budget;
+}
+
+size_t ONX_Model::LazyGeometryLoadedSize() const
+{
+  return (nullptr != m_lazy_geometry) ? m_lazy_geometry->m_sizeof_loaded_geometry : 0;
+}
+
+bool ONX_Model::Internal_LoadLazyGeometry(
+  const ON_ModelComponent* model_component
+  ) const
+{
+  if (nullptr == m_lazy_geometry || nullptr == model_component)
+    return true;
+
+  const int placeholder_index = m_lazy_geometry->PlaceholderIndex(model_component->RuntimeSerialNumber());
+  if (placeholder_index < 0)
+    return true;
+
+  ONX_ModelLazyGeometry::Placeholder& placeholder = m_lazy_geometry->m_placeholders[placeholder_index];
+  if (placeholder.m_bLoaded)
+  {
+    // most recently used
+    m_lazy_geometry->LruRemove(placeholder_index);
+    m_lazy_geometry->LruPushFront(placeholder_index);
+    return true;
+  }
+
+  ON_ModelGeometryComponent* model_geometry = const_cast<ON_ModelGeometryComponent*>(ON_ModelGeometryComponent::Cast(model_component));
+  if (nullptr == model_geometry)
+    return true;
+  if (nullptr != model_geometry->Geometry(nullptr))
+    return true; // geometry was set by other means
+  if (placeholder.m_bReadFailed)
+    return false;
+
+  // The archive owns the geometry until it is moved to model_geometry.
+  ON_ModelGeometryComponent* archive_geometry = nullptr;
+  ON_Geometry* geometry = nullptr;
+  if (m_lazy_geometry->m_file->Read3dmModelGeometryFromTableOfContents(placeholder.m_record, false, true, &archive_geometry))
+    geometry = archive_geometry->ExclusiveGeometry();
+  delete archive_geometry;
+
+  if (nullptr == geometry || false == model_geometry->SetGeometryForExperts(true, geometry))
+  {
+    ON_ERROR("Unable to read lazily loaded geometry.");
+    delete geometry;
+    placeholder.m_bReadFailed = true;
+    return false;
+  }
+
+  if (false == placeholder.m_record.m_bbox.IsValid())
+    placeholder.m_record.m_bbox = geometry->BoundingBox();
+  placeholder.m_bLoaded = true;
+  placeholder.m_sizeof_geometry = geometry->SizeOf();
+  m_lazy_geometry->m_sizeof_loaded_geometry += placeholder.m_sizeof_geometry;
+  m_lazy_geometry->LruPushFront(placeholder_index);
+
+  // Unload least recently used geometry to get back under the budget.
+  // The geometry that was just loaded is always kept.
+  while (
+    m_lazy_geometry_memory_budget > 0
+    && m_lazy_geometry->m_sizeof_loaded_geometry > m_lazy_geometry_memory_budget
+    && m_lazy_geometry->m_lru_last >= 0
+    && m_lazy_geometry->m_lru_last != placeholder_index
+    )
+  {
+    Internal_UnloadLazyGeometry(m_lazy_geometry->m_lru_last);
+  }
+
+  return true;
+}
+
+void ONX_Model::Internal_UnloadLazyGeometry(
+  int placeholder_index
+  ) const
+{
+  ONX_ModelLazyGeometry::Placeholder& placeholder = m_lazy_geometry->m_placeholders[placeholder_index];
+  if (false == placeholder.m_bLoaded)
+    return;
+
+  m_lazy_geometry->LruRemove(placeholder_index);
+  m_lazy_geometry->m_sizeof_loaded_geometry -= placeholder.m_sizeof_geometry;
+  placeholder.m_sizeof_geometry = 0;
+  placeholder.m_bLoaded = false;
+
+  // The component is not in the model if it was removed after it was loaded.
+  const ONX_ModelComponentReferenceLink* link = Internal_ModelComponentLinkFromSerialNumber(placeholder.m_component_sn);
+  ON_ModelGeometryComponent* model_geometry
+    = (nullptr != link)
+    ? const_cast<ON_ModelGeometryComponent*>(ON_ModelGeometryComponent::Cast(link->m_mcr.ModelComponent()))
+    : nullptr;
+  if (nullptr != model_geometry)
+    model_geometry->SetGeometryForExperts(true, nullptr);
+}
+
+ON_BoundingBox ONX_Model::Internal_LazyGeometryBoundingBox(
+  const ON_ModelComponent* model_component
+  ) const
+{
+  if (nullptr == m_lazy_geometry || nullptr == model_component)
+    return ON_BoundingBox::UnsetBoundingBox;
+
+  const int placeholder_index = m_lazy_geometry->PlaceholderIndex(model_component->RuntimeSerialNumber());
+  if (placeholder_index < 0)
+    return ON_BoundingBox::UnsetBoundingBox;
+
+  // Without a table of contents, the bounding box is set when the geometry is loaded.
+  if (false == m_lazy_geometry->m_placeholders[placeholder_index].m_record.m_bbox.IsValid())
+    Internal_LoadLazyGeometry(model_component);
+
+  return m_lazy_geometry->m_placeholders[placeholder_index].m_record.m_bbox;
+}
+
 bool ONX_Model::Read( 
        ON_BinaryArchive& archive,
        ON_TextLog* error_log
@@ -2982,7 +3412,11 @@ bool ONX_Model::Write(
       ON_BinaryFile file( ON::archive_mode::write3dm, fp );
       const ON_wString wFileName(filename);
       file.SetArchiveFullPath(static_cast<const wchar_t*>(wFileName));
+      // Serialization and compression overlap with writing to disk.
+      file.EnableWriteBehind();
       rc = Write( file, version, error_log );
+      if (false == file.EndWriteBehind())
+        rc = false;
       ON::CloseFile(fp);
     }
   }
@@ -3004,7 +3438,11 @@ bool ONX_Model::Write(
     {
       ON_BinaryFile file( ON::archive_mode::write3dm, fp );
       file.SetArchiveFullPath(filename);
+      // Serialization and compression overlap with writing to disk.
+      file.EnableWriteBehind();
       rc = Write( file, version, error_log );
+      if (false == file.EndWriteBehind())
+        rc = false;
       ON::CloseFile(fp);
     }
   }
@@ -3044,6 +3482,9 @@ bool ONX_Model::Write(
 
   bool ok;
 
+  // Locations of the layer and object table records
+  ON_3dmArchiveTableOfContents table_of_contents;
+
   // START SECTION
   ok = archive.Write3dmStartSection( version, static_cast< const char* >(m_sStartSectionComments) );
   if ( !ok )
@@ -3211,30 +3652,44 @@ bool ONX_Model::Write(
     return false;
   }
   unsigned int layer_count = 0;
+  ON_UUID default_layer_id = ON_nil_uuid;
   for( 
     class ONX_ModelComponentReferenceLink* link = Internal_ComponentListConst(ON_ModelComponent::Type::Layer).m_first_mcr_link;
     nullptr != link && ok;
     link = link->m_next
     )
   {
+    const ON__UINT64 offset = archive.CurrentPosition();
     ok = archive.Write3dmLayerComponent(link->m_mcr);
     if (!ok)
     {
       if (error_log) error_log->Print("ONX_Model::Write archive.Write3dmLayerComponent() failed.\n");
     }
     else
+    {
       layer_count++;
+      const ON_ModelComponent* layer = link->m_mcr.ModelComponent();
+      if (m_bWriteTableOfContents && nullptr != layer)
+        Internal_AppendTableOfContentsItem(archive, offset, layer->Id(), ON_ModelComponent::Type::Layer, layer->Name(), ON_nil_uuid, ON_BoundingBox::UnsetBoundingBox, table_of_contents);
+    }
   }
   if (0 == layer_count && ok)
   {
     ON_Layer layer(ON_Layer::Default);
     layer.SetId();
     layer.SetIndex(0);
+    const ON__UINT64 offset = archive.CurrentPosition();
     ok = archive.Write3dmLayer(layer);
     if (!ok)
     {
       if (error_log) error_log->Print("ONX_Model::Write archive.Write3dmLayer() failed.\n");
     }
+    else
+    {
+      default_layer_id = layer.Id();
+      if (m_bWriteTableOfContents)
+        Internal_AppendTableOfContentsItem(archive, offset, layer.Id(), ON_ModelComponent::Type::Layer, layer.Name(), ON_nil_uuid, ON_BoundingBox::UnsetBoundingBox, table_of_contents);
+    }
   }
   if ( !archive.EndWrite3dmLayerTable() )
   {
@@ -3410,12 +3865,32 @@ bool ONX_Model::Write(
     link = link->m_next
     )
   {
+    if (false == Internal_LoadLazyGeometry(link->m_mcr.ModelComponent()))
+    {
+      if ( error_log)
+        error_log->Print("ONX_Model::Write unable to read lazily loaded geometry.\n");
+      continue;
+    }
+    // The bounding box is computed before the geometry is written. Some geometry,
+    // like ON_Mesh, caches it and writes the cached box.
+    const ON_ModelGeometryComponent* model_geometry = ON_ModelGeometryComponent::Cast(link->m_mcr.ModelComponent());
+    const ON_3dmObjectAttributes* attributes = (m_bWriteTableOfContents && nullptr != model_geometry) ? model_geometry->Attributes(nullptr) : nullptr;
+    const ON_Geometry* geometry = (nullptr != attributes) ? model_geometry->Geometry(nullptr) : nullptr;
+    const ON_BoundingBox bbox = (nullptr != geometry) ? geometry->BoundingBox() : ON_BoundingBox::UnsetBoundingBox;
+
+    const ON__UINT64 offset = archive.CurrentPosition();
     ok = archive.Write3dmModelGeometryComponent(link->m_mcr);
     if ( !ok )
     {
       if ( error_log)
         error_log->Print("ONX_Model::Write archive.Write3dmModelGeometryComponent() failed.\n");
     }
+    else if (nullptr != attributes)
+    {
+      const ON_ModelComponent* layer = LayerFromIndex(attributes->m_layer_index).ModelComponent();
+      const ON_UUID layer_id = (nullptr != layer && false == layer->IsSystemComponent()) ? layer->Id() : default_layer_id;
+      Internal_AppendTableOfContentsItem(archive, offset, attributes->m_uuid, ON_ModelComponent::Type::ModelGeometry, attributes->m_name, layer_id, bbox, table_of_contents);
+    }
   }
   if ( !archive.EndWrite3dmObjectTable() )
   {
@@ -3481,6 +3956,8 @@ bool ONX_Model::Write(
       const ONX_Model_UserData* model_ud = m_userdata_table[i];
       if (nullptr == model_ud)
         continue;
+      if (ON_3dmArchiveTableOfContents::UserTableId == model_ud->m_uuid)
+        continue; // replaced by the table of contents written below
       if (ON_UuidIsNotNil(model_ud->m_uuid))
       {
         if (!archive.Write3dmAnonymousUserTableRecord(
@@ -3494,6 +3971,16 @@ bool ONX_Model::Write(
         }
       }
     }
+
+    // TABLE OF CONTENTS - last user table
+    if (ok && m_bWriteTableOfContents && table_of_contents.ItemCount() > 0)
+    {
+      if (archive.BeginWrite3dmUserTable(ON_3dmArchiveTableOfContents::UserTableId, false, 0, 0))
+      {
+        table_of_contents.Write(archive);
+        archive.EndWrite3dmUserTable();
+      }
+    }
   }
 
   if ( !archive.Write3dmEndMark() )
@@ -3505,6 +3992,31 @@ bool ONX_Model::Write(
   return ok;
 }
 
+void ONX_Model::Internal_AppendTableOfContentsItem(
+  const ON_BinaryArchive& archive,
+  ON__UINT64 offset,
+  ON_UUID component_id,
+  ON_ModelComponent::Type component_type,
+  const ON_wString& name,
+  ON_UUID layer_id,
+  const ON_BoundingBox& bbox,
+  ON_3dmArchiveTableOfContents& table_of_contents
+  )
+{
+  const ON__UINT64 end_offset = archive.CurrentPosition();
+  if (end_offset <= offset || ON_UuidIsNil(component_id))
+    return; // nothing was written
+  ON_3dmArchiveTableOfContentsItem item;
+  item.m_component_id = component_id;
+  item.m_component_type = component_type;
+  item.m_name_hash = ON_NameHash::Create(name).MappedNameSha1Hash();
+  item.m_layer_id = layer_id;
+  item.m_offset = offset;
+  item.m_length = end_offset - offset;
+  item.m_bbox = bbox;
+  table_of_contents.Append(item);
+}
+
 int ONX_Model::UsesIDef(
         const ON_InstanceRef& iref,
         ON_UUID idef_uuid
@@ -3687,6 +4199,14 @@ void ONX_ModelComponentIterator::Internal_SetLink(
 }
 
 
+const ON_ModelComponentWeakReference& ONX_ModelComponentIterator::Internal_CurrentComponentWeakReference() const
+{
+  // m_link is safe to dereference after it is set.
+  if (nullptr != m_link && ON_ModelComponent::Type::ModelGeometry == m_component_type)
+    m_model->Internal_LoadLazyGeometry(m_link->m_mcr.ModelComponent());
+  return m_current_component_weak_ref;
+}
+
 ON_ModelComponentReference ONX_ModelComponentIterator::FirstComponentReference()
 {
   return ON_ModelComponentReference(FirstComponentWeakReference());
@@ -3718,14 +4238,14 @@ ON_ModelComponentWeakReference ONX_ModelComponentIterator::FirstComponentWeakRef
 {
   const ONX_Model::ONX_ModelComponentList* list = Internal_List();
   Internal_SetLink((nullptr != list) ? list->m_first_mcr_link : nullptr);
-  return m_current_component_weak_ref;
+  return Internal_CurrentComponentWeakReference();
 }
 
 ON_ModelComponentWeakReference ONX_ModelComponentIterator::LastComponentWeakReference()
 {
   const ONX_Model::ONX_ModelComponentList* list = Internal_List();
   Internal_SetLink((nullptr != list) ? list->m_last_mcr_link : nullptr);
-  return m_current_component_weak_ref;
+  return Internal_CurrentComponentWeakReference();
 }
 
 ON_ModelComponentWeakReference ONX_ModelComponentIterator::CurrentComponentWeakReference() const
@@ -3734,7 +4254,7 @@ ON_ModelComponentWeakReference ONX_ModelComponentIterator::CurrentComponentWeakR
   // Otherwise use sn for safe reset.
   if (m_model_content_version != m_model->ModelContentVersionNumber() )
     Internal_SetLink(m_model->Internal_ModelComponentLinkFromSerialNumber(m_current_component_sn));
-  return m_current_component_weak_ref;
+  return Internal_CurrentComponentWeakReference();
 }
 
 ON_ModelComponentWeakReference ONX_ModelComponentIterator::NextComponentWeakReference()
@@ -3777,7 +4297,7 @@ ON_ModelComponentWeakReference ONX_ModelComponentIterator::NextComponentWeakRefe
     m_current_component_weak_ref = ON_ModelComponentWeakReference::Empty;
   }
 
-  return m_current_component_weak_ref;
+  return Internal_CurrentComponentWeakReference();
 }
 
 ON_ModelComponentWeakReference ONX_ModelComponentIterator::PreviousComponentWeakReference()
@@ -3817,7 +4337,7 @@ ON_ModelComponentWeakReference ONX_ModelComponentIterator::PreviousComponentWeak
     m_current_component_weak_ref = ON_ModelComponentReference::Empty;
   }
 
-  return m_current_component_weak_ref;
+  return Internal_CurrentComponentWeakReference();
 }
 
 const ON_ModelComponent* ONX_ModelComponentIterator::FirstComponent()
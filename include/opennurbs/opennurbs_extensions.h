@@ -320,6 +320,86 @@ public:
     ON_TextLog* error_log = nullptr
     );
 
+  /*
+  Description:
+    Sets the number of threads ONX_Model::Read() uses to decode
+    geometry in the object table.
+  Parameters:
+    read_thread_count - [in]
+      0: (default) std::thread::hardware_concurrency() threads.
+      1: geometry is decoded on the calling thread.
+  Remarks:
+    Components are added to the model in archive order and
+    get the same ids and indices for every thread count.
+    See ON_BinaryArchive::Read3dmModelGeometryListForExperts().
+  */
+  void SetReadThreadCount(
+    unsigned int read_thread_count
+    );
+
+  unsigned int ReadThreadCount() const;
+
+  /*
+  Description:
+    Sets whether ONX_Model::Write() appends a table of contents.
+  Parameters:
+    bWriteTableOfContents - [in]
+      true: (default) the last user table written is an
+        ON_3dmArchiveTableOfContents of the layer and object table records.
+      false: no table of contents is written.
+  Remarks:
+    A table of contents read with the model is never written again;
+    it would not match the offsets of the new archive.
+  */
+  void SetWriteTableOfContents(
+    bool bWriteTableOfContents
+    );
+
+  bool WriteTableOfContents() const;
+
+  /*
+  Description:
+    Enables lazy geometry loading in Read(filename,...).
+  Parameters:
+    bLazyGeometryLoading - [in]
+      If true, Read(filename,...) maps the file and keeps it open until
+      Reset() is called or the model is destroyed. Points, point clouds,
+      curves, surfaces, breps, meshes, SubDs, extrusions and cages are
+      added as ON_ModelGeometryComponent placeholders that have attributes
+      and no geometry. The geometry of a placeholder is read the first time
+      the component is returned by ModelGeometryComponentFromId() or
+      an ONX_ModelComponentIterator. Everything else is read as usual.
+    geometry_memory_budget - [in]
+      Approximate number of bytes (ON_Object::SizeOf()) of lazily loaded
+      geometry that is kept in memory. When loading geometry exceeds the
+      budget, the least recently used geometry is unloaded.
+      0 = no limit.
+  Remarks:
+    Loading is not thread safe.
+    Pointers returned by ON_ModelGeometryComponent::Geometry() are not
+    valid after the geometry is unloaded. A copy of the ON_ModelGeometryComponent
+    keeps the geometry. Changes made to lazily loaded geometry are lost when
+    it is unloaded.
+    Write() loads geometry as it is needed. Do not write to the file that
+    was read while the model has placeholders.
+    If the file cannot be mapped, Read(filename,...) reads all geometry.
+  */
+  void SetLazyGeometryLoading(
+    bool bLazyGeometryLoading,
+    size_t geometry_memory_budget
+    );
+
+  bool LazyGeometryLoading() const;
+
+  size_t LazyGeometryMemoryBudget() const;
+
+  /*
+  Returns:
+    Number of bytes (ON_Object::SizeOf()) of lazily loaded geometry
+    that is currently in memory.
+  */
+  size_t LazyGeometryLoadedSize() const;
+
   /*
   Description:
     Reads everything up to the object table.
@@ -528,6 +608,10 @@ public:
     True if archive is written with no error. 
     False if errors occur.
     Error details are logged in error_log.
+  Remarks:
+    When WriteTableOfContents() is true, the last user table is an
+    ON_3dmArchiveTableOfContents of the layer and object table records.
+    ON_BinaryArchive::Read3dmTableOfContents() reads it.
   */
   bool Write( 
     const char* filename,
@@ -1296,6 +1380,20 @@ public:
     ON_UUID model_geometry_component_id
     ) const;
 
+  /*
+  Description:
+    Get the bounding box of a model geometry component.
+  Parameters:
+    model_geometry_component_id - [in]
+  Returns:
+    The bounding box of the component's geometry. The bounding box of 
+    a lazily loaded placeholder comes from the table of contents saved
+    in the file, when there is one, and does not require loading the geometry.
+  */
+  ON_BoundingBox ModelGeometryComponentBoundingBox(
+    ON_UUID model_geometry_component_id
+    ) const;
+
 public:
   ON_SimpleArray<ONX_Model_UserData*> m_userdata_table;
 
@@ -1306,6 +1404,101 @@ private:
   ON_ModelComponentReference m_default_text_style = ON_ModelComponentReference::CreateConstantSystemComponentReference(ON_TextStyle::Default);
   ON_ModelComponentReference m_default_dimension_style = ON_ModelComponentReference::CreateConstantSystemComponentReference(ON_DimStyle::Default);
 
+private:
+  // Number of threads ONX_Model::Read() uses to decode geometry. 0 = hardware concurrency.
+  unsigned int m_read_thread_count = 0;
+
+  // True if ONX_Model::Write() appends a table of contents.
+  bool m_bWriteTableOfContents = true;
+
+  /*
+  Description:
+    Begins reading the object table if needed and verifies that
+    it is in progress.
+  */
+  bool Internal_IncrementalReadBeginModelGeometry(
+    ON_BinaryArchive& archive
+    ) const;
+
+private:
+  /*
+  Description:
+    Appends an item for the record written from offset to the current
+    archive position. Used by ONX_Model::Write().
+  */
+  static void Internal_AppendTableOfContentsItem(
+    const ON_BinaryArchive& archive,
+    ON__UINT64 offset,
+    ON_UUID component_id,
+    ON_ModelComponent::Type component_type,
+    const ON_wString& name,
+    ON_UUID layer_id,
+    const ON_BoundingBox& bbox,
+    ON_3dmArchiveTableOfContents& table_of_contents
+    );
+
+private:
+  // Lazy geometry loading settings. See SetLazyGeometryLoading().
+  bool m_bLazyGeometryLoading = false;
+  size_t m_lazy_geometry_memory_budget = 0;
+
+  // The mapped file and placeholders of a lazy Read(). nullptr when
+  // the model has no placeholders.
+  class ONX_ModelLazyGeometry* m_lazy_geometry = nullptr;
+
+  /*
+  Description:
+    Reads the model from a file.
+  Parameters:
+    bResetIfNotOpened - [in]
+      If true, the model is reset when the file cannot be opened.
+      If false, the model is not changed.
+  */
+  bool Internal_ReadFile(
+    const wchar_t* filename,
+    unsigned int table_filter,
+    unsigned int model_object_type_filter,
+    bool bResetIfNotOpened,
+    ON_TextLog* error_log
+    );
+
+  /*
+  Description:
+    Reads the model and defers geometry. file is deleted when reading
+    fails or no geometry is deferred.
+  */
+  bool Internal_ReadLazyGeometry(
+    class ON_Read3dmMappedFileArchive* file,
+    unsigned int table_filter,
+    unsigned int model_object_type_filter,
+    ON_TextLog* error_log
+    );
+
+  /*
+  Description:
+    Reads the geometry of a placeholder and unloads the least recently
+    used geometry that exceeds the memory budget.
+  Returns:
+    False if model_component is a placeholder whose geometry cannot be read.
+    True otherwise.
+  */
+  bool Internal_LoadLazyGeometry(
+    const ON_ModelComponent* model_component
+    ) const;
+
+  void Internal_UnloadLazyGeometry(
+    int placeholder_index
+    ) const;
+
+  /*
+  Returns:
+    The bounding box of a placeholder, or ON_BoundingBox::UnsetBoundingBox
+    if model_component is not a placeholder.
+  */
+  ON_BoundingBox Internal_LazyGeometryBoundingBox(
+    const ON_ModelComponent* model_component
+    ) const;
+
 private:
   ON_ModelComponentReference Internal_AddModelComponent(
     ON_ModelComponent* model_component,
@@ -1612,6 +1805,12 @@ private:
   void Internal_SetLink(const class ONX_ModelComponentReferenceLink* link) const;
   void Internal_SetLink(ON__UINT64 model_component_sn) const;
 
+  /*
+  Returns:
+    m_current_component_weak_ref after loading the geometry of a lazily read component.
+  */
+  const ON_ModelComponentWeakReference& Internal_CurrentComponentWeakReference() const;
+
   ON_ModelComponent::Type m_component_type = ON_ModelComponent::Type::Unset;
   const class ONX_Model* m_model = nullptr;
   mutable ON__UINT64 m_model_content_version = 0;
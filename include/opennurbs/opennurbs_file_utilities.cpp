@@ -45,6 +45,8 @@
 
 #if defined(ON_RUNTIME_APPLE)
 #include "unistd.h" //for unlink
+#elif !defined(ON_COMPILER_MSC)
+#include <unistd.h> //for fsync
 #endif
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -2145,6 +2147,20 @@ bool ON_FileStream::Flush( FILE* fp )
   return true;
 }
 
+bool ON_FileStream::Sync( FILE* fp )
+{
+  if ( false == ON_FileStream::Flush(fp) )
+    return false;
+#if defined(ON_COMPILER_MSC)
+  return ( 0 == _commit(_fileno(fp)) );
+#else
+  if ( 0 == fsync(fileno(fp)) )
+    return true;
+  // pipes, sockets and character devices cannot be synchronized
+  return ( EINVAL == errno || ENOTSUP == errno );
+#endif
+}
+
 bool ON_FileStream::GetFileInformation(
   const wchar_t* file_name,
   ON__UINT64* file_size,
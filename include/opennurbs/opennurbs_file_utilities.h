@@ -816,6 +816,20 @@ public:
   */
   static bool Flush( FILE* fp );
 
+  /*
+  Description:
+    Flushes fp and asks the operating system to write its data
+    to the storage device with fsync() or _commit().
+  Parameters:
+    fp - [in]
+      FILE pointer returned by ON_FileStream::Open().
+  Returns:
+    true if successful.  False if an error occured.
+  Remarks:
+    Streams that cannot be synchronized, like pipes, only are flushed.
+  */
+  static bool Sync( FILE* fp );
+
   /*
   Description:
     Portable wrapper for C runtime fstat().
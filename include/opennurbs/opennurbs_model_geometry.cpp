@@ -308,6 +308,24 @@ ON_3dmObjectAttributes* ON_ModelGeometryComponent::ExclusiveAttributes() const
     : nullptr;
 }
 
+bool ON_ModelGeometryComponent::SetGeometryForExperts(
+  bool bManageGeometry,
+  ON_Geometry* geometry
+  )
+{
+  if (ON_ModelComponent::Type::ModelGeometry != ComponentType())
+    return false;
+  if (nullptr != ON_Light::Cast(geometry))
+    return false;
+
+  m_geometry_sp
+    = bManageGeometry
+    ? ON_MANAGED_SHARED_PTR(ON_Geometry,geometry)
+    : ON_UNMANAGED_SHARED_PTR(ON_Geometry,geometry);
+
+  return true;
+}
+
 void ON_ModelGeometryComponent::Dump( ON_TextLog& text_log ) const
 {
   ON_ModelComponent::Dump(text_log);
@@ -228,6 +228,29 @@ public:
   */
   class ON_3dmObjectAttributes* ExclusiveAttributes() const;
 
+  /*
+  Description:
+    Expert user function used by ONX_Model to load and unload the
+    geometry of components whose geometry is read on demand.
+  Parameters:
+    bManageGeometry - [in]
+      If true, geometry was created on the heap using operator new and 
+      this ON_ModelGeometryComponent will eventually delete it.
+    geometry - [in]
+      nullptr unloads the geometry. Lights are not permitted because
+      they change the component type.
+  Returns:
+    True if the geometry was set.
+  Remarks:
+    Copies of this ON_ModelGeometryComponent keep the geometry they share.
+    Pointers returned by Geometry() that are not shared by a copy are
+    not valid after the geometry is unloaded.
+  */
+  bool SetGeometryForExperts(
+    bool bManageGeometry,
+    class ON_Geometry* geometry
+    );
+
 private:
 
 #pragma ON_PRAGMA_WARNING_PUSH
@@ -505,7 +505,8 @@ ON_RTree::~ON_RTree()
 
 bool ON_RTree::CreateMeshFaceTree( const ON_Mesh* mesh )
 {
-  double fmin[3], fmax[3];
+  double* fmin;
+  double* fmax;
   ON_3dPoint V;
   unsigned int fi, fcount;
   const int* fvi;
@@ -532,6 +533,12 @@ bool ON_RTree::CreateMeshFaceTree( const ON_Mesh* mesh )
          ? mesh->DoublePrecisionVertices().Array() 
          : 0;
 
+  // The face bounding boxes are collected and the tree is built
+  // with CreatePackedTree().
+  ON_RTreeBBox* boxes = (ON_RTreeBBox*)onmalloc(fcount*sizeof(boxes[0]));
+  if ( 0 == boxes )
+    return false;
+
   if ( 0 != meshfV )
   {
     if ( 0 != meshdV )
@@ -539,6 +546,8 @@ bool ON_RTree::CreateMeshFaceTree( const ON_Mesh* mesh )
       for ( fi = 0; fi < fcount; fi++ )
       {
         fvi = meshF[fi].vi;
+        fmin = boxes[fi].m_min;
+        fmax = boxes[fi].m_max;
 
         V = meshfV[fvi[0]];
         fmin[0] = fmax[0] = V.x;
@@ -578,12 +587,6 @@ bool ON_RTree::CreateMeshFaceTree( const ON_Mesh* mesh )
           if ( V.y < fmin[1] ) fmin[1] = V.y; else if ( V.y > fmax[1] ) fmax[1] = V.y;
           if ( V.z < fmin[2] ) fmin[2] = V.z; else if ( V.z > fmax[2] ) fmax[2] = V.z;  
         }
-
-        if ( !Insert(fmin,fmax,fi) )
-        {
-          RemoveAll();
-          return false;
-        }
       }
     }
     else
@@ -591,6 +594,8 @@ bool ON_RTree::CreateMeshFaceTree( const ON_Mesh* mesh )
       for ( fi = 0; fi < fcount; fi++ )
       {
         fvi = meshF[fi].vi;
+        fmin = boxes[fi].m_min;
+        fmax = boxes[fi].m_max;
 
         V = meshfV[fvi[0]];
         fmin[0] = fmax[0] = V.x;
@@ -614,12 +619,6 @@ bool ON_RTree::CreateMeshFaceTree( const ON_Mesh* mesh )
           if ( V.y < fmin[1] ) fmin[1] = V.y; else if ( V.y > fmax[1] ) fmax[1] = V.y;
           if ( V.z < fmin[2] ) fmin[2] = V.z; else if ( V.z > fmax[2] ) fmax[2] = V.z;      
         }
-
-        if ( !Insert(fmin,fmax,fi) )
-        {
-          RemoveAll();
-          return false;
-        }
       }
     }
   }
@@ -628,6 +627,8 @@ bool ON_RTree::CreateMeshFaceTree( const ON_Mesh* mesh )
     for ( fi = 0; fi < fcount; fi++ )
     {
       fvi = meshF[fi].vi;
+      fmin = boxes[fi].m_min;
+      fmax = boxes[fi].m_max;
 
       V = meshdV[fvi[0]];
       fmin[0] = fmax[0] = V.x;
@@ -651,21 +652,430 @@ bool ON_RTree::CreateMeshFaceTree( const ON_Mesh* mesh )
         if ( V.y < fmin[1] ) fmin[1] = V.y; else if ( V.y > fmax[1] ) fmax[1] = V.y;
         if ( V.z < fmin[2] ) fmin[2] = V.z; else if ( V.z > fmax[2] ) fmax[2] = V.z;      
       }
+    }
+  }
+  else
+  {
+    // no vertices
+    onfree(boxes);
+    return false;
+  }
+
+  const bool rc = CreatePackedTree(fcount, boxes, nullptr);
+  onfree(boxes);
+  return rc;
+}
+
+////////////////////////////////////////////////////////////////
+//
+// ON_RTree packed construction
+//
+
+// Number of bits per coordinate in a Hilbert key (3*21 = 63 bits).
+#define ON_RTree_HILBERT_BITS 21
+
+// Parallel sorting is used when each thread sorts at least this many keys.
+#define ON_RTree_PARALLEL_SORT_MIN_COUNT 32768
+
+// Maximum number of threads used to sort keys.
+#define ON_RTree_PARALLEL_SORT_MAX_THREADS 8
+
+struct ON_RTreeHilbertKey
+{
+  ON__UINT64 m_key;   // position of the element center along the Hilbert curve
+  size_t m_index;     // index of the element
+};
+
+#define ON_COMPILING_OPENNURBS_QSORT_FUNCTIONS
+#define ON_SORT_TEMPLATE_STATIC_FUNCTION
+#define ON_SORT_TEMPLATE_TYPE struct ON_RTreeHilbertKey
+#define ON_SORT_TEMPLATE_COMPARE ON__RTreeHilbertKey_compare
+#define ON_QSORT_SHORT_SORT_FNAME ON__RTreeHilbertKey_shortsort
+#define ON_QSORT_FNAME ON__RTreeHilbertKey_qsort
+
+static int ON_SORT_TEMPLATE_COMPARE(
+  ON_SORT_TEMPLATE_TYPE const * a,
+  ON_SORT_TEMPLATE_TYPE const * b
+  )
+{
+  // The index breaks ties so the order does not depend on how
+  // the keys were split between threads.
+  if ( a->m_key < b->m_key )
+    return -1;
+  if ( a->m_key > b->m_key )
+    return 1;
+  if ( a->m_index < b->m_index )
+    return -1;
+  if ( a->m_index > b->m_index )
+    return 1;
+  return 0;
+}
+
+#include "opennurbs_qsort_template.h"
+
+#undef ON_COMPILING_OPENNURBS_QSORT_FUNCTIONS
+#undef ON_SORT_TEMPLATE_STATIC_FUNCTION
+#undef ON_SORT_TEMPLATE_TYPE
+#undef ON_SORT_TEMPLATE_COMPARE
+#undef ON_QSORT_SHORT_SORT_FNAME
+#undef ON_QSORT_FNAME
+
+/*
+Description:
+  Skilling's algorithm for the distance along a 3d Hilbert curve works
+  from the highest bit down. At each bit it inverts the lower bits of
+  a coordinate or exchanges the lower bits of two coordinates, so the
+  lower bits are always a permutation of the input coordinates with
+  some of them inverted. The 6 permutations times 8 inversions give
+  48 states, and one table lookup per bit replaces the loops over all
+  the lower bits.
+*/
+class ON_RTreeHilbertTable
+{
+public:
+  ON_RTreeHilbertTable();
+
+  // m_table[8*state + input bits] = (next state << 3) | output bits
+  unsigned short m_table[48*8];
+
+  static unsigned int StateIndex(const int perm[3], unsigned int inverted);
+};
+
+static const int ON_RTreeHilbertPermutations[6][3] =
+{
+  {0,1,2}, {0,2,1}, {1,0,2}, {1,2,0}, {2,0,1}, {2,1,0}
+};
+
+unsigned int ON_RTreeHilbertTable::StateIndex(const int perm[3], unsigned int inverted)
+{
+  for ( unsigned int p = 0; p < 6; p++ )
+  {
+    if ( perm[0] == ON_RTreeHilbertPermutations[p][0]
+      && perm[1] == ON_RTreeHilbertPermutations[p][1]
+      && perm[2] == ON_RTreeHilbertPermutations[p][2] )
+      return 8*p + inverted;
+  }
+  return 0;
+}
+
+ON_RTreeHilbertTable::ON_RTreeHilbertTable()
+{
+  for ( unsigned int state = 0; state < 48; state++ )
+  {
+    for ( unsigned int input = 0; input < 8; input++ )
+    {
+      // Coordinate i of the current frame is input coordinate perm[i],
+      // inverted when bit i of inverted is set.
+      int perm[3] = {
+        ON_RTreeHilbertPermutations[state/8][0],
+        ON_RTreeHilbertPermutations[state/8][1],
+        ON_RTreeHilbertPermutations[state/8][2]
+      };
+      unsigned int inverted = state % 8;
+      unsigned int y[3];
+      for ( int i = 0; i < 3; i++ )
+        y[i] = ((input >> (2 - perm[i])) & 1U) ^ ((inverted >> i) & 1U);
+
+      // Skilling's "inverse undo" step applied to the lower bits
+      for ( int i = 0; i < 3; i++ )
+      {
+        if ( 0 != y[i] )
+          inverted ^= 1U;
+        else
+        {
+          const int p = perm[0];
+          perm[0] = perm[i];
+          perm[i] = p;
+          const unsigned int b0 = inverted & 1U;
+          const unsigned int bi = (inverted >> i) & 1U;
+          inverted = (inverted & ~(1U | (1U << i))) | (bi) | (b0 << i);
+        }
+      }
+
+      m_table[8*state + input] = (unsigned short)((StateIndex(perm, inverted) << 3) | (y[0] << 2) | (y[1] << 1) | y[2]);
+    }
+  }
+}
+
+/*
+Parameters:
+  X0, X1, X2 - [in]
+    Coordinates with ON_RTree_HILBERT_BITS bits each.
+Returns:
+  Distance along a 3d Hilbert curve.
+*/
+static ON__UINT64 Internal_RTreeHilbertKey( const ON_RTreeHilbertTable& table, ON__UINT32 X0, ON__UINT32 X1, ON__UINT32 X2 )
+{
+  ON__UINT64 key = 0;
+  unsigned int state = 0;
+  unsigned int parity = 0;
+  for ( int b = ON_RTree_HILBERT_BITS - 1; b >= 0; b-- )
+  {
+    const unsigned int input = (((X0 >> b) & 1U) << 2) | (((X1 >> b) & 1U) << 1) | ((X2 >> b) & 1U);
+    const unsigned int entry = table.m_table[8*state + input];
+    state = entry >> 3;
+
+    // Gray encode; parity is the exclusive or of the last gray code
+    // bit at the higher bits.
+    const unsigned int y = entry & 7U;
+    const unsigned int g0 = (y >> 2);
+    const unsigned int g1 = g0 ^ ((y >> 1) & 1U);
+    const unsigned int g2 = g1 ^ (y & 1U);
+    key = (key << 3) | (((g0 << 2) | (g1 << 1) | g2) ^ (7U*parity));
+    parity ^= g2;
+  }
+  return key;
+}
+
+static void Internal_RTreeSortHilbertKeys( struct ON_RTreeHilbertKey* keys, size_t count )
+{
+  ON__RTreeHilbertKey_qsort(keys, count);
+}
+
+#if !defined(OPENNURBS_NO_STD_THREAD)
+static void Internal_RTreeMergeHilbertKeys(
+  const struct ON_RTreeHilbertKey* a,
+  size_t a_count,
+  const struct ON_RTreeHilbertKey* b,
+  size_t b_count,
+  struct ON_RTreeHilbertKey* merged
+  )
+{
+  const struct ON_RTreeHilbertKey* a1 = a + a_count;
+  const struct ON_RTreeHilbertKey* b1 = b + b_count;
+  while ( a < a1 && b < b1 )
+    *merged++ = (ON__RTreeHilbertKey_compare(b, a) < 0) ? *b++ : *a++;
+  while ( a < a1 )
+    *merged++ = *a++;
+  while ( b < b1 )
+    *merged++ = *b++;
+}
+
+/*
+Description:
+  Sorts keys[]. Large arrays are split into runs that are sorted
+  on separate threads and then merged in pairs, also on separate
+  threads.
+*/
+static void Internal_RTreeParallelSortHilbertKeys( struct ON_RTreeHilbertKey* keys, size_t count )
+{
+  unsigned int thread_count = std::thread::hardware_concurrency();
+  if ( thread_count > ON_RTree_PARALLEL_SORT_MAX_THREADS )
+    thread_count = ON_RTree_PARALLEL_SORT_MAX_THREADS;
+
+  // run_count is a power of 2 so the runs merge in pairs.
+  unsigned int run_count = 1;
+  while ( 2*run_count <= thread_count && count/(2*run_count) >= ON_RTree_PARALLEL_SORT_MIN_COUNT )
+    run_count *= 2;
+
+  struct ON_RTreeHilbertKey* buffer
+    = (run_count > 1)
+    ? (struct ON_RTreeHilbertKey*)onmalloc(count*sizeof(buffer[0]))
+    : nullptr;
+  if ( nullptr == buffer )
+  {
+    Internal_RTreeSortHilbertKeys(keys, count);
+    return;
+  }
+
+  size_t run[ON_RTree_PARALLEL_SORT_MAX_THREADS + 1];
+  for ( unsigned int i = 0; i <= run_count; i++ )
+    run[i] = (count/run_count)*i;
+  run[run_count] = count;
 
-      if ( !Insert(fmin,fmax,fi) )
+  std::thread workers[ON_RTree_PARALLEL_SORT_MAX_THREADS];
+  for ( unsigned int i = 1; i < run_count; i++ )
+    workers[i] = std::thread(Internal_RTreeSortHilbertKeys, keys + run[i], run[i + 1] - run[i]);
+  Internal_RTreeSortHilbertKeys(keys, run[1]);
+  for ( unsigned int i = 1; i < run_count; i++ )
+    workers[i].join();
+
+  struct ON_RTreeHilbertKey* src = keys;
+  struct ON_RTreeHilbertKey* dst = buffer;
+  for ( unsigned int width = 1; width < run_count; width *= 2 )
+  {
+    for ( unsigned int i = 2*width; i < run_count; i += 2*width )
+    {
+      workers[i] = std::thread(
+        Internal_RTreeMergeHilbertKeys,
+        src + run[i], run[i + width] - run[i],
+        src + run[i + width], run[i + 2*width] - run[i + width],
+        dst + run[i]
+        );
+    }
+    Internal_RTreeMergeHilbertKeys(src, run[width], src + run[width], run[2*width] - run[width], dst);
+    for ( unsigned int i = 2*width; i < run_count; i += 2*width )
+      workers[i].join();
+    struct ON_RTreeHilbertKey* tmp = src;
+    src = dst;
+    dst = tmp;
+  }
+
+  if ( src != keys )
+    memcpy(keys, src, count*sizeof(keys[0]));
+  onfree(buffer);
+}
+#endif
+
+/*
+Returns:
+  Number of branches in the next packed node when remaining_count
+  branches are left. Nodes are full except the last two, which share
+  the remainder so neither has fewer than ON_RTree_MIN_NODE_COUNT
+  branches.
+*/
+static int Internal_RTreePackedNodeCount( size_t remaining_count )
+{
+  if ( remaining_count <= ON_RTree_MAX_NODE_COUNT )
+    return (int)remaining_count;
+  if ( remaining_count < ON_RTree_MAX_NODE_COUNT + ON_RTree_MIN_NODE_COUNT )
+    return (int)(remaining_count - ON_RTree_MIN_NODE_COUNT);
+  return ON_RTree_MAX_NODE_COUNT;
+}
+
+bool ON_RTree::CreatePackedTree(
+  size_t element_count,
+  const ON_RTreeBBox* element_boxes,
+  const ON__INT_PTR* element_ids
+  )
+{
+  RemoveAll();
+
+  if ( 0 == element_count || nullptr == element_boxes )
+    return false;
+
+  // Bounding box of the element centers
+  double cmin[3], cmax[3];
+  size_t i;
+  int j;
+  for ( j = 0; j < 3; j++ )
+  {
+    cmin[j] = ON_DBL_MAX;
+    cmax[j] = -ON_DBL_MAX;
+  }
+  for ( i = 0; i < element_count; i++ )
+  {
+    const ON_RTreeBBox& box = element_boxes[i];
+    for ( j = 0; j < 3; j++ )
+    {
+      if ( !(box.m_min[j] <= box.m_max[j]) )
       {
-        RemoveAll();
+        // invalid bounding box - don't let this corrupt the tree
+        ON_ERROR("ON_RTree::CreatePackedTree - invalid element_boxes[] input.");
         return false;
       }
+      const double c = 0.5*(box.m_min[j] + box.m_max[j]);
+      if ( c < cmin[j] )
+        cmin[j] = c;
+      if ( c > cmax[j] )
+        cmax[j] = c;
     }
   }
-  else
+
+  struct ON_RTreeHilbertKey* keys = (struct ON_RTreeHilbertKey*)onmalloc(element_count*sizeof(keys[0]));
+  const size_t leaf_node_capacity = element_count/ON_RTree_MAX_NODE_COUNT + 1;
+  ON_RTreeNode** nodes = (ON_RTreeNode**)onmalloc(leaf_node_capacity*sizeof(nodes[0]));
+  if ( nullptr == keys || nullptr == nodes )
   {
-    // no vertices
+    onfree(keys);
+    onfree(nodes);
+    ON_ERROR("ON_RTree::CreatePackedTree - out of memory");
     return false;
   }
 
-  return (0 != m_root);
+  // The same scale is used in every direction so the curve does not
+  // stretch thin directions, like the thickness of a flat mesh.
+  const double grid_max = (double)((1U << ON_RTree_HILBERT_BITS) - 1);
+  double extent = 0.0;
+  for ( j = 0; j < 3; j++ )
+  {
+    if ( cmax[j] - cmin[j] > extent )
+      extent = cmax[j] - cmin[j];
+  }
+  const double scale = (extent > 0.0) ? grid_max/extent : 0.0;
+
+  static const ON_RTreeHilbertTable hilbert_table;
+  for ( i = 0; i < element_count; i++ )
+  {
+    const ON_RTreeBBox& box = element_boxes[i];
+    ON__UINT32 X[3];
+    for ( j = 0; j < 3; j++ )
+    {
+      double x = (0.5*(box.m_min[j] + box.m_max[j]) - cmin[j])*scale;
+      if ( !(x > 0.0) )
+        x = 0.0;
+      else if ( x > grid_max )
+        x = grid_max;
+      X[j] = (ON__UINT32)x;
+    }
+    keys[i].m_key = Internal_RTreeHilbertKey(hilbert_table, X[0], X[1], X[2]);
+    keys[i].m_index = i;
+  }
+
+#if defined(OPENNURBS_NO_STD_THREAD)
+  Internal_RTreeSortHilbertKeys(keys, element_count);
+#else
+  Internal_RTreeParallelSortHilbertKeys(keys, element_count);
+#endif
+
+  // Leaf nodes hold consecutive elements along the Hilbert curve.
+  size_t node_count = 0;
+  bool rc = true;
+  for ( i = 0; i < element_count && rc; /*empty iterator*/ )
+  {
+    const int count = Internal_RTreePackedNodeCount(element_count - i);
+    ON_RTreeNode* node = m_mem_pool.AllocNode();
+    if ( nullptr == node )
+    {
+      rc = false;
+      break;
+    }
+    node->m_level = 0;
+    node->m_count = count;
+    for ( j = 0; j < count; j++, i++ )
+    {
+      const size_t element_index = keys[i].m_index;
+      node->m_branch[j].m_rect = element_boxes[element_index];
+      node->m_branch[j].m_id = (nullptr != element_ids) ? element_ids[element_index] : (ON__INT_PTR)element_index;
+    }
+    nodes[node_count++] = node;
+  }
+  onfree(keys);
+
+  // Each level packs consecutive nodes of the level below; they stay
+  // in Hilbert order because the leaves are.
+  for ( int level = 1; node_count > 1 && rc; level++ )
+  {
+    size_t parent_count = 0;
+    for ( i = 0; i < node_count; /*empty iterator*/ )
+    {
+      const int count = Internal_RTreePackedNodeCount(node_count - i);
+      ON_RTreeNode* node = m_mem_pool.AllocNode();
+      if ( nullptr == node )
+      {
+        rc = false;
+        break;
+      }
+      node->m_level = level;
+      node->m_count = count;
+      for ( j = 0; j < count; j++, i++ )
+      {
+        node->m_branch[j].m_child = nodes[i];
+        node->m_branch[j].m_rect = NodeCover(nodes[i]);
+      }
+      // parent_count < i, so nodes[] can be reused for the parents.
+      nodes[parent_count++] = node;
+    }
+    node_count = parent_count;
+  }
+
+  if ( rc )
+    m_root = nodes[0];
+  else
+    RemoveAll();
+  onfree(nodes);
+
+  return rc;
 }
 
 bool ON_RTree::Insert2d(const double a_min[2], const double a_max[2], int a_element_id)
@@ -2276,6 +2686,288 @@ bool ON_RTree::Search(
 #endif
 
 
+////////////////////////////////////////////////////////////////
+//
+// ON_RTree nearest element searches
+//
+
+// An entry in the priority queue of SearchNearest() and SearchNearestPairs().
+// A branch in a node with m_level > 0 points to a child node and a branch
+// in a node with m_level = 0 is an element.
+struct ON_RTreeNearestItem
+{
+  // Distance between the bounding boxes, or between the elements when m_bExact is true.
+  double m_distance;
+  const ON_RTreeBranch* m_branch[2];
+  // m_level[i] = m_level of the node that contains m_branch[i]
+  int m_level[2];
+  bool m_bExact;
+};
+
+// Binary heap with the nearest item on top.
+class ON_RTreeNearestQueue
+{
+public:
+  ON_RTreeNearestQueue() = default;
+  ~ON_RTreeNearestQueue() = default;
+
+  bool IsEmpty() const
+  {
+    return m_heap.Count() <= 0;
+  }
+
+  void Push(const ON_RTreeNearestItem& item)
+  {
+    int i = m_heap.Count();
+    m_heap.Append(item);
+    ON_RTreeNearestItem* a = m_heap.Array();
+    while ( i > 0 )
+    {
+      const int parent = (i - 1)/2;
+      if ( !Precedes(a[i], a[parent]) )
+        break;
+      const ON_RTreeNearestItem tmp = a[i];
+      a[i] = a[parent];
+      a[parent] = tmp;
+      i = parent;
+    }
+  }
+
+  ON_RTreeNearestItem Pop()
+  {
+    ON_RTreeNearestItem* a = m_heap.Array();
+    const ON_RTreeNearestItem top = a[0];
+    const int count = m_heap.Count() - 1;
+    a[0] = a[count];
+    m_heap.SetCount(count);
+    int i = 0;
+    for (;;)
+    {
+      int child = 2*i + 1;
+      if ( child >= count )
+        break;
+      if ( child + 1 < count && Precedes(a[child + 1], a[child]) )
+        child++;
+      if ( !Precedes(a[child], a[i]) )
+        break;
+      const ON_RTreeNearestItem tmp = a[i];
+      a[i] = a[child];
+      a[child] = tmp;
+      i = child;
+    }
+    return top;
+  }
+
+private:
+  static bool Precedes(const ON_RTreeNearestItem& a, const ON_RTreeNearestItem& b)
+  {
+    // At equal distances, results come out before items that need more work.
+    if ( a.m_distance < b.m_distance )
+      return true;
+    if ( a.m_distance > b.m_distance )
+      return false;
+    return (a.m_bExact && !b.m_bExact);
+  }
+
+  ON_SimpleArray<ON_RTreeNearestItem> m_heap;
+
+private:
+  ON_RTreeNearestQueue(const ON_RTreeNearestQueue&) = delete;
+  ON_RTreeNearestQueue& operator=(const ON_RTreeNearestQueue&) = delete;
+};
+
+static double PointDistanceHelper(const double a_point[3], const ON_RTreeBBox* a_rect)
+{
+  double d, dd = 0.0;
+  for ( int i = 0; i < ON_RTree_NODE_DIM; i++ )
+  {
+    if ( a_point[i] < a_rect->m_min[i] )
+      d = a_rect->m_min[i] - a_point[i];
+    else if ( a_point[i] > a_rect->m_max[i] )
+      d = a_point[i] - a_rect->m_max[i];
+    else
+      continue;
+    dd += d*d;
+  }
+  return sqrt(dd);
+}
+
+static double RectDistanceHelper(const ON_RTreeBBox* a_rectA, const ON_RTreeBBox* a_rectB)
+{
+  double d, dd = 0.0;
+  for ( int i = 0; i < ON_RTree_NODE_DIM; i++ )
+  {
+    if ( a_rectA->m_max[i] < a_rectB->m_min[i] )
+      d = a_rectB->m_min[i] - a_rectA->m_max[i];
+    else if ( a_rectB->m_max[i] < a_rectA->m_min[i] )
+      d = a_rectA->m_min[i] - a_rectB->m_max[i];
+    else
+      continue;
+    dd += d*d;
+  }
+  return sqrt(dd);
+}
+
+int ON_RTree::SearchNearest(
+  const double a_point[3],
+  int neighbor_count,
+  double maximum_distance,
+  double ON_CALLBACK_CDECL distanceCallback(void* a_context, const double a_point[3], ON__INT_PTR a_id),
+  void* a_context,
+  ON_SimpleArray<ON_RTreeNearestElement>& a_result
+  ) const
+{
+  if ( nullptr == a_point || neighbor_count <= 0 || !(maximum_distance >= 0.0) )
+    return 0;
+  if ( nullptr == m_root || m_root->m_count <= 0 )
+    return 0;
+
+  // The root node is the child of a branch that covers the entire tree.
+  ON_RTreeBranch root_branch;
+  root_branch.m_rect = NodeCover(m_root);
+  root_branch.m_child = m_root;
+
+  ON_RTreeNearestItem item;
+  item.m_distance = PointDistanceHelper(a_point, &root_branch.m_rect);
+  item.m_branch[0] = &root_branch;
+  item.m_branch[1] = nullptr;
+  item.m_level[0] = m_root->m_level + 1;
+  item.m_level[1] = 0;
+  item.m_bExact = false;
+  if ( !(item.m_distance <= maximum_distance) )
+    return 0;
+
+  ON_RTreeNearestQueue queue;
+  queue.Push(item);
+
+  int found_count = 0;
+  while ( found_count < neighbor_count && !queue.IsEmpty() )
+  {
+    item = queue.Pop();
+
+    if ( item.m_bExact )
+    {
+      // Nothing left in the queue is nearer.
+      ON_RTreeNearestElement& e = a_result.AppendNew();
+      e.m_id = item.m_branch[0]->m_id;
+      e.m_distance = item.m_distance;
+      found_count++;
+      continue;
+    }
+
+    if ( 0 == item.m_level[0] )
+    {
+      // Replace the bounding box distance with the element distance.
+      const double d = distanceCallback(a_context, a_point, item.m_branch[0]->m_id);
+      if ( d < ON_DBL_MAX && d <= maximum_distance )
+      {
+        item.m_distance = d;
+        item.m_bExact = true;
+        queue.Push(item);
+      }
+      continue;
+    }
+
+    const ON_RTreeNode* node = item.m_branch[0]->m_child;
+    item.m_level[0] = node->m_level;
+    item.m_bExact = (0 == node->m_level && nullptr == distanceCallback);
+    for ( int i = 0; i < node->m_count; i++ )
+    {
+      item.m_distance = PointDistanceHelper(a_point, &node->m_branch[i].m_rect);
+      if ( item.m_distance <= maximum_distance )
+      {
+        item.m_branch[0] = &node->m_branch[i];
+        queue.Push(item);
+      }
+    }
+  }
+
+  return found_count;
+}
+
+int ON_RTree::SearchNearestPairs(
+  const ON_RTree& a_rtreeA,
+  const ON_RTree& a_rtreeB,
+  int pair_count,
+  double maximum_distance,
+  double ON_CALLBACK_CDECL distanceCallback(void* a_context, ON__INT_PTR a_idA, ON__INT_PTR a_idB),
+  void* a_context,
+  ON_SimpleArray<ON_RTreeNearestPair>& a_result
+  )
+{
+  if ( pair_count <= 0 || !(maximum_distance >= 0.0) )
+    return 0;
+  if ( nullptr == a_rtreeA.m_root || a_rtreeA.m_root->m_count <= 0 )
+    return 0;
+  if ( nullptr == a_rtreeB.m_root || a_rtreeB.m_root->m_count <= 0 )
+    return 0;
+
+  ON_RTreeBranch root_branch[2];
+  root_branch[0].m_rect = NodeCover(a_rtreeA.m_root);
+  root_branch[0].m_child = a_rtreeA.m_root;
+  root_branch[1].m_rect = NodeCover(a_rtreeB.m_root);
+  root_branch[1].m_child = a_rtreeB.m_root;
+
+  ON_RTreeNearestItem item;
+  item.m_distance = RectDistanceHelper(&root_branch[0].m_rect, &root_branch[1].m_rect);
+  item.m_branch[0] = &root_branch[0];
+  item.m_branch[1] = &root_branch[1];
+  item.m_level[0] = a_rtreeA.m_root->m_level + 1;
+  item.m_level[1] = a_rtreeB.m_root->m_level + 1;
+  item.m_bExact = false;
+  if ( !(item.m_distance <= maximum_distance) )
+    return 0;
+
+  ON_RTreeNearestQueue queue;
+  queue.Push(item);
+
+  int found_count = 0;
+  while ( found_count < pair_count && !queue.IsEmpty() )
+  {
+    item = queue.Pop();
+
+    if ( item.m_bExact )
+    {
+      ON_RTreeNearestPair& p = a_result.AppendNew();
+      p.m_idA = item.m_branch[0]->m_id;
+      p.m_idB = item.m_branch[1]->m_id;
+      p.m_distance = item.m_distance;
+      found_count++;
+      continue;
+    }
+
+    if ( 0 == item.m_level[0] && 0 == item.m_level[1] )
+    {
+      const double d = distanceCallback(a_context, item.m_branch[0]->m_id, item.m_branch[1]->m_id);
+      if ( d < ON_DBL_MAX && d <= maximum_distance )
+      {
+        item.m_distance = d;
+        item.m_bExact = true;
+        queue.Push(item);
+      }
+      continue;
+    }
+
+    // Expand the side that is higher in its tree.
+    const int side = (item.m_level[0] >= item.m_level[1]) ? 0 : 1;
+    const ON_RTreeBranch* other = item.m_branch[1 - side];
+    const ON_RTreeNode* node = item.m_branch[side]->m_child;
+    item.m_level[side] = node->m_level;
+    item.m_bExact = (0 == item.m_level[0] && 0 == item.m_level[1] && nullptr == distanceCallback);
+    for ( int i = 0; i < node->m_count; i++ )
+    {
+      item.m_distance = RectDistanceHelper(&node->m_branch[i].m_rect, &other->m_rect);
+      if ( item.m_distance <= maximum_distance )
+      {
+        item.m_branch[side] = &node->m_branch[i];
+        queue.Push(item);
+      }
+    }
+  }
+
+  return found_count;
+}
+
 int ON_RTree::ElementCount()
 {
   int count = 0;
@@ -119,6 +119,21 @@ struct ON_RTreeLeaf
   ON__INT_PTR m_id;
 };
 
+// Result of ON_RTree::SearchNearest()
+struct ON_RTreeNearestElement
+{
+  ON__INT_PTR m_id;
+  double m_distance;
+};
+
+// Result of ON_RTree::SearchNearestPairs()
+struct ON_RTreeNearestPair
+{
+  ON__INT_PTR m_idA;
+  ON__INT_PTR m_idB;
+  double m_distance;
+};
+
 // The ON_RTreeNode is used at root, branch and leaf nodes.
 // When m_level > 0, the node is a branch.
 // When m_level = 0, the node is a leaf.
@@ -396,6 +411,36 @@ public:
     True if successful.
   */
   bool CreateMeshFaceTree( const class ON_Mesh* mesh );
+
+  /*
+  Description:
+    Create an R-tree from a set of elements in a single pass.
+    The elements are sorted along a Hilbert curve through the centers
+    of their bounding boxes and packed into full nodes. This is much
+    faster than calling Insert() for each element, and the tree has
+    fewer nodes with less overlap, so searches visit fewer nodes.
+  Parameters:
+    element_count - [in]
+      number of elements
+    element_boxes - [in]
+      element_boxes[i] is the 3d bounding box of the i-th element.
+      Each box must satisfy m_min[j] <= m_max[j].
+    element_ids - [in]
+      element_ids[i] is the id of the i-th element. If element_ids
+      is nullptr, then the id of the i-th element is i.
+  Returns:
+    True if successful.
+  Remarks:
+    Any elements in the tree are removed first. Insert() and Remove()
+    can be used to modify the tree after it is created. Large sets of
+    elements are sorted on multiple threads unless OPENNURBS_NO_STD_THREAD
+    is defined.
+  */
+  bool CreatePackedTree(
+    size_t element_count,
+    const ON_RTreeBBox* element_boxes,
+    const ON__INT_PTR* element_ids
+    );
   
   /*
   Description:
@@ -791,6 +836,81 @@ public:
     void* a_context
     ) const;
 
+  /*
+  Description:
+    Find the elements nearest to a point. Nodes are visited in order
+    of the distance from the point to their bounding boxes, so only
+    the nodes that can contain one of the nearest elements are visited.
+  Parameters:
+    a_point - [in]
+    neighbor_count - [in]
+      Maximum number of elements to find.
+    maximum_distance - [in]
+      Elements farther from a_point than maximum_distance are ignored.
+      Pass ON_DBL_MAX to find the nearest elements at any distance.
+    distanceCallback - [in]
+      If distanceCallback is nullptr, the distance to an element is
+      the distance to its bounding box. Otherwise distanceCallback()
+      returns the exact distance from a_point to the element a_id.
+      It must be >= the distance to the element's bounding box.
+      Return ON_DBL_MAX to ignore the element. distanceCallback() is
+      only called for elements whose bounding box is closer than the
+      elements already found.
+    a_context - [in]
+      pointer passed to the distanceCallback() function.
+    a_result - [out]
+      The nearest elements are appended in order of increasing distance.
+  Returns:
+    Number of elements appended to a_result[].
+  */
+  int SearchNearest(
+    const double a_point[3],
+    int neighbor_count,
+    double maximum_distance,
+    double ON_CALLBACK_CDECL distanceCallback(void* a_context, const double a_point[3], ON__INT_PTR a_id),
+    void* a_context,
+    ON_SimpleArray<ON_RTreeNearestElement>& a_result
+    ) const;
+
+  /*
+  Description:
+    Find the pairs of elements, one from each R-tree, that are nearest
+    to each other. Pairs of nodes are visited in order of the distance
+    between their bounding boxes.
+  Parameters:
+    a_rtreeA - [in]
+    a_rtreeB - [in]
+    pair_count - [in]
+      Maximum number of pairs to find.
+    maximum_distance - [in]
+      Pairs farther apart than maximum_distance are ignored.
+      Pass ON_DBL_MAX to find the nearest pairs at any distance.
+    distanceCallback - [in]
+      If distanceCallback is nullptr, the distance between two elements
+      is the distance between their bounding boxes. Otherwise
+      distanceCallback() returns the exact distance between the element
+      a_idA in a_rtreeA and the element a_idB in a_rtreeB. It must be
+      >= the distance between the bounding boxes. Return ON_DBL_MAX to
+      ignore the pair.
+    a_context - [in]
+      pointer passed to the distanceCallback() function.
+    a_result - [out]
+      The nearest pairs are appended in order of increasing distance.
+  Returns:
+    Number of pairs appended to a_result[].
+  Remarks:
+    Use pair_count = 1 to find the closest points between two objects.
+  */
+  static int SearchNearestPairs(
+    const ON_RTree& a_rtreeA,
+    const ON_RTree& a_rtreeB,
+    int pair_count,
+    double maximum_distance,
+    double ON_CALLBACK_CDECL distanceCallback(void* a_context, ON__INT_PTR a_idA, ON__INT_PTR a_idB),
+    void* a_context,
+    ON_SimpleArray<ON_RTreeNearestPair>& a_result
+    );
+
   /*
   Returns:
     Number of elements (leaves).
@@ -22,6 +22,21 @@
 #error ON_COMPILING_OPENNURBS must be defined when compiling opennurbs
 #endif
 
+#if defined(ON_64BIT_RUNTIME) && (defined(__x86_64__) || defined(_M_X64)) && (defined(ON_COMPILER_MSC) || defined(ON_COMPILER_GNU) || defined(ON_COMPILER_CLANG))
+// The SHA extensions are used to transform blocks when the cpu supports
+// them. Support is tested at runtime. SSE2 is part of every x64 cpu and
+// is used to hash independent buffers in four parallel lanes.
+#define ON_SHA1_X64
+#if defined(ON_COMPILER_MSC)
+#include <intrin.h>
+#define ON_SHA1_SHANI_TARGET
+#else
+#include <cpuid.h>
+#include <immintrin.h>
+#define ON_SHA1_SHANI_TARGET __attribute__((target("sha,sse4.1,ssse3")))
+#endif
+#endif
+
 ON_SHA1_Hash::ON_SHA1_Hash()
 {
   ON__UINT32* p = (ON__UINT32*)m_digest;
@@ -462,6 +477,454 @@ static void SHA1_transform(ON__UINT32 state[5], const ON__UINT8 block[64])
 	state[4] += e;
 }
 
+#if defined(ON_SHA1_X64)
+
+static bool Internal_CPUHasSHA()
+{
+  // CPUID leaf 7, EBX bit 29 = SHA extensions
+  // CPUID leaf 1, ECX bit 9 = SSSE3, ECX bit 19 = SSE4.1
+#if defined(ON_COMPILER_MSC)
+  int cpu_info[4] = { 0, 0, 0, 0 };
+  __cpuid(cpu_info, 0);
+  if (cpu_info[0] < 7)
+    return false;
+  __cpuid(cpu_info, 1);
+  if (0x80200 != (cpu_info[2] & 0x80200))
+    return false;
+  __cpuidex(cpu_info, 7, 0);
+  return 0 != (cpu_info[1] & 0x20000000);
+#else
+  unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+  if (__get_cpuid_max(0, nullptr) < 7)
+    return false;
+  if (0 == __get_cpuid(1, &eax, &ebx, &ecx, &edx))
+    return false;
+  if (0x80200 != (ecx & 0x80200))
+    return false;
+  __cpuid_count(7, 0, eax, ebx, ecx, edx);
+  return 0 != (ebx & 0x20000000);
+#endif
+}
+
+// SHA extension rounds 4*k to 4*k+3 for 3 <= k <= 16.
+// M0 holds the message words for these rounds and M1, M2, M3 hold
+// the partially scheduled words for the next three groups of rounds.
+#define ON_SHA1_SHANI_ROUNDS(Ea,Eb,M0,M1,M2,M3,f) \
+  Ea = _mm_sha1nexte_epu32(Ea, M0); Eb = abcd; \
+  M1 = _mm_sha1msg2_epu32(M1, M0); abcd = _mm_sha1rnds4_epu32(abcd, Ea, f); \
+  M3 = _mm_sha1msg1_epu32(M3, M0); M2 = _mm_xor_si128(M2, M0);
+
+/*
+Description:
+  SHA-1 transform of consecutive 64 byte blocks using the SHA extensions.
+*/
+ON_SHA1_SHANI_TARGET
+static void Internal_SHA1TransformSHA(
+  ON__UINT32 state[5],
+  const ON__UINT8* blocks,
+  size_t block_count
+  )
+{
+  const __m128i byte_swap = _mm_set_epi64x(0x0001020304050607LL, 0x08090a0b0c0d0e0fLL);
+
+  __m128i abcd = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)state), 0x1B);
+  __m128i e0 = _mm_set_epi32((int)state[4], 0, 0, 0);
+  __m128i e1;
+  __m128i m0, m1, m2, m3;
+
+  for (/*empty init*/; block_count > 0; block_count--, blocks += 64)
+  {
+    const __m128i abcd_save = abcd;
+    const __m128i e0_save = e0;
+
+    // rounds 0-3
+    m0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(blocks + 0)), byte_swap);
+    e0 = _mm_add_epi32(e0, m0);
+    e1 = abcd;
+    abcd = _mm_sha1rnds4_epu32(abcd, e0, 0);
+
+    // rounds 4-7
+    m1 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(blocks + 16)), byte_swap);
+    e1 = _mm_sha1nexte_epu32(e1, m1);
+    e0 = abcd;
+    abcd = _mm_sha1rnds4_epu32(abcd, e1, 0);
+    m0 = _mm_sha1msg1_epu32(m0, m1);
+
+    // rounds 8-11
+    m2 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(blocks + 32)), byte_swap);
+    e0 = _mm_sha1nexte_epu32(e0, m2);
+    e1 = abcd;
+    abcd = _mm_sha1rnds4_epu32(abcd, e0, 0);
+    m1 = _mm_sha1msg1_epu32(m1, m2);
+    m0 = _mm_xor_si128(m0, m2);
+
+    // rounds 12-63
+    m3 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(blocks + 48)), byte_swap);
+    ON_SHA1_SHANI_ROUNDS(e1, e0, m3, m0, m1, m2, 0);
+    ON_SHA1_SHANI_ROUNDS(e0, e1, m0, m1, m2, m3, 0);
+    ON_SHA1_SHANI_ROUNDS(e1, e0, m1, m2, m3, m0, 1);
+    ON_SHA1_SHANI_ROUNDS(e0, e1, m2, m3, m0, m1, 1);
+    ON_SHA1_SHANI_ROUNDS(e1, e0, m3, m0, m1, m2, 1);
+    ON_SHA1_SHANI_ROUNDS(e0, e1, m0, m1, m2, m3, 1);
+    ON_SHA1_SHANI_ROUNDS(e1, e0, m1, m2, m3, m0, 1);
+    ON_SHA1_SHANI_ROUNDS(e0, e1, m2, m3, m0, m1, 2);
+    ON_SHA1_SHANI_ROUNDS(e1, e0, m3, m0, m1, m2, 2);
+    ON_SHA1_SHANI_ROUNDS(e0, e1, m0, m1, m2, m3, 2);
+    ON_SHA1_SHANI_ROUNDS(e1, e0, m1, m2, m3, m0, 2);
+    ON_SHA1_SHANI_ROUNDS(e0, e1, m2, m3, m0, m1, 2);
+    ON_SHA1_SHANI_ROUNDS(e1, e0, m3, m0, m1, m2, 3);
+
+    // rounds 64-67
+    ON_SHA1_SHANI_ROUNDS(e0, e1, m0, m1, m2, m3, 3);
+
+    // rounds 68-71
+    e1 = _mm_sha1nexte_epu32(e1, m1);
+    e0 = abcd;
+    m2 = _mm_sha1msg2_epu32(m2, m1);
+    abcd = _mm_sha1rnds4_epu32(abcd, e1, 3);
+    m3 = _mm_xor_si128(m3, m1);
+
+    // rounds 72-75
+    e0 = _mm_sha1nexte_epu32(e0, m2);
+    e1 = abcd;
+    m3 = _mm_sha1msg2_epu32(m3, m2);
+    abcd = _mm_sha1rnds4_epu32(abcd, e0, 3);
+
+    // rounds 76-79
+    e1 = _mm_sha1nexte_epu32(e1, m3);
+    e0 = abcd;
+    abcd = _mm_sha1rnds4_epu32(abcd, e1, 3);
+
+    // Add the working vars back into state
+    e0 = _mm_sha1nexte_epu32(e0, e0_save);
+    abcd = _mm_add_epi32(abcd, abcd_save);
+  }
+
+  _mm_storeu_si128((__m128i*)state, _mm_shuffle_epi32(abcd, 0x1B));
+  state[4] = (ON__UINT32)_mm_extract_epi32(e0, 3);
+}
+
+#undef ON_SHA1_SHANI_ROUNDS
+
+static bool Internal_SHA1UseSHA()
+{
+  static const bool bHasSHA = Internal_CPUHasSHA();
+  return bHasSHA;
+}
+
+#endif
+
+/*
+Description:
+  SHA-1 transform of consecutive 64 byte blocks.
+*/
+static void Internal_SHA1TransformBlocks(
+  ON__UINT32 state[5],
+  const ON__UINT8* blocks,
+  size_t block_count
+  )
+{
+#if defined(ON_SHA1_X64)
+  if (Internal_SHA1UseSHA())
+  {
+    Internal_SHA1TransformSHA(state, blocks, block_count);
+    return;
+  }
+#endif
+  for (/*empty init*/; block_count > 0; block_count--, blocks += 64)
+    SHA1_transform(state, blocks);
+}
+
+/*
+Description:
+  The blocks of one buffer being hashed by ON_SHA1_Hash::BufferContentHashes().
+  The whole blocks are read from the buffer and the last one or two blocks,
+  which hold the remaining bytes, the padding and the bit count, are copied
+  into m_tail.
+*/
+class ON_Internal_SHA1Message
+{
+public:
+  void Initialize(const void* buffer, size_t sizeof_buffer)
+  {
+    m_state[0] = 0x67452301;
+    m_state[1] = 0xEFCDAB89;
+    m_state[2] = 0x98BADCFE;
+    m_state[3] = 0x10325476;
+    m_state[4] = 0xC3D2E1F0;
+
+    if (nullptr == buffer)
+      sizeof_buffer = 0;
+    m_blocks = (const ON__UINT8*)buffer;
+    m_block_count = sizeof_buffer/64;
+
+    const size_t remainder = sizeof_buffer%64;
+    const size_t sizeof_tail = (remainder < 56) ? 64 : 128;
+    // The tail blocks always end at the end of m_tail.
+    ON__UINT8* tail = m_tail + sizeof(m_tail) - sizeof_tail;
+    if (remainder > 0)
+      memcpy(tail, m_blocks + 64*m_block_count, remainder);
+    tail[remainder] = 0x80U;
+    memset(tail + remainder + 1, 0, sizeof_tail - 8 - remainder - 1);
+    const ON__UINT64 bit_count = ((ON__UINT64)sizeof_buffer) << 3;
+    for (size_t i = 0; i < 8; i++)
+      tail[sizeof_tail - 1 - i] = (ON__UINT8)((bit_count >> (8*i)) & 0xFF);
+    m_tail_block_count = sizeof_tail/64;
+  }
+
+  bool IsDone() const
+  {
+    return 0 == m_block_count && 0 == m_tail_block_count;
+  }
+
+  const ON__UINT8* NextBlock()
+  {
+    const ON__UINT8* block;
+    if (m_block_count > 0)
+    {
+      block = m_blocks;
+      m_blocks += 64;
+      m_block_count--;
+    }
+    else
+    {
+      block = m_tail + sizeof(m_tail) - 64*m_tail_block_count;
+      m_tail_block_count--;
+    }
+    return block;
+  }
+
+  void Finish()
+  {
+    if (m_block_count > 0)
+    {
+      Internal_SHA1TransformBlocks(m_state, m_blocks, m_block_count);
+      m_blocks += 64*m_block_count;
+      m_block_count = 0;
+    }
+    if (m_tail_block_count > 0)
+    {
+      Internal_SHA1TransformBlocks(m_state, m_tail + sizeof(m_tail) - 64*m_tail_block_count, m_tail_block_count);
+      m_tail_block_count = 0;
+    }
+  }
+
+  void GetHash(ON_SHA1_Hash& hash) const
+  {
+    for (int i = 0; i < 20; ++i)
+      hash.m_digest[i] = static_cast<ON__UINT8>((m_state[i >> 2] >> ((3 - (i & 3)) * 8)) & 0xFF);
+  }
+
+  ON__UINT32 m_state[5];
+
+private:
+  const ON__UINT8* m_blocks;
+  size_t m_block_count;
+  size_t m_tail_block_count;
+  ON__UINT8 m_tail[128];
+};
+
+#if defined(ON_SHA1_X64)
+
+#define ON_SHA1_ROL4(x,n) _mm_or_si128(_mm_slli_epi32(x,n),_mm_srli_epi32(x,32-(n)))
+
+/*
+Description:
+  SHA-1 transform of one 64 byte block in each of four independent lanes
+  using SSE2.
+Parameters:
+  state - [in/out]
+    state[i] holds word i of the state of the four lanes.
+  blocks - [in]
+    blocks[lane] = 64 bytes to transform in lane.
+*/
+static void Internal_SHA1Transform4(
+  __m128i state[5],
+  const ON__UINT8* const blocks[4]
+  )
+{
+  const __m128i byte_mask = _mm_set1_epi32(0x00FF00FF);
+  __m128i w[16];
+  for (int i = 0; i < 16; i += 4)
+  {
+    // Load words i to i+3 of each lane and transpose so w[i+j] holds word i+j of the four lanes.
+    const __m128i r0 = _mm_loadu_si128((const __m128i*)(blocks[0] + 4*i));
+    const __m128i r1 = _mm_loadu_si128((const __m128i*)(blocks[1] + 4*i));
+    const __m128i r2 = _mm_loadu_si128((const __m128i*)(blocks[2] + 4*i));
+    const __m128i r3 = _mm_loadu_si128((const __m128i*)(blocks[3] + 4*i));
+    const __m128i t0 = _mm_unpacklo_epi32(r0, r1);
+    const __m128i t1 = _mm_unpacklo_epi32(r2, r3);
+    const __m128i t2 = _mm_unpackhi_epi32(r0, r1);
+    const __m128i t3 = _mm_unpackhi_epi32(r2, r3);
+    w[i] = _mm_unpacklo_epi64(t0, t1);
+    w[i + 1] = _mm_unpackhi_epi64(t0, t1);
+    w[i + 2] = _mm_unpacklo_epi64(t2, t3);
+    w[i + 3] = _mm_unpackhi_epi64(t2, t3);
+    for (int j = i; j < i + 4; j++)
+    {
+      // big endian words
+      const __m128i x = _mm_or_si128(_mm_slli_epi32(w[j], 16), _mm_srli_epi32(w[j], 16));
+      w[j] = _mm_or_si128(_mm_slli_epi32(_mm_and_si128(x, byte_mask), 8), _mm_and_si128(_mm_srli_epi32(x, 8), byte_mask));
+    }
+  }
+
+  __m128i a = state[0], b = state[1], c = state[2], d = state[3], e = state[4];
+  __m128i f, t;
+  int i = 0;
+
+#define ON_SHA1_W4(i) ((i) < 16 ? w[i] : (w[(i)&15] = ON_SHA1_ROL4(_mm_xor_si128(_mm_xor_si128(w[((i)+13)&15], w[((i)+8)&15]), _mm_xor_si128(w[((i)+2)&15], w[(i)&15])), 1)))
+#define ON_SHA1_ROUND4(k) \
+    t = _mm_add_epi32(_mm_add_epi32(ON_SHA1_ROL4(a, 5), f), _mm_add_epi32(_mm_add_epi32(e, k), ON_SHA1_W4(i))); \
+    e = d; d = c; c = ON_SHA1_ROL4(b, 30); b = a; a = t;
+
+  const __m128i k0 = _mm_set1_epi32(0x5A827999);
+  for (/*empty init*/; i < 20; i++)
+  {
+    f = _mm_xor_si128(_mm_and_si128(b, _mm_xor_si128(c, d)), d);
+    ON_SHA1_ROUND4(k0);
+  }
+  const __m128i k1 = _mm_set1_epi32(0x6ED9EBA1);
+  for (/*empty init*/; i < 40; i++)
+  {
+    f = _mm_xor_si128(_mm_xor_si128(b, c), d);
+    ON_SHA1_ROUND4(k1);
+  }
+  const __m128i k2 = _mm_set1_epi32((int)0x8F1BBCDC);
+  for (/*empty init*/; i < 60; i++)
+  {
+    f = _mm_or_si128(_mm_and_si128(_mm_or_si128(b, c), d), _mm_and_si128(b, c));
+    ON_SHA1_ROUND4(k2);
+  }
+  const __m128i k3 = _mm_set1_epi32((int)0xCA62C1D6);
+  for (/*empty init*/; i < 80; i++)
+  {
+    f = _mm_xor_si128(_mm_xor_si128(b, c), d);
+    ON_SHA1_ROUND4(k3);
+  }
+
+#undef ON_SHA1_ROUND4
+#undef ON_SHA1_W4
+
+  state[0] = _mm_add_epi32(state[0], a);
+  state[1] = _mm_add_epi32(state[1], b);
+  state[2] = _mm_add_epi32(state[2], c);
+  state[3] = _mm_add_epi32(state[3], d);
+  state[4] = _mm_add_epi32(state[4], e);
+}
+
+#undef ON_SHA1_ROL4
+
+/*
+Description:
+  Hashes the messages in four SSE2 lanes. A lane is refilled with the
+  next message as soon as its message is done, so messages with
+  different lengths keep the lanes busy. When a single message is left,
+  it is finished with the single lane transform.
+*/
+static void Internal_SHA1HashMessages4(
+  size_t count,
+  const void* const* buffers,
+  const size_t* sizeof_buffers,
+  ON_SHA1_Hash* hashes
+  )
+{
+  static const ON__UINT8 idle_block[64] = { 0 };
+
+  ON_Internal_SHA1Message messages[4];
+  size_t message_index[4];
+  bool bActive[4] = { false, false, false, false };
+  ON__UINT32 lane_state[5][4];
+  memset(lane_state, 0, sizeof(lane_state));
+  size_t next_index = 0;
+
+  for (;;)
+  {
+    int active_count = 0;
+    for (int lane = 0; lane < 4; lane++)
+    {
+      if (false == bActive[lane] && next_index < count)
+      {
+        messages[lane].Initialize(buffers[next_index], sizeof_buffers[next_index]);
+        message_index[lane] = next_index++;
+        for (int i = 0; i < 5; i++)
+          lane_state[i][lane] = messages[lane].m_state[i];
+        bActive[lane] = true;
+      }
+      if (bActive[lane])
+        active_count++;
+    }
+    if (0 == active_count)
+      break;
+
+    if (1 == active_count)
+    {
+      for (int lane = 0; lane < 4; lane++)
+      {
+        if (false == bActive[lane])
+          continue;
+        for (int i = 0; i < 5; i++)
+          messages[lane].m_state[i] = lane_state[i][lane];
+        messages[lane].Finish();
+        messages[lane].GetHash(hashes[message_index[lane]]);
+        bActive[lane] = false;
+      }
+      continue;
+    }
+
+    const ON__UINT8* blocks[4];
+    for (int lane = 0; lane < 4; lane++)
+      blocks[lane] = bActive[lane] ? messages[lane].NextBlock() : idle_block;
+
+    __m128i state[5];
+    for (int i = 0; i < 5; i++)
+      state[i] = _mm_loadu_si128((const __m128i*)lane_state[i]);
+    Internal_SHA1Transform4(state, blocks);
+    for (int i = 0; i < 5; i++)
+      _mm_storeu_si128((__m128i*)lane_state[i], state[i]);
+
+    for (int lane = 0; lane < 4; lane++)
+    {
+      if (bActive[lane] && messages[lane].IsDone())
+      {
+        for (int i = 0; i < 5; i++)
+          messages[lane].m_state[i] = lane_state[i][lane];
+        messages[lane].GetHash(hashes[message_index[lane]]);
+        bActive[lane] = false;
+      }
+    }
+  }
+}
+
+#endif
+
+void ON_SHA1_Hash::BufferContentHashes(
+  size_t count,
+  const void* const* buffers,
+  const size_t* sizeof_buffers,
+  ON_SHA1_Hash* hashes
+  )
+{
+  if (count <= 0 || nullptr == buffers || nullptr == sizeof_buffers || nullptr == hashes)
+    return;
+
+#if defined(ON_SHA1_X64)
+  // A single SHA extensions lane is faster than four SSE2 lanes.
+  if (count > 1 && false == Internal_SHA1UseSHA())
+  {
+    Internal_SHA1HashMessages4(count, buffers, sizeof_buffers, hashes);
+    return;
+  }
+#endif
+
+  ON_Internal_SHA1Message message;
+  for (size_t i = 0; i < count; i++)
+  {
+    message.Initialize(buffers[i], sizeof_buffers[i]);
+    message.Finish();
+    message.GetHash(hashes[i]);
+  }
+}
+
 void ON_SHA1::Internal_Accumulate(const ON__UINT8* input, ON__UINT32 length)
 {
 	ON__UINT32 j = ((m_bit_count[0] >> 3) & 0x3F);
@@ -476,10 +939,14 @@ void ON_SHA1::Internal_Accumulate(const ON__UINT8* input, ON__UINT32 length)
 	{
 		i = 64 - j;
 		memcpy(&m_buffer[j], input, i);
-		SHA1_transform(m_state, m_buffer);
+		Internal_SHA1TransformBlocks(m_state, m_buffer, 1);
 
-		for( ; (i + 63) < length; i += 64)
-			SHA1_transform(m_state, &input[i]);
+		const ON__UINT32 block_count = (length - i)/64;
+		if (block_count > 0)
+		{
+			Internal_SHA1TransformBlocks(m_state, &input[i], block_count);
+			i += 64*block_count;
+		}
 
 		j = 0;
 	}
@@ -501,14 +968,12 @@ void ON_SHA1::set_final_hash()
   for (i = 4; i < 8; ++i)
     pbFinalCount[i] = static_cast<ON__UINT8>((bit_count >> ((3 - (i & 3)) * 8)) & 0xFF); // Endian independent
 
-  //update((ON__UINT8*)"\200", 1);
-  const ON__UINT8 byte_80 = 0x80U;
-  Internal_Accumulate(&byte_80, 1);
-
-  const ON__UINT8 byte_00 = 0U;
-  while ((m_bit_count[0] & 504) != 448)
-    Internal_Accumulate(&byte_00, 1);
-    //Internal_Accumulate((ON__UINT8*)"\0", 1);
+  // 0x80 followed by enough zeros to leave 8 bytes in the last block.
+  ON__UINT8 padding[64];
+  padding[0] = 0x80U;
+  memset(padding + 1, 0, sizeof(padding) - 1);
+  const ON__UINT32 j = ((m_bit_count[0] >> 3) & 0x3F);
+  Internal_Accumulate(padding, (j < 56) ? (56 - j) : (120 - j));
 
   Internal_Accumulate(pbFinalCount, 8); // Cause a transform()
 
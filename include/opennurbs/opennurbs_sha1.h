@@ -47,6 +47,31 @@ public:
     size_t sizeof_buffer
     );
 
+  /*
+  Description:
+    Calculates the SHA-1 hashes of many independent buffers.
+  Parameters:
+    count - [in]
+      number of buffers
+    buffers - [in]
+      buffers[i] = i-th buffer
+    sizeof_buffers - [in]
+      sizeof_buffers[i] = number of bytes in buffers[i]
+    hashes - [out]
+      hashes[i] = SHA-1 hash of buffers[i].
+      The values are identical to ON_SHA1_Hash::BufferContentHash(buffers[i],sizeof_buffers[i]).
+  Remarks:
+    This is faster than calling BufferContentHash() for each buffer when the
+    buffers are short, like component names. When the cpu does not have the SHA
+    extensions, the buffers are hashed in parallel SIMD lanes.
+  */
+  static void BufferContentHashes(
+    size_t count,
+    const void* const* buffers,
+    const size_t* sizeof_buffers,
+    ON_SHA1_Hash* hashes
+    );
+
   /*
   Parameters:
     file_name - [in]
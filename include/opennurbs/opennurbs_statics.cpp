@@ -762,6 +762,12 @@ const ON_3dmAnnotationContext ON_3dmAnnotationContext::Default ON_CLANG_CONSTRUC
 
 const ON_3dmArchiveTableStatus ON_3dmArchiveTableStatus::Unset ON_CLANG_CONSTRUCTOR_BUG_INIT(ON_3dmArchiveTableStatus);
 
+const ON_3dmArchiveTableOfContentsItem ON_3dmArchiveTableOfContentsItem::Unset ON_CLANG_CONSTRUCTOR_BUG_INIT(ON_3dmArchiveTableOfContentsItem);
+
+// {B58B7338-58A6-42A7-906C-DE11181C303A}
+const ON_UUID ON_3dmArchiveTableOfContents::UserTableId =
+{ 0xB58B7338,0x58A6,0x42A7,{ 0x90,0x6C,0xDE,0x11,0x18,0x1C,0x30,0x3A } };
+
 const wchar_t* ON_TextDot::DefaultFontFace = L"Arial";
 const int ON_TextDot::DefaultHeightInPoints = 14;
 const int ON_TextDot::MinimumHeightInPoints = 3;
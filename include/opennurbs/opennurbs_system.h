@@ -608,6 +608,7 @@ typedef ON__UINT32 wchar_t;
 #pragma ON_PRAGMA_WARNING_BEFORE_DIRTY_INCLUDE
 #if !defined(OPENNURBS_NO_STD_MUTEX)
 #include <mutex>  // for std:mutex
+#include <condition_variable>  // for std:condition_variable
 #endif
 #pragma ON_PRAGMA_WARNING_AFTER_DIRTY_INCLUDE
 
@@ -86,6 +86,24 @@ class ON_CompressorImplementation& ON_BinaryArchive::Compressor()
   return *m_compressor;
 }
 
+static int Internal_ZlibLevel(ON_BinaryArchive::BufferCompressionLevel level)
+{
+  switch (level)
+  {
+  case ON_BinaryArchive::BufferCompressionLevel::Fast:
+    return Z_BEST_SPEED;
+  case ON_BinaryArchive::BufferCompressionLevel::Default:
+    return Z_DEFAULT_COMPRESSION;
+  default:
+    break;
+  }
+  return Z_BEST_COMPRESSION;
+}
+
+// uncompressed size of a BlockDeflate block and number of blocks in a group
+#define ON_BlockDeflate_block_size 0x40000
+#define ON_BlockDeflate_group_size 64
+
 
 bool ON_BinaryArchive::WriteCompressedBuffer(
         size_t sizeof__inbuffer,  // sizeof uncompressed input data
@@ -109,16 +127,29 @@ bool ON_BinaryArchive::WriteCompressedBuffer(
     return true;
 
   // 32 bit crc of uncompressed data
-  const unsigned int buffer_crc = ON_CRC32( 0, sizeof__inbuffer, inbuffer );
+  unsigned int buffer_crc;
+  {
+    const ProfileTask profile_task(*this, ON_BinaryArchiveProfile::Task::CRC);
+    buffer_crc = ON_CRC32( 0, sizeof__inbuffer, inbuffer );
+  }
   if (!WriteInt(buffer_crc))
     return false;
 
+  // method 0 = uncompressed, 1 = zlib deflate, 2 = FastLZ, 3 = zlib deflate in blocks
   unsigned char method
     = (m_bUseBufferCompression && sizeof__inbuffer > 128)
     ? 1
     : 0;
 
-  if ( method ) {
+  if (1 == method && Archive3dmVersion() >= ON_BinaryArchive::CurrentArchiveVersion())
+  {
+    if (ON_BinaryArchive::BufferCompressionCodec::FastLZ == m_buffer_compression_codec)
+      method = 2;
+    else if (ON_BinaryArchive::BufferCompressionCodec::BlockDeflate == m_buffer_compression_codec && sizeof__inbuffer > ON_BlockDeflate_block_size)
+      method = 3;
+  }
+
+  if ( 1 == method ) {
     if ( !CompressionInit() ) {
       CompressionEnd();
       method = 0;
@@ -127,6 +158,7 @@ bool ON_BinaryArchive::WriteCompressedBuffer(
   if ( !WriteChar(method) )
     return false;
 
+  const ProfileTask profile_task(*this, ON_BinaryArchiveProfile::Task::Deflate);
   switch ( method )
   {
   case 0: // uncompressed
@@ -142,6 +174,16 @@ bool ON_BinaryArchive::WriteCompressedBuffer(
     rc = ( compressed_size > 0 ) ? true : false;
     CompressionEnd();
     break;
+
+  case 2: // FastLZ
+    compressed_size = WriteFastLZ( sizeof__inbuffer, inbuffer );
+    rc = ( compressed_size > 0 ) ? true : false;
+    break;
+
+  case 3: // compressed blocks
+    compressed_size = WriteBlockDeflate( sizeof__inbuffer, inbuffer );
+    rc = ( compressed_size > 0 ) ? true : false;
+    break;
   }
 
 
@@ -179,25 +221,37 @@ bool ON_BinaryArchive::ReadCompressedBuffer( // read and uncompress
   if ( !ReadChar(&method) )
     return false;
 
-  if ( method != 0 && method != 1 )
+  if ( method < 0 || method > 3 )
     return false;
 
-  switch(method)
   {
-  case 0: // uncompressed
-    rc = ReadByte(sizeof__outbuffer, outbuffer);
-    break;
-  case 1: // compressed
-    rc = CompressionInit();
-    if (rc)
-      rc = ReadInflate( sizeof__outbuffer, outbuffer );
-    CompressionEnd();
-    break;
+    const ProfileTask profile_task(*this, ON_BinaryArchiveProfile::Task::Inflate);
+    switch(method)
+    {
+    case 0: // uncompressed
+      rc = ReadByte(sizeof__outbuffer, outbuffer);
+      break;
+    case 1: // compressed
+      rc = CompressionInit();
+      if (rc)
+        rc = ReadInflate( sizeof__outbuffer, outbuffer );
+      CompressionEnd();
+      break;
+    case 2: // FastLZ
+      rc = ReadFastLZ( sizeof__outbuffer, outbuffer );
+      break;
+    case 3: // compressed blocks
+      rc = ReadBlockDeflate( sizeof__outbuffer, outbuffer );
+      break;
+    }
   }
 
   if (rc ) 
   {
-    buffer_crc1 = ON_CRC32( 0, sizeof__outbuffer, outbuffer );
+    {
+      const ProfileTask profile_task(*this, ON_BinaryArchiveProfile::Task::CRC);
+      buffer_crc1 = ON_CRC32( 0, sizeof__outbuffer, outbuffer );
+    }
     if ( buffer_crc1 != buffer_crc0 ) 
     {
       ON_ERROR("ON_BinaryArchive::ReadCompressedBuffer() crc error");
@@ -598,6 +652,733 @@ bool ON_BinaryArchive::ReadInflate(
   return rc;
 }
 
+/*
+FastLZ is a byte oriented LZ77 codec in the spirit of LZ4. Input is compressed in
+blocks of at most ON_FastLZ_block_size bytes and every block is a sequence of
+
+  token: high 4 bits = literal count, low 4 bits = match length - 4
+         (a value of 15 continues with bytes that are added up to the first byte < 255)
+  literal bytes
+  2 byte little endian match offset (1 to 65535 bytes back in the block)
+
+The last sequence of a block ends after its literals. Blocks that do not shrink are
+stored. Compressed output only depends on the input, so files are reproducible.
+*/
+#define ON_FastLZ_block_size 0x100000
+#define ON_FastLZ_hash_bits 14
+#define ON_FastLZ_min_match 4
+#define ON_FastLZ_max_offset 0xFFFF
+// No match starts in the last ON_FastLZ_end_literals bytes of a block.
+#define ON_FastLZ_end_literals 12
+
+static ON__UINT32 Internal_FastLZRead32(const unsigned char* p)
+{
+  ON__UINT32 u;
+  memcpy(&u, p, sizeof(u));
+  return u;
+}
+
+static unsigned char* Internal_FastLZWriteLength(unsigned char* op, size_t length)
+{
+  // length >= 15 was already counted in the token
+  for (length -= 15; length >= 255; length -= 255)
+    *op++ = 255;
+  *op++ = (unsigned char)length;
+  return op;
+}
+
+static size_t Internal_FastLZBound(size_t sizeof_in)
+{
+  return sizeof_in + sizeof_in / 255 + 16;
+}
+
+/*
+Returns:
+  Number of bytes written to out[], or 0 if the block does not fit in capacity bytes.
+*/
+static size_t Internal_FastLZCompressBlock(
+  const unsigned char* in,
+  size_t sizeof_in,
+  unsigned char* out,
+  size_t capacity,
+  ON__UINT32* hash_table // 1 << ON_FastLZ_hash_bits entries
+)
+{
+  memset(hash_table, 0, sizeof(hash_table[0]) << ON_FastLZ_hash_bits);
+
+  unsigned char* op = out;
+  unsigned char* const op_end = out + capacity;
+  size_t anchor = 0;
+  size_t ip = 1; // position 0 is in every hash table slot
+
+  if (sizeof_in > ON_FastLZ_end_literals)
+  {
+    const size_t match_limit = sizeof_in - ON_FastLZ_end_literals;
+    while (ip < match_limit)
+    {
+      const ON__UINT32 sequence = Internal_FastLZRead32(in + ip);
+      const ON__UINT32 h = (sequence * 2654435761U) >> (32 - ON_FastLZ_hash_bits);
+      const size_t ref = hash_table[h];
+      hash_table[h] = (ON__UINT32)ip;
+      if (ip - ref > ON_FastLZ_max_offset || sequence != Internal_FastLZRead32(in + ref))
+      {
+        // skip faster through data that does not compress
+        ip += 1 + ((ip - anchor) >> 6);
+        continue;
+      }
+
+      size_t match_length = ON_FastLZ_min_match;
+      const size_t max_length = sizeof_in - 5 - ip;
+      while (match_length + 8 <= max_length && 0 == memcmp(in + ref + match_length, in + ip + match_length, 8))
+        match_length += 8;
+      while (match_length < max_length && in[ref + match_length] == in[ip + match_length])
+        match_length++;
+
+      const size_t literal_count = ip - anchor;
+      if ((size_t)(op_end - op) < 1 + literal_count + literal_count / 255 + 2 + match_length / 255 + 2)
+        return 0;
+      unsigned char* token = op++;
+      *token = (unsigned char)(((literal_count < 15) ? literal_count : 15) << 4);
+      if (literal_count >= 15)
+        op = Internal_FastLZWriteLength(op, literal_count);
+      memcpy(op, in + anchor, literal_count);
+      op += literal_count;
+      const size_t offset = ip - ref;
+      *op++ = (unsigned char)(offset & 0xFF);
+      *op++ = (unsigned char)(offset >> 8);
+      const size_t length_code = match_length - ON_FastLZ_min_match;
+      *token |= (unsigned char)((length_code < 15) ? length_code : 15);
+      if (length_code >= 15)
+        op = Internal_FastLZWriteLength(op, length_code);
+
+      ip += match_length;
+      anchor = ip;
+    }
+  }
+
+  // last literals
+  const size_t literal_count = sizeof_in - anchor;
+  if ((size_t)(op_end - op) < 1 + literal_count + literal_count / 255 + 1)
+    return 0;
+  *op = (unsigned char)(((literal_count < 15) ? literal_count : 15) << 4);
+  op++;
+  if (literal_count >= 15)
+    op = Internal_FastLZWriteLength(op, literal_count);
+  memcpy(op, in + anchor, literal_count);
+  op += literal_count;
+
+  return (size_t)(op - out);
+}
+
+static bool Internal_FastLZReadLength(const unsigned char*& ip, const unsigned char* ip_end, size_t& length)
+{
+  unsigned int b;
+  do
+  {
+    if (ip >= ip_end)
+      return false;
+    b = *ip++;
+    length += b;
+  } while (255 == b);
+  return true;
+}
+
+/*
+Returns:
+  True if in[] decodes to exactly sizeof_out bytes.
+*/
+static bool Internal_FastLZDecompressBlock(
+  const unsigned char* in,
+  size_t sizeof_in,
+  unsigned char* out,
+  size_t sizeof_out
+)
+{
+  const unsigned char* ip = in;
+  const unsigned char* const ip_end = in + sizeof_in;
+  unsigned char* op = out;
+  unsigned char* const op_end = out + sizeof_out;
+
+  while (ip < ip_end)
+  {
+    const unsigned int token = *ip++;
+
+    size_t literal_count = token >> 4;
+    if (15 == literal_count && !Internal_FastLZReadLength(ip, ip_end, literal_count))
+      return false;
+    if (literal_count > (size_t)(ip_end - ip) || literal_count > (size_t)(op_end - op))
+      return false;
+    memcpy(op, ip, literal_count);
+    ip += literal_count;
+    op += literal_count;
+
+    if (ip == ip_end)
+      break; // last sequence
+
+    if (ip_end - ip < 2)
+      return false;
+    const size_t offset = (size_t)ip[0] | ((size_t)ip[1] << 8);
+    ip += 2;
+    if (0 == offset || offset > (size_t)(op - out))
+      return false;
+
+    size_t match_length = token & 15;
+    if (15 == match_length && !Internal_FastLZReadLength(ip, ip_end, match_length))
+      return false;
+    match_length += ON_FastLZ_min_match;
+    if (match_length > (size_t)(op_end - op))
+      return false;
+
+    const unsigned char* match = op - offset;
+    if (offset >= match_length)
+    {
+      memcpy(op, match, match_length);
+      op += match_length;
+    }
+    else
+    {
+      // The match overlaps its own output and repeats the last offset bytes.
+      // Every copy doubles the length of the repeated pattern.
+      unsigned char* const match_end = op + match_length;
+      while (op < match_end)
+      {
+        const size_t count = ((size_t)(op - match) < (size_t)(match_end - op)) ? (size_t)(op - match) : (size_t)(match_end - op);
+        memcpy(op, match, count);
+        op += count;
+      }
+    }
+  }
+
+  return (op == op_end);
+}
+
+size_t ON_BinaryArchive::WriteFastLZ( // returns number of bytes written
+        size_t sizeof___inbuffer,  // sizeof uncompressed input data ( > 0 )
+        const void* in___buffer     // uncompressed input data ( != nullptr )
+        )
+{
+  // Every block is written as a 4 byte header followed by its bytes. The header is the
+  // compressed size, or 0x80000000 | block size when the block is stored.
+  const size_t capacity = Internal_FastLZBound(ON_FastLZ_block_size);
+  ON__UINT32* hash_table = (ON__UINT32*)onmalloc((sizeof(ON__UINT32) << ON_FastLZ_hash_bits) + capacity);
+  if (nullptr == hash_table)
+    return 0;
+  unsigned char* scratch = (unsigned char*)(hash_table + ((size_t)1 << ON_FastLZ_hash_bits));
+
+  //  Compressed information is saved in a chunk.
+  bool rc = BeginWrite3dmChunk(TCODE_ANONYMOUS_CHUNK,0);
+  size_t out__count = 0;
+
+  const unsigned char* in = (const unsigned char*)in___buffer;
+  for (size_t offset = 0; rc && offset < sizeof___inbuffer; offset += ON_FastLZ_block_size)
+  {
+    const size_t block_size
+      = (sizeof___inbuffer - offset < ON_FastLZ_block_size)
+      ? (sizeof___inbuffer - offset)
+      : ON_FastLZ_block_size;
+    size_t compressed_size = Internal_FastLZCompressBlock(in + offset, block_size, scratch, capacity, hash_table);
+    if (compressed_size > 0 && compressed_size < block_size)
+    {
+      rc = WriteInt((ON__UINT32)compressed_size) && WriteByte(compressed_size, scratch);
+    }
+    else
+    {
+      compressed_size = block_size;
+      rc = WriteInt(0x80000000U | (ON__UINT32)block_size) && WriteByte(block_size, in + offset);
+    }
+    out__count += sizeof(ON__UINT32) + compressed_size;
+  }
+
+  if ( !EndWrite3dmChunk() )
+  {
+    rc = false;
+  }
+
+  onfree(hash_table);
+
+  return (rc ? out__count : 0);
+}
+
+bool ON_BinaryArchive::ReadFastLZ(
+        size_t sizeof___outbuffer,  // sizeof uncompressed data
+        void* out___buffer          // buffer for uncompressed data
+        )
+{
+  ON__UINT32 tcode = 0;
+  ON__INT64  big_value = 0;
+  bool rc = BeginRead3dmBigChunk(&tcode,&big_value );
+  if (!rc)
+  {
+    if ( 0 != out___buffer && sizeof___outbuffer > 0 )
+      memset(out___buffer,0,sizeof___outbuffer);
+    return false;
+  }
+
+  unsigned char* scratch = nullptr;
+  if (tcode != TCODE_ANONYMOUS_CHUNK || big_value <= 4 || 0 == out___buffer)
+  {
+    // Either I have the wrong chunk, or the input
+    // parameters are bogus. 
+    rc = false;
+  }
+  else
+  {
+    scratch = (unsigned char*)onmalloc(Internal_FastLZBound(ON_FastLZ_block_size));
+    rc = (nullptr != scratch);
+  }
+
+  unsigned char* out = (unsigned char*)out___buffer;
+  for (size_t offset = 0; rc && offset < sizeof___outbuffer; offset += ON_FastLZ_block_size)
+  {
+    const size_t block_size
+      = (sizeof___outbuffer - offset < ON_FastLZ_block_size)
+      ? (sizeof___outbuffer - offset)
+      : ON_FastLZ_block_size;
+    ON__UINT32 header = 0;
+    rc = ReadInt(&header);
+    if (!rc)
+      break;
+    if (0 != (header & 0x80000000U))
+    {
+      rc = (block_size == (header & 0x7FFFFFFFU)) && ReadByte(block_size, out + offset);
+    }
+    else
+    {
+      rc = (header > 0 && header < block_size)
+        && ReadByte(header, scratch)
+        && Internal_FastLZDecompressBlock(scratch, header, out + offset, block_size);
+      if (!rc)
+        ON_ERROR("ON_BinaryArchive::ReadFastLZ - corrupt block");
+    }
+  }
+
+  if (nullptr != scratch)
+    onfree(scratch);
+
+  unsigned int c0 = BadCRCCount();
+  if ( !EndRead3dmChunk() )
+  {
+    rc = false;
+  }
+  if ( BadCRCCount() > c0 )
+  {
+    rc = false;
+  }
+
+  if ( !rc && 0 != out___buffer && sizeof___outbuffer > 0 )
+  {
+    memset(out___buffer,0,sizeof___outbuffer);
+  }
+
+  return rc;
+}
+
+/*
+BlockDeflate splits the buffer into ON_BlockDeflate_block_size blocks that are
+deflated independently, so they can be compressed and decompressed on several
+threads. The chunk holds the block size followed by groups of up to
+ON_BlockDeflate_group_size blocks. A group starts with an index of 4 byte block
+headers, the compressed size or 0x80000000 | block size when the block is stored,
+followed by the bytes of its blocks. The bytes written only depend on the input
+and the compression level.
+*/
+class Internal_BlockDeflateGroup
+{
+public:
+  const unsigned char* m_in = nullptr;  // first uncompressed byte of the group
+  unsigned char* m_out = nullptr;       // first uncompressed byte of the group
+  size_t m_size = 0;                    // uncompressed bytes in the group
+  size_t m_block_size = 0;
+  int m_level = Z_BEST_COMPRESSION;
+  unsigned char* m_scratch = nullptr;   // compressed blocks
+  size_t m_scratch_offset[ON_BlockDeflate_group_size] = {};
+  ON__UINT32 m_header[ON_BlockDeflate_group_size] = {};
+  bool m_bFailed[ON_BlockDeflate_group_size] = {};
+
+  size_t BlockSize(unsigned int block_index) const
+  {
+    const size_t offset = block_index*m_block_size;
+    return (m_size - offset < m_block_size) ? (m_size - offset) : m_block_size;
+  }
+};
+
+static void Internal_DeflateBlockTask(void* context, unsigned int block_index)
+{
+  Internal_BlockDeflateGroup& group = *((Internal_BlockDeflateGroup*)context);
+  const size_t block_size = group.BlockSize(block_index);
+  unsigned char* out = group.m_scratch + group.m_scratch_offset[block_index];
+
+  // Output that does not fit in block_size - 1 bytes is not worth keeping.
+  z_stream strm;
+  memset(&strm, 0, sizeof(strm));
+  size_t compressed_size = 0;
+  if (Z_OK == deflateInit(&strm, group.m_level))
+  {
+    strm.next_in = (Bytef*)(group.m_in + block_index*group.m_block_size);
+    strm.avail_in = (unsigned int)block_size;
+    strm.next_out = out;
+    strm.avail_out = (unsigned int)(block_size - 1);
+    if (Z_STREAM_END == z_deflate(&strm, Z_FINISH))
+      compressed_size = block_size - 1 - strm.avail_out;
+    deflateEnd(&strm);
+  }
+
+  group.m_header[block_index]
+    = (compressed_size > 0)
+    ? (ON__UINT32)compressed_size
+    : (0x80000000U | (ON__UINT32)block_size);
+}
+
+static void Internal_InflateBlockTask(void* context, unsigned int block_index)
+{
+  Internal_BlockDeflateGroup& group = *((Internal_BlockDeflateGroup*)context);
+  if (0 != (group.m_header[block_index] & 0x80000000U))
+    return; // stored block was read in place
+
+  const size_t block_size = group.BlockSize(block_index);
+  z_stream strm;
+  memset(&strm, 0, sizeof(strm));
+  bool rc = false;
+  if (Z_OK == inflateInit(&strm))
+  {
+    strm.next_in = group.m_scratch + group.m_scratch_offset[block_index];
+    strm.avail_in = group.m_header[block_index];
+    strm.next_out = group.m_out + block_index*group.m_block_size;
+    strm.avail_out = (unsigned int)block_size;
+    rc = Z_STREAM_END == z_inflate(&strm, Z_FINISH) && 0 == strm.avail_in && 0 == strm.avail_out;
+    inflateEnd(&strm);
+  }
+  group.m_bFailed[block_index] = !rc;
+}
+
+/*
+Description:
+  Runs the tasks of the groups of one buffer. The worker threads are started
+  once and wait between groups, so a large buffer does not start threads for
+  every group. Without std::thread or std::mutex the tasks run on the calling
+  thread.
+*/
+class Internal_BlockTaskPool
+{
+public:
+  /*
+  Parameters:
+    thread_count - [in]
+      maximum number of threads, including the calling thread.
+      0 = std::thread::hardware_concurrency().
+    task_count - [in]
+      total number of tasks of the buffer; no more threads are started.
+  */
+  Internal_BlockTaskPool(unsigned int thread_count, size_t task_count);
+  ~Internal_BlockTaskPool();
+
+  /*
+  Description:
+    Runs task(context,0), ..., task(context,task_count-1) on the workers
+    and the calling thread and returns when all tasks are finished.
+  */
+  void Run(
+    unsigned int task_count,
+    void (*task)(void*, unsigned int),
+    void* context
+    );
+
+private:
+  Internal_BlockTaskPool(const Internal_BlockTaskPool&) = delete;
+  Internal_BlockTaskPool& operator=(const Internal_BlockTaskPool&) = delete;
+
+  void Internal_RunTasks();
+
+  unsigned int m_task_count = 0;
+  void (*m_task)(void*, unsigned int) = nullptr;
+  void* m_context = nullptr;
+  std::atomic<unsigned int> m_next_task;
+
+#if !defined(OPENNURBS_NO_STD_THREAD) && !defined(OPENNURBS_NO_STD_MUTEX)
+  static void Internal_Worker(Internal_BlockTaskPool* pool);
+
+  std::mutex m_mutex;
+  std::condition_variable m_start;    // signaled when a group is ready or the pool stops
+  std::condition_variable m_finished; // signaled when the last worker finishes a group
+  std::thread m_workers[ON_BlockDeflate_group_size];
+  unsigned int m_worker_count = 0;
+  unsigned int m_group_serial_number = 0;
+  unsigned int m_busy_count = 0;      // workers still running the current group
+  bool m_bStop = false;
+#endif
+};
+
+Internal_BlockTaskPool::Internal_BlockTaskPool(unsigned int thread_count, size_t task_count)
+  : m_next_task(0)
+{
+#if !defined(OPENNURBS_NO_STD_THREAD) && !defined(OPENNURBS_NO_STD_MUTEX)
+  if (0 == thread_count)
+    thread_count = std::thread::hardware_concurrency();
+  if (thread_count > ON_BlockDeflate_group_size)
+    thread_count = ON_BlockDeflate_group_size;
+  if (thread_count > task_count)
+    thread_count = (unsigned int)task_count;
+  for (unsigned int i = 1; i < thread_count; i++)
+    m_workers[m_worker_count++] = std::thread(Internal_BlockTaskPool::Internal_Worker, this);
+#endif
+}
+
+Internal_BlockTaskPool::~Internal_BlockTaskPool()
+{
+#if !defined(OPENNURBS_NO_STD_THREAD) && !defined(OPENNURBS_NO_STD_MUTEX)
+  if (m_worker_count > 0)
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_bStop = true;
+    }
+    m_start.notify_all();
+    for (unsigned int i = 0; i < m_worker_count; i++)
+      m_workers[i].join();
+  }
+#endif
+}
+
+void Internal_BlockTaskPool::Internal_RunTasks()
+{
+  for (unsigned int i = m_next_task++; i < m_task_count; i = m_next_task++)
+    m_task(m_context, i);
+}
+
+#if !defined(OPENNURBS_NO_STD_THREAD) && !defined(OPENNURBS_NO_STD_MUTEX)
+void Internal_BlockTaskPool::Internal_Worker(Internal_BlockTaskPool* pool)
+{
+  unsigned int group_serial_number = 0;
+  std::unique_lock<std::mutex> lock(pool->m_mutex);
+  for (;;)
+  {
+    while (!pool->m_bStop && group_serial_number == pool->m_group_serial_number)
+      pool->m_start.wait(lock);
+    if (pool->m_bStop)
+      break;
+    group_serial_number = pool->m_group_serial_number;
+    lock.unlock();
+    pool->Internal_RunTasks();
+    lock.lock();
+    if (0 == --pool->m_busy_count)
+      pool->m_finished.notify_one();
+  }
+}
+#endif
+
+void Internal_BlockTaskPool::Run(
+  unsigned int task_count,
+  void (*task)(void*, unsigned int),
+  void* context
+)
+{
+#if !defined(OPENNURBS_NO_STD_THREAD) && !defined(OPENNURBS_NO_STD_MUTEX)
+  if (m_worker_count > 0 && task_count > 1)
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_task_count = task_count;
+      m_task = task;
+      m_context = context;
+      m_next_task = 0;
+      m_busy_count = m_worker_count;
+      m_group_serial_number++;
+    }
+    m_start.notify_all();
+    Internal_RunTasks();
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (m_busy_count > 0)
+      m_finished.wait(lock);
+    return;
+  }
+#endif
+  for (unsigned int i = 0; i < task_count; i++)
+    task(context, i);
+}
+
+size_t ON_BinaryArchive::WriteBlockDeflate( // returns number of bytes written
+        size_t sizeof___inbuffer,  // sizeof uncompressed input data ( > 0 )
+        const void* in___buffer     // uncompressed input data ( != nullptr )
+        )
+{
+  const size_t block_size = ON_BlockDeflate_block_size;
+  const size_t group_size = block_size*ON_BlockDeflate_group_size;
+
+  Internal_BlockDeflateGroup group;
+  group.m_block_size = block_size;
+  group.m_level = Internal_ZlibLevel(m_buffer_compression_level);
+  group.m_scratch = (unsigned char*)onmalloc((sizeof___inbuffer < group_size) ? sizeof___inbuffer : group_size);
+  if (nullptr == group.m_scratch)
+    return 0;
+  for (unsigned int i = 0; i < ON_BlockDeflate_group_size; i++)
+    group.m_scratch_offset[i] = i*block_size;
+
+  //  Compressed information is saved in a chunk.
+  bool rc = BeginWrite3dmChunk(TCODE_ANONYMOUS_CHUNK,0);
+  if (rc)
+    rc = WriteInt((ON__UINT32)block_size);
+  size_t out__count = sizeof(ON__UINT32);
+
+  Internal_BlockTaskPool pool(m_buffer_compression_thread_count, (sizeof___inbuffer + block_size - 1)/block_size);
+  const unsigned char* in = (const unsigned char*)in___buffer;
+  for (size_t offset = 0; rc && offset < sizeof___inbuffer; offset += group_size)
+  {
+    group.m_in = in + offset;
+    group.m_size = (sizeof___inbuffer - offset < group_size) ? (sizeof___inbuffer - offset) : group_size;
+    const unsigned int block_count = (unsigned int)((group.m_size + block_size - 1)/block_size);
+    pool.Run(block_count, Internal_DeflateBlockTask, &group);
+
+    rc = WriteInt(block_count, group.m_header);
+    out__count += block_count*sizeof(ON__UINT32);
+    for (unsigned int i = 0; rc && i < block_count; i++)
+    {
+      if (0 != (group.m_header[i] & 0x80000000U))
+      {
+        rc = WriteByte(group.BlockSize(i), group.m_in + i*block_size);
+        out__count += group.BlockSize(i);
+      }
+      else
+      {
+        rc = WriteByte(group.m_header[i], group.m_scratch + group.m_scratch_offset[i]);
+        out__count += group.m_header[i];
+      }
+    }
+  }
+
+  if ( !EndWrite3dmChunk() )
+  {
+    rc = false;
+  }
+
+  onfree(group.m_scratch);
+
+  return (rc ? out__count : 0);
+}
+
+bool ON_BinaryArchive::ReadBlockDeflate(
+        size_t sizeof___outbuffer,  // sizeof uncompressed data
+        void* out___buffer          // buffer for uncompressed data
+        )
+{
+  ON__UINT32 tcode = 0;
+  ON__INT64  big_value = 0;
+  bool rc = BeginRead3dmBigChunk(&tcode,&big_value );
+  if (!rc)
+  {
+    if ( 0 != out___buffer && sizeof___outbuffer > 0 )
+      memset(out___buffer,0,sizeof___outbuffer);
+    return false;
+  }
+
+  Internal_BlockDeflateGroup group;
+  ON__UINT32 block_size = 0;
+  if (tcode != TCODE_ANONYMOUS_CHUNK || big_value <= 4 || 0 == out___buffer)
+  {
+    // Either I have the wrong chunk, or the input
+    // parameters are bogus. 
+    rc = false;
+  }
+  else
+  {
+    rc = ReadInt(&block_size) && block_size >= 4096 && block_size <= ON_BlockDeflate_block_size;
+    if (!rc)
+      ON_ERROR("ON_BinaryArchive::ReadBlockDeflate - invalid block size");
+  }
+  group.m_block_size = block_size;
+
+  // Every group must fit in the rest of the chunk. This keeps a corrupt
+  // block index from allocating more scratch than the file can hold.
+  ON__UINT64 chunk_bytes_left = rc ? (ON__UINT64)(big_value - 4) : 0;
+  size_t sizeof_scratch = 0;
+  const size_t group_size = (size_t)block_size*ON_BlockDeflate_group_size;
+  Internal_BlockTaskPool pool(m_buffer_compression_thread_count, rc ? (sizeof___outbuffer + block_size - 1)/block_size : 0);
+  unsigned char* out = (unsigned char*)out___buffer;
+  for (size_t offset = 0; rc && offset < sizeof___outbuffer; offset += group_size)
+  {
+    group.m_out = out + offset;
+    group.m_size = (sizeof___outbuffer - offset < group_size) ? (sizeof___outbuffer - offset) : group_size;
+    const unsigned int block_count = (unsigned int)((group.m_size + block_size - 1)/block_size);
+    rc = ReadInt(block_count, group.m_header);
+
+    size_t compressed_size = 0;
+    ON__UINT64 group_bytes = 4*(ON__UINT64)block_count;
+    for (unsigned int i = 0; rc && i < block_count; i++)
+    {
+      group.m_bFailed[i] = false;
+      group.m_scratch_offset[i] = compressed_size;
+      if (0 != (group.m_header[i] & 0x80000000U))
+      {
+        rc = (group.BlockSize(i) == (group.m_header[i] & 0x7FFFFFFFU));
+        group_bytes += group.BlockSize(i);
+      }
+      else
+      {
+        rc = (group.m_header[i] > 0 && group.m_header[i] < group.BlockSize(i));
+        compressed_size += group.m_header[i];
+        group_bytes += group.m_header[i];
+      }
+    }
+    if (rc)
+    {
+      rc = (group_bytes <= chunk_bytes_left);
+      chunk_bytes_left -= rc ? group_bytes : 0;
+    }
+    if (!rc)
+    {
+      ON_ERROR("ON_BinaryArchive::ReadBlockDeflate - corrupt block index");
+      break;
+    }
+
+    if (compressed_size > sizeof_scratch)
+    {
+      group.m_scratch = (unsigned char*)onrealloc(group.m_scratch, compressed_size);
+      sizeof_scratch = (nullptr != group.m_scratch) ? compressed_size : 0;
+      if (nullptr == group.m_scratch)
+      {
+        rc = false;
+        break;
+      }
+    }
+
+    // Stored blocks go straight to the output.
+    for (unsigned int i = 0; rc && i < block_count; i++)
+    {
+      if (0 != (group.m_header[i] & 0x80000000U))
+        rc = ReadByte(group.BlockSize(i), group.m_out + i*block_size);
+      else
+        rc = ReadByte(group.m_header[i], group.m_scratch + group.m_scratch_offset[i]);
+    }
+    if (!rc)
+      break;
+
+    pool.Run(block_count, Internal_InflateBlockTask, &group);
+    for (unsigned int i = 0; rc && i < block_count; i++)
+      rc = !group.m_bFailed[i];
+    if (!rc)
+      ON_ERROR("ON_BinaryArchive::ReadBlockDeflate - z_inflate failure");
+  }
+
+  if (nullptr != group.m_scratch)
+    onfree(group.m_scratch);
+
+  unsigned int c0 = BadCRCCount();
+  if ( !EndRead3dmChunk() )
+  {
+    rc = false;
+  }
+  if ( BadCRCCount() > c0 )
+  {
+    rc = false;
+  }
+
+  if ( !rc && 0 != out___buffer && sizeof___outbuffer > 0 )
+  {
+    memset(out___buffer,0,sizeof___outbuffer);
+  }
+
+  return rc;
+}
+
 bool ON_BinaryArchive::CompressionInit()
 {
   // inflateInit() and deflateInit() are in zlib 1.3.3
@@ -609,7 +1390,7 @@ bool ON_BinaryArchive::CompressionInit()
     rc = (m_zlib.m_mode == ON::archive_mode::write) ? true : false;
     if ( !rc ) {
       CompressionEnd();
-      if ( Z_OK == deflateInit( &m_zlib.m_strm, Z_BEST_COMPRESSION ) ) {
+      if ( Z_OK == deflateInit( &m_zlib.m_strm, Internal_ZlibLevel(m_buffer_compression_level) ) ) {
         m_zlib.m_mode = ON::archive_mode::write;
         rc = true;
       }
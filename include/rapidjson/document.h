@@ -683,7 +683,7 @@ public:
         switch (rhs.GetType()) {
         case kObjectType: {
                 SizeType count = rhs.data_.o.size;
-                Member* lm = reinterpret_cast<Member*>(allocator.Malloc(count * sizeof(Member)));
+                Member* lm = DoAllocMembers(count, allocator);
                 const typename GenericValue<Encoding,SourceAllocator>::Member* rm = rhs.GetMembersPointer();
                 for (SizeType i = 0; i < count; i++) {
                     new (&lm[i].name) GenericValue(rm[i].name, allocator, copyConstStrings);
@@ -692,6 +692,7 @@ public:
                 data_.f.flags = kObjectFlag;
                 data_.o.size = data_.o.capacity = count;
                 SetMembersPointer(lm);
+                DoIndexMembers();
             }
             break;
         case kArrayType: {
@@ -842,7 +843,7 @@ public:
             case kObjectFlag:
                 for (MemberIterator m = MemberBegin(); m != MemberEnd(); ++m)
                     m->~Member();
-                Allocator::Free(GetMembersPointer());
+                DoFreeMembers();
                 break;
 
             case kCopyStringFlag:
@@ -1207,10 +1208,8 @@ public:
     */
     GenericValue& MemberReserve(SizeType newCapacity, Allocator &allocator) {
         RAPIDJSON_ASSERT(IsObject());
-        if (newCapacity > data_.o.capacity) {
-            SetMembersPointer(reinterpret_cast<Member*>(allocator.Realloc(GetMembersPointer(), data_.o.capacity * sizeof(Member), newCapacity * sizeof(Member))));
-            data_.o.capacity = newCapacity;
-        }
+        if (newCapacity > data_.o.capacity)
+            DoReallocMembers(newCapacity, allocator);
         return *this;
     }
 
@@ -1278,12 +1277,17 @@ public:
         \note Earlier versions of Rapidjson returned a \c NULL pointer, in case
             the requested member doesn't exist. For consistency with e.g.
             \c std::map, this has been changed to MemberEnd() now.
-        \note Linear time complexity.
+        \note Linear time complexity, constant on average for objects indexed
+            with \ref RAPIDJSON_MEMBER_INDEX.
     */
     template <typename SourceAllocator>
     MemberIterator FindMember(const GenericValue<Encoding, SourceAllocator>& name) {
         RAPIDJSON_ASSERT(IsObject());
         RAPIDJSON_ASSERT(name.IsString());
+#if RAPIDJSON_MEMBER_INDEX
+        if (MemberIndex* index = GetMemberIndex())
+            return MemberIterator(FindIndexedMember(index, name));
+#endif
         MemberIterator member = MemberBegin();
         for ( ; member != MemberEnd(); ++member)
             if (name.StringEqual(member->name))
@@ -1324,6 +1328,7 @@ public:
         Member* members = GetMembersPointer();
         members[o.size].name.RawAssign(name);
         members[o.size].value.RawAssign(value);
+        DoIndexAddMember(o.size);
         o.size++;
         return *this;
     }
@@ -1461,6 +1466,7 @@ public:
         for (MemberIterator m = MemberBegin(); m != MemberEnd(); ++m)
             m->~Member();
         data_.o.size = 0;
+        DoIndexMembers();
     }
 
     //! Remove a member in object by its name.
@@ -1506,6 +1512,7 @@ public:
         RAPIDJSON_ASSERT(m >= MemberBegin() && m < MemberEnd());
 
         MemberIterator last(GetMembersPointer() + (data_.o.size - 1));
+        DoIndexRemoveMember(static_cast<SizeType>(m - MemberBegin()));
         if (data_.o.size > 1 && m != last)
             *m = *last; // Move the last one to this place
         else
@@ -1549,6 +1556,7 @@ public:
             itr->~Member();
         std::memmove(static_cast<void*>(&*pos), &*last, static_cast<size_t>(MemberEnd() - last) * sizeof(Member));
         data_.o.size -= static_cast<SizeType>(last - first);
+        DoIndexMembers();
         return pos;
     }
 
@@ -2060,6 +2068,195 @@ private:
     RAPIDJSON_FORCEINLINE Member* GetMembersPointer() const { return RAPIDJSON_GETPOINTER(Member, data_.o.members); }
     RAPIDJSON_FORCEINLINE Member* SetMembersPointer(Member* members) { return RAPIDJSON_SETPOINTER(Member, data_.o.members, members); }
 
+#if RAPIDJSON_MEMBER_INDEX
+    RAPIDJSON_STATIC_ASSERT(RAPIDJSON_MEMBER_INDEX_THRESHOLD > 0);
+
+    // Objects with a member capacity of at least RAPIDJSON_MEMBER_INDEX_THRESHOLD
+    // store a MemberIndex* right in front of their members. The index is an
+    // open addressing table with linear probing and at most 50% load; each
+    // bucket holds the hash of a member name and the member position + 1.
+    struct MemberIndex {
+        struct Bucket {
+            uint32_t hash;
+            SizeType slot;  // member position + 1, 0 for an empty bucket
+        };
+        SizeType bucketCount;  // power of two
+
+        Bucket* GetBuckets() { return reinterpret_cast<Bucket*>(reinterpret_cast<char*>(this) + RAPIDJSON_ALIGN(sizeof(MemberIndex))); }
+        static size_t GetSize(SizeType bucketCount) { return RAPIDJSON_ALIGN(sizeof(MemberIndex)) + bucketCount * sizeof(Bucket); }
+    };
+
+    static size_t GetMembersHeaderSize(SizeType capacity) {
+        return capacity >= RAPIDJSON_MEMBER_INDEX_THRESHOLD ? RAPIDJSON_ALIGN(sizeof(MemberIndex*)) : 0;
+    }
+
+    static MemberIndex*& GetMemberIndexRef(Member* members) {
+        return *reinterpret_cast<MemberIndex**>(reinterpret_cast<char*>(members) - RAPIDJSON_ALIGN(sizeof(MemberIndex*)));
+    }
+
+    MemberIndex* GetMemberIndex() const {
+        return GetMembersHeaderSize(data_.o.capacity) ? GetMemberIndexRef(GetMembersPointer()) : 0;
+    }
+
+    template <typename SourceAllocator>
+    static uint32_t HashMemberName(const GenericValue<Encoding, SourceAllocator>& name) {
+        // FNV-1a
+        const Ch* str = name.GetString();
+        uint32_t hash = 2166136261u;
+        for (SizeType i = 0, length = name.GetStringLength(); i < length; i++)
+            hash = (hash ^ static_cast<uint32_t>(str[i])) * 16777619u;
+        return hash;
+    }
+
+    static MemberIndex* AllocMemberIndex(SizeType capacity, MemberIndex* old, Allocator& allocator) {
+        SizeType bucketCount = 1;
+        while (bucketCount < capacity * 2)
+            bucketCount *= 2;
+        size_t oldSize = old ? MemberIndex::GetSize(old->bucketCount) : 0;
+        MemberIndex* index = static_cast<MemberIndex*>(allocator.Realloc(old, oldSize, MemberIndex::GetSize(bucketCount)));
+        index->bucketCount = bucketCount;
+        return index;
+    }
+
+    template <typename SourceAllocator>
+    Member* FindIndexedMember(MemberIndex* index, const GenericValue<Encoding, SourceAllocator>& name) const {
+        const uint32_t hash = HashMemberName(name);
+        const SizeType mask = index->bucketCount - 1;
+        typename MemberIndex::Bucket* buckets = index->GetBuckets();
+        Member* members = GetMembersPointer();
+        for (SizeType i = hash & mask; buckets[i].slot; i = (i + 1) & mask)
+            if (buckets[i].hash == hash && name.StringEqual(members[buckets[i].slot - 1].name))
+                return members + buckets[i].slot - 1;
+        return members + data_.o.size;
+    }
+
+    //! Returns the bucket that refers to the member at position \c pos.
+    typename MemberIndex::Bucket* FindMemberBucket(MemberIndex* index, SizeType pos) const {
+        const SizeType mask = index->bucketCount - 1;
+        typename MemberIndex::Bucket* buckets = index->GetBuckets();
+        SizeType i = HashMemberName(GetMembersPointer()[pos].name) & mask;
+        while (buckets[i].slot != pos + 1) {
+            RAPIDJSON_ASSERT(buckets[i].slot != 0);
+            i = (i + 1) & mask;
+        }
+        return buckets + i;
+    }
+
+    void InsertMemberBucket(MemberIndex* index, SizeType pos) {
+        const uint32_t hash = HashMemberName(GetMembersPointer()[pos].name);
+        const SizeType mask = index->bucketCount - 1;
+        typename MemberIndex::Bucket* buckets = index->GetBuckets();
+        SizeType i = hash & mask;
+        while (buckets[i].slot)
+            i = (i + 1) & mask;
+        buckets[i].hash = hash;
+        buckets[i].slot = pos + 1;
+    }
+
+    void EraseMemberBucket(MemberIndex* index, typename MemberIndex::Bucket* bucket) {
+        // Backward shift deletion: pull later entries of the probe sequence
+        // into the hole unless their home bucket lies after it.
+        const SizeType mask = index->bucketCount - 1;
+        typename MemberIndex::Bucket* buckets = index->GetBuckets();
+        SizeType hole = static_cast<SizeType>(bucket - buckets);
+        for (SizeType j = (hole + 1) & mask; buckets[j].slot; j = (j + 1) & mask) {
+            SizeType home = buckets[j].hash & mask;
+            bool stays = hole <= j ? (hole < home && home <= j) : (hole < home || home <= j);
+            if (!stays) {
+                buckets[hole] = buckets[j];
+                hole = j;
+            }
+        }
+        buckets[hole].slot = 0;
+    }
+#endif // RAPIDJSON_MEMBER_INDEX
+
+    //! Allocates uninitialized storage for \c capacity members.
+    Member* DoAllocMembers(SizeType capacity, Allocator& allocator) {
+#if RAPIDJSON_MEMBER_INDEX
+        size_t header = GetMembersHeaderSize(capacity);
+        char* block = static_cast<char*>(allocator.Malloc(header + capacity * sizeof(Member)));
+        Member* members = reinterpret_cast<Member*>(block + header);
+        if (header)
+            GetMemberIndexRef(members) = AllocMemberIndex(capacity, 0, allocator);
+        return members;
+#else
+        return static_cast<Member*>(allocator.Malloc(capacity * sizeof(Member)));
+#endif
+    }
+
+    //! Grows the member storage of this object to \c newCapacity members.
+    void DoReallocMembers(SizeType newCapacity, Allocator& allocator) {
+#if RAPIDJSON_MEMBER_INDEX
+        const SizeType oldCapacity = data_.o.capacity;
+        const size_t oldHeader = GetMembersHeaderSize(oldCapacity);
+        const size_t newHeader = GetMembersHeaderSize(newCapacity);
+        Member* old = GetMembersPointer();
+        MemberIndex* index = GetMemberIndex();
+        char* oldBlock = old ? reinterpret_cast<char*>(old) - oldHeader : 0;
+        char* block = static_cast<char*>(allocator.Realloc(oldBlock, old ? oldHeader + oldCapacity * sizeof(Member) : 0, newHeader + newCapacity * sizeof(Member)));
+        if (newHeader != oldHeader)
+            std::memmove(block + newHeader, block + oldHeader, data_.o.size * sizeof(Member));
+        Member* members = reinterpret_cast<Member*>(block + newHeader);
+        SetMembersPointer(members);
+        data_.o.capacity = newCapacity;
+        if (newHeader) {
+            GetMemberIndexRef(members) = AllocMemberIndex(newCapacity, index, allocator);
+            DoIndexMembers();
+        }
+#else
+        SetMembersPointer(reinterpret_cast<Member*>(allocator.Realloc(GetMembersPointer(), data_.o.capacity * sizeof(Member), newCapacity * sizeof(Member))));
+        data_.o.capacity = newCapacity;
+#endif
+    }
+
+    //! Releases the member storage (but does not destroy the members).
+    void DoFreeMembers() {
+#if RAPIDJSON_MEMBER_INDEX
+        if (MemberIndex* index = GetMemberIndex()) {
+            Allocator::Free(index);
+            Allocator::Free(reinterpret_cast<char*>(GetMembersPointer()) - GetMembersHeaderSize(data_.o.capacity));
+            return;
+        }
+#endif
+        Allocator::Free(GetMembersPointer());
+    }
+
+    //! Rebuilds the member index, if any, from the current members.
+    void DoIndexMembers() {
+#if RAPIDJSON_MEMBER_INDEX
+        if (MemberIndex* index = GetMemberIndex()) {
+            std::memset(static_cast<void*>(index->GetBuckets()), 0, index->bucketCount * sizeof(typename MemberIndex::Bucket));
+            for (SizeType i = 0; i < data_.o.size; i++)
+                InsertMemberBucket(index, i);
+        }
+#endif
+    }
+
+    //! Adds the member at position \c pos to the index, if any.
+    void DoIndexAddMember(SizeType pos) {
+#if RAPIDJSON_MEMBER_INDEX
+        if (MemberIndex* index = GetMemberIndex())
+            InsertMemberBucket(index, pos);
+#else
+        (void)pos;
+#endif
+    }
+
+    //! Updates the index, if any, for RemoveMember() moving the last member to position \c pos.
+    void DoIndexRemoveMember(SizeType pos) {
+#if RAPIDJSON_MEMBER_INDEX
+        if (MemberIndex* index = GetMemberIndex()) {
+            const SizeType last = data_.o.size - 1;
+            EraseMemberBucket(index, FindMemberBucket(index, pos));
+            if (pos != last)
+                FindMemberBucket(index, last)->slot = pos + 1;
+        }
+#else
+        (void)pos;
+#endif
+    }
+
     // Initialize this value as array with initial data, without calling destructor.
     void SetArrayRaw(GenericValue* values, SizeType count, Allocator& allocator) {
         data_.f.flags = kArrayFlag;
@@ -2077,13 +2274,14 @@ private:
     void SetObjectRaw(Member* members, SizeType count, Allocator& allocator) {
         data_.f.flags = kObjectFlag;
         if (count) {
-            Member* m = static_cast<Member*>(allocator.Malloc(count * sizeof(Member)));
+            Member* m = DoAllocMembers(count, allocator);
             SetMembersPointer(m);
             std::memcpy(static_cast<void*>(m), members, count * sizeof(Member));
         }
         else
             SetMembersPointer(0);
         data_.o.size = data_.o.capacity = count;
+        DoIndexMembers();
     }
 
     //! Initialize this value as constant string, without calling destructor.
@@ -41,6 +41,10 @@ class CrtAllocator;
 template <typename BaseAllocator>
 class MemoryPoolAllocator;
 
+// threadcachingallocator.h
+
+class ThreadCachingAllocator;
+
 // stream.h
 
 template <typename Encoding>
@@ -79,6 +83,18 @@ typedef GenericMemoryBuffer<CrtAllocator> MemoryBuffer;
 
 struct MemoryStream;
 
+// mmapreadstream.h
+
+class MmapReadStream;
+class MmapInsituReadStream;
+
+// ndjsonreader.h
+
+template <typename BaseAllocator>
+class GenericNdjsonReader;
+
+typedef GenericNdjsonReader<CrtAllocator> NdjsonReader;
+
 // reader.h
 
 template<typename Encoding, typename Derived>
@@ -120,6 +136,16 @@ class GenericDocument;
 
 typedef GenericDocument<UTF8<char>, MemoryPoolAllocator<CrtAllocator>, CrtAllocator> Document;
 
+// lazydocument.h
+
+template <typename DocumentType>
+class GenericLazyValue;
+
+template <typename Allocator, typename StackAllocator>
+class GenericLazyDocument;
+
+typedef GenericLazyDocument<MemoryPoolAllocator<CrtAllocator>, CrtAllocator> LazyDocument;
+
 // pointer.h
 
 template <typename ValueType, typename Allocator>
@@ -127,6 +153,11 @@ class GenericPointer;
 
 typedef GenericPointer<Value, CrtAllocator> Pointer;
 
+template <typename ValueType, typename Allocator>
+class GenericPointerSet;
+
+typedef GenericPointerSet<Value, CrtAllocator> PointerSet;
+
 // schema.h
 
 template <typename SchemaDocumentType>
@@ -0,0 +1,398 @@
+// Tencent is pleased to support the open source community by making RapidJSON available.
+//
+// Copyright (C) 2015 THL A29 Limited, a Tencent company, and Milo Yip. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef RAPIDJSON_INTERNAL_STRUCTURALINDEX_H_
+#define RAPIDJSON_INTERNAL_STRUCTURALINDEX_H_
+
+#include "../rapidjson.h"
+#include <cstring>
+
+// Runtime dispatched x86 kernels. GCC and clang compile them with a target
+// attribute, MSVC accepts the intrinsics without one.
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define RAPIDJSON_STRUCTURAL_INDEX_X86 1
+#define RAPIDJSON_STRUCTURAL_INDEX_TARGET(isa) __attribute__((target(isa)))
+#include <immintrin.h>
+#elif defined(_MSC_VER) && (defined(_M_AMD64) || defined(_M_IX86))
+#define RAPIDJSON_STRUCTURAL_INDEX_X86 1
+#define RAPIDJSON_STRUCTURAL_INDEX_TARGET(isa)
+#include <intrin.h>
+#include <immintrin.h>
+#else
+#define RAPIDJSON_STRUCTURAL_INDEX_X86 0
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define RAPIDJSON_STRUCTURAL_INDEX_NOINLINE __attribute__((noinline))
+#elif defined(_MSC_VER)
+#define RAPIDJSON_STRUCTURAL_INDEX_NOINLINE __declspec(noinline)
+#else
+#define RAPIDJSON_STRUCTURAL_INDEX_NOINLINE
+#endif
+
+RAPIDJSON_NAMESPACE_BEGIN
+namespace internal {
+
+//! Instruction set used by StructuralIndexer to classify input bytes.
+enum StructuralIsa {
+    kStructuralIsaScalar,   //!< Portable code, one byte at a time.
+    kStructuralIsaSse42,    //!< 16 bytes per step with SSE4.2 string compares.
+    kStructuralIsaAvx2      //!< 32 bytes per step with AVX2 compares (also requires BMI1 and POPCNT).
+};
+
+#if RAPIDJSON_STRUCTURAL_INDEX_X86
+inline StructuralIsa DetectStructuralIsa() {
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    const int maxLeaf = info[0];
+    __cpuid(info, 1);
+    const bool sse42 = (info[2] & (1 << 20)) != 0;
+    const bool popcnt = (info[2] & (1 << 23)) != 0;
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx2 = false;
+    if (popcnt && osxsave && maxLeaf >= 7 && (_xgetbv(0) & 6) == 6) {
+        __cpuidex(info, 7, 0);
+        avx2 = (info[1] & (1 << 5)) != 0 && (info[1] & (1 << 3)) != 0;  // AVX2 and BMI1
+    }
+    return avx2 ? kStructuralIsaAvx2 : sse42 ? kStructuralIsaSse42 : kStructuralIsaScalar;
+#else
+    __builtin_cpu_init();
+    const bool avx2 = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("bmi") && __builtin_cpu_supports("popcnt");
+    return avx2 ? kStructuralIsaAvx2 :
+           __builtin_cpu_supports("sse4.2") ? kStructuralIsaSse42 : kStructuralIsaScalar;
+#endif
+}
+#endif
+
+//! Best instruction set supported by the running CPU (detected once).
+inline StructuralIsa GetStructuralIsa() {
+#if RAPIDJSON_STRUCTURAL_INDEX_X86
+    static const StructuralIsa isa = DetectStructuralIsa();
+    return isa;
+#else
+    return kStructuralIsaScalar;
+#endif
+}
+
+//! Character classes of one 64 byte block, one bit per byte.
+struct StructuralBlock {
+    uint64_t backslash;     //!< '\\'
+    uint64_t quote;         //!< '"'
+    uint64_t structural;    //!< '{', '}', '[', ']', ':' and ','
+    uint64_t whitespace;    //!< ' ', '\\t', '\\n' and '\\r'
+};
+
+inline uint32_t CountTrailingZeros64(uint64_t x) {
+    RAPIDJSON_ASSERT(x != 0);
+#if defined(_MSC_VER) && defined(_M_AMD64)
+    unsigned long index;
+    _BitScanForward64(&index, x);
+    return static_cast<uint32_t>(index);
+#elif defined(__GNUC__)
+    return static_cast<uint32_t>(__builtin_ctzll(x));
+#else
+    uint32_t n = 0;
+    while (!(x & 1)) {
+        x >>= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+//! State carried from one block to the next while locating structural characters.
+struct StructuralCarry {
+    StructuralCarry() : oddBackslash(0), inString(0), separator(1) {}
+
+    //! Bits of the characters escaped by an odd run of backslashes.
+    RAPIDJSON_FORCEINLINE uint64_t Escaped(uint64_t backslash) {
+        const uint64_t evenBits = RAPIDJSON_UINT64_C2(0x55555555, 0x55555555);
+        const uint64_t oddBits = ~evenBits;
+        const uint64_t startEdges = backslash & ~(backslash << 1);
+        // A run continuing from the previous block behaves as if it started on an odd bit.
+        const uint64_t evenStartMask = evenBits ^ oddBackslash;
+        const uint64_t evenStarts = startEdges & evenStartMask;
+        const uint64_t oddStarts = startEdges & ~evenStartMask;
+        const uint64_t evenCarries = backslash + evenStarts;
+        const uint64_t oddCarries = (backslash + oddStarts) | oddBackslash;
+        oddBackslash = (backslash + oddStarts) < backslash ? 1u : 0u;
+        const uint64_t evenCarryEnds = evenCarries & ~backslash;
+        const uint64_t oddCarryEnds = oddCarries & ~backslash;
+        return (evenCarryEnds & oddBits) | (oddCarryEnds & evenBits);
+    }
+
+    //! Bits of the characters of a block that are indexed.
+    /*! These are structural characters and opening quotes outside of strings, and the first
+        character of every other token (numbers, literals and garbage) so that stage 2 of the
+        parser can tell where each scalar starts and check what follows it.
+    */
+    RAPIDJSON_FORCEINLINE uint64_t Locate(const StructuralBlock& b) {
+        const uint64_t quote = b.quote & ~Escaped(b.backslash);
+
+        uint64_t inString = quote;  // prefix xor: set from an opening quote up to its closing one
+        inString ^= inString << 1;
+        inString ^= inString << 2;
+        inString ^= inString << 4;
+        inString ^= inString << 8;
+        inString ^= inString << 16;
+        inString ^= inString << 32;
+        inString ^= this->inString;
+        this->inString = static_cast<uint64_t>(static_cast<int64_t>(inString) >> 63);
+
+        const uint64_t outside = ~inString;
+        const uint64_t structural = b.structural & outside;
+        const uint64_t closingQuote = quote & outside;
+        const uint64_t separator = structural | (b.whitespace & outside) | closingQuote;
+        const uint64_t scalar = outside & ~(b.structural | b.whitespace | quote);
+        const uint64_t scalarStart = scalar & ((separator << 1) | this->separator);
+        this->separator = separator >> 63;
+
+        return structural | (quote & inString) | scalarStart;
+    }
+
+    uint64_t oddBackslash;  //!< 1 if the previous block ended in an odd run of backslashes.
+    uint64_t inString;      //!< All ones if the previous block ended inside a string.
+    uint64_t separator;     //!< 1 if the previous block ended in a character that may precede a token.
+};
+
+//! Writes offset plus the index of every set bit to out, returns the number of bits.
+inline size_t WriteOffsets(uint64_t bits, size_t offset, size_t* out) {
+    size_t n = 0;
+    while (bits) {
+        out[n++] = offset + CountTrailingZeros64(bits);
+        bits &= bits - 1;
+    }
+    return n;
+}
+
+inline void ClassifyScalar(const char* p, StructuralBlock& b) {
+    b.backslash = b.quote = b.structural = b.whitespace = 0;
+    for (unsigned i = 0; i < 64; i++) {
+        const uint64_t bit = static_cast<uint64_t>(1) << i;
+        switch (p[i]) {
+        case '\\': b.backslash |= bit; break;
+        case '"': b.quote |= bit; break;
+        case '{': case '}': case '[': case ']': case ':': case ',': b.structural |= bit; break;
+        case ' ': case '\t': case '\n': case '\r': b.whitespace |= bit; break;
+        default: break;
+        }
+    }
+}
+
+inline size_t ScanScalar(StructuralCarry& carry, const char* p, size_t blocks, size_t offset, size_t* out) {
+    size_t n = 0;
+    for (size_t i = 0; i < blocks; i++, p += 64, offset += 64) {
+        StructuralBlock b;
+        ClassifyScalar(p, b);
+        n += WriteOffsets(carry.Locate(b), offset, out + n);
+    }
+    return n;
+}
+
+#if RAPIDJSON_STRUCTURAL_INDEX_X86
+RAPIDJSON_STRUCTURAL_INDEX_TARGET("sse4.2")
+inline size_t ScanSse42(StructuralCarry& carry, const char* p, size_t blocks, size_t offset, size_t* out) {
+    // The input is cut at the first '\0', so the implicit length compares see whole vectors.
+    static const char structuralChars[16] = "{}[]:,";
+    static const char whitespaceChars[16] = " \t\n\r";
+    const __m128i structuralSet = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&structuralChars[0]));
+    const __m128i whitespaceSet = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&whitespaceChars[0]));
+    const __m128i backslashes = _mm_set1_epi8('\\');
+    const __m128i quotes = _mm_set1_epi8('"');
+    const int mode = _SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ANY | _SIDD_BIT_MASK;
+
+    size_t n = 0;
+    for (size_t i = 0; i < blocks; i++, p += 64, offset += 64) {
+        StructuralBlock b;
+        b.backslash = b.quote = b.structural = b.whitespace = 0;
+        for (unsigned j = 0; j < 64; j += 16) {
+            const __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + j));
+            b.backslash |= static_cast<uint64_t>(static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(s, backslashes)))) << j;
+            b.quote |= static_cast<uint64_t>(static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(s, quotes)))) << j;
+            b.structural |= static_cast<uint64_t>(static_cast<unsigned>(_mm_cvtsi128_si32(_mm_cmpistrm(structuralSet, s, mode)))) << j;
+            b.whitespace |= static_cast<uint64_t>(static_cast<unsigned>(_mm_cvtsi128_si32(_mm_cmpistrm(whitespaceSet, s, mode)))) << j;
+        }
+        n += WriteOffsets(carry.Locate(b), offset, out + n);
+    }
+    return n;
+}
+
+#if defined(__x86_64__) || defined(_M_AMD64)
+//! WriteOffsets() without a branch per bit: writes groups of eight offsets, at most 64 in total.
+RAPIDJSON_STRUCTURAL_INDEX_TARGET("popcnt,bmi")
+inline size_t WriteOffsetsBmi(uint64_t bits, size_t offset, size_t* out) {
+#define RAPIDJSON_STRUCTURAL_INDEX_WRITE(i) \
+    out[i] = offset + static_cast<size_t>(_tzcnt_u64(bits)); \
+    bits = _blsr_u64(bits)
+
+    const size_t n = static_cast<size_t>(_mm_popcnt_u64(bits));
+    for (size_t i = 0; i < n; i += 8, out += 8) {
+        RAPIDJSON_STRUCTURAL_INDEX_WRITE(0); RAPIDJSON_STRUCTURAL_INDEX_WRITE(1);
+        RAPIDJSON_STRUCTURAL_INDEX_WRITE(2); RAPIDJSON_STRUCTURAL_INDEX_WRITE(3);
+        RAPIDJSON_STRUCTURAL_INDEX_WRITE(4); RAPIDJSON_STRUCTURAL_INDEX_WRITE(5);
+        RAPIDJSON_STRUCTURAL_INDEX_WRITE(6); RAPIDJSON_STRUCTURAL_INDEX_WRITE(7);
+    }
+    return n;
+
+#undef RAPIDJSON_STRUCTURAL_INDEX_WRITE
+}
+#define RAPIDJSON_STRUCTURAL_INDEX_AVX2_WRITE WriteOffsetsBmi
+#define RAPIDJSON_STRUCTURAL_INDEX_AVX2_TARGET "avx2,popcnt,bmi"
+#else
+#define RAPIDJSON_STRUCTURAL_INDEX_AVX2_WRITE WriteOffsets
+#define RAPIDJSON_STRUCTURAL_INDEX_AVX2_TARGET "avx2"
+#endif
+
+RAPIDJSON_STRUCTURAL_INDEX_TARGET(RAPIDJSON_STRUCTURAL_INDEX_AVX2_TARGET)
+inline size_t ScanAvx2(StructuralCarry& carry, const char* p, size_t blocks, size_t offset, size_t* out) {
+    const __m256i backslashes = _mm256_set1_epi8('\\');
+    const __m256i quotes = _mm256_set1_epi8('"');
+    const __m256i lowerCase = _mm256_set1_epi8(0x20);  // maps '[' to '{' and ']' to '}'
+    const __m256i openBraces = _mm256_set1_epi8('{');
+    const __m256i closeBraces = _mm256_set1_epi8('}');
+    const __m256i colons = _mm256_set1_epi8(':');
+    const __m256i commas = _mm256_set1_epi8(',');
+    const __m256i spaces = _mm256_set1_epi8(' ');
+    const __m256i tabs = _mm256_set1_epi8('\t');
+    const __m256i newlines = _mm256_set1_epi8('\n');
+    const __m256i returns = _mm256_set1_epi8('\r');
+
+    size_t n = 0;
+    for (size_t i = 0; i < blocks; i++, p += 64, offset += 64) {
+        StructuralBlock b;
+        b.backslash = b.quote = b.structural = b.whitespace = 0;
+        for (unsigned j = 0; j < 64; j += 32) {
+            const __m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + j));
+            const __m256i lower = _mm256_or_si256(s, lowerCase);
+            const __m256i structural = _mm256_or_si256(
+                _mm256_or_si256(_mm256_cmpeq_epi8(lower, openBraces), _mm256_cmpeq_epi8(lower, closeBraces)),
+                _mm256_or_si256(_mm256_cmpeq_epi8(s, colons), _mm256_cmpeq_epi8(s, commas)));
+            const __m256i whitespace = _mm256_or_si256(
+                _mm256_or_si256(_mm256_cmpeq_epi8(s, spaces), _mm256_cmpeq_epi8(s, tabs)),
+                _mm256_or_si256(_mm256_cmpeq_epi8(s, newlines), _mm256_cmpeq_epi8(s, returns)));
+            b.backslash |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(s, backslashes)))) << j;
+            b.quote |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(s, quotes)))) << j;
+            b.structural |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(structural))) << j;
+            b.whitespace |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(whitespace))) << j;
+        }
+        n += RAPIDJSON_STRUCTURAL_INDEX_AVX2_WRITE(carry.Locate(b), offset, out + n);
+    }
+    return n;
+}
+#endif // RAPIDJSON_STRUCTURAL_INDEX_X86
+
+//! Stage 1 of structural index parsing: locates the tokens of a JSON text.
+/*! Scans the text 64 bytes at a time and reports the offset of every structural character
+    (<tt>{ } [ ] : ,</tt>) and opening quote outside of strings, plus the first character of
+    every other token. Strings are tracked with escape aware quote masks, so the reported
+    offsets are exactly the tokens a sequential parser would visit.
+
+    Offsets are produced in batches by Next(), so the index never has to hold the whole
+    document. The text must not contain '\\0'; its end is given by the length.
+*/
+class StructuralIndexer {
+public:
+    //! Minimum capacity of the buffer passed to Next().
+    static const size_t kMinCapacity = 64;
+
+    StructuralIndexer(const char* text, size_t length, StructuralIsa isa = GetStructuralIsa()) :
+        text_(text), length_(length), scanned_(0), isa_(isa), carry_() {}
+
+    //! Writes the offsets of the next tokens to out, returns their count (0 at the end of the text).
+    size_t Next(size_t* out, size_t capacity) {
+        RAPIDJSON_ASSERT(capacity >= kMinCapacity);
+        size_t n = 0;
+        while (n == 0 && scanned_ < length_) {
+            size_t blocks = (length_ - scanned_) / 64;
+            if (blocks > (capacity - n) / 64)
+                blocks = (capacity - n) / 64;
+            if (blocks > 0) {
+                n += Scan(text_ + scanned_, blocks, out + n);
+                scanned_ += blocks * 64;
+            }
+            else {
+                // Pad the last partial block with whitespace, which is never indexed.
+                char tail[64];
+                std::memset(tail, ' ', sizeof(tail));
+                std::memcpy(tail, text_ + scanned_, length_ - scanned_);
+                n += Scan(tail, 1, out + n);
+                scanned_ = length_;
+            }
+        }
+        return n;
+    }
+
+    //! Whether the text scanned so far ends inside a string.
+    bool InString() const { return carry_.inString != 0; }
+
+private:
+    size_t Scan(const char* p, size_t blocks, size_t* out) {
+        switch (isa_) {
+#if RAPIDJSON_STRUCTURAL_INDEX_X86
+        case kStructuralIsaAvx2: return ScanAvx2(carry_, p, blocks, scanned_, out);
+        case kStructuralIsaSse42: return ScanSse42(carry_, p, blocks, scanned_, out);
+#endif
+        default: return ScanScalar(carry_, p, blocks, scanned_, out);
+        }
+    }
+
+    const char* text_;
+    size_t length_;
+    size_t scanned_;
+    StructuralIsa isa_;
+    StructuralCarry carry_;
+};
+
+//! Sequential access to the tokens of a text, indexed in batches by StructuralIndexer.
+class StructuralTokens {
+public:
+    //! Indexes text[begin, end); offsets are relative to text.
+    StructuralTokens(const char* text, size_t begin, size_t end, StructuralIsa isa = GetStructuralIsa()) :
+        indexer_(text + begin, end - begin, isa), begin_(begin), end_(end), count_(0), next_(0) {}
+
+    //! Offset of the current token, or End() after the last one.
+    size_t Peek() {
+        if (RAPIDJSON_LIKELY(next_ < count_))
+            return begin_ + tokens_[next_];
+        return Refill() ? begin_ + tokens_[next_] : end_;
+    }
+
+    //! Moves to the next token.
+    void Skip() { RAPIDJSON_ASSERT(next_ < count_); ++next_; }
+
+    size_t End() const { return end_; }
+
+private:
+    static const size_t kCapacity = 1024;
+
+    // Kept out of line so that Peek() stays cheap to inline.
+    RAPIDJSON_STRUCTURAL_INDEX_NOINLINE bool Refill() {
+        next_ = 0;
+        count_ = indexer_.Next(tokens_, kCapacity);
+        return count_ != 0;
+    }
+
+    StructuralIndexer indexer_;
+    size_t begin_;
+    size_t end_;
+    size_t count_;
+    size_t next_;
+    size_t tokens_[kCapacity];
+};
+
+} // namespace internal
+RAPIDJSON_NAMESPACE_END
+
+#endif // RAPIDJSON_INTERNAL_STRUCTURALINDEX_H_
@@ -0,0 +1,633 @@
+// Tencent is pleased to support the open source community by making RapidJSON available.
+//
+// Copyright (C) 2015 THL A29 Limited, a Tencent company, and Milo Yip. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef RAPIDJSON_LAZYDOCUMENT_H_
+#define RAPIDJSON_LAZYDOCUMENT_H_
+
+#include "document.h"
+#include "internal/structuralindex.h"
+#include <cstring>
+
+RAPIDJSON_DIAG_PUSH
+#ifdef __clang__
+RAPIDJSON_DIAG_OFF(padded)
+#endif
+#ifdef __GNUC__
+RAPIDJSON_DIAG_OFF(effc++)
+#endif
+
+RAPIDJSON_NAMESPACE_BEGIN
+
+template <typename DocumentType>
+class GenericLazyValue;
+
+namespace internal {
+
+//! Member or element of a container of a GenericLazyDocument.
+template <typename ValueType>
+struct LazyEntry {
+    LazyEntry() : name(), value(), container() {}
+
+    ValueType name;         //!< Name of an object member, null for an array element.
+    ValueType value;        //!< Scalar value, or the whole subtree of a container once it is requested.
+    SizeType container;     //!< Index of the container plus one, 0 for a scalar.
+};
+
+} // namespace internal
+
+///////////////////////////////////////////////////////////////////////////////
+// GenericLazyMember
+
+//! Name-value pair of an object of a GenericLazyDocument.
+template <typename DocumentType>
+struct GenericLazyMember {
+    GenericLazyMember(const typename DocumentType::ValueType& n, const GenericLazyValue<DocumentType>& v) : name(n), value(v) {}
+
+    const typename DocumentType::ValueType& name;   //!< name of member (must be a string)
+    GenericLazyValue<DocumentType> value;           //!< value of member.
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// GenericLazyValue
+
+//! Handle of a value in a GenericLazyDocument.
+/*!
+    A handle is cheap to copy and stays valid until the document is parsed again or destroyed.
+    Scalars are read like a GenericValue. The members or elements of an object or array are
+    materialized when they are first accessed, by MemberCount(), FindMember(), operator[],
+    Size() or the iterators; containers nested in them stay unparsed until they are accessed
+    in turn. GetValue() materializes the whole subtree of the value as a GenericValue.
+
+    Accessing a value that does not exist, e.g. a missing member with operator[], asserts
+    and returns a null handle.
+
+    \tparam DocumentType Type of the GenericLazyDocument.
+*/
+template <typename DocumentType>
+class GenericLazyValue {
+public:
+    typedef typename DocumentType::ValueType ValueType;
+    typedef typename DocumentType::Ch Ch;
+    typedef GenericLazyMember<DocumentType> Member;
+
+    //! Iterator over the elements of an array.
+    class ValueIterator {
+    public:
+        ValueIterator() : document_(0), entry_(0) {}
+        GenericLazyValue operator*() const { return GenericLazyValue(document_, entry_); }
+        ValueIterator& operator++() { ++entry_; return *this; }
+        ValueIterator operator++(int) { ValueIterator old(*this); ++entry_; return old; }
+        bool operator==(const ValueIterator& rhs) const { return entry_ == rhs.entry_; }
+        bool operator!=(const ValueIterator& rhs) const { return entry_ != rhs.entry_; }
+
+    private:
+        friend class GenericLazyValue;
+        ValueIterator(DocumentType* document, const internal::LazyEntry<ValueType>* entry) : document_(document), entry_(entry) {}
+
+        DocumentType* document_;
+        const internal::LazyEntry<ValueType>* entry_;
+    };
+
+    //! Iterator over the members of an object.
+    class MemberIterator {
+    public:
+        //! Result of operator->(), keeps the member alive while it is accessed.
+        class Pointer {
+        public:
+            explicit Pointer(const Member& member) : member_(member) {}
+            const Member* operator->() const { return &member_; }
+        private:
+            Member member_;
+        };
+
+        MemberIterator() : document_(0), entry_(0) {}
+        Member operator*() const { return Member(entry_->name, GenericLazyValue(document_, entry_)); }
+        Pointer operator->() const { return Pointer(**this); }
+        MemberIterator& operator++() { ++entry_; return *this; }
+        MemberIterator operator++(int) { MemberIterator old(*this); ++entry_; return old; }
+        bool operator==(const MemberIterator& rhs) const { return entry_ == rhs.entry_; }
+        bool operator!=(const MemberIterator& rhs) const { return entry_ != rhs.entry_; }
+
+    private:
+        friend class GenericLazyValue;
+        MemberIterator(DocumentType* document, const internal::LazyEntry<ValueType>* entry) : document_(document), entry_(entry) {}
+
+        DocumentType* document_;
+        const internal::LazyEntry<ValueType>* entry_;
+    };
+
+    //! Default constructor creates a null handle.
+    GenericLazyValue() : document_(0), entry_(0) {}
+
+    //!@name Type
+    //@{
+
+    Type GetType() const {
+        if (!entry_)
+            return kNullType;
+        if (entry_->container)
+            return document_->IsObjectContainer(entry_->container - 1) ? kObjectType : kArrayType;
+        return entry_->value.GetType();
+    }
+    bool IsNull()   const { return GetType() == kNullType; }
+    bool IsFalse()  const { return IsScalar() && entry_->value.IsFalse(); }
+    bool IsTrue()   const { return IsScalar() && entry_->value.IsTrue(); }
+    bool IsBool()   const { return IsScalar() && entry_->value.IsBool(); }
+    bool IsObject() const { return GetType() == kObjectType; }
+    bool IsArray()  const { return GetType() == kArrayType; }
+    bool IsNumber() const { return IsScalar() && entry_->value.IsNumber(); }
+    bool IsInt()    const { return IsScalar() && entry_->value.IsInt(); }
+    bool IsUint()   const { return IsScalar() && entry_->value.IsUint(); }
+    bool IsInt64()  const { return IsScalar() && entry_->value.IsInt64(); }
+    bool IsUint64() const { return IsScalar() && entry_->value.IsUint64(); }
+    bool IsDouble() const { return IsScalar() && entry_->value.IsDouble(); }
+    bool IsString() const { return IsScalar() && entry_->value.IsString(); }
+
+    //@}
+
+    //!@name Scalars
+    //@{
+
+    bool GetBool() const { RAPIDJSON_ASSERT(IsBool()); return entry_->value.GetBool(); }
+    int GetInt() const { RAPIDJSON_ASSERT(IsInt()); return entry_->value.GetInt(); }
+    unsigned GetUint() const { RAPIDJSON_ASSERT(IsUint()); return entry_->value.GetUint(); }
+    int64_t GetInt64() const { RAPIDJSON_ASSERT(IsInt64()); return entry_->value.GetInt64(); }
+    uint64_t GetUint64() const { RAPIDJSON_ASSERT(IsUint64()); return entry_->value.GetUint64(); }
+    double GetDouble() const { RAPIDJSON_ASSERT(IsNumber()); return entry_->value.GetDouble(); }
+    const Ch* GetString() const { RAPIDJSON_ASSERT(IsString()); return entry_->value.GetString(); }
+    SizeType GetStringLength() const { RAPIDJSON_ASSERT(IsString()); return entry_->value.GetStringLength(); }
+
+    //! Materializes the whole subtree of the value.
+    /*! The result is kept by the document, so it is parsed only once. If the subtree is
+        invalid, the error is recorded in the document and a null value is returned.
+    */
+    const ValueType& GetValue() const {
+        RAPIDJSON_ASSERT(entry_ != 0);
+        if (entry_->container && entry_->value.IsNull())
+            document_->MaterializeSubtree(const_cast<internal::LazyEntry<ValueType>*>(entry_));
+        return entry_->value;
+    }
+
+    //@}
+
+    //!@name Object
+    //@{
+
+    SizeType MemberCount() const { RAPIDJSON_ASSERT(IsObject()); SizeType count; document_->GetEntries(entry_->container - 1, &count); return count; }
+    bool ObjectEmpty() const { return MemberCount() == 0; }
+    MemberIterator MemberBegin() const { RAPIDJSON_ASSERT(IsObject()); SizeType count; return MemberIterator(document_, document_->GetEntries(entry_->container - 1, &count)); }
+    MemberIterator MemberEnd() const { RAPIDJSON_ASSERT(IsObject()); SizeType count; return MemberIterator(document_, document_->GetEntries(entry_->container - 1, &count) + count); }
+
+    //! Finds a member by name, returns MemberEnd() if it does not exist.
+    MemberIterator FindMember(const Ch* name) const { return FindMember(name, internal::StrLen(name)); }
+
+    //! Finds a member by a name of the given length, returns MemberEnd() if it does not exist.
+    MemberIterator FindMember(const Ch* name, SizeType length) const {
+        RAPIDJSON_ASSERT(IsObject());
+        SizeType count;
+        const internal::LazyEntry<ValueType>* e = document_->GetEntries(entry_->container - 1, &count);
+        const internal::LazyEntry<ValueType>* end = e + count;
+        for (; e != end; ++e)
+            if (e->name.GetStringLength() == length && std::memcmp(e->name.GetString(), name, sizeof(Ch) * length) == 0)
+                break;
+        return MemberIterator(document_, e);
+    }
+
+    bool HasMember(const Ch* name) const { return FindMember(name) != MemberEnd(); }
+
+    GenericLazyValue operator[](const Ch* name) const {
+        MemberIterator member = FindMember(name);
+        if (member != MemberEnd())
+            return member->value;
+        RAPIDJSON_ASSERT(false);
+        return GenericLazyValue();
+    }
+
+#if RAPIDJSON_HAS_STDSTRING
+    MemberIterator FindMember(const std::basic_string<Ch>& name) const { return FindMember(name.data(), static_cast<SizeType>(name.size())); }
+    bool HasMember(const std::basic_string<Ch>& name) const { return FindMember(name) != MemberEnd(); }
+    GenericLazyValue operator[](const std::basic_string<Ch>& name) const {
+        MemberIterator member = FindMember(name);
+        if (member != MemberEnd())
+            return member->value;
+        RAPIDJSON_ASSERT(false);
+        return GenericLazyValue();
+    }
+#endif
+
+    //@}
+
+    //!@name Array
+    //@{
+
+    SizeType Size() const { RAPIDJSON_ASSERT(IsArray()); SizeType count; document_->GetEntries(entry_->container - 1, &count); return count; }
+    bool Empty() const { return Size() == 0; }
+    ValueIterator Begin() const { RAPIDJSON_ASSERT(IsArray()); SizeType count; return ValueIterator(document_, document_->GetEntries(entry_->container - 1, &count)); }
+    ValueIterator End() const { RAPIDJSON_ASSERT(IsArray()); SizeType count; return ValueIterator(document_, document_->GetEntries(entry_->container - 1, &count) + count); }
+
+    GenericLazyValue operator[](SizeType index) const {
+        RAPIDJSON_ASSERT(IsArray());
+        SizeType count;
+        const internal::LazyEntry<ValueType>* e = document_->GetEntries(entry_->container - 1, &count);
+        RAPIDJSON_ASSERT(index < count);
+        return index < count ? GenericLazyValue(document_, e + index) : GenericLazyValue();
+    }
+
+    //@}
+
+private:
+    template <typename, typename> friend class GenericLazyDocument;
+
+    GenericLazyValue(DocumentType* document, const internal::LazyEntry<ValueType>* entry) : document_(document), entry_(entry) {}
+
+    bool IsScalar() const { return entry_ && !entry_->container; }
+
+    DocumentType* document_;
+    const internal::LazyEntry<ValueType>* entry_;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// GenericLazyDocument
+
+//! A document that materializes values on demand.
+/*!
+    Parse() only locates the tokens of the text with the structural indexer of
+    kParseStructuralIndexFlag and pairs the brackets of all objects and arrays. A container is
+    parsed when it is first accessed through GetRoot() and the handles it returns: its scalar
+    members or elements become GenericValue, while containers nested in it are skipped in one
+    step to their closing bracket. A subtree that is never accessed costs only its share of
+    the index scan, so reading a few fields of a large message is much cheaper in time and
+    memory than GenericDocument::Parse().
+
+    The text is not copied and must outlive the document. It must be UTF-8 without '\\0'
+    characters, and its length must fit in a SizeType.
+
+    Parse() reports errors in the nesting of brackets, in a scalar root and in any text after
+    the root, but other syntax errors are only found when the container holding them is
+    accessed. They are then recorded in the document, so HasParseError() should be checked
+    after the accesses; the container that failed appears empty.
+
+    \tparam Allocator Allocator for the materialized values.
+    \tparam StackAllocator Allocator for the index and the parsing buffers.
+*/
+template <typename Allocator = MemoryPoolAllocator<>, typename StackAllocator = CrtAllocator>
+class GenericLazyDocument {
+public:
+    typedef UTF8<> EncodingType;
+    typedef EncodingType::Ch Ch;
+    typedef GenericValue<EncodingType, Allocator> ValueType;   //!< Type of the materialized values.
+    typedef GenericLazyValue<GenericLazyDocument> LazyValueType;
+    typedef Allocator AllocatorType;
+
+    //! Constructor
+    /*!
+        \param allocator Optional allocator for the materialized values.
+        \param stackAllocator Optional allocator for the index and the parsing buffers.
+    */
+    explicit GenericLazyDocument(Allocator* allocator = 0, StackAllocator* stackAllocator = 0) :
+        allocator_(allocator), ownAllocator_(0), text_(0), length_(0),
+        containers_(stackAllocator, kDefaultStackCapacity), stack_(stackAllocator, kDefaultStackCapacity),
+        reader_(stackAllocator), parseValue_(0), parseSubtree_(0), root_(), parseResult_()
+    {
+        if (!allocator_)
+            ownAllocator_ = allocator_ = RAPIDJSON_NEW(Allocator)();
+    }
+
+    ~GenericLazyDocument() {
+        Destroy();
+        RAPIDJSON_DELETE(ownAllocator_);
+    }
+
+    //!@name Parse from a string
+    //@{
+
+    //! Indexes a text of the given length.
+    /*! \tparam parseFlags Combination of \ref ParseFlag; kParseInsituFlag and kParseCommentsFlag are not supported.
+        \param str Text to parse, which must outlive the document.
+        \param length Length of the text.
+    */
+    template <unsigned parseFlags>
+    GenericLazyDocument& Parse(const Ch* str, size_t length) {
+        RAPIDJSON_STATIC_ASSERT(!(parseFlags & (kParseInsituFlag | kParseCommentsFlag)));
+        Destroy();
+        text_ = str;
+        length_ = length;
+        parseValue_ = &GenericLazyDocument::template ParseValue<parseFlags>;
+        parseSubtree_ = &GenericLazyDocument::template ParseSubtree<parseFlags>;
+        Index();
+        return *this;
+    }
+
+    //! Indexes a null-terminated text.
+    template <unsigned parseFlags>
+    GenericLazyDocument& Parse(const Ch* str) {
+        RAPIDJSON_ASSERT(str != 0);
+        return Parse<parseFlags>(str, internal::StrLen(str));
+    }
+
+    //! Indexes a text of the given length, with kParseDefaultFlags.
+    GenericLazyDocument& Parse(const Ch* str, size_t length) { return Parse<kParseDefaultFlags>(str, length); }
+
+    //! Indexes a null-terminated text, with kParseDefaultFlags.
+    GenericLazyDocument& Parse(const Ch* str) { return Parse<kParseDefaultFlags>(str); }
+
+    //@}
+
+    //!@name Handling parse errors
+    //@{
+
+    //! Whether a parse error has occurred, while indexing or materializing.
+    bool HasParseError() const { return parseResult_.IsError(); }
+
+    //! Get the \ref ParseErrorCode of the first parse error.
+    ParseErrorCode GetParseError() const { return parseResult_.Code(); }
+
+    //! Get the position of the first parse error.
+    size_t GetErrorOffset() const { return parseResult_.Offset(); }
+
+    //! Implicit conversion to get the first parse error.
+    operator ParseResult() const { return parseResult_; }
+
+    //@}
+
+    //! Gets the root value, or a null handle if indexing failed.
+    LazyValueType GetRoot() { return parseValue_ && !(root_.container == 0 && HasParseError()) ? LazyValueType(this, &root_) : LazyValueType(); }
+
+    //! Gets a member of the root object.
+    LazyValueType operator[](const Ch* name) { return GetRoot()[name]; }
+
+    //! Get the allocator of the materialized values.
+    Allocator& GetAllocator() { return *allocator_; }
+
+private:
+    friend class GenericLazyValue<GenericLazyDocument>;
+    typedef internal::LazyEntry<ValueType> Entry;
+
+    //! Object or array of the text.
+    struct Container {
+        SizeType open;      //!< Offset of '{' or '['.
+        SizeType close;     //!< Offset of the matching '}' or ']'.
+        SizeType next;      //!< Index of the first container after this one and its descendants.
+        SizeType count;     //!< Number of entries, kNotMaterialized before the first access.
+        Entry* entries;     //!< Members or elements.
+    };
+
+    //! Builds the values of scalars.
+    struct ValueHandler : BaseReaderHandler<EncodingType, ValueHandler> {
+        ValueHandler(ValueType& value, Allocator& allocator) : value_(value), allocator_(allocator) {}
+
+        bool Null() { value_.SetNull(); return true; }
+        bool Bool(bool b) { value_.SetBool(b); return true; }
+        bool Int(int i) { value_.SetInt(i); return true; }
+        bool Uint(unsigned i) { value_.SetUint(i); return true; }
+        bool Int64(int64_t i) { value_.SetInt64(i); return true; }
+        bool Uint64(uint64_t i) { value_.SetUint64(i); return true; }
+        bool Double(double d) { value_.SetDouble(d); return true; }
+        bool RawNumber(const Ch* str, SizeType length, bool) { value_.SetString(str, length, allocator_); return true; }
+        bool String(const Ch* str, SizeType length, bool) { value_.SetString(str, length, allocator_); return true; }
+        bool Default() { return false; }    // containers are never passed to the reader
+
+        ValueType& value_;
+        Allocator& allocator_;
+    };
+
+    typedef bool (GenericLazyDocument::*ParseValueFunc)(MemoryStream&, ValueType&);
+    typedef void (GenericLazyDocument::*ParseSubtreeFunc)(const Container&, ValueType&);
+
+    static const size_t kDefaultStackCapacity = 1024;
+    static const SizeType kNotMaterialized = ~SizeType(0);
+
+    GenericLazyDocument(const GenericLazyDocument&);
+    GenericLazyDocument& operator=(const GenericLazyDocument&);
+
+    //! Pairs the brackets of the text and parses a scalar root.
+    void Index() {
+        if (length_ >= static_cast<size_t>(kNotMaterialized)) {
+            SetError(kParseErrorTermination, 0);
+            return;
+        }
+
+        internal::StructuralTokens tokens(text_, 0, length_);
+        size_t first = length_;
+        bool rootDone = false;
+        stack_.Clear();
+        for (size_t p; (p = tokens.Peek()) != length_; tokens.Skip()) {
+            if (rootDone && stack_.Empty()) {
+                SetError(kParseErrorDocumentRootNotSingular, p);
+                break;
+            }
+            if (first == length_)
+                first = p;
+
+            const Ch c = text_[p];
+            if (c == '{' || c == '[') {
+                *stack_.template Push<SizeType>() = ContainerCount();
+                Container* container = containers_.template Push<Container>();
+                container->open = static_cast<SizeType>(p);
+                container->close = container->next = 0;
+                container->count = kNotMaterialized;
+                container->entries = 0;
+            }
+            else if (c == '}' || c == ']') {
+                const Ch open = c == '}' ? '{' : '[';
+                if (stack_.Empty()) {
+                    SetError(c == '}' ? kParseErrorObjectMissCommaOrCurlyBracket : kParseErrorArrayMissCommaOrSquareBracket, p);
+                    break;
+                }
+                Container& container = containers_.template Bottom<Container>()[*stack_.template Pop<SizeType>(1)];
+                if (text_[container.open] != open) {
+                    SetError(c == '}' ? kParseErrorArrayMissCommaOrSquareBracket : kParseErrorObjectMissCommaOrCurlyBracket, p);
+                    break;
+                }
+                container.close = static_cast<SizeType>(p);
+                container.next = ContainerCount();
+                rootDone = stack_.Empty();
+            }
+            else if (stack_.Empty())
+                rootDone = true;
+        }
+
+        if (!HasParseError() && !stack_.Empty())
+            SetError(text_[containers_.template Bottom<Container>()[*stack_.template Top<SizeType>()].open] == '{' ?
+                kParseErrorObjectMissCommaOrCurlyBracket : kParseErrorArrayMissCommaOrSquareBracket, length_);
+        stack_.Clear();
+        if (HasParseError())
+            return;
+
+        if (first == length_)
+            SetError(kParseErrorDocumentEmpty, length_);
+        else if (text_[first] == '{' || text_[first] == '[')
+            root_.container = 1;
+        else {
+            MemoryStream is(text_, length_);
+            is.src_ = text_ + first;
+            if ((this->*parseValue_)(is, root_.value)) {
+                SkipWhitespace(is);
+                if (is.Tell() != length_)
+                    SetError(kParseErrorDocumentRootNotSingular, is.Tell());
+            }
+        }
+    }
+
+    SizeType ContainerCount() const { return static_cast<SizeType>(containers_.GetSize() / sizeof(Container)); }
+
+    bool IsObjectContainer(SizeType index) const { return text_[containers_.template Bottom<Container>()[index].open] == '{'; }
+
+    //! Gets the entries of a container, materializing them on the first access.
+    const Entry* GetEntries(SizeType index, SizeType* count) {
+        Container& container = containers_.template Bottom<Container>()[index];
+        if (container.count == kNotMaterialized)
+            Materialize(index);
+        *count = container.count;
+        return container.entries;
+    }
+
+    //! Parses the scalars of a container and skips the containers nested in it.
+    void Materialize(SizeType index) {
+        Container& container = containers_.template Bottom<Container>()[index];
+        const bool isObject = text_[container.open] == '{';
+        container.count = 0;
+
+        // The stream ends at the closing bracket, which then reads as '\0'.
+        MemoryStream is(text_, container.close);
+        is.src_ = text_ + container.open + 1;
+        SizeType child = index + 1;
+        SkipWhitespace(is);
+        if (is.Peek() != '\0')
+            for (;;) {
+                Entry* e = new (stack_.template Push<Entry>()) Entry();
+                if (isObject) {
+                    if (is.Peek() != '"')
+                        return MaterializeError(kParseErrorObjectMissName, is.Tell());
+                    if (!(this->*parseValue_)(is, e->name))
+                        return MaterializeError(kParseErrorNone, 0);
+                    SkipWhitespace(is);
+                    if (is.Peek() != ':')
+                        return MaterializeError(kParseErrorObjectMissColon, is.Tell());
+                    is.Take();
+                    SkipWhitespace(is);
+                }
+
+                const Ch c = is.Peek();
+                if (c == '{' || c == '[') {
+                    const Container& nested = containers_.template Bottom<Container>()[child];
+                    RAPIDJSON_ASSERT(nested.open == is.Tell());
+                    e->container = child + 1;
+                    is.src_ = text_ + nested.close + 1;
+                    child = nested.next;
+                }
+                else if (c == '\0')
+                    return MaterializeError(kParseErrorValueInvalid, is.Tell());
+                else if (!(this->*parseValue_)(is, e->value))
+                    return MaterializeError(kParseErrorNone, 0);
+
+                SkipWhitespace(is);
+                if (is.Peek() == '\0')
+                    break;
+                if (is.Peek() != ',')
+                    return MaterializeError(isObject ? kParseErrorObjectMissCommaOrCurlyBracket : kParseErrorArrayMissCommaOrSquareBracket, is.Tell());
+                is.Take();
+                SkipWhitespace(is);
+            }
+
+        const size_t size = stack_.GetSize();
+        if (size > 0) {
+            container.entries = static_cast<Entry*>(allocator_->Malloc(size));
+            std::memcpy(static_cast<void*>(container.entries), stack_.template Bottom<Entry>(), size);
+            container.count = static_cast<SizeType>(size / sizeof(Entry));
+        }
+        stack_.Clear();
+    }
+
+    //! Records an error of Materialize(); the container stays empty.
+    void MaterializeError(ParseErrorCode code, size_t offset) {
+        if (code != kParseErrorNone)
+            SetError(code, offset);
+        if (Allocator::kNeedFree)
+            while (!stack_.Empty())
+                stack_.template Pop<Entry>(1)->~Entry();
+        stack_.Clear();
+    }
+
+    void MaterializeSubtree(Entry* entry) {
+        (this->*parseSubtree_)(containers_.template Bottom<Container>()[entry->container - 1], entry->value);
+    }
+
+    template <unsigned parseFlags>
+    bool ParseValue(MemoryStream& is, ValueType& value) {
+        ValueHandler handler(value, *allocator_);
+        ParseResult result = reader_.template Parse<(parseFlags | kParseStopWhenDoneFlag) & ~static_cast<unsigned>(kParseStructuralIndexFlag)>(is, handler);
+        if (result.IsError())
+            SetError(result.Code(), result.Offset());
+        return !result.IsError();
+    }
+
+    template <unsigned parseFlags>
+    void ParseSubtree(const Container& container, ValueType& value) {
+        MemoryStream is(text_, container.close + 1);
+        is.src_ = text_ + container.open;
+        GenericDocument<EncodingType, Allocator, StackAllocator> d(allocator_);
+        d.template ParseStream<(parseFlags | kParseStopWhenDoneFlag) & ~static_cast<unsigned>(kParseStructuralIndexFlag)>(is);
+        if (d.HasParseError())
+            SetError(d.GetParseError(), d.GetErrorOffset());
+        else
+            value.Swap(static_cast<ValueType&>(d));
+    }
+
+    //! Keeps the first error.
+    void SetError(ParseErrorCode code, size_t offset) {
+        if (!HasParseError())
+            parseResult_.Set(code, offset);
+    }
+
+    //! Releases the values of the previous text.
+    void Destroy() {
+        if (Allocator::kNeedFree) {
+            Container* c = containers_.template Bottom<Container>();
+            for (Container* end = containers_.template End<Container>(); c != end; ++c)
+                if (c->count != kNotMaterialized) {
+                    for (SizeType i = 0; i < c->count; i++)
+                        c->entries[i].~Entry();
+                    Allocator::Free(c->entries);
+                }
+        }
+        root_.value.SetNull();
+        root_.container = 0;
+        containers_.Clear();
+        parseValue_ = 0;
+        parseSubtree_ = 0;
+        parseResult_.Clear();
+    }
+
+    Allocator* allocator_;
+    Allocator* ownAllocator_;
+    const Ch* text_;
+    size_t length_;
+    internal::Stack<StackAllocator> containers_;    //!< Containers in the order of their opening brackets.
+    internal::Stack<StackAllocator> stack_;         //!< Open containers while indexing, entries while materializing.
+    GenericReader<EncodingType, EncodingType, StackAllocator> reader_;
+    ParseValueFunc parseValue_;
+    ParseSubtreeFunc parseSubtree_;
+    Entry root_;
+    ParseResult parseResult_;
+};
+
+//! GenericLazyDocument with the default allocators.
+typedef GenericLazyDocument<> LazyDocument;
+
+RAPIDJSON_NAMESPACE_END
+
+RAPIDJSON_DIAG_POP
+
+#endif // RAPIDJSON_LAZYDOCUMENT_H_
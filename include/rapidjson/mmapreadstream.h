@@ -0,0 +1,155 @@
+// Tencent is pleased to support the open source community by making RapidJSON available.
+//
+// Copyright (C) 2015 THL A29 Limited, a Tencent company, and Milo Yip. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef RAPIDJSON_MMAPREADSTREAM_H_
+#define RAPIDJSON_MMAPREADSTREAM_H_
+
+#include "stream.h"
+
+#ifdef _WIN32
+#error "MmapReadStream requires POSIX mmap()"
+#endif
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef __clang__
+RAPIDJSON_DIAG_PUSH
+RAPIDJSON_DIAG_OFF(padded)
+#endif
+
+RAPIDJSON_NAMESPACE_BEGIN
+namespace internal {
+
+//! Private mapping of a whole file, followed by at least one '\0'.
+/*!
+    The file is mapped over an anonymous mapping that is one page longer than needed, so the
+    text stays NUL terminated even if the file size is a multiple of the page size. A writable
+    mapping is copy-on-write: changes never reach the file.
+*/
+class FileMapping {
+public:
+    FileMapping(const char* path, bool writable) : data_(0), size_(0), mapSize_(0), empty_('\0') {
+        RAPIDJSON_ASSERT(path != 0);
+        int fd = ::open(path, O_RDONLY);
+        if (fd < 0)
+            return;
+        struct stat st;
+        if (::fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size >= 0 &&
+            static_cast<unsigned long long>(st.st_size) < static_cast<unsigned long long>(~size_t(0) / 2))
+            Map(fd, static_cast<size_t>(st.st_size), writable);
+        ::close(fd);
+    }
+
+    ~FileMapping() {
+        if (data_)
+            ::munmap(data_, mapSize_);
+    }
+
+    //! Whether the file could be opened and mapped.
+    bool IsOpen() const { return data_ != 0; }
+
+    //! Size of the file in bytes.
+    size_t Size() const { return size_; }
+
+    //! The text of the file, or an empty string if it could not be mapped.
+    char* Data() { return data_ ? data_ : &empty_; }
+
+private:
+    FileMapping(const FileMapping&);
+    FileMapping& operator=(const FileMapping&);
+
+    void Map(int fd, size_t size, bool writable) {
+        const size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+        const size_t mapSize = (size / page + 1) * page;
+        const int prot = writable ? PROT_READ | PROT_WRITE : PROT_READ;
+#ifdef MAP_ANONYMOUS
+        void* p = ::mmap(0, mapSize, prot, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+#else
+        void* p = ::mmap(0, mapSize, prot, MAP_PRIVATE | MAP_ANON, -1, 0);
+#endif
+        if (p == MAP_FAILED)
+            return;
+        if (size > 0) {
+            if (::mmap(p, size, prot, MAP_PRIVATE | MAP_FIXED, fd, 0) == MAP_FAILED) {
+                ::munmap(p, mapSize);
+                return;
+            }
+            ::posix_madvise(p, size, POSIX_MADV_SEQUENTIAL);
+        }
+        data_ = static_cast<char*>(p);
+        size_ = size;
+        mapSize_ = mapSize;
+    }
+
+    char* data_;
+    size_t size_;
+    size_t mapSize_;
+    char empty_;
+};
+
+} // namespace internal
+
+//! File input stream that maps the whole file into memory.
+/*!
+    The text is parsed straight from the mapping, without fread() or an intermediate buffer,
+    and the kernel is advised that the file is read sequentially. The stream is a StringStream
+    of the file, so GenericReader and GenericDocument::ParseStream() handle it like a string,
+    including kParseStructuralIndexFlag.
+
+    The file must be UTF-8 without BOM. Like StringStream, reading stops at the first '\0'.
+    A file that cannot be opened or mapped reads as empty; check IsOpen().
+    \note implements Stream concept
+*/
+class MmapReadStream : private internal::FileMapping, public GenericStringStream<UTF8<> > {
+public:
+    //! Constructor.
+    /*!
+        \param path Path of the file to map.
+    */
+    explicit MmapReadStream(const char* path) : internal::FileMapping(path, false), GenericStringStream<UTF8<> >(Data()) {}
+
+    using internal::FileMapping::IsOpen;
+    using internal::FileMapping::Size;
+};
+
+//! File input stream for in-situ parsing of a memory-mapped file.
+/*!
+    Like MmapReadStream, but the mapping is private and writable, so parsing with
+    kParseInsituFlag decodes strings in place: the strings of the resulting document point
+    into the mapping and the stream must outlive the document. Only the pages that are
+    written to are copied; the file itself is never modified.
+    \note implements Stream concept
+*/
+class MmapInsituReadStream : private internal::FileMapping, public GenericInsituStringStream<UTF8<> > {
+public:
+    //! Constructor.
+    /*!
+        \param path Path of the file to map.
+    */
+    explicit MmapInsituReadStream(const char* path) : internal::FileMapping(path, true), GenericInsituStringStream<UTF8<> >(Data()) {}
+
+    using internal::FileMapping::IsOpen;
+    using internal::FileMapping::Size;
+};
+
+RAPIDJSON_NAMESPACE_END
+
+#ifdef __clang__
+RAPIDJSON_DIAG_POP
+#endif
+
+#endif // RAPIDJSON_MMAPREADSTREAM_H_
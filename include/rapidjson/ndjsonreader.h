@@ -0,0 +1,333 @@
+// Tencent is pleased to support the open source community by making RapidJSON available.
+//
+// Copyright (C) 2015 THL A29 Limited, a Tencent company, and Milo Yip. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef RAPIDJSON_NDJSONREADER_H_
+#define RAPIDJSON_NDJSONREADER_H_
+
+#include "document.h"
+#include "memorystream.h"
+#include "encodedstream.h"
+
+#if !RAPIDJSON_HAS_CXX11_RVALUE_REFS
+#error "NdjsonReader requires C++11"
+#endif
+
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef __clang__
+RAPIDJSON_DIAG_PUSH
+RAPIDJSON_DIAG_OFF(padded)
+#endif
+
+RAPIDJSON_NAMESPACE_BEGIN
+
+//! Parallel reader of newline-delimited JSON (NDJSON, JSON Lines).
+/*!
+    The text is split into chunks of about ChunkSize() bytes that end at a line break, and the
+    chunks are parsed by a pool of worker threads. Every line holds one JSON value; lines that
+    are empty or only hold whitespace are skipped. The text is UTF-8 and need not be NUL
+    terminated, so it can be a memory buffer or a mapped file (e.g. the head_ and Size() of a
+    MmapReadStream).
+
+    ParseDocuments() builds one document per line. The documents of each chunk live in a
+    MemoryPoolAllocator that belongs to the chunk and is only touched by the worker that parses
+    it, and they are handed to the caller in input order.
+
+    Parse() sends SAX events to one handler per worker instead. The events of a line always
+    reach a single handler without interruption, but the order of lines across handlers is
+    unspecified.
+
+    \tparam BaseAllocator Allocator for the memory chunks of the documents.
+*/
+template <typename BaseAllocator = CrtAllocator>
+class GenericNdjsonReader {
+public:
+    typedef char Ch;
+    typedef GenericDocument<UTF8<>, MemoryPoolAllocator<BaseAllocator>, BaseAllocator> DocumentType;
+
+    static const size_t kDefaultChunkSize = 1024 * 1024;
+
+    //! Constructor.
+    /*!
+        \param threadCount Number of worker threads, or 0 for one per hardware thread.
+        \param chunkSize Approximate number of bytes parsed by a worker at a time.
+    */
+    explicit GenericNdjsonReader(size_t threadCount = 0, size_t chunkSize = kDefaultChunkSize)
+        : threadCount_(threadCount ? threadCount : std::thread::hardware_concurrency()), chunkSize_(chunkSize) {
+        if (threadCount_ == 0)
+            threadCount_ = 1;
+        RAPIDJSON_ASSERT(chunkSize_ > 0);
+    }
+
+    //! Number of worker threads, and of the handlers Parse() requires.
+    size_t ThreadCount() const { return threadCount_; }
+
+    size_t ChunkSize() const { return chunkSize_; }
+
+    //! Parses every line into a document and passes the documents to a handler in input order.
+    /*!
+        The handler is called on the calling thread as
+        \code bool handler(size_t line, DocumentType& document) \endcode
+        where line is the zero-based line number. A malformed line is passed too and
+        document.HasParseError() tells why, with an offset relative to the start of the line.
+        The document and its strings are released once the handler returns; copy what has to be
+        kept. Returning false stops parsing.
+
+        \tparam parseFlags Combination of \ref ParseFlag, except kParseInsituFlag.
+        \return false if the handler stopped parsing.
+    */
+    template <unsigned parseFlags, typename DocumentHandler>
+    bool ParseDocuments(const Ch* text, size_t length, DocumentHandler& handler) {
+        RAPIDJSON_STATIC_ASSERT(!(parseFlags & kParseInsituFlag));
+        Split(text, length);
+        const size_t chunkCount = bounds_.size() - 1;
+        if (chunkCount == 0)
+            return true;
+
+        // A chunk is parsed into slot (chunk % slotCount); workers run ahead of the handler
+        // by at most slotCount chunks, which bounds the memory held by parsed documents.
+        const size_t workerCount = threadCount_ < chunkCount ? threadCount_ : chunkCount;
+        const size_t slotCount = 2 * workerCount;
+        std::unique_ptr<DocumentSlot[]> slots(new DocumentSlot[slotCount]);
+        DocumentSchedule schedule(slotCount);
+
+        WorkerGroup workers(schedule);
+        for (size_t i = 0; i < workerCount; i++)
+            workers.threads.push_back(std::thread(&GenericNdjsonReader::DocumentWorker<parseFlags>, this, text, slots.get(), std::ref(schedule)));
+
+        size_t line = 0;
+        for (size_t chunk = 0; chunk < chunkCount; chunk++) {
+            DocumentSlot& slot = slots[chunk % slotCount];
+            {
+                std::unique_lock<std::mutex> lock(schedule.mutex);
+                schedule.changed.wait(lock, [&slot] { return slot.ready; });
+            }
+
+            for (size_t i = 0; i < slot.documents.size(); i++)
+                if (!handler(line + slot.lines[i], slot.documents[i]))
+                    return false;
+            line += slot.lineCount;
+
+            std::lock_guard<std::mutex> lock(schedule.mutex);
+            slot.ready = false;
+            schedule.delivered = chunk + 1;
+            schedule.changed.notify_all();
+        }
+        return true;
+    }
+
+    //! Parses every line with SAX events.
+    /*!
+        Worker i sends the events of the lines it parses to handlers[i], so the handlers need no
+        locking of their own. Parsing stops at the first malformed line or when a handler
+        returns false.
+
+        \tparam parseFlags Combination of \ref ParseFlag, except kParseInsituFlag.
+        \param handlers Array of ThreadCount() handlers.
+        \return The result of the first line in input order that failed, with an offset
+            relative to text.
+    */
+    template <unsigned parseFlags, typename Handler>
+    ParseResult Parse(const Ch* text, size_t length, Handler* handlers) {
+        RAPIDJSON_STATIC_ASSERT(!(parseFlags & kParseInsituFlag));
+        Split(text, length);
+        const size_t chunkCount = bounds_.size() - 1;
+
+        SaxSchedule schedule;
+        WorkerGroup workers(schedule);
+        for (size_t i = 0; i < threadCount_ && i < chunkCount; i++)
+            workers.threads.push_back(std::thread(&GenericNdjsonReader::SaxWorker<parseFlags, Handler>, this, text, std::ref(handlers[i]), std::ref(schedule)));
+        workers.Join();
+        return schedule.result;
+    }
+
+private:
+    struct Schedule {
+        Schedule() : stop(false) {}
+        std::mutex mutex;
+        std::condition_variable changed;
+        bool stop;
+    };
+
+    struct DocumentSchedule : Schedule {
+        explicit DocumentSchedule(size_t slots) : slotCount(slots), next(0), delivered(0) {}
+        size_t slotCount;
+        size_t next;        // next chunk to parse
+        size_t delivered;   // chunks passed to the handler
+    };
+
+    struct SaxSchedule : Schedule {
+        SaxSchedule() : next(0), failedChunk(~size_t(0)) {}
+        std::atomic<size_t> next;
+        size_t failedChunk;
+        ParseResult result;
+    };
+
+    struct DocumentSlot {
+        DocumentSlot() : lineCount(0), ready(false) {}
+        MemoryPoolAllocator<BaseAllocator> allocator;
+        std::vector<DocumentType> documents;
+        std::vector<size_t> lines;  // line of each document, relative to the chunk
+        size_t lineCount;
+        bool ready;
+    };
+
+    // Stops and joins the workers on any exit, including exceptions thrown by a handler.
+    struct WorkerGroup {
+        explicit WorkerGroup(Schedule& s) : schedule(s) {}
+        ~WorkerGroup() {
+            {
+                std::lock_guard<std::mutex> lock(schedule.mutex);
+                schedule.stop = true;
+                schedule.changed.notify_all();
+            }
+            Join();
+        }
+        void Join() {
+            for (size_t i = 0; i < threads.size(); i++)
+                if (threads[i].joinable())
+                    threads[i].join();
+        }
+        Schedule& schedule;
+        std::vector<std::thread> threads;
+    };
+
+    // Chunk i is [bounds_[i], bounds_[i + 1]); every chunk but the last ends after a '\n'.
+    void Split(const Ch* text, size_t length) {
+        bounds_.clear();
+        bounds_.push_back(0);
+        size_t begin = 0;
+        while (begin < length) {
+            size_t end = length;
+            if (length - begin > chunkSize_) {
+                const void* newline = std::memchr(text + begin + chunkSize_, '\n', length - begin - chunkSize_);
+                if (newline)
+                    end = static_cast<size_t>(static_cast<const Ch*>(newline) - text) + 1;
+            }
+            bounds_.push_back(end);
+            begin = end;
+        }
+    }
+
+    static bool IsBlank(const Ch* begin, const Ch* end) {
+        for (; begin != end; ++begin)
+            if (*begin != ' ' && *begin != '\t' && *begin != '\r' && *begin != '\n')
+                return false;
+        return true;
+    }
+
+    // Calls f(begin, end, line) for every line of a chunk that is not blank. Returns the number of
+    // lines, or stops early and returns ~0 if f returns false.
+    template <typename LineFunction>
+    static size_t ForEachLine(const Ch* begin, const Ch* end, LineFunction f) {
+        size_t line = 0;
+        while (begin < end) {
+            const void* newline = std::memchr(begin, '\n', static_cast<size_t>(end - begin));
+            const Ch* lineEnd = newline ? static_cast<const Ch*>(newline) : end;
+            if (!IsBlank(begin, lineEnd) && !f(begin, lineEnd, line))
+                return ~size_t(0);
+            ++line;
+            begin = lineEnd + (newline ? 1 : 0);
+        }
+        return line;
+    }
+
+    template <unsigned parseFlags>
+    void DocumentWorker(const Ch* text, DocumentSlot* slots, DocumentSchedule& schedule) {
+        const size_t chunkCount = bounds_.size() - 1;
+        for (;;) {
+            size_t chunk;
+            {
+                std::unique_lock<std::mutex> lock(schedule.mutex);
+                schedule.changed.wait(lock, [&schedule, chunkCount] {
+                    return schedule.stop || schedule.next == chunkCount || schedule.next < schedule.delivered + schedule.slotCount;
+                });
+                if (schedule.stop || schedule.next == chunkCount)
+                    return;
+                chunk = schedule.next++;
+            }
+
+            DocumentSlot& slot = slots[chunk % schedule.slotCount];
+            slot.documents.clear();
+            slot.lines.clear();
+            slot.allocator.Clear();
+            slot.lineCount = ForEachLine(text + bounds_[chunk], text + bounds_[chunk + 1], [&slot](const Ch* begin, const Ch* end, size_t line) {
+                slot.documents.emplace_back(&slot.allocator);
+                slot.documents.back().template Parse<parseFlags>(begin, static_cast<size_t>(end - begin));
+                slot.lines.push_back(line);
+                return true;
+            });
+
+            std::lock_guard<std::mutex> lock(schedule.mutex);
+            slot.ready = true;
+            schedule.changed.notify_all();
+        }
+    }
+
+    template <unsigned parseFlags, typename Handler>
+    void SaxWorker(const Ch* text, Handler& handler, SaxSchedule& schedule) {
+        GenericReader<UTF8<>, UTF8<> > reader;
+        const size_t chunkCount = bounds_.size() - 1;
+        for (;;) {
+            const size_t chunk = schedule.next++;
+            if (chunk >= chunkCount)
+                return;
+            {
+                // Later chunks cannot change the first error.
+                std::lock_guard<std::mutex> lock(schedule.mutex);
+                if (schedule.stop || chunk > schedule.failedChunk)
+                    return;
+            }
+
+            ParseResult result;
+            ForEachLine(text + bounds_[chunk], text + bounds_[chunk + 1], [&](const Ch* begin, const Ch* end, size_t) {
+                MemoryStream ms(begin, static_cast<size_t>(end - begin));
+                EncodedInputStream<UTF8<>, MemoryStream> is(ms);
+                result = reader.template Parse<parseFlags>(is, handler);
+                if (result.IsError())
+                    result.Set(result.Code(), static_cast<size_t>(begin - text) + result.Offset());
+                return !result.IsError();
+            });
+
+            if (result.IsError()) {
+                std::lock_guard<std::mutex> lock(schedule.mutex);
+                if (chunk < schedule.failedChunk) {
+                    schedule.failedChunk = chunk;
+                    schedule.result = result;
+                }
+            }
+        }
+    }
+
+    size_t threadCount_;
+    size_t chunkSize_;
+    std::vector<size_t> bounds_;
+};
+
+//! NDJSON reader that builds Document objects.
+typedef GenericNdjsonReader<CrtAllocator> NdjsonReader;
+
+RAPIDJSON_NAMESPACE_END
+
+#ifdef __clang__
+RAPIDJSON_DIAG_POP
+#endif
+
+#endif // RAPIDJSON_NDJSONREADER_H_
@@ -1406,6 +1406,190 @@ bool EraseValueByPointer(T& root, const CharType(&source)[N]) {
 
 //@}
 
+///////////////////////////////////////////////////////////////////////////////
+// GenericPointerSet
+
+//! A set of JSON pointers that are resolved together.
+/*!
+    The pointers are merged into a tree of tokens, so Get() resolves a token shared by several
+    pointers (e.g. "/meta" of "/meta/id" and "/meta/time") only once and finds all values in a
+    single traversal of the document.
+
+    Each token also remembers the position of the member it was found at last. Documents of
+    the same shape usually keep their members in the same order, so the next Get() checks that
+    position first and only falls back to GenericValue::FindMember() (which uses the hashed
+    member index with \ref RAPIDJSON_MEMBER_INDEX) when it moved. For an object with duplicate
+    member names this may find another member than GenericPointer::Get().
+
+    As Get() updates these positions, a set must not be used by several threads at once.
+
+    \tparam ValueType The value type of the DOM tree. E.g. GenericValue<UTF8<> >
+    \tparam Allocator The allocator type for allocating memory for internal representation.
+*/
+template <typename ValueType, typename Allocator = CrtAllocator>
+class GenericPointerSet {
+public:
+    typedef GenericPointer<ValueType, Allocator> PointerType;   //!< Pointer type of this set
+    typedef typename ValueType::EncodingType EncodingType;      //!< Encoding type from Value
+    typedef typename ValueType::Ch Ch;                          //!< Character type from Value
+
+    //! Constructor.
+    /*!
+        \param allocator User supplied allocator for this set. If no allocator is provided, it creates a self-owned one.
+    */
+    GenericPointerSet(Allocator* allocator = 0) : nodes_(allocator, kDefaultNodeCapacity * sizeof(Node)), names_(allocator, kDefaultNameCapacity * sizeof(Ch)), targetCount_() {
+        PushNode(0, 0, kPointerInvalidIndex);   // root
+    }
+
+    //! Adds a pointer to the set.
+    /*!
+        \param pointer A valid pointer.
+        \return Position of the pointer's value in the results of Get(). A pointer that is
+            already in the set keeps its position.
+    */
+    SizeType Add(const PointerType& pointer) {
+        RAPIDJSON_ASSERT(pointer.IsValid());
+        SizeType n = 0;
+        const typename PointerType::Token* tokens = pointer.GetTokens();
+        for (size_t i = 0; i < pointer.GetTokenCount(); i++) {
+            SizeType c = FindChild(n, tokens[i]);
+            if (c == 0) {
+                c = PushNode(tokens[i].name, tokens[i].length, tokens[i].index);
+                Node* nodes = nodes_.template Bottom<Node>();
+                nodes[c].nextSibling = nodes[n].firstChild;
+                nodes[n].firstChild = c;
+            }
+            n = c;
+        }
+        Node& node = nodes_.template Bottom<Node>()[n];
+        if (node.target == kPointerInvalidIndex)
+            node.target = targetCount_++;
+        return node.target;
+    }
+
+    //! Number of distinct pointers in the set, and the size of the results of Get().
+    SizeType GetCount() const { return targetCount_; }
+
+    //! Resolves all pointers of the set.
+    /*!
+        \param root Root value of a DOM subtree to be resolved. It can be any value other than document root.
+        \param results Array of GetCount() values. results[i] is set to the value of the pointer
+            at position i, or null if it cannot be resolved.
+        \return Number of pointers that were resolved.
+    */
+    SizeType Get(ValueType& root, ValueType** results) {
+        for (SizeType i = 0; i < targetCount_; i++)
+            results[i] = 0;
+        SizeType resolved = 0;
+        const SizeType rootTarget = nodes_.template Bottom<Node>()->target;
+        if (rootTarget != kPointerInvalidIndex) {
+            results[rootTarget] = &root;
+            ++resolved;
+        }
+        return resolved + Resolve(0, root, results);
+    }
+
+    //! Resolves all pointers of the set in a const subtree.
+    SizeType Get(const ValueType& root, const ValueType** results) {
+        return Get(const_cast<ValueType&>(root), const_cast<ValueType**>(results));
+    }
+
+private:
+    static const size_t kDefaultNodeCapacity = 16;
+    static const size_t kDefaultNameCapacity = 256;
+
+    //! A token of one or more pointers, linked to the tokens that follow it.
+    struct Node {
+        size_t name;            //!< Offset of the null-terminated name in names_.
+        SizeType length;        //!< Length of the name.
+        SizeType index;         //!< A valid array index, if it is not equal to kPointerInvalidIndex.
+        SizeType firstChild;    //!< First following token, 0 if none.
+        SizeType nextSibling;   //!< Next token with the same parent, 0 if none.
+        SizeType target;        //!< Position in the results for a pointer ending here, or kPointerInvalidIndex.
+        SizeType hint;          //!< Member position at which the name was found last.
+    };
+
+    GenericPointerSet(const GenericPointerSet&);
+    GenericPointerSet& operator=(const GenericPointerSet&);
+
+    SizeType PushNode(const Ch* name, SizeType length, SizeType index) {
+        const SizeType n = static_cast<SizeType>(nodes_.GetSize() / sizeof(Node));
+        const size_t offset = names_.GetSize() / sizeof(Ch);
+        Ch* buffer = names_.template Push<Ch>(length + 1);
+        if (length)
+            std::memcpy(buffer, name, length * sizeof(Ch));
+        buffer[length] = '\0';
+
+        Node* node = nodes_.template Push<Node>();
+        node->name = offset;
+        node->length = length;
+        node->index = index;
+        node->firstChild = 0;
+        node->nextSibling = 0;
+        node->target = kPointerInvalidIndex;
+        node->hint = 0;
+        return n;
+    }
+
+    SizeType FindChild(SizeType parent, const typename PointerType::Token& token) const {
+        const Node* nodes = nodes_.template Bottom<Node>();
+        const Ch* names = names_.template Bottom<Ch>();
+        for (SizeType c = nodes[parent].firstChild; c != 0; c = nodes[c].nextSibling)
+            if (nodes[c].length == token.length && (token.length == 0 || std::memcmp(names + nodes[c].name, token.name, token.length * sizeof(Ch)) == 0))
+                return c;
+        return 0;
+    }
+
+    SizeType Resolve(SizeType parent, ValueType& v, ValueType** results) {
+        SizeType resolved = 0;
+        for (SizeType c = nodes_.template Bottom<Node>()[parent].firstChild; c != 0; c = nodes_.template Bottom<Node>()[c].nextSibling) {
+            Node& node = nodes_.template Bottom<Node>()[c];
+            ValueType* child = GetChild(node, v);
+            if (!child)
+                continue;
+            if (node.target != kPointerInvalidIndex) {
+                results[node.target] = child;
+                ++resolved;
+            }
+            if (node.firstChild != 0)
+                resolved += Resolve(c, *child, results);
+        }
+        return resolved;
+    }
+
+    ValueType* GetChild(Node& node, ValueType& v) {
+        switch (v.GetType()) {
+        case kObjectType:
+            {
+                const Ch* name = names_.template Bottom<Ch>() + node.name;
+                if (node.hint < v.MemberCount()) {
+                    typename ValueType::MemberIterator m = v.MemberBegin() + node.hint;
+                    if (m->name.GetStringLength() == node.length && (node.length == 0 || std::memcmp(m->name.GetString(), name, node.length * sizeof(Ch)) == 0))
+                        return &m->value;
+                }
+                typename ValueType::MemberIterator m = v.FindMember(GenericValue<EncodingType>(GenericStringRef<Ch>(name, node.length)));
+                if (m == v.MemberEnd())
+                    return 0;
+                node.hint = static_cast<SizeType>(m - v.MemberBegin());
+                return &m->value;
+            }
+        case kArrayType:
+            if (node.index == kPointerInvalidIndex || node.index >= v.Size())
+                return 0;
+            return &v[node.index];
+        default:
+            return 0;
+        }
+    }
+
+    internal::Stack<Allocator> nodes_;  //!< Nodes of the token tree, the root first.
+    internal::Stack<Allocator> names_;  //!< Names of all tokens.
+    SizeType targetCount_;              //!< Number of distinct pointers.
+};
+
+//! GenericPointerSet for Value (UTF-8, default allocator).
+typedef GenericPointerSet<Value> PointerSet;
+
 RAPIDJSON_NAMESPACE_END
 
 #if defined(__clang__) || defined(_MSC_VER)
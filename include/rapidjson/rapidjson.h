@@ -319,6 +319,38 @@
 #define RAPIDJSON_GETPOINTER(type, p) (p)
 #endif
 
+///////////////////////////////////////////////////////////////////////////////
+// RAPIDJSON_MEMBER_INDEX
+
+/*! \def RAPIDJSON_MEMBER_INDEX
+    \ingroup RAPIDJSON_CONFIG
+    \brief Enable a hashed member index for large objects.
+
+    By default \c GenericValue::FindMember (and therefore \c operator[],
+    \c HasMember and \c GenericValue::operator==) scans the members of an
+    object linearly. Defining \c RAPIDJSON_MEMBER_INDEX to 1 gives every
+    object whose member capacity reaches \ref RAPIDJSON_MEMBER_INDEX_THRESHOLD
+    an open addressing hash table over its member names, which makes these
+    lookups constant time on average. The table is kept up to date by
+    \c AddMember, \c RemoveMember and \c EraseMember.
+
+    Smaller objects keep the default layout. The index of an object is
+    built from its member names; renaming a member in place through a
+    member iterator is not supported while it is indexed.
+*/
+#ifndef RAPIDJSON_MEMBER_INDEX
+#define RAPIDJSON_MEMBER_INDEX 0
+#endif
+
+/*! \def RAPIDJSON_MEMBER_INDEX_THRESHOLD
+    \ingroup RAPIDJSON_CONFIG
+    \brief Member capacity from which an object is indexed (default: 32).
+    \see RAPIDJSON_MEMBER_INDEX
+*/
+#ifndef RAPIDJSON_MEMBER_INDEX_THRESHOLD
+#define RAPIDJSON_MEMBER_INDEX_THRESHOLD 32
+#endif
+
 ///////////////////////////////////////////////////////////////////////////////
 // RAPIDJSON_SSE2/RAPIDJSON_SSE42/RAPIDJSON_NEON/RAPIDJSON_SIMD
 
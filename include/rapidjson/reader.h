@@ -23,6 +23,7 @@
 #include "internal/meta.h"
 #include "internal/stack.h"
 #include "internal/strtod.h"
+#include "internal/structuralindex.h"
 #include <limits>
 
 #if defined(RAPIDJSON_SIMD) && defined(_MSC_VER)
@@ -153,6 +154,7 @@ enum ParseFlag {
     kParseNumbersAsStringsFlag = 64,    //!< Parse all numbers (ints/doubles) as strings.
     kParseTrailingCommasFlag = 128, //!< Allow trailing commas at the end of objects and arrays.
     kParseNanAndInfFlag = 256,      //!< Allow parsing NaN, Inf, Infinity, -Inf and -Infinity as doubles.
+    kParseStructuralIndexFlag = 512,    //!< Locate all tokens with SIMD first, then parse from the index. Used for string and memory streams without comments.
     kParseDefaultFlags = RAPIDJSON_PARSE_DEFAULT_FLAGS  //!< Default parse flags. Can be customized by defining RAPIDJSON_PARSE_DEFAULT_FLAGS
 };
 
@@ -558,6 +560,9 @@ public:
         if (parseFlags & kParseIterativeFlag)
             return IterativeParse<parseFlags>(is, handler);
 
+        if ((parseFlags & kParseStructuralIndexFlag) && !(parseFlags & kParseCommentsFlag))
+            return StructuralParse<parseFlags>(is, handler);
+
         parseResult_.Clear();
 
         ClearStackOnExit scope(*this);
@@ -705,6 +710,16 @@ private:
         ClearStackOnExit& operator=(const ClearStackOnExit&);
     };
 
+    // text and tokens of structural index parsing
+    struct StructuralText {
+        StructuralText(Ch* h, size_t begin, size_t e, bool t) : head(h), end(e), terminated(t), tokens(h, begin, e) {}
+
+        Ch* head;
+        size_t end;
+        bool terminated;    // head[end] == '\0'
+        internal::StructuralTokens tokens;
+    };
+
     template<unsigned parseFlags, typename InputStream>
     void SkipWhitespaceAndComments(InputStream& is) {
         SkipWhitespace(is);
@@ -1748,6 +1763,311 @@ private:
         }
     }
 
+    // Structural index parsing
+    //
+    // Stage 1 (internal::StructuralIndexer) locates every token of the text with SIMD, stage 2
+    // below descends through the tokens like ParseObject() and ParseArray(). Strings, numbers
+    // and literals are still parsed by the functions above, so both parsers report the same
+    // events and errors.
+
+    // String streams, and streams derived from them (e.g. MmapReadStream), hold the whole text.
+    template<typename InputStream, typename StringStreamType>
+    struct IsStructuralText : internal::AndExpr<internal::IsSame<Ch, char>, internal::IsBaseOf<StringStreamType, InputStream> >::Type {};
+
+    // Streams without a contiguous text use the regular parser.
+    template<unsigned parseFlags, typename InputStream, typename Handler>
+    RAPIDJSON_DISABLEIF_RETURN((internal::OrExpr<IsStructuralText<InputStream, GenericStringStream<SourceEncoding> >, IsStructuralText<InputStream, GenericInsituStringStream<SourceEncoding> > >), (ParseResult))
+    StructuralParse(InputStream& is, Handler& handler) {
+        return Parse<parseFlags & ~static_cast<unsigned>(kParseStructuralIndexFlag)>(is, handler);
+    }
+
+    template<unsigned parseFlags, typename InputStream, typename Handler>
+    RAPIDJSON_ENABLEIF_RETURN((IsStructuralText<InputStream, GenericStringStream<SourceEncoding> >), (ParseResult))
+    StructuralParse(InputStream& stream, Handler& handler) {
+        GenericStringStream<SourceEncoding>& is = stream;
+        size_t position = is.Tell();
+        const size_t end = position + std::strlen(is.src_);
+        StructuralParseText<parseFlags, GenericStringStream<SourceEncoding> >(const_cast<Ch*>(is.head_), end, true, position, handler);
+        is.src_ = is.head_ + (HasParseError() ? parseResult_.Offset() : position);
+        return parseResult_;
+    }
+
+    template<unsigned parseFlags, typename InputStream, typename Handler>
+    RAPIDJSON_ENABLEIF_RETURN((IsStructuralText<InputStream, GenericInsituStringStream<SourceEncoding> >), (ParseResult))
+    StructuralParse(InputStream& stream, Handler& handler) {
+        GenericInsituStringStream<SourceEncoding>& is = stream;
+        size_t position = is.Tell();
+        const size_t end = position + std::strlen(is.src_);
+        StructuralParseText<parseFlags, GenericInsituStringStream<SourceEncoding> >(is.head_, end, true, position, handler);
+        is.src_ = is.head_ + (HasParseError() ? parseResult_.Offset() : position);
+        return parseResult_;
+    }
+
+    template<unsigned parseFlags, typename Encoding, typename Handler>
+    RAPIDJSON_ENABLEIF_RETURN((internal::AndExpr<internal::IsSame<Encoding, UTF8<> >, internal::IsSame<Ch, char> >), (ParseResult))
+    StructuralParse(EncodedInputStream<Encoding, MemoryStream>& is, Handler& handler) {
+        MemoryStream& ms = is.is_;
+        size_t position = ms.Tell();
+        // Nothing is left to scan, and the buffer of an empty stream may be null.
+        if (RAPIDJSON_UNLIKELY(ms.src_ == ms.end_)) {
+            parseResult_.Clear();
+            RAPIDJSON_PARSE_ERROR_NORETURN(kParseErrorDocumentEmpty, position);
+            return parseResult_;
+        }
+        // Like Peek(), treat the first '\0' as the end of the text.
+        const void* nul = std::memchr(ms.src_, '\0', static_cast<size_t>(ms.end_ - ms.src_));
+        const size_t end = static_cast<size_t>((nul ? static_cast<const Ch*>(nul) : ms.end_) - ms.begin_);
+        StructuralParseText<parseFlags, GenericStringStream<SourceEncoding> >(const_cast<Ch*>(ms.begin_), end, nul != 0, position, handler);
+        ms.src_ = ms.begin_ + (HasParseError() ? parseResult_.Offset() : position);
+        return parseResult_;
+    }
+
+    // Parses head[position, end) and leaves position after the root value (or at the end of the text).
+    // Unless terminated, head[end] may not be readable.
+    template<unsigned parseFlags, typename LeafStream, typename Handler>
+    void StructuralParseText(Ch* head, size_t end, bool terminated, size_t& position, Handler& handler) {
+        parseResult_.Clear();
+        ClearStackOnExit scope(*this);
+        StructuralText text(head, position, end, terminated);
+
+        const size_t p = text.tokens.Peek();
+        if (RAPIDJSON_UNLIKELY(p == end)) {
+            position = end;
+            RAPIDJSON_PARSE_ERROR(kParseErrorDocumentEmpty, end);
+        }
+
+        const ParseErrorCode strayError = (parseFlags & kParseStopWhenDoneFlag) ? kParseErrorNone : kParseErrorDocumentRootNotSingular;
+        StructuralParseValue<parseFlags, LeafStream>(text, strayError, position, handler);
+        RAPIDJSON_PARSE_ERROR_EARLY_RETURN_VOID;
+
+        if (!(parseFlags & kParseStopWhenDoneFlag)) {
+            const size_t q = text.tokens.Peek();
+            if (RAPIDJSON_UNLIKELY(q != end))
+                RAPIDJSON_PARSE_ERROR(kParseErrorDocumentRootNotSingular, q);
+            position = end;
+        }
+    }
+
+    // Parses the value at the current token. strayError is reported if a number or literal is
+    // followed by anything but whitespace and the next token (kParseErrorNone to accept it).
+    template<unsigned parseFlags, typename LeafStream, typename Handler>
+    void StructuralParseValue(StructuralText& text, ParseErrorCode strayError, size_t& position, Handler& handler) {
+        const size_t p = text.tokens.Peek();
+        const Ch c = p < text.end ? text.head[p] : '\0';
+        switch (c) {
+            case '{': StructuralParseObject<parseFlags, LeafStream>(text, position, handler); return;
+            case '[': StructuralParseArray <parseFlags, LeafStream>(text, position, handler); return;
+            case '\0': RAPIDJSON_PARSE_ERROR(kParseErrorValueInvalid, p);
+            default: break;
+        }
+
+        position = StructuralParseLeaf<parseFlags, LeafStream>(text, false, handler);
+        RAPIDJSON_PARSE_ERROR_EARLY_RETURN_VOID;
+
+        if (c != '"' && strayError != kParseErrorNone) {
+            size_t q = position;
+            while (q < text.end && (text.head[q] == ' ' || text.head[q] == '\n' || text.head[q] == '\r' || text.head[q] == '\t'))
+                ++q;
+            if (RAPIDJSON_UNLIKELY(q != text.tokens.Peek()))
+                RAPIDJSON_PARSE_ERROR(strayError, q);
+        }
+    }
+
+    template<unsigned parseFlags, typename LeafStream, typename Handler>
+    void StructuralParseObject(StructuralText& text, size_t& position, Handler& handler) {
+        size_t p = text.tokens.Peek();
+        RAPIDJSON_ASSERT(text.head[p] == '{');
+        text.tokens.Skip();
+
+        if (RAPIDJSON_UNLIKELY(!handler.StartObject()))
+            RAPIDJSON_PARSE_ERROR(kParseErrorTermination, p + 1);
+
+        p = text.tokens.Peek();
+        if (p < text.end && text.head[p] == '}') {
+            text.tokens.Skip();
+            position = p + 1;
+            if (RAPIDJSON_UNLIKELY(!handler.EndObject(0)))  // empty object
+                RAPIDJSON_PARSE_ERROR(kParseErrorTermination, p + 1);
+            return;
+        }
+
+        for (SizeType memberCount = 0;;) {
+            if (RAPIDJSON_UNLIKELY(p == text.end || text.head[p] != '"'))
+                RAPIDJSON_PARSE_ERROR(kParseErrorObjectMissName, p);
+
+            StructuralParseLeaf<parseFlags, LeafStream>(text, true, handler);
+            RAPIDJSON_PARSE_ERROR_EARLY_RETURN_VOID;
+
+            p = text.tokens.Peek();
+            if (RAPIDJSON_UNLIKELY(p == text.end || text.head[p] != ':'))
+                RAPIDJSON_PARSE_ERROR(kParseErrorObjectMissColon, p);
+            text.tokens.Skip();
+
+            StructuralParseValue<parseFlags, LeafStream>(text, kParseErrorObjectMissCommaOrCurlyBracket, position, handler);
+            RAPIDJSON_PARSE_ERROR_EARLY_RETURN_VOID;
+
+            ++memberCount;
+
+            p = text.tokens.Peek();
+            switch (p < text.end ? text.head[p] : '\0') {
+                case ',':
+                    text.tokens.Skip();
+                    p = text.tokens.Peek();
+                    break;
+                case '}':
+                    text.tokens.Skip();
+                    position = p + 1;
+                    if (RAPIDJSON_UNLIKELY(!handler.EndObject(memberCount)))
+                        RAPIDJSON_PARSE_ERROR(kParseErrorTermination, p + 1);
+                    return;
+                default:
+                    RAPIDJSON_PARSE_ERROR(kParseErrorObjectMissCommaOrCurlyBracket, p); break; // This useless break is only for making warning and coverage happy
+            }
+
+            if (parseFlags & kParseTrailingCommasFlag) {
+                if (p < text.end && text.head[p] == '}') {
+                    if (RAPIDJSON_UNLIKELY(!handler.EndObject(memberCount)))
+                        RAPIDJSON_PARSE_ERROR(kParseErrorTermination, p);
+                    text.tokens.Skip();
+                    position = p + 1;
+                    return;
+                }
+            }
+        }
+    }
+
+    template<unsigned parseFlags, typename LeafStream, typename Handler>
+    void StructuralParseArray(StructuralText& text, size_t& position, Handler& handler) {
+        size_t p = text.tokens.Peek();
+        RAPIDJSON_ASSERT(text.head[p] == '[');
+        text.tokens.Skip();
+
+        if (RAPIDJSON_UNLIKELY(!handler.StartArray()))
+            RAPIDJSON_PARSE_ERROR(kParseErrorTermination, p + 1);
+
+        p = text.tokens.Peek();
+        if (p < text.end && text.head[p] == ']') {
+            text.tokens.Skip();
+            position = p + 1;
+            if (RAPIDJSON_UNLIKELY(!handler.EndArray(0))) // empty array
+                RAPIDJSON_PARSE_ERROR(kParseErrorTermination, p + 1);
+            return;
+        }
+
+        for (SizeType elementCount = 0;;) {
+            StructuralParseValue<parseFlags, LeafStream>(text, kParseErrorArrayMissCommaOrSquareBracket, position, handler);
+            RAPIDJSON_PARSE_ERROR_EARLY_RETURN_VOID;
+
+            ++elementCount;
+
+            p = text.tokens.Peek();
+            const Ch c = p < text.end ? text.head[p] : '\0';
+            if (c == ',') {
+                text.tokens.Skip();
+                p = text.tokens.Peek();
+            }
+            else if (c == ']') {
+                text.tokens.Skip();
+                position = p + 1;
+                if (RAPIDJSON_UNLIKELY(!handler.EndArray(elementCount)))
+                    RAPIDJSON_PARSE_ERROR(kParseErrorTermination, p + 1);
+                return;
+            }
+            else
+                RAPIDJSON_PARSE_ERROR(kParseErrorArrayMissCommaOrSquareBracket, p);
+
+            if (parseFlags & kParseTrailingCommasFlag) {
+                if (p < text.end && text.head[p] == ']') {
+                    if (RAPIDJSON_UNLIKELY(!handler.EndArray(elementCount)))
+                        RAPIDJSON_PARSE_ERROR(kParseErrorTermination, p);
+                    text.tokens.Skip();
+                    position = p + 1;
+                    return;
+                }
+            }
+        }
+    }
+
+    // Parses the string, number or literal at the current token and returns the offset after it.
+    template<unsigned parseFlags, typename LeafStream, typename Handler>
+    size_t StructuralParseLeaf(StructuralText& text, bool isKey, Handler& handler) {
+        const size_t p = text.tokens.Peek();
+        text.tokens.Skip();
+        // Peeking makes stage 1 scan past this token, before an in-situ string is rewritten.
+        const size_t next = text.tokens.Peek();
+        if (text.head[p] == '"' && internal::IsSame<SourceEncoding, TargetEncoding>::Value && !(parseFlags & kParseValidateEncodingFlag)) {
+            size_t after;
+            if (StructuralParsePlainString<parseFlags>(text.head, p, next, isKey, after, handler))
+                return after;
+        }
+        if (RAPIDJSON_UNLIKELY(next == text.end) && !text.terminated) {
+            // The last token of a text that is not NUL terminated is parsed from a terminated copy.
+            const size_t length = text.end - p;
+            internal::Stack<StackAllocator> copy(0, (length + 1) * sizeof(Ch));
+            Ch* head = copy.template Push<Ch>(length + 1);
+            std::memcpy(head, text.head + p, length * sizeof(Ch));
+            head[length] = '\0';
+            const size_t q = p + ParseLeaf<parseFlags, LeafStream>(head, 0, isKey, handler);
+            if (HasParseError())
+                SetParseError(parseResult_.Code(), p + parseResult_.Offset());
+            return q;
+        }
+        return ParseLeaf<parseFlags, LeafStream>(text.head, p, isKey, handler);
+    }
+
+    // A string is followed by whitespace and the next token, so the index tells where it ends.
+    // Strings without escapes are then copied (or terminated in-situ) in one go. Returns false
+    // for strings that need ParseString().
+    template<unsigned parseFlags, typename Handler>
+    bool StructuralParsePlainString(Ch* head, size_t p, size_t next, bool isKey, size_t& after, Handler& handler) {
+        size_t e = next;
+        while (e > p + 1 && (head[e - 1] == ' ' || head[e - 1] == '\n' || head[e - 1] == '\r' || head[e - 1] == '\t'))
+            --e;
+        if (e <= p + 1 || head[e - 1] != '"')
+            return false;   // unterminated
+
+        const Ch* str = head + p + 1;
+        const size_t length = e - 1 - (p + 1);
+        unsigned special = 0;
+        for (size_t i = 0; i < length; i++) {
+            const unsigned c = static_cast<unsigned char>(str[i]);
+            special |= static_cast<unsigned>(c == '\\') | static_cast<unsigned>(c < 0x20);
+        }
+        if (special || length > 0xFFFFFFFFu)
+            return false;
+
+        bool success;
+        if (parseFlags & kParseInsituFlag) {
+            head[e - 1] = '\0';
+            success = isKey ? handler.Key(str, SizeType(length), false) : handler.String(str, SizeType(length), false);
+        }
+        else {
+            Ch* copy = stack_.template Push<Ch>(length + 1);
+            std::memcpy(copy, str, length * sizeof(Ch));
+            copy[length] = '\0';
+            stack_.template Pop<Ch>(length + 1);
+            success = isKey ? handler.Key(copy, SizeType(length), true) : handler.String(copy, SizeType(length), true);
+        }
+        after = e;
+        if (RAPIDJSON_UNLIKELY(!success))
+            RAPIDJSON_PARSE_ERROR_NORETURN(kParseErrorTermination, e);
+        return true;
+    }
+
+    template<unsigned parseFlags, typename LeafStream, typename Handler>
+    size_t ParseLeaf(Ch* head, size_t p, bool isKey, Handler& handler) {
+        LeafStream s(head);
+        s.src_ = head + p;
+        switch (head[p]) {
+            case 'n': ParseNull  <parseFlags>(s, handler); break;
+            case 't': ParseTrue  <parseFlags>(s, handler); break;
+            case 'f': ParseFalse <parseFlags>(s, handler); break;
+            case '"': ParseString<parseFlags>(s, handler, isKey); break;
+            default : ParseNumber<parseFlags>(s, handler); break;
+        }
+        return s.Tell();
+    }
+
     // Iterative Parsing
 
     // States
@@ -149,6 +149,7 @@ public:
     virtual ~ISchemaStateFactory() {}
     virtual ISchemaValidator* CreateSchemaValidator(const SchemaType&) = 0;
     virtual void DestroySchemaValidator(ISchemaValidator* validator) = 0;
+    virtual bool* GetPatternPropertyMatches(const SchemaType&, const typename SchemaType::Ch* str, SizeType length, SizeType count, bool* found) = 0;
     virtual void* CreateHasher() = 0;
     virtual uint64_t GetHashCode(void* hasher) = 0;
     virtual void DestroryHasher(void* hasher) = 0;
@@ -309,6 +310,129 @@ private:
     Stack<Allocator> stack_;
 };
 
+///////////////////////////////////////////////////////////////////////////////
+// Name hashing
+
+// FNV-1a of a property name
+template <typename Ch>
+inline uint64_t HashName(const Ch* str, SizeType length) {
+    uint64_t h = RAPIDJSON_UINT64_C2(0xcbf29ce4, 0x84222325);
+    for (SizeType i = 0; i < length; i++) {
+        h ^= static_cast<uint64_t>(str[i]);
+        h *= RAPIDJSON_UINT64_C2(0x00000100, 0x000001b3);
+    }
+    return h;
+}
+
+// Finalizer of MurmurHash3 applied to a hash plus a seed, spreads it over all bits
+inline uint64_t MixHash(uint64_t h, uint64_t seed) {
+    h += seed * RAPIDJSON_UINT64_C2(0x9e3779b9, 0x7f4a7c15);
+    h ^= h >> 33;
+    h *= RAPIDJSON_UINT64_C2(0xff51afd7, 0xed558ccd);
+    h ^= h >> 33;
+    h *= RAPIDJSON_UINT64_C2(0xc4ceb9fe, 0x1a85ec53);
+    h ^= h >> 33;
+    return h;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// PatternPropertyCache
+
+// Remembers which pattern properties of a schema match an object key, so that the regular
+// expressions run once per distinct key instead of once per key of every object. Entries are
+// kept in one buffer and the cache starts over once it holds kMaxEntries keys.
+template <typename Ch, typename Allocator>
+class PatternPropertyCache {
+public:
+    PatternPropertyCache(Allocator* allocator) : entries_(allocator, kInitialEntryCapacity), slots_(allocator, 0), count_() {}
+
+    // Returns the results of the count pattern properties of schema for a key. For a new entry
+    // *found is false and the caller fills in the results.
+    bool* Get(const void* schema, const Ch* str, SizeType length, SizeType count, bool* found) {
+        const uint64_t h = MixHash(HashName(str, length), reinterpret_cast<uintptr_t>(schema));
+        if (!slots_.Empty()) {
+            const size_t mask = SlotCount() - 1;
+            for (size_t i = static_cast<size_t>(h) & mask; ; i = (i + 1) & mask) {
+                const size_t slot = slots_.template Bottom<size_t>()[i];
+                if (slot == 0)
+                    break;
+                Entry* e = GetEntry(slot - 1);
+                if (e->hash == h && e->schema == schema && e->length == length && std::memcmp(GetKey(e), str, length * sizeof(Ch)) == 0) {
+                    *found = true;
+                    return GetResults(e);
+                }
+            }
+        }
+
+        if (count_ >= kMaxEntries)
+            Clear();
+        if (2 * (count_ + 1) > SlotCount())
+            Rehash(SlotCount() ? 2 * SlotCount() : kInitialSlotCount);
+
+        const size_t offset = entries_.GetSize();
+        entries_.template Push<char>(EntrySize(length, count));
+        Entry* e = GetEntry(offset);
+        e->schema = schema;
+        e->hash = h;
+        e->length = length;
+        e->count = count;
+        std::memcpy(GetKey(e), str, length * sizeof(Ch));
+        Insert(e, offset);
+        count_++;
+        *found = false;
+        return GetResults(e);
+    }
+
+    void Clear() {
+        entries_.Clear();
+        if (!slots_.Empty())
+            std::memset(slots_.template Bottom<size_t>(), 0, slots_.GetSize());
+        count_ = 0;
+    }
+
+private:
+    static const size_t kInitialEntryCapacity = 1024;
+    static const size_t kInitialSlotCount = 64;
+    static const size_t kMaxEntries = 4096;
+
+    struct Entry {
+        const void* schema;
+        uint64_t hash;
+        SizeType length;
+        SizeType count;
+        // followed by the key and the results
+    };
+
+    static size_t EntrySize(SizeType length, SizeType count) { return RAPIDJSON_ALIGN(sizeof(Entry) + length * sizeof(Ch) + count * sizeof(bool)); }
+    size_t SlotCount() const { return slots_.GetSize() / sizeof(size_t); }
+    Entry* GetEntry(size_t offset) { return reinterpret_cast<Entry*>(entries_.template Bottom<char>() + offset); }
+    static Ch* GetKey(Entry* e) { return reinterpret_cast<Ch*>(e + 1); }
+    static bool* GetResults(Entry* e) { return reinterpret_cast<bool*>(GetKey(e) + e->length); }
+
+    // A slot holds the offset of an entry plus one, or 0 if it is empty.
+    void Insert(const Entry* e, size_t offset) {
+        const size_t mask = SlotCount() - 1;
+        size_t i = static_cast<size_t>(e->hash) & mask;
+        while (slots_.template Bottom<size_t>()[i] != 0)
+            i = (i + 1) & mask;
+        slots_.template Bottom<size_t>()[i] = offset + 1;
+    }
+
+    void Rehash(size_t slotCount) {
+        slots_.Clear();
+        std::memset(slots_.template Push<size_t>(slotCount), 0, slotCount * sizeof(size_t));
+        for (size_t offset = 0; offset < entries_.GetSize(); ) {
+            Entry* e = GetEntry(offset);
+            Insert(e, offset);
+            offset += EntrySize(e->length, e->count);
+        }
+    }
+
+    Stack<Allocator> entries_;
+    Stack<Allocator> slots_;
+    size_t count_;
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 // SchemaValidationContext
 
@@ -418,6 +542,9 @@ public:
         validatorCount_(),
         notValidatorIndex_(),
         properties_(),
+        propertyHash_(),
+        propertySlotMask_(),
+        propertyBucketMask_(),
         additionalPropertiesSchema_(),
         patternProperties_(),
         patternPropertyCount_(),
@@ -519,6 +646,7 @@ public:
                     properties_[i].name = allProperties[i];
                     properties_[i].schema = typeless_;
                 }
+                CreatePropertyHash();
             }
         }
 
@@ -651,6 +779,7 @@ public:
                 properties_[i].~Property();
             AllocatorType::Free(properties_);
         }
+        AllocatorType::Free(propertyHash_);
         if (patternProperties_) {
             for (SizeType i = 0; i < patternPropertyCount_; i++)
                 patternProperties_[i].~PatternProperty();
@@ -892,15 +1021,20 @@ public:
     bool Key(Context& context, const Ch* str, SizeType len, bool) const {
         if (patternProperties_) {
             context.patternPropertiesSchemaCount = 0;
+            bool found;
+            bool* matches = context.factory.GetPatternPropertyMatches(*this, str, len, patternPropertyCount_, &found);
+            if (!found)
+                for (SizeType i = 0; i < patternPropertyCount_; i++)
+                    matches[i] = patternProperties_[i].pattern && IsPatternMatch(patternProperties_[i].pattern, str, len);
             for (SizeType i = 0; i < patternPropertyCount_; i++)
-                if (patternProperties_[i].pattern && IsPatternMatch(patternProperties_[i].pattern, str, len)) {
+                if (matches[i]) {
                     context.patternPropertiesSchemas[context.patternPropertiesSchemaCount++] = patternProperties_[i].schema;
                     context.valueSchema = typeless_;
                 }
         }
 
         SizeType index;
-        if (FindPropertyIndex(ValueType(str, len).Move(), &index)) {
+        if (FindPropertyIndex(str, len, &index)) {
             if (context.patternPropertiesSchemaCount > 0) {
                 context.patternPropertiesSchemas[context.patternPropertiesSchemaCount++] = properties_[index].schema;
                 context.valueSchema = typeless_;
@@ -1070,6 +1204,9 @@ private:
         kTotalSchemaType
     };
 
+    static const SizeType kInvalidPropertyIndex = ~SizeType(0);
+    static const SizeType kMaxDisplacement = 65536;
+
 #if RAPIDJSON_SCHEMA_USE_INTERNALREGEX
         typedef internal::GenericRegex<EncodingType, AllocatorType> RegexType;
 #elif RAPIDJSON_SCHEMA_USE_STDREGEX
@@ -1218,20 +1355,115 @@ private:
             context.validators[schemas.begin + i] = context.factory.CreateSchemaValidator(*schemas.schemas[i]);
     }
 
-    // O(n)
     bool FindPropertyIndex(const ValueType& name, SizeType* outIndex) const {
-        SizeType len = name.GetStringLength();
-        const Ch* str = name.GetString();
-        for (SizeType index = 0; index < propertyCount_; index++)
+        return FindPropertyIndex(name.GetString(), name.GetStringLength(), outIndex);
+    }
+
+    // O(1)
+    bool FindPropertyIndex(const Ch* str, SizeType len, SizeType* outIndex) const {
+        SizeType index;
+        if (propertyHash_) {
+            const uint64_t h = HashName(str, len);
+            const SizeType displacement = propertyHash_[propertySlotMask_ + 1 + (static_cast<SizeType>(h >> 32) & propertyBucketMask_)];
+            index = propertyHash_[static_cast<SizeType>(MixHash(h, displacement)) & propertySlotMask_];
+            if (index == kInvalidPropertyIndex)
+                return false;
+        }
+        else
+            for (index = 0; index < propertyCount_ && properties_[index].name.GetStringLength() != len; index++)
+                ;
+        for (; index < propertyCount_; index++) {
             if (properties_[index].name.GetStringLength() == len && 
                 (std::memcmp(properties_[index].name.GetString(), str, sizeof(Ch) * len) == 0))
             {
                 *outIndex = index;
                 return true;
             }
+            if (propertyHash_)
+                break;
+        }
         return false;
     }
 
+    // Builds a perfect hash of the property names with "hash and displace": the upper half of a
+    // name's hash selects a bucket, and the displacement of that bucket is chosen such that all of
+    // its names land in slots of their own. Buckets are placed largest first. If no displacement
+    // is found in kMaxDisplacement tries the table is doubled; if that fails as well (e.g. two
+    // names with the same 64-bit hash), FindPropertyIndex() keeps scanning the names.
+    void CreatePropertyHash() {
+        SizeType bucketCount = 1;
+        while (bucketCount * 2 < propertyCount_)
+            bucketCount <<= 1;
+        SizeType slotCount = 2;
+        while (slotCount < propertyCount_ * 2)
+            slotCount <<= 1;
+
+        // Sort the properties by bucket (counting sort), and the buckets by size.
+        uint64_t* hashes = static_cast<uint64_t*>(allocator_->Malloc(sizeof(uint64_t) * propertyCount_));
+        SizeType* bucketStart = static_cast<SizeType*>(allocator_->Malloc(sizeof(SizeType) * (bucketCount + 2)));
+        SizeType* members = static_cast<SizeType*>(allocator_->Malloc(sizeof(SizeType) * propertyCount_));
+        SizeType* order = static_cast<SizeType*>(allocator_->Malloc(sizeof(SizeType) * bucketCount));
+        std::memset(bucketStart, 0, sizeof(SizeType) * (bucketCount + 2));
+        for (SizeType i = 0; i < propertyCount_; i++) {
+            hashes[i] = HashName(properties_[i].name.GetString(), properties_[i].name.GetStringLength());
+            bucketStart[(static_cast<SizeType>(hashes[i] >> 32) & (bucketCount - 1)) + 2]++;
+        }
+        SizeType maxBucketSize = 0;
+        for (SizeType b = 0; b < bucketCount; b++) {
+            if (bucketStart[b + 2] > maxBucketSize)
+                maxBucketSize = bucketStart[b + 2];
+            bucketStart[b + 2] += bucketStart[b + 1];
+        }
+        for (SizeType i = 0; i < propertyCount_; i++)  // afterwards bucket b is [bucketStart[b], bucketStart[b + 1])
+            members[bucketStart[(static_cast<SizeType>(hashes[i] >> 32) & (bucketCount - 1)) + 1]++] = i;
+        SizeType orderCount = 0;
+        for (SizeType size = maxBucketSize; size > 0; size--)
+            for (SizeType b = 0; b < bucketCount; b++)
+                if (bucketStart[b + 1] - bucketStart[b] == size)
+                    order[orderCount++] = b;
+
+        for (int attempt = 0; attempt < 4 && !propertyHash_; attempt++, slotCount <<= 1) {
+            SizeType* table = static_cast<SizeType*>(allocator_->Malloc(sizeof(SizeType) * (slotCount + bucketCount)));
+            for (SizeType i = 0; i < slotCount + bucketCount; i++)
+                table[i] = kInvalidPropertyIndex;
+
+            SizeType placed = 0;
+            for (; placed < orderCount; placed++) {
+                const SizeType b = order[placed];
+                SizeType displacement = 0;
+                for (; displacement < kMaxDisplacement; displacement++) {
+                    SizeType m = bucketStart[b];
+                    for (; m < bucketStart[b + 1]; m++) {
+                        SizeType& slot = table[static_cast<SizeType>(MixHash(hashes[members[m]], displacement)) & (slotCount - 1)];
+                        if (slot != kInvalidPropertyIndex)
+                            break;
+                        slot = members[m];
+                    }
+                    if (m == bucketStart[b + 1])
+                        break;
+                    while (m-- > bucketStart[b])    // undo
+                        table[static_cast<SizeType>(MixHash(hashes[members[m]], displacement)) & (slotCount - 1)] = kInvalidPropertyIndex;
+                }
+                if (displacement == kMaxDisplacement)
+                    break;
+                table[slotCount + b] = displacement;
+            }
+
+            if (placed == orderCount) {
+                propertyHash_ = table;
+                propertySlotMask_ = slotCount - 1;
+                propertyBucketMask_ = bucketCount - 1;
+            }
+            else
+                AllocatorType::Free(table);
+        }
+
+        AllocatorType::Free(hashes);
+        AllocatorType::Free(bucketStart);
+        AllocatorType::Free(members);
+        AllocatorType::Free(order);
+    }
+
     bool CheckInt(Context& context, int64_t i) const {
         if (!(type_ & ((1 << kIntegerSchemaType) | (1 << kNumberSchemaType)))) {
             DisallowedType(context, GetIntegerString());
@@ -1409,6 +1641,9 @@ private:
     SizeType notValidatorIndex_;
 
     Property* properties_;
+    SizeType* propertyHash_;        // slots of the perfect hash, followed by the displacements of the buckets
+    SizeType propertySlotMask_;
+    SizeType propertyBucketMask_;
     const SchemaType* additionalPropertiesSchema_;
     PatternProperty* patternProperties_;
     SizeType patternPropertyCount_;
@@ -1751,7 +1986,9 @@ typedef IGenericRemoteSchemaDocumentProvider<SchemaDocument> IRemoteSchemaDocume
     It uses a \c GenericSchemaDocument to validate SAX events.
     It delegates the incoming SAX events to an output handler.
     The default output handler does nothing.
-    It can be reused multiple times by calling \c Reset().
+    It can be reused multiple times by calling \c Reset(); the validators created for
+    sub-schemas (allOf, anyOf, patternProperties, ...) and the results of the patternProperties
+    regular expressions per key are kept for the next document.
 
     \tparam SchemaDocumentType Type of schema document.
     \tparam OutputHandler Type of output handler. Default handler does nothing.
@@ -1789,9 +2026,12 @@ public:
         size_t documentStackCapacity = kDefaultDocumentStackCapacity)
         :
         schemaDocument_(&schemaDocument),
-        root_(schemaDocument.GetRoot()),
+        root_(&schemaDocument.GetRoot()),
         stateAllocator_(allocator),
         ownStateAllocator_(0),
+        topLevel_(),
+        freeValidators_(0),
+        patternPropertyCache_(allocator),
         schemaStack_(allocator, schemaStackCapacity),
         documentStack_(allocator, documentStackCapacity),
         outputHandler_(0),
@@ -1803,6 +2043,7 @@ public:
         , depth_(0)
 #endif
     {
+        topLevel_ = this;
     }
 
     //! Constructor with output handler.
@@ -1820,9 +2061,12 @@ public:
         size_t documentStackCapacity = kDefaultDocumentStackCapacity)
         :
         schemaDocument_(&schemaDocument),
-        root_(schemaDocument.GetRoot()),
+        root_(&schemaDocument.GetRoot()),
         stateAllocator_(allocator),
         ownStateAllocator_(0),
+        topLevel_(),
+        freeValidators_(0),
+        patternPropertyCache_(allocator),
         schemaStack_(allocator, schemaStackCapacity),
         documentStack_(allocator, documentStackCapacity),
         outputHandler_(&outputHandler),
@@ -1834,11 +2078,18 @@ public:
         , depth_(0)
 #endif
     {
+        topLevel_ = this;
     }
 
     //! Destructor.
     ~GenericSchemaValidator() {
         Reset();
+        while (GenericSchemaValidator* v = freeValidators_) {
+            freeValidators_ = v->freeValidators_;
+            v->freeValidators_ = 0;
+            v->~GenericSchemaValidator();
+            StateAllocator::Free(v);
+        }
         RAPIDJSON_DELETE(ownStateAllocator_);
     }
 
@@ -2154,17 +2405,35 @@ RAPIDJSON_MULTILINEMACRO_END
 
     // Implementation of ISchemaStateFactory<SchemaType>
     virtual ISchemaValidator* CreateSchemaValidator(const SchemaType& root) {
+        // Reuse a validator of the top-level pool, with the stacks it has already grown
+        if (GenericSchemaValidator* v = topLevel_->freeValidators_) {
+            topLevel_->freeValidators_ = v->freeValidators_;
+            v->freeValidators_ = 0;
+            v->root_ = &root;
+            if (!documentStack_.Empty())
+                std::memcpy(v->documentStack_.template Push<char>(documentStack_.GetSize()), documentStack_.template Bottom<char>(), documentStack_.GetSize());
+#if RAPIDJSON_SCHEMA_VERBOSE
+            v->depth_ = depth_ + 1;
+#endif
+            return v;
+        }
         return new (GetStateAllocator().Malloc(sizeof(GenericSchemaValidator))) GenericSchemaValidator(*schemaDocument_, root, documentStack_.template Bottom<char>(), documentStack_.GetSize(),
 #if RAPIDJSON_SCHEMA_VERBOSE
         depth_ + 1,
 #endif
+        topLevel_,
         &GetStateAllocator());
     }
 
     virtual void DestroySchemaValidator(ISchemaValidator* validator) {
         GenericSchemaValidator* v = static_cast<GenericSchemaValidator*>(validator);
-        v->~GenericSchemaValidator();
-        StateAllocator::Free(v);
+        v->Reset();
+        v->freeValidators_ = topLevel_->freeValidators_;
+        topLevel_->freeValidators_ = v;
+    }
+
+    virtual bool* GetPatternPropertyMatches(const SchemaType& schema, const Ch* str, SizeType length, SizeType count, bool* found) {
+        return topLevel_->patternPropertyCache_.Get(&schema, str, length, count, found);
     }
 
     virtual void* CreateHasher() {
@@ -2201,14 +2470,18 @@ private:
 #if RAPIDJSON_SCHEMA_VERBOSE
         unsigned depth,
 #endif
+        GenericSchemaValidator* topLevel,
         StateAllocator* allocator = 0,
         size_t schemaStackCapacity = kDefaultSchemaStackCapacity,
         size_t documentStackCapacity = kDefaultDocumentStackCapacity)
         :
         schemaDocument_(&schemaDocument),
-        root_(root),
+        root_(&root),
         stateAllocator_(allocator),
         ownStateAllocator_(0),
+        topLevel_(topLevel),
+        freeValidators_(0),
+        patternPropertyCache_(allocator),
         schemaStack_(allocator, schemaStackCapacity),
         documentStack_(allocator, documentStackCapacity),
         outputHandler_(0),
@@ -2232,7 +2505,7 @@ private:
 
     bool BeginValue() {
         if (schemaStack_.Empty())
-            PushSchema(root_);
+            PushSchema(*root_);
         else {
             if (CurrentContext().inArray)
                 internal::TokenHelper<internal::Stack<StateAllocator>, Ch>::AppendIndexToken(documentStack_, CurrentContext().arrayElementIndex);
@@ -2399,9 +2672,12 @@ private:
     static const size_t kDefaultSchemaStackCapacity = 1024;
     static const size_t kDefaultDocumentStackCapacity = 256;
     const SchemaDocumentType* schemaDocument_;
-    const SchemaType& root_;
+    const SchemaType* root_;
     StateAllocator* stateAllocator_;
     StateAllocator* ownStateAllocator_;
+    GenericSchemaValidator* topLevel_;              //!< validator owning the pools below
+    GenericSchemaValidator* freeValidators_;        //!< sub-validators for reuse (in topLevel_), or the next of them
+    internal::PatternPropertyCache<Ch, StateAllocator> patternPropertyCache_;   //!< patternProperties results per key (in topLevel_)
     internal::Stack<StateAllocator> schemaStack_;    //!< stack to store the current path of schema (BaseSchemaType *)
     internal::Stack<StateAllocator> documentStack_;  //!< stack to store the current path of validating document (Ch)
     OutputHandler* outputHandler_;
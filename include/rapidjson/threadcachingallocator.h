@@ -0,0 +1,267 @@
+// Tencent is pleased to support the open source community by making RapidJSON available.
+//
+// Copyright (C) 2015 THL A29 Limited, a Tencent company, and Milo Yip. All rights reserved.
+//
+// Licensed under the MIT License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// http://opensource.org/licenses/MIT
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef RAPIDJSON_THREADCACHINGALLOCATOR_H_
+#define RAPIDJSON_THREADCACHINGALLOCATOR_H_
+
+#include "allocators.h"
+
+#if !RAPIDJSON_HAS_CXX11_RVALUE_REFS
+#error "ThreadCachingAllocator requires C++11"
+#endif
+
+#include <cstring>
+
+#ifdef __clang__
+RAPIDJSON_DIAG_PUSH
+RAPIDJSON_DIAG_OFF(padded)
+#endif
+
+RAPIDJSON_NAMESPACE_BEGIN
+
+/*! \def RAPIDJSON_THREAD_CACHE_GRANULARITY
+    \ingroup RAPIDJSON_CONFIG
+    \brief Granularity in bytes of the blocks cached by ThreadCachingAllocator.
+
+    Blocks, including their header, are rounded up to a multiple of this size.
+*/
+#ifndef RAPIDJSON_THREAD_CACHE_GRANULARITY
+#define RAPIDJSON_THREAD_CACHE_GRANULARITY (4 * 1024)
+#endif
+
+/*! \def RAPIDJSON_THREAD_CACHE_MAX_BLOCK
+    \ingroup RAPIDJSON_CONFIG
+    \brief Size in bytes of the largest block cached by ThreadCachingAllocator.
+
+    Larger blocks are always taken from and returned to the C runtime library.
+*/
+#ifndef RAPIDJSON_THREAD_CACHE_MAX_BLOCK
+#define RAPIDJSON_THREAD_CACHE_MAX_BLOCK (1024 * 1024)
+#endif
+
+/*! \def RAPIDJSON_THREAD_CACHE_MAX_RETAINED
+    \ingroup RAPIDJSON_CONFIG
+    \brief Maximum number of bytes retained by the cache of one thread.
+
+    A freed block that would take the cache of the thread above this size goes back to the
+    C runtime library.
+*/
+#ifndef RAPIDJSON_THREAD_CACHE_MAX_RETAINED
+#define RAPIDJSON_THREAD_CACHE_MAX_RETAINED (32 * 1024 * 1024)
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+// ThreadCacheStats
+
+//! Memory statistics of the calling thread, see ThreadCachingAllocator::GetThreadStats().
+struct ThreadCacheStats {
+    size_t allocated;       //!< Bytes in blocks handed out by Malloc()/Realloc() and not freed yet.
+    size_t peakAllocated;   //!< Maximum of allocated.
+    size_t retained;        //!< Bytes in freed blocks kept for reuse.
+    size_t peakRetained;    //!< Maximum of retained.
+    size_t heapAllocations; //!< Blocks taken from the C runtime library.
+    size_t heapFrees;       //!< Blocks returned to the C runtime library.
+    size_t cacheHits;       //!< Blocks served from the cache.
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// ThreadCachingAllocator
+
+//! Allocator that recycles memory blocks through a cache per thread.
+/*! Freed blocks are kept in a free list of the freeing thread, per size class, and a later
+    Malloc() of the same size class on that thread reuses them without calling the C runtime
+    library. It is meant as the \c BaseAllocator of MemoryPoolAllocator: the chunks of a
+    document are then recycled by the next document parsed on the same thread.
+
+    GenericDocument, MemoryPoolAllocator and internal::Stack create the allocators they are
+    not given with RAPIDJSON_NEW, which takes them from the global heap for every document.
+    The allocators should therefore be passed to the constructors, so that a thread in a
+    steady state of parsing does not call the global heap at all:
+
+    \code
+    typedef MemoryPoolAllocator<ThreadCachingAllocator> CachedPoolAllocator;
+    typedef GenericDocument<UTF8<>, CachedPoolAllocator, ThreadCachingAllocator> CachedDocument;
+
+    ThreadCachingAllocator baseAllocator;
+    CachedPoolAllocator poolAllocator(RAPIDJSON_ALLOCATOR_DEFAULT_CHUNK_CAPACITY, &baseAllocator);
+    CachedDocument d(&poolAllocator, 1024, &baseAllocator);
+    d.Parse(json);
+    \endcode
+
+    Blocks are rounded up to a multiple of RAPIDJSON_THREAD_CACHE_GRANULARITY, so small
+    allocations waste memory. Blocks above RAPIDJSON_THREAD_CACHE_MAX_BLOCK are not cached,
+    and a thread retains at most RAPIDJSON_THREAD_CACHE_MAX_RETAINED bytes. The cache of a
+    thread is released when the thread exits or by Trim().
+
+    A block may be freed by another thread than the one that allocated it; it then goes to
+    the cache of the freeing thread. The statistics are kept per thread and are only
+    meaningful if blocks are freed on the thread that allocated them.
+    \note implements Allocator concept
+*/
+class ThreadCachingAllocator {
+public:
+    static const bool kNeedFree = true;
+
+    //! Allocates a memory block. (concept Allocator)
+    void* Malloc(size_t size) {
+        if (!size)
+            return NULL;
+        if (size > ~size_t(0) - kGranularity - kHeaderSize)
+            return NULL;
+
+        ThreadCache& cache = GetThreadCache();
+        const size_t blockSize = BlockSize(size);
+        BlockHeader* block;
+        if (blockSize <= kMaxBlock && (block = cache.bins[BinIndex(blockSize)]) != 0) {
+            cache.bins[BinIndex(blockSize)] = block->next;
+            cache.stats.retained -= blockSize;
+            cache.stats.cacheHits++;
+        }
+        else {
+            block = static_cast<BlockHeader*>(std::malloc(blockSize));
+            if (!block)
+                return NULL;
+            cache.stats.heapAllocations++;
+        }
+        block->size = blockSize;
+        cache.stats.allocated += blockSize;
+        if (cache.stats.allocated > cache.stats.peakAllocated)
+            cache.stats.peakAllocated = cache.stats.allocated;
+        return reinterpret_cast<char*>(block) + kHeaderSize;
+    }
+
+    //! Resizes a memory block (concept Allocator)
+    void* Realloc(void* originalPtr, size_t originalSize, size_t newSize) {
+        if (originalPtr == 0)
+            return Malloc(newSize);
+
+        if (newSize == 0) {
+            Free(originalPtr);
+            return NULL;
+        }
+
+        // Grow in place while the block has room
+        if (newSize <= GetHeader(originalPtr)->size - kHeaderSize)
+            return originalPtr;
+
+        void* newBuffer = Malloc(newSize);
+        if (newBuffer) {
+            std::memcpy(newBuffer, originalPtr, originalSize < newSize ? originalSize : newSize);
+            Free(originalPtr);
+        }
+        return newBuffer;
+    }
+
+    //! Frees a memory block (concept Allocator)
+    static void Free(void *ptr) {
+        if (!ptr)
+            return;
+
+        ThreadCache& cache = GetThreadCache();
+        BlockHeader* block = GetHeader(ptr);
+        const size_t blockSize = block->size;
+        cache.stats.allocated -= blockSize < cache.stats.allocated ? blockSize : cache.stats.allocated;
+
+        if (blockSize <= kMaxBlock && !cache.released && cache.stats.retained + blockSize <= kMaxRetained) {
+            if (!cache.registered) {
+                RegisterRelease();
+                cache.registered = true;
+            }
+            block->next = cache.bins[BinIndex(blockSize)];
+            cache.bins[BinIndex(blockSize)] = block;
+            cache.stats.retained += blockSize;
+            if (cache.stats.retained > cache.stats.peakRetained)
+                cache.stats.peakRetained = cache.stats.retained;
+        }
+        else {
+            std::free(block);
+            cache.stats.heapFrees++;
+        }
+    }
+
+    //! Gets the memory statistics of the calling thread.
+    static ThreadCacheStats GetThreadStats() { return GetThreadCache().stats; }
+
+    //! Resets the peaks of the statistics of the calling thread to the current values.
+    static void ResetThreadPeaks() {
+        ThreadCache& cache = GetThreadCache();
+        cache.stats.peakAllocated = cache.stats.allocated;
+        cache.stats.peakRetained = cache.stats.retained;
+    }
+
+    //! Returns the blocks retained by the calling thread to the C runtime library.
+    static void Trim() {
+        ThreadCache& cache = GetThreadCache();
+        for (size_t i = 0; i < kBinCount; i++)
+            while (BlockHeader* block = cache.bins[i]) {
+                cache.bins[i] = block->next;
+                std::free(block);
+                cache.stats.heapFrees++;
+            }
+        cache.stats.retained = 0;
+    }
+
+private:
+    static const size_t kGranularity = RAPIDJSON_THREAD_CACHE_GRANULARITY;
+    static const size_t kMaxBlock = RAPIDJSON_THREAD_CACHE_MAX_BLOCK;
+    static const size_t kMaxRetained = RAPIDJSON_THREAD_CACHE_MAX_RETAINED;
+    static const size_t kBinCount = RAPIDJSON_THREAD_CACHE_MAX_BLOCK / RAPIDJSON_THREAD_CACHE_GRANULARITY;
+
+    //! Header in front of each block; while the block is cached it links the free list.
+    struct BlockHeader {
+        size_t size;        //!< Size of the whole block, including the header.
+        BlockHeader* next;  //!< Next free block of the same size class.
+    };
+
+    static const size_t kHeaderSize = RAPIDJSON_ALIGN(sizeof(size_t));
+
+    //! Cache of a thread. It is trivially destructible, so it stays usable while other
+    //! thread_local objects are destroyed at thread exit.
+    struct ThreadCache {
+        BlockHeader* bins[kBinCount];
+        ThreadCacheStats stats;
+        bool registered;    //!< Whether the release at thread exit is registered.
+        bool released;      //!< Whether the thread exits; blocks are not cached anymore.
+    };
+
+    //! Releases the cache of a thread at thread exit.
+    struct ThreadCacheRelease {
+        ~ThreadCacheRelease() {
+            Trim();
+            GetThreadCache().released = true;
+        }
+    };
+
+    static size_t BlockSize(size_t size) { return (size + kHeaderSize + kGranularity - 1) / kGranularity * kGranularity; }
+    static size_t BinIndex(size_t blockSize) { return blockSize / kGranularity - 1; }
+    static BlockHeader* GetHeader(void* ptr) { return reinterpret_cast<BlockHeader*>(static_cast<char*>(ptr) - kHeaderSize); }
+
+    static ThreadCache& GetThreadCache() {
+        static thread_local ThreadCache cache;
+        return cache;
+    }
+
+    static void RegisterRelease() {
+        static thread_local ThreadCacheRelease release;
+        (void)release;
+    }
+};
+
+RAPIDJSON_NAMESPACE_END
+
+#ifdef __clang__
+RAPIDJSON_DIAG_POP
+#endif
+
+#endif // RAPIDJSON_THREADCACHINGALLOCATOR_H_
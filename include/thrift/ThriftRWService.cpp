@@ -3613,6 +3613,799 @@ uint32_t ThriftRWService_readId_presult::read(::apache::thrift::protocol::TProto
   return xfer;
 }
 
+
+ThriftRWService_scanIds_args::~ThriftRWService_scanIds_args() throw() {
+}
+
+
+uint32_t ThriftRWService_scanIds_args::read(::apache::thrift::protocol::TProtocol* iprot) {
+
+  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+  uint32_t xfer = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TType ftype;
+  int16_t fid;
+
+  xfer += iprot->readStructBegin(fname);
+
+  using ::apache::thrift::protocol::TProtocolException;
+
+
+  while (true)
+  {
+    xfer += iprot->readFieldBegin(fname, ftype, fid);
+    if (ftype == ::apache::thrift::protocol::T_STOP) {
+      break;
+    }
+    switch (fid)
+    {
+      case 1:
+        if (ftype == ::apache::thrift::protocol::T_STRING) {
+          xfer += iprot->readString(this->_cursor);
+          this->__isset._cursor = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 2:
+        if (ftype == ::apache::thrift::protocol::T_STRING) {
+          xfer += iprot->readString(this->_prefix);
+          this->__isset._prefix = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 3:
+        if (ftype == ::apache::thrift::protocol::T_I32) {
+          xfer += iprot->readI32(this->_limit);
+          this->__isset._limit = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      default:
+        xfer += iprot->skip(ftype);
+        break;
+    }
+    xfer += iprot->readFieldEnd();
+  }
+
+  xfer += iprot->readStructEnd();
+
+  return xfer;
+}
+
+uint32_t ThriftRWService_scanIds_args::write(::apache::thrift::protocol::TProtocol* oprot) const {
+  uint32_t xfer = 0;
+  ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+  xfer += oprot->writeStructBegin("ThriftRWService_scanIds_args");
+
+  xfer += oprot->writeFieldBegin("_cursor", ::apache::thrift::protocol::T_STRING, 1);
+  xfer += oprot->writeString(this->_cursor);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_prefix", ::apache::thrift::protocol::T_STRING, 2);
+  xfer += oprot->writeString(this->_prefix);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_limit", ::apache::thrift::protocol::T_I32, 3);
+  xfer += oprot->writeI32(this->_limit);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
+
+
+ThriftRWService_scanIds_pargs::~ThriftRWService_scanIds_pargs() throw() {
+}
+
+
+uint32_t ThriftRWService_scanIds_pargs::write(::apache::thrift::protocol::TProtocol* oprot) const {
+  uint32_t xfer = 0;
+  ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+  xfer += oprot->writeStructBegin("ThriftRWService_scanIds_pargs");
+
+  xfer += oprot->writeFieldBegin("_cursor", ::apache::thrift::protocol::T_STRING, 1);
+  xfer += oprot->writeString((*(this->_cursor)));
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_prefix", ::apache::thrift::protocol::T_STRING, 2);
+  xfer += oprot->writeString((*(this->_prefix)));
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_limit", ::apache::thrift::protocol::T_I32, 3);
+  xfer += oprot->writeI32((*(this->_limit)));
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
+
+
+ThriftRWService_scanIds_result::~ThriftRWService_scanIds_result() throw() {
+}
+
+
+uint32_t ThriftRWService_scanIds_result::read(::apache::thrift::protocol::TProtocol* iprot) {
+
+  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+  uint32_t xfer = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TType ftype;
+  int16_t fid;
+
+  xfer += iprot->readStructBegin(fname);
+
+  using ::apache::thrift::protocol::TProtocolException;
+
+
+  while (true)
+  {
+    xfer += iprot->readFieldBegin(fname, ftype, fid);
+    if (ftype == ::apache::thrift::protocol::T_STOP) {
+      break;
+    }
+    switch (fid)
+    {
+      case 0:
+        if (ftype == ::apache::thrift::protocol::T_LIST) {
+          {
+            this->success.clear();
+            uint32_t _size162;
+            ::apache::thrift::protocol::TType _etype165;
+            xfer += iprot->readListBegin(_etype165, _size162);
+            this->success.resize(_size162);
+            uint32_t _i166;
+            for (_i166 = 0; _i166 < _size162; ++_i166)
+            {
+              xfer += iprot->readString(this->success[_i166]);
+            }
+            xfer += iprot->readListEnd();
+          }
+          this->__isset.success = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 1:
+        if (ftype == ::apache::thrift::protocol::T_STRUCT) {
+          xfer += this->e.read(iprot);
+          this->__isset.e = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      default:
+        xfer += iprot->skip(ftype);
+        break;
+    }
+    xfer += iprot->readFieldEnd();
+  }
+
+  xfer += iprot->readStructEnd();
+
+  return xfer;
+}
+
+uint32_t ThriftRWService_scanIds_result::write(::apache::thrift::protocol::TProtocol* oprot) const {
+
+  uint32_t xfer = 0;
+
+  xfer += oprot->writeStructBegin("ThriftRWService_scanIds_result");
+
+  if (this->__isset.success) {
+    xfer += oprot->writeFieldBegin("success", ::apache::thrift::protocol::T_LIST, 0);
+    {
+      xfer += oprot->writeListBegin(::apache::thrift::protocol::T_STRING, static_cast<uint32_t>(this->success.size()));
+      std::vector<std::string> ::const_iterator _iter167;
+      for (_iter167 = this->success.begin(); _iter167 != this->success.end(); ++_iter167)
+      {
+        xfer += oprot->writeString((*_iter167));
+      }
+      xfer += oprot->writeListEnd();
+    }
+    xfer += oprot->writeFieldEnd();
+  } else if (this->__isset.e) {
+    xfer += oprot->writeFieldBegin("e", ::apache::thrift::protocol::T_STRUCT, 1);
+    xfer += this->e.write(oprot);
+    xfer += oprot->writeFieldEnd();
+  }
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
+
+
+ThriftRWService_scanIds_presult::~ThriftRWService_scanIds_presult() throw() {
+}
+
+
+uint32_t ThriftRWService_scanIds_presult::read(::apache::thrift::protocol::TProtocol* iprot) {
+
+  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+  uint32_t xfer = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TType ftype;
+  int16_t fid;
+
+  xfer += iprot->readStructBegin(fname);
+
+  using ::apache::thrift::protocol::TProtocolException;
+
+
+  while (true)
+  {
+    xfer += iprot->readFieldBegin(fname, ftype, fid);
+    if (ftype == ::apache::thrift::protocol::T_STOP) {
+      break;
+    }
+    switch (fid)
+    {
+      case 0:
+        if (ftype == ::apache::thrift::protocol::T_LIST) {
+          {
+            (*(this->success)).clear();
+            uint32_t _size168;
+            ::apache::thrift::protocol::TType _etype171;
+            xfer += iprot->readListBegin(_etype171, _size168);
+            (*(this->success)).resize(_size168);
+            uint32_t _i172;
+            for (_i172 = 0; _i172 < _size168; ++_i172)
+            {
+              xfer += iprot->readString((*(this->success))[_i172]);
+            }
+            xfer += iprot->readListEnd();
+          }
+          this->__isset.success = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 1:
+        if (ftype == ::apache::thrift::protocol::T_STRUCT) {
+          xfer += this->e.read(iprot);
+          this->__isset.e = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      default:
+        xfer += iprot->skip(ftype);
+        break;
+    }
+    xfer += iprot->readFieldEnd();
+  }
+
+  xfer += iprot->readStructEnd();
+
+  return xfer;
+}
+
+
+ThriftRWService_waitForChanges_args::~ThriftRWService_waitForChanges_args() throw() {
+}
+
+
+uint32_t ThriftRWService_waitForChanges_args::read(::apache::thrift::protocol::TProtocol* iprot) {
+
+  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+  uint32_t xfer = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TType ftype;
+  int16_t fid;
+
+  xfer += iprot->readStructBegin(fname);
+
+  using ::apache::thrift::protocol::TProtocolException;
+
+
+  while (true)
+  {
+    xfer += iprot->readFieldBegin(fname, ftype, fid);
+    if (ftype == ::apache::thrift::protocol::T_STOP) {
+      break;
+    }
+    switch (fid)
+    {
+      case 1:
+        if (ftype == ::apache::thrift::protocol::T_LIST) {
+          {
+            this->_ids.clear();
+            uint32_t _size173;
+            ::apache::thrift::protocol::TType _etype176;
+            xfer += iprot->readListBegin(_etype176, _size173);
+            this->_ids.resize(_size173);
+            uint32_t _i177;
+            for (_i177 = 0; _i177 < _size173; ++_i177)
+            {
+              xfer += iprot->readString(this->_ids[_i177]);
+            }
+            xfer += iprot->readListEnd();
+          }
+          this->__isset._ids = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 2:
+        if (ftype == ::apache::thrift::protocol::T_I64) {
+          xfer += iprot->readI64(this->_since_version);
+          this->__isset._since_version = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 3:
+        if (ftype == ::apache::thrift::protocol::T_I32) {
+          xfer += iprot->readI32(this->_timeout_ms);
+          this->__isset._timeout_ms = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      default:
+        xfer += iprot->skip(ftype);
+        break;
+    }
+    xfer += iprot->readFieldEnd();
+  }
+
+  xfer += iprot->readStructEnd();
+
+  return xfer;
+}
+
+uint32_t ThriftRWService_waitForChanges_args::write(::apache::thrift::protocol::TProtocol* oprot) const {
+  uint32_t xfer = 0;
+  ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+  xfer += oprot->writeStructBegin("ThriftRWService_waitForChanges_args");
+
+  xfer += oprot->writeFieldBegin("_ids", ::apache::thrift::protocol::T_LIST, 1);
+  {
+    xfer += oprot->writeListBegin(::apache::thrift::protocol::T_STRING, static_cast<uint32_t>(this->_ids.size()));
+    std::vector<std::string> ::const_iterator _iter178;
+    for (_iter178 = this->_ids.begin(); _iter178 != this->_ids.end(); ++_iter178)
+    {
+      xfer += oprot->writeString((*_iter178));
+    }
+    xfer += oprot->writeListEnd();
+  }
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_since_version", ::apache::thrift::protocol::T_I64, 2);
+  xfer += oprot->writeI64(this->_since_version);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_timeout_ms", ::apache::thrift::protocol::T_I32, 3);
+  xfer += oprot->writeI32(this->_timeout_ms);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
+
+
+ThriftRWService_waitForChanges_pargs::~ThriftRWService_waitForChanges_pargs() throw() {
+}
+
+
+uint32_t ThriftRWService_waitForChanges_pargs::write(::apache::thrift::protocol::TProtocol* oprot) const {
+  uint32_t xfer = 0;
+  ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+  xfer += oprot->writeStructBegin("ThriftRWService_waitForChanges_pargs");
+
+  xfer += oprot->writeFieldBegin("_ids", ::apache::thrift::protocol::T_LIST, 1);
+  {
+    xfer += oprot->writeListBegin(::apache::thrift::protocol::T_STRING, static_cast<uint32_t>((*(this->_ids)).size()));
+    std::vector<std::string> ::const_iterator _iter179;
+    for (_iter179 = (*(this->_ids)).begin(); _iter179 != (*(this->_ids)).end(); ++_iter179)
+    {
+      xfer += oprot->writeString((*_iter179));
+    }
+    xfer += oprot->writeListEnd();
+  }
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_since_version", ::apache::thrift::protocol::T_I64, 2);
+  xfer += oprot->writeI64((*(this->_since_version)));
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_timeout_ms", ::apache::thrift::protocol::T_I32, 3);
+  xfer += oprot->writeI32((*(this->_timeout_ms)));
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
+
+
+ThriftRWService_waitForChanges_result::~ThriftRWService_waitForChanges_result() throw() {
+}
+
+
+uint32_t ThriftRWService_waitForChanges_result::read(::apache::thrift::protocol::TProtocol* iprot) {
+
+  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+  uint32_t xfer = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TType ftype;
+  int16_t fid;
+
+  xfer += iprot->readStructBegin(fname);
+
+  using ::apache::thrift::protocol::TProtocolException;
+
+
+  while (true)
+  {
+    xfer += iprot->readFieldBegin(fname, ftype, fid);
+    if (ftype == ::apache::thrift::protocol::T_STOP) {
+      break;
+    }
+    switch (fid)
+    {
+      case 0:
+        if (ftype == ::apache::thrift::protocol::T_LIST) {
+          {
+            this->success.clear();
+            uint32_t _size180;
+            ::apache::thrift::protocol::TType _etype183;
+            xfer += iprot->readListBegin(_etype183, _size180);
+            this->success.resize(_size180);
+            uint32_t _i184;
+            for (_i184 = 0; _i184 < _size180; ++_i184)
+            {
+              xfer += this->success[_i184].read(iprot);
+            }
+            xfer += iprot->readListEnd();
+          }
+          this->__isset.success = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 1:
+        if (ftype == ::apache::thrift::protocol::T_STRUCT) {
+          xfer += this->e.read(iprot);
+          this->__isset.e = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      default:
+        xfer += iprot->skip(ftype);
+        break;
+    }
+    xfer += iprot->readFieldEnd();
+  }
+
+  xfer += iprot->readStructEnd();
+
+  return xfer;
+}
+
+uint32_t ThriftRWService_waitForChanges_result::write(::apache::thrift::protocol::TProtocol* oprot) const {
+
+  uint32_t xfer = 0;
+
+  xfer += oprot->writeStructBegin("ThriftRWService_waitForChanges_result");
+
+  if (this->__isset.success) {
+    xfer += oprot->writeFieldBegin("success", ::apache::thrift::protocol::T_LIST, 0);
+    {
+      xfer += oprot->writeListBegin(::apache::thrift::protocol::T_STRUCT, static_cast<uint32_t>(this->success.size()));
+      std::vector<ThriftMessage> ::const_iterator _iter185;
+      for (_iter185 = this->success.begin(); _iter185 != this->success.end(); ++_iter185)
+      {
+        xfer += (*_iter185).write(oprot);
+      }
+      xfer += oprot->writeListEnd();
+    }
+    xfer += oprot->writeFieldEnd();
+  } else if (this->__isset.e) {
+    xfer += oprot->writeFieldBegin("e", ::apache::thrift::protocol::T_STRUCT, 1);
+    xfer += this->e.write(oprot);
+    xfer += oprot->writeFieldEnd();
+  }
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
+
+
+ThriftRWService_waitForChanges_presult::~ThriftRWService_waitForChanges_presult() throw() {
+}
+
+
+uint32_t ThriftRWService_waitForChanges_presult::read(::apache::thrift::protocol::TProtocol* iprot) {
+
+  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+  uint32_t xfer = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TType ftype;
+  int16_t fid;
+
+  xfer += iprot->readStructBegin(fname);
+
+  using ::apache::thrift::protocol::TProtocolException;
+
+
+  while (true)
+  {
+    xfer += iprot->readFieldBegin(fname, ftype, fid);
+    if (ftype == ::apache::thrift::protocol::T_STOP) {
+      break;
+    }
+    switch (fid)
+    {
+      case 0:
+        if (ftype == ::apache::thrift::protocol::T_LIST) {
+          {
+            (*(this->success)).clear();
+            uint32_t _size186;
+            ::apache::thrift::protocol::TType _etype189;
+            xfer += iprot->readListBegin(_etype189, _size186);
+            (*(this->success)).resize(_size186);
+            uint32_t _i190;
+            for (_i190 = 0; _i190 < _size186; ++_i190)
+            {
+              xfer += (*(this->success))[_i190].read(iprot);
+            }
+            xfer += iprot->readListEnd();
+          }
+          this->__isset.success = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 1:
+        if (ftype == ::apache::thrift::protocol::T_STRUCT) {
+          xfer += this->e.read(iprot);
+          this->__isset.e = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      default:
+        xfer += iprot->skip(ftype);
+        break;
+    }
+    xfer += iprot->readFieldEnd();
+  }
+
+  xfer += iprot->readStructEnd();
+
+  return xfer;
+}
+
+
+ThriftRWService_writeThriftMessageDelta_args::~ThriftRWService_writeThriftMessageDelta_args() throw() {
+}
+
+
+uint32_t ThriftRWService_writeThriftMessageDelta_args::read(::apache::thrift::protocol::TProtocol* iprot) {
+
+  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+  uint32_t xfer = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TType ftype;
+  int16_t fid;
+
+  xfer += iprot->readStructBegin(fname);
+
+  using ::apache::thrift::protocol::TProtocolException;
+
+
+  while (true)
+  {
+    xfer += iprot->readFieldBegin(fname, ftype, fid);
+    if (ftype == ::apache::thrift::protocol::T_STOP) {
+      break;
+    }
+    switch (fid)
+    {
+      case 1:
+        if (ftype == ::apache::thrift::protocol::T_STRUCT) {
+          xfer += this->_delta.read(iprot);
+          this->__isset._delta = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 2:
+        if (ftype == ::apache::thrift::protocol::T_I64) {
+          xfer += iprot->readI64(this->_base_hash);
+          this->__isset._base_hash = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      default:
+        xfer += iprot->skip(ftype);
+        break;
+    }
+    xfer += iprot->readFieldEnd();
+  }
+
+  xfer += iprot->readStructEnd();
+
+  return xfer;
+}
+
+uint32_t ThriftRWService_writeThriftMessageDelta_args::write(::apache::thrift::protocol::TProtocol* oprot) const {
+  uint32_t xfer = 0;
+  ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+  xfer += oprot->writeStructBegin("ThriftRWService_writeThriftMessageDelta_args");
+
+  xfer += oprot->writeFieldBegin("_delta", ::apache::thrift::protocol::T_STRUCT, 1);
+  xfer += this->_delta.write(oprot);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_base_hash", ::apache::thrift::protocol::T_I64, 2);
+  xfer += oprot->writeI64(this->_base_hash);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
+
+
+ThriftRWService_writeThriftMessageDelta_pargs::~ThriftRWService_writeThriftMessageDelta_pargs() throw() {
+}
+
+
+uint32_t ThriftRWService_writeThriftMessageDelta_pargs::write(::apache::thrift::protocol::TProtocol* oprot) const {
+  uint32_t xfer = 0;
+  ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+  xfer += oprot->writeStructBegin("ThriftRWService_writeThriftMessageDelta_pargs");
+
+  xfer += oprot->writeFieldBegin("_delta", ::apache::thrift::protocol::T_STRUCT, 1);
+  xfer += (*(this->_delta)).write(oprot);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_base_hash", ::apache::thrift::protocol::T_I64, 2);
+  xfer += oprot->writeI64((*(this->_base_hash)));
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
+
+
+ThriftRWService_writeThriftMessageDelta_result::~ThriftRWService_writeThriftMessageDelta_result() throw() {
+}
+
+
+uint32_t ThriftRWService_writeThriftMessageDelta_result::read(::apache::thrift::protocol::TProtocol* iprot) {
+
+  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+  uint32_t xfer = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TType ftype;
+  int16_t fid;
+
+  xfer += iprot->readStructBegin(fname);
+
+  using ::apache::thrift::protocol::TProtocolException;
+
+
+  while (true)
+  {
+    xfer += iprot->readFieldBegin(fname, ftype, fid);
+    if (ftype == ::apache::thrift::protocol::T_STOP) {
+      break;
+    }
+    switch (fid)
+    {
+      case 0:
+        if (ftype == ::apache::thrift::protocol::T_I64) {
+          xfer += iprot->readI64(this->success);
+          this->__isset.success = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 1:
+        if (ftype == ::apache::thrift::protocol::T_STRUCT) {
+          xfer += this->e.read(iprot);
+          this->__isset.e = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      default:
+        xfer += iprot->skip(ftype);
+        break;
+    }
+    xfer += iprot->readFieldEnd();
+  }
+
+  xfer += iprot->readStructEnd();
+
+  return xfer;
+}
+
+uint32_t ThriftRWService_writeThriftMessageDelta_result::write(::apache::thrift::protocol::TProtocol* oprot) const {
+
+  uint32_t xfer = 0;
+
+  xfer += oprot->writeStructBegin("ThriftRWService_writeThriftMessageDelta_result");
+
+  if (this->__isset.success) {
+    xfer += oprot->writeFieldBegin("success", ::apache::thrift::protocol::T_I64, 0);
+    xfer += oprot->writeI64(this->success);
+    xfer += oprot->writeFieldEnd();
+  } else if (this->__isset.e) {
+    xfer += oprot->writeFieldBegin("e", ::apache::thrift::protocol::T_STRUCT, 1);
+    xfer += this->e.write(oprot);
+    xfer += oprot->writeFieldEnd();
+  }
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
+
+
+ThriftRWService_writeThriftMessageDelta_presult::~ThriftRWService_writeThriftMessageDelta_presult() throw() {
+}
+
+
+uint32_t ThriftRWService_writeThriftMessageDelta_presult::read(::apache::thrift::protocol::TProtocol* iprot) {
+
+  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+  uint32_t xfer = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TType ftype;
+  int16_t fid;
+
+  xfer += iprot->readStructBegin(fname);
+
+  using ::apache::thrift::protocol::TProtocolException;
+
+
+  while (true)
+  {
+    xfer += iprot->readFieldBegin(fname, ftype, fid);
+    if (ftype == ::apache::thrift::protocol::T_STOP) {
+      break;
+    }
+    switch (fid)
+    {
+      case 0:
+        if (ftype == ::apache::thrift::protocol::T_I64) {
+          xfer += iprot->readI64((*(this->success)));
+          this->__isset.success = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 1:
+        if (ftype == ::apache::thrift::protocol::T_STRUCT) {
+          xfer += this->e.read(iprot);
+          this->__isset.e = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      default:
+        xfer += iprot->skip(ftype);
+        break;
+    }
+    xfer += iprot->readFieldEnd();
+  }
+
+  xfer += iprot->readStructEnd();
+
+  return xfer;
+}
+
 bool ThriftRWServiceClient::ping()
 {
   send_ping();
@@ -4309,7 +5102,190 @@ void ThriftRWServiceClient::send_readI32(const std::string& _id)
   oprot_->getTransport()->flush();
 }
 
-int32_t ThriftRWServiceClient::recv_readI32()
+int32_t ThriftRWServiceClient::recv_readI32()
+{
+
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
+
+  iprot_->readMessageBegin(fname, mtype, rseqid);
+  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+    ::apache::thrift::TApplicationException x;
+    x.read(iprot_);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+    throw x;
+  }
+  if (mtype != ::apache::thrift::protocol::T_REPLY) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  if (fname.compare("readI32") != 0) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  int32_t _return;
+  ThriftRWService_readI32_presult result;
+  result.success = &_return;
+  result.read(iprot_);
+  iprot_->readMessageEnd();
+  iprot_->getTransport()->readEnd();
+
+  if (result.__isset.success) {
+    return _return;
+  }
+  if (result.__isset.e) {
+    throw result.e;
+  }
+  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "readI32 failed: unknown result");
+}
+
+int64_t ThriftRWServiceClient::readI64(const std::string& _id)
+{
+  send_readI64(_id);
+  return recv_readI64();
+}
+
+void ThriftRWServiceClient::send_readI64(const std::string& _id)
+{
+  int32_t cseqid = 0;
+  oprot_->writeMessageBegin("readI64", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  ThriftRWService_readI64_pargs args;
+  args._id = &_id;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+}
+
+int64_t ThriftRWServiceClient::recv_readI64()
+{
+
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
+
+  iprot_->readMessageBegin(fname, mtype, rseqid);
+  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+    ::apache::thrift::TApplicationException x;
+    x.read(iprot_);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+    throw x;
+  }
+  if (mtype != ::apache::thrift::protocol::T_REPLY) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  if (fname.compare("readI64") != 0) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  int64_t _return;
+  ThriftRWService_readI64_presult result;
+  result.success = &_return;
+  result.read(iprot_);
+  iprot_->readMessageEnd();
+  iprot_->getTransport()->readEnd();
+
+  if (result.__isset.success) {
+    return _return;
+  }
+  if (result.__isset.e) {
+    throw result.e;
+  }
+  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "readI64 failed: unknown result");
+}
+
+double ThriftRWServiceClient::readDouble(const std::string& _id)
+{
+  send_readDouble(_id);
+  return recv_readDouble();
+}
+
+void ThriftRWServiceClient::send_readDouble(const std::string& _id)
+{
+  int32_t cseqid = 0;
+  oprot_->writeMessageBegin("readDouble", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  ThriftRWService_readDouble_pargs args;
+  args._id = &_id;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+}
+
+double ThriftRWServiceClient::recv_readDouble()
+{
+
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
+
+  iprot_->readMessageBegin(fname, mtype, rseqid);
+  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+    ::apache::thrift::TApplicationException x;
+    x.read(iprot_);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+    throw x;
+  }
+  if (mtype != ::apache::thrift::protocol::T_REPLY) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  if (fname.compare("readDouble") != 0) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  double _return;
+  ThriftRWService_readDouble_presult result;
+  result.success = &_return;
+  result.read(iprot_);
+  iprot_->readMessageEnd();
+  iprot_->getTransport()->readEnd();
+
+  if (result.__isset.success) {
+    return _return;
+  }
+  if (result.__isset.e) {
+    throw result.e;
+  }
+  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "readDouble failed: unknown result");
+}
+
+void ThriftRWServiceClient::readString(std::string& _return, const std::string& _id)
+{
+  send_readString(_id);
+  recv_readString(_return);
+}
+
+void ThriftRWServiceClient::send_readString(const std::string& _id)
+{
+  int32_t cseqid = 0;
+  oprot_->writeMessageBegin("readString", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  ThriftRWService_readString_pargs args;
+  args._id = &_id;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+}
+
+void ThriftRWServiceClient::recv_readString(std::string& _return)
 {
 
   int32_t rseqid = 0;
@@ -4329,39 +5305,39 @@ int32_t ThriftRWServiceClient::recv_readI32()
     iprot_->readMessageEnd();
     iprot_->getTransport()->readEnd();
   }
-  if (fname.compare("readI32") != 0) {
+  if (fname.compare("readString") != 0) {
     iprot_->skip(::apache::thrift::protocol::T_STRUCT);
     iprot_->readMessageEnd();
     iprot_->getTransport()->readEnd();
   }
-  int32_t _return;
-  ThriftRWService_readI32_presult result;
+  ThriftRWService_readString_presult result;
   result.success = &_return;
   result.read(iprot_);
   iprot_->readMessageEnd();
   iprot_->getTransport()->readEnd();
 
   if (result.__isset.success) {
-    return _return;
+    // _return pointer has now been filled
+    return;
   }
   if (result.__isset.e) {
     throw result.e;
   }
-  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "readI32 failed: unknown result");
+  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "readString failed: unknown result");
 }
 
-int64_t ThriftRWServiceClient::readI64(const std::string& _id)
+bool ThriftRWServiceClient::writeId(const std::string& _id)
 {
-  send_readI64(_id);
-  return recv_readI64();
+  send_writeId(_id);
+  return recv_writeId();
 }
 
-void ThriftRWServiceClient::send_readI64(const std::string& _id)
+void ThriftRWServiceClient::send_writeId(const std::string& _id)
 {
   int32_t cseqid = 0;
-  oprot_->writeMessageBegin("readI64", ::apache::thrift::protocol::T_CALL, cseqid);
+  oprot_->writeMessageBegin("writeId", ::apache::thrift::protocol::T_CALL, cseqid);
 
-  ThriftRWService_readI64_pargs args;
+  ThriftRWService_writeId_pargs args;
   args._id = &_id;
   args.write(oprot_);
 
@@ -4370,7 +5346,7 @@ void ThriftRWServiceClient::send_readI64(const std::string& _id)
   oprot_->getTransport()->flush();
 }
 
-int64_t ThriftRWServiceClient::recv_readI64()
+bool ThriftRWServiceClient::recv_writeId()
 {
 
   int32_t rseqid = 0;
@@ -4390,13 +5366,13 @@ int64_t ThriftRWServiceClient::recv_readI64()
     iprot_->readMessageEnd();
     iprot_->getTransport()->readEnd();
   }
-  if (fname.compare("readI64") != 0) {
+  if (fname.compare("writeId") != 0) {
     iprot_->skip(::apache::thrift::protocol::T_STRUCT);
     iprot_->readMessageEnd();
     iprot_->getTransport()->readEnd();
   }
-  int64_t _return;
-  ThriftRWService_readI64_presult result;
+  bool _return;
+  ThriftRWService_writeId_presult result;
   result.success = &_return;
   result.read(iprot_);
   iprot_->readMessageEnd();
@@ -4408,22 +5384,21 @@ int64_t ThriftRWServiceClient::recv_readI64()
   if (result.__isset.e) {
     throw result.e;
   }
-  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "readI64 failed: unknown result");
+  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "writeId failed: unknown result");
 }
 
-double ThriftRWServiceClient::readDouble(const std::string& _id)
+void ThriftRWServiceClient::readId(std::vector<std::string> & _return)
 {
-  send_readDouble(_id);
-  return recv_readDouble();
+  send_readId();
+  recv_readId(_return);
 }
 
-void ThriftRWServiceClient::send_readDouble(const std::string& _id)
+void ThriftRWServiceClient::send_readId()
 {
   int32_t cseqid = 0;
-  oprot_->writeMessageBegin("readDouble", ::apache::thrift::protocol::T_CALL, cseqid);
+  oprot_->writeMessageBegin("readId", ::apache::thrift::protocol::T_CALL, cseqid);
 
-  ThriftRWService_readDouble_pargs args;
-  args._id = &_id;
+  ThriftRWService_readId_pargs args;
   args.write(oprot_);
 
   oprot_->writeMessageEnd();
@@ -4431,7 +5406,7 @@ void ThriftRWServiceClient::send_readDouble(const std::string& _id)
   oprot_->getTransport()->flush();
 }
 
-double ThriftRWServiceClient::recv_readDouble()
+void ThriftRWServiceClient::recv_readId(std::vector<std::string> & _return)
 {
 
   int32_t rseqid = 0;
@@ -4451,40 +5426,42 @@ double ThriftRWServiceClient::recv_readDouble()
     iprot_->readMessageEnd();
     iprot_->getTransport()->readEnd();
   }
-  if (fname.compare("readDouble") != 0) {
+  if (fname.compare("readId") != 0) {
     iprot_->skip(::apache::thrift::protocol::T_STRUCT);
     iprot_->readMessageEnd();
     iprot_->getTransport()->readEnd();
   }
-  double _return;
-  ThriftRWService_readDouble_presult result;
+  ThriftRWService_readId_presult result;
   result.success = &_return;
   result.read(iprot_);
   iprot_->readMessageEnd();
   iprot_->getTransport()->readEnd();
 
   if (result.__isset.success) {
-    return _return;
+    // _return pointer has now been filled
+    return;
   }
   if (result.__isset.e) {
     throw result.e;
   }
-  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "readDouble failed: unknown result");
+  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "readId failed: unknown result");
 }
 
-void ThriftRWServiceClient::readString(std::string& _return, const std::string& _id)
+void ThriftRWServiceClient::scanIds(std::vector<std::string> & _return, const std::string& _cursor, const std::string& _prefix, const int32_t _limit)
 {
-  send_readString(_id);
-  recv_readString(_return);
+  send_scanIds(_cursor, _prefix, _limit);
+  recv_scanIds(_return);
 }
 
-void ThriftRWServiceClient::send_readString(const std::string& _id)
+void ThriftRWServiceClient::send_scanIds(const std::string& _cursor, const std::string& _prefix, const int32_t _limit)
 {
   int32_t cseqid = 0;
-  oprot_->writeMessageBegin("readString", ::apache::thrift::protocol::T_CALL, cseqid);
+  oprot_->writeMessageBegin("scanIds", ::apache::thrift::protocol::T_CALL, cseqid);
 
-  ThriftRWService_readString_pargs args;
-  args._id = &_id;
+  ThriftRWService_scanIds_pargs args;
+  args._cursor = &_cursor;
+  args._prefix = &_prefix;
+  args._limit = &_limit;
   args.write(oprot_);
 
   oprot_->writeMessageEnd();
@@ -4492,7 +5469,7 @@ void ThriftRWServiceClient::send_readString(const std::string& _id)
   oprot_->getTransport()->flush();
 }
 
-void ThriftRWServiceClient::recv_readString(std::string& _return)
+void ThriftRWServiceClient::recv_scanIds(std::vector<std::string> & _return)
 {
 
   int32_t rseqid = 0;
@@ -4512,12 +5489,12 @@ void ThriftRWServiceClient::recv_readString(std::string& _return)
     iprot_->readMessageEnd();
     iprot_->getTransport()->readEnd();
   }
-  if (fname.compare("readString") != 0) {
+  if (fname.compare("scanIds") != 0) {
     iprot_->skip(::apache::thrift::protocol::T_STRUCT);
     iprot_->readMessageEnd();
     iprot_->getTransport()->readEnd();
   }
-  ThriftRWService_readString_presult result;
+  ThriftRWService_scanIds_presult result;
   result.success = &_return;
   result.read(iprot_);
   iprot_->readMessageEnd();
@@ -4530,22 +5507,24 @@ void ThriftRWServiceClient::recv_readString(std::string& _return)
   if (result.__isset.e) {
     throw result.e;
   }
-  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "readString failed: unknown result");
+  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "scanIds failed: unknown result");
 }
 
-bool ThriftRWServiceClient::writeId(const std::string& _id)
+void ThriftRWServiceClient::waitForChanges(std::vector<ThriftMessage> & _return, const std::vector<std::string> & _ids, const int64_t _since_version, const int32_t _timeout_ms)
 {
-  send_writeId(_id);
-  return recv_writeId();
+  send_waitForChanges(_ids, _since_version, _timeout_ms);
+  recv_waitForChanges(_return);
 }
 
-void ThriftRWServiceClient::send_writeId(const std::string& _id)
+void ThriftRWServiceClient::send_waitForChanges(const std::vector<std::string> & _ids, const int64_t _since_version, const int32_t _timeout_ms)
 {
   int32_t cseqid = 0;
-  oprot_->writeMessageBegin("writeId", ::apache::thrift::protocol::T_CALL, cseqid);
+  oprot_->writeMessageBegin("waitForChanges", ::apache::thrift::protocol::T_CALL, cseqid);
 
-  ThriftRWService_writeId_pargs args;
-  args._id = &_id;
+  ThriftRWService_waitForChanges_pargs args;
+  args._ids = &_ids;
+  args._since_version = &_since_version;
+  args._timeout_ms = &_timeout_ms;
   args.write(oprot_);
 
   oprot_->writeMessageEnd();
@@ -4553,7 +5532,7 @@ void ThriftRWServiceClient::send_writeId(const std::string& _id)
   oprot_->getTransport()->flush();
 }
 
-bool ThriftRWServiceClient::recv_writeId()
+void ThriftRWServiceClient::recv_waitForChanges(std::vector<ThriftMessage> & _return)
 {
 
   int32_t rseqid = 0;
@@ -4573,39 +5552,41 @@ bool ThriftRWServiceClient::recv_writeId()
     iprot_->readMessageEnd();
     iprot_->getTransport()->readEnd();
   }
-  if (fname.compare("writeId") != 0) {
+  if (fname.compare("waitForChanges") != 0) {
     iprot_->skip(::apache::thrift::protocol::T_STRUCT);
     iprot_->readMessageEnd();
     iprot_->getTransport()->readEnd();
   }
-  bool _return;
-  ThriftRWService_writeId_presult result;
+  ThriftRWService_waitForChanges_presult result;
   result.success = &_return;
   result.read(iprot_);
   iprot_->readMessageEnd();
   iprot_->getTransport()->readEnd();
 
   if (result.__isset.success) {
-    return _return;
+    // _return pointer has now been filled
+    return;
   }
   if (result.__isset.e) {
     throw result.e;
   }
-  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "writeId failed: unknown result");
+  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "waitForChanges failed: unknown result");
 }
 
-void ThriftRWServiceClient::readId(std::vector<std::string> & _return)
+int64_t ThriftRWServiceClient::writeThriftMessageDelta(const ThriftMessage& _delta, const int64_t _base_hash)
 {
-  send_readId();
-  recv_readId(_return);
+  send_writeThriftMessageDelta(_delta, _base_hash);
+  return recv_writeThriftMessageDelta();
 }
 
-void ThriftRWServiceClient::send_readId()
+void ThriftRWServiceClient::send_writeThriftMessageDelta(const ThriftMessage& _delta, const int64_t _base_hash)
 {
   int32_t cseqid = 0;
-  oprot_->writeMessageBegin("readId", ::apache::thrift::protocol::T_CALL, cseqid);
+  oprot_->writeMessageBegin("writeThriftMessageDelta", ::apache::thrift::protocol::T_CALL, cseqid);
 
-  ThriftRWService_readId_pargs args;
+  ThriftRWService_writeThriftMessageDelta_pargs args;
+  args._delta = &_delta;
+  args._base_hash = &_base_hash;
   args.write(oprot_);
 
   oprot_->writeMessageEnd();
@@ -4613,7 +5594,7 @@ void ThriftRWServiceClient::send_readId()
   oprot_->getTransport()->flush();
 }
 
-void ThriftRWServiceClient::recv_readId(std::vector<std::string> & _return)
+int64_t ThriftRWServiceClient::recv_writeThriftMessageDelta()
 {
 
   int32_t rseqid = 0;
@@ -4633,25 +5614,25 @@ void ThriftRWServiceClient::recv_readId(std::vector<std::string> & _return)
     iprot_->readMessageEnd();
     iprot_->getTransport()->readEnd();
   }
-  if (fname.compare("readId") != 0) {
+  if (fname.compare("writeThriftMessageDelta") != 0) {
     iprot_->skip(::apache::thrift::protocol::T_STRUCT);
     iprot_->readMessageEnd();
     iprot_->getTransport()->readEnd();
   }
-  ThriftRWService_readId_presult result;
+  int64_t _return;
+  ThriftRWService_writeThriftMessageDelta_presult result;
   result.success = &_return;
   result.read(iprot_);
   iprot_->readMessageEnd();
   iprot_->getTransport()->readEnd();
 
   if (result.__isset.success) {
-    // _return pointer has now been filled
-    return;
+    return _return;
   }
   if (result.__isset.e) {
     throw result.e;
   }
-  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "readId failed: unknown result");
+  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "writeThriftMessageDelta failed: unknown result");
 }
 
 bool ThriftRWServiceProcessor::dispatchCall(::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, const std::string& fname, int32_t seqid, void* callContext) {
@@ -5532,37 +6513,208 @@ void ThriftRWServiceProcessor::process_writeId(int32_t seqid, ::apache::thrift::
 {
   void* ctx = NULL;
   if (this->eventHandler_.get() != NULL) {
-    ctx = this->eventHandler_->getContext("ThriftRWService.writeId", callContext);
+    ctx = this->eventHandler_->getContext("ThriftRWService.writeId", callContext);
+  }
+  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "ThriftRWService.writeId");
+
+  if (this->eventHandler_.get() != NULL) {
+    this->eventHandler_->preRead(ctx, "ThriftRWService.writeId");
+  }
+
+  ThriftRWService_writeId_args args;
+  args.read(iprot);
+  iprot->readMessageEnd();
+  uint32_t bytes = iprot->getTransport()->readEnd();
+
+  if (this->eventHandler_.get() != NULL) {
+    this->eventHandler_->postRead(ctx, "ThriftRWService.writeId", bytes);
+  }
+
+  ThriftRWService_writeId_result result;
+  try {
+    result.success = iface_->writeId(args._id);
+    result.__isset.success = true;
+  } catch (InvalidOperationException &e) {
+    result.e = e;
+    result.__isset.e = true;
+  } catch (const std::exception& e) {
+    if (this->eventHandler_.get() != NULL) {
+      this->eventHandler_->handlerError(ctx, "ThriftRWService.writeId");
+    }
+
+    ::apache::thrift::TApplicationException x(e.what());
+    oprot->writeMessageBegin("writeId", ::apache::thrift::protocol::T_EXCEPTION, seqid);
+    x.write(oprot);
+    oprot->writeMessageEnd();
+    oprot->getTransport()->writeEnd();
+    oprot->getTransport()->flush();
+    return;
+  }
+
+  if (this->eventHandler_.get() != NULL) {
+    this->eventHandler_->preWrite(ctx, "ThriftRWService.writeId");
+  }
+
+  oprot->writeMessageBegin("writeId", ::apache::thrift::protocol::T_REPLY, seqid);
+  result.write(oprot);
+  oprot->writeMessageEnd();
+  bytes = oprot->getTransport()->writeEnd();
+  oprot->getTransport()->flush();
+
+  if (this->eventHandler_.get() != NULL) {
+    this->eventHandler_->postWrite(ctx, "ThriftRWService.writeId", bytes);
+  }
+}
+
+void ThriftRWServiceProcessor::process_readId(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
+{
+  void* ctx = NULL;
+  if (this->eventHandler_.get() != NULL) {
+    ctx = this->eventHandler_->getContext("ThriftRWService.readId", callContext);
+  }
+  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "ThriftRWService.readId");
+
+  if (this->eventHandler_.get() != NULL) {
+    this->eventHandler_->preRead(ctx, "ThriftRWService.readId");
+  }
+
+  ThriftRWService_readId_args args;
+  args.read(iprot);
+  iprot->readMessageEnd();
+  uint32_t bytes = iprot->getTransport()->readEnd();
+
+  if (this->eventHandler_.get() != NULL) {
+    this->eventHandler_->postRead(ctx, "ThriftRWService.readId", bytes);
+  }
+
+  ThriftRWService_readId_result result;
+  try {
+    iface_->readId(result.success);
+    result.__isset.success = true;
+  } catch (InvalidOperationException &e) {
+    result.e = e;
+    result.__isset.e = true;
+  } catch (const std::exception& e) {
+    if (this->eventHandler_.get() != NULL) {
+      this->eventHandler_->handlerError(ctx, "ThriftRWService.readId");
+    }
+
+    ::apache::thrift::TApplicationException x(e.what());
+    oprot->writeMessageBegin("readId", ::apache::thrift::protocol::T_EXCEPTION, seqid);
+    x.write(oprot);
+    oprot->writeMessageEnd();
+    oprot->getTransport()->writeEnd();
+    oprot->getTransport()->flush();
+    return;
+  }
+
+  if (this->eventHandler_.get() != NULL) {
+    this->eventHandler_->preWrite(ctx, "ThriftRWService.readId");
+  }
+
+  oprot->writeMessageBegin("readId", ::apache::thrift::protocol::T_REPLY, seqid);
+  result.write(oprot);
+  oprot->writeMessageEnd();
+  bytes = oprot->getTransport()->writeEnd();
+  oprot->getTransport()->flush();
+
+  if (this->eventHandler_.get() != NULL) {
+    this->eventHandler_->postWrite(ctx, "ThriftRWService.readId", bytes);
+  }
+}
+
+void ThriftRWServiceProcessor::process_scanIds(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
+{
+  void* ctx = NULL;
+  if (this->eventHandler_.get() != NULL) {
+    ctx = this->eventHandler_->getContext("ThriftRWService.scanIds", callContext);
+  }
+  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "ThriftRWService.scanIds");
+
+  if (this->eventHandler_.get() != NULL) {
+    this->eventHandler_->preRead(ctx, "ThriftRWService.scanIds");
+  }
+
+  ThriftRWService_scanIds_args args;
+  args.read(iprot);
+  iprot->readMessageEnd();
+  uint32_t bytes = iprot->getTransport()->readEnd();
+
+  if (this->eventHandler_.get() != NULL) {
+    this->eventHandler_->postRead(ctx, "ThriftRWService.scanIds", bytes);
+  }
+
+  ThriftRWService_scanIds_result result;
+  try {
+    iface_->scanIds(result.success, args._cursor, args._prefix, args._limit);
+    result.__isset.success = true;
+  } catch (InvalidOperationException &e) {
+    result.e = e;
+    result.__isset.e = true;
+  } catch (const std::exception& e) {
+    if (this->eventHandler_.get() != NULL) {
+      this->eventHandler_->handlerError(ctx, "ThriftRWService.scanIds");
+    }
+
+    ::apache::thrift::TApplicationException x(e.what());
+    oprot->writeMessageBegin("scanIds", ::apache::thrift::protocol::T_EXCEPTION, seqid);
+    x.write(oprot);
+    oprot->writeMessageEnd();
+    oprot->getTransport()->writeEnd();
+    oprot->getTransport()->flush();
+    return;
+  }
+
+  if (this->eventHandler_.get() != NULL) {
+    this->eventHandler_->preWrite(ctx, "ThriftRWService.scanIds");
+  }
+
+  oprot->writeMessageBegin("scanIds", ::apache::thrift::protocol::T_REPLY, seqid);
+  result.write(oprot);
+  oprot->writeMessageEnd();
+  bytes = oprot->getTransport()->writeEnd();
+  oprot->getTransport()->flush();
+
+  if (this->eventHandler_.get() != NULL) {
+    this->eventHandler_->postWrite(ctx, "ThriftRWService.scanIds", bytes);
+  }
+}
+
+void ThriftRWServiceProcessor::process_waitForChanges(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
+{
+  void* ctx = NULL;
+  if (this->eventHandler_.get() != NULL) {
+    ctx = this->eventHandler_->getContext("ThriftRWService.waitForChanges", callContext);
   }
-  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "ThriftRWService.writeId");
+  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "ThriftRWService.waitForChanges");
 
   if (this->eventHandler_.get() != NULL) {
-    this->eventHandler_->preRead(ctx, "ThriftRWService.writeId");
+    this->eventHandler_->preRead(ctx, "ThriftRWService.waitForChanges");
   }
 
-  ThriftRWService_writeId_args args;
+  ThriftRWService_waitForChanges_args args;
   args.read(iprot);
   iprot->readMessageEnd();
   uint32_t bytes = iprot->getTransport()->readEnd();
 
   if (this->eventHandler_.get() != NULL) {
-    this->eventHandler_->postRead(ctx, "ThriftRWService.writeId", bytes);
+    this->eventHandler_->postRead(ctx, "ThriftRWService.waitForChanges", bytes);
   }
 
-  ThriftRWService_writeId_result result;
+  ThriftRWService_waitForChanges_result result;
   try {
-    result.success = iface_->writeId(args._id);
+    iface_->waitForChanges(result.success, args._ids, args._since_version, args._timeout_ms);
     result.__isset.success = true;
   } catch (InvalidOperationException &e) {
     result.e = e;
     result.__isset.e = true;
   } catch (const std::exception& e) {
     if (this->eventHandler_.get() != NULL) {
-      this->eventHandler_->handlerError(ctx, "ThriftRWService.writeId");
+      this->eventHandler_->handlerError(ctx, "ThriftRWService.waitForChanges");
     }
 
     ::apache::thrift::TApplicationException x(e.what());
-    oprot->writeMessageBegin("writeId", ::apache::thrift::protocol::T_EXCEPTION, seqid);
+    oprot->writeMessageBegin("waitForChanges", ::apache::thrift::protocol::T_EXCEPTION, seqid);
     x.write(oprot);
     oprot->writeMessageEnd();
     oprot->getTransport()->writeEnd();
@@ -5571,55 +6723,55 @@ void ThriftRWServiceProcessor::process_writeId(int32_t seqid, ::apache::thrift::
   }
 
   if (this->eventHandler_.get() != NULL) {
-    this->eventHandler_->preWrite(ctx, "ThriftRWService.writeId");
+    this->eventHandler_->preWrite(ctx, "ThriftRWService.waitForChanges");
   }
 
-  oprot->writeMessageBegin("writeId", ::apache::thrift::protocol::T_REPLY, seqid);
+  oprot->writeMessageBegin("waitForChanges", ::apache::thrift::protocol::T_REPLY, seqid);
   result.write(oprot);
   oprot->writeMessageEnd();
   bytes = oprot->getTransport()->writeEnd();
   oprot->getTransport()->flush();
 
   if (this->eventHandler_.get() != NULL) {
-    this->eventHandler_->postWrite(ctx, "ThriftRWService.writeId", bytes);
+    this->eventHandler_->postWrite(ctx, "ThriftRWService.waitForChanges", bytes);
   }
 }
 
-void ThriftRWServiceProcessor::process_readId(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
+void ThriftRWServiceProcessor::process_writeThriftMessageDelta(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
 {
   void* ctx = NULL;
   if (this->eventHandler_.get() != NULL) {
-    ctx = this->eventHandler_->getContext("ThriftRWService.readId", callContext);
+    ctx = this->eventHandler_->getContext("ThriftRWService.writeThriftMessageDelta", callContext);
   }
-  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "ThriftRWService.readId");
+  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "ThriftRWService.writeThriftMessageDelta");
 
   if (this->eventHandler_.get() != NULL) {
-    this->eventHandler_->preRead(ctx, "ThriftRWService.readId");
+    this->eventHandler_->preRead(ctx, "ThriftRWService.writeThriftMessageDelta");
   }
 
-  ThriftRWService_readId_args args;
+  ThriftRWService_writeThriftMessageDelta_args args;
   args.read(iprot);
   iprot->readMessageEnd();
   uint32_t bytes = iprot->getTransport()->readEnd();
 
   if (this->eventHandler_.get() != NULL) {
-    this->eventHandler_->postRead(ctx, "ThriftRWService.readId", bytes);
+    this->eventHandler_->postRead(ctx, "ThriftRWService.writeThriftMessageDelta", bytes);
   }
 
-  ThriftRWService_readId_result result;
+  ThriftRWService_writeThriftMessageDelta_result result;
   try {
-    iface_->readId(result.success);
+    result.success = iface_->writeThriftMessageDelta(args._delta, args._base_hash);
     result.__isset.success = true;
   } catch (InvalidOperationException &e) {
     result.e = e;
     result.__isset.e = true;
   } catch (const std::exception& e) {
     if (this->eventHandler_.get() != NULL) {
-      this->eventHandler_->handlerError(ctx, "ThriftRWService.readId");
+      this->eventHandler_->handlerError(ctx, "ThriftRWService.writeThriftMessageDelta");
     }
 
     ::apache::thrift::TApplicationException x(e.what());
-    oprot->writeMessageBegin("readId", ::apache::thrift::protocol::T_EXCEPTION, seqid);
+    oprot->writeMessageBegin("writeThriftMessageDelta", ::apache::thrift::protocol::T_EXCEPTION, seqid);
     x.write(oprot);
     oprot->writeMessageEnd();
     oprot->getTransport()->writeEnd();
@@ -5628,17 +6780,17 @@ void ThriftRWServiceProcessor::process_readId(int32_t seqid, ::apache::thrift::p
   }
 
   if (this->eventHandler_.get() != NULL) {
-    this->eventHandler_->preWrite(ctx, "ThriftRWService.readId");
+    this->eventHandler_->preWrite(ctx, "ThriftRWService.writeThriftMessageDelta");
   }
 
-  oprot->writeMessageBegin("readId", ::apache::thrift::protocol::T_REPLY, seqid);
+  oprot->writeMessageBegin("writeThriftMessageDelta", ::apache::thrift::protocol::T_REPLY, seqid);
   result.write(oprot);
   oprot->writeMessageEnd();
   bytes = oprot->getTransport()->writeEnd();
   oprot->getTransport()->flush();
 
   if (this->eventHandler_.get() != NULL) {
-    this->eventHandler_->postWrite(ctx, "ThriftRWService.readId", bytes);
+    this->eventHandler_->postWrite(ctx, "ThriftRWService.writeThriftMessageDelta", bytes);
   }
 }
 
@@ -7149,5 +8301,274 @@ void ThriftRWServiceConcurrentClient::recv_readId(std::vector<std::string> & _re
   } // end while(true)
 }
 
+void ThriftRWServiceConcurrentClient::scanIds(std::vector<std::string> & _return, const std::string& _cursor, const std::string& _prefix, const int32_t _limit)
+{
+  int32_t seqid = send_scanIds(_cursor, _prefix, _limit);
+  recv_scanIds(_return, seqid);
+}
+
+int32_t ThriftRWServiceConcurrentClient::send_scanIds(const std::string& _cursor, const std::string& _prefix, const int32_t _limit)
+{
+  int32_t cseqid = this->sync_.generateSeqId();
+  ::apache::thrift::async::TConcurrentSendSentry sentry(&this->sync_);
+  oprot_->writeMessageBegin("scanIds", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  ThriftRWService_scanIds_pargs args;
+  args._cursor = &_cursor;
+  args._prefix = &_prefix;
+  args._limit = &_limit;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+
+  sentry.commit();
+  return cseqid;
+}
+
+void ThriftRWServiceConcurrentClient::recv_scanIds(std::vector<std::string> & _return, const int32_t seqid)
+{
+
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
+
+  // the read mutex gets dropped and reacquired as part of waitForWork()
+  // The destructor of this sentry wakes up other clients
+  ::apache::thrift::async::TConcurrentRecvSentry sentry(&this->sync_, seqid);
+
+  while(true) {
+    if(!this->sync_.getPending(fname, mtype, rseqid)) {
+      iprot_->readMessageBegin(fname, mtype, rseqid);
+    }
+    if(seqid == rseqid) {
+      if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+        ::apache::thrift::TApplicationException x;
+        x.read(iprot_);
+        iprot_->readMessageEnd();
+        iprot_->getTransport()->readEnd();
+        sentry.commit();
+        throw x;
+      }
+      if (mtype != ::apache::thrift::protocol::T_REPLY) {
+        iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+        iprot_->readMessageEnd();
+        iprot_->getTransport()->readEnd();
+      }
+      if (fname.compare("scanIds") != 0) {
+        iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+        iprot_->readMessageEnd();
+        iprot_->getTransport()->readEnd();
+
+        // in a bad state, don't commit
+        using ::apache::thrift::protocol::TProtocolException;
+        throw TProtocolException(TProtocolException::INVALID_DATA);
+      }
+      ThriftRWService_scanIds_presult result;
+      result.success = &_return;
+      result.read(iprot_);
+      iprot_->readMessageEnd();
+      iprot_->getTransport()->readEnd();
+
+      if (result.__isset.success) {
+        // _return pointer has now been filled
+        sentry.commit();
+        return;
+      }
+      if (result.__isset.e) {
+        sentry.commit();
+        throw result.e;
+      }
+      // in a bad state, don't commit
+      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "scanIds failed: unknown result");
+    }
+    // seqid != rseqid
+    this->sync_.updatePending(fname, mtype, rseqid);
+
+    // this will temporarily unlock the readMutex, and let other clients get work done
+    this->sync_.waitForWork(seqid);
+  } // end while(true)
+}
+
+void ThriftRWServiceConcurrentClient::waitForChanges(std::vector<ThriftMessage> & _return, const std::vector<std::string> & _ids, const int64_t _since_version, const int32_t _timeout_ms)
+{
+  int32_t seqid = send_waitForChanges(_ids, _since_version, _timeout_ms);
+  recv_waitForChanges(_return, seqid);
+}
+
+int32_t ThriftRWServiceConcurrentClient::send_waitForChanges(const std::vector<std::string> & _ids, const int64_t _since_version, const int32_t _timeout_ms)
+{
+  int32_t cseqid = this->sync_.generateSeqId();
+  ::apache::thrift::async::TConcurrentSendSentry sentry(&this->sync_);
+  oprot_->writeMessageBegin("waitForChanges", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  ThriftRWService_waitForChanges_pargs args;
+  args._ids = &_ids;
+  args._since_version = &_since_version;
+  args._timeout_ms = &_timeout_ms;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+
+  sentry.commit();
+  return cseqid;
+}
+
+void ThriftRWServiceConcurrentClient::recv_waitForChanges(std::vector<ThriftMessage> & _return, const int32_t seqid)
+{
+
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
+
+  // the read mutex gets dropped and reacquired as part of waitForWork()
+  // The destructor of this sentry wakes up other clients
+  ::apache::thrift::async::TConcurrentRecvSentry sentry(&this->sync_, seqid);
+
+  while(true) {
+    if(!this->sync_.getPending(fname, mtype, rseqid)) {
+      iprot_->readMessageBegin(fname, mtype, rseqid);
+    }
+    if(seqid == rseqid) {
+      if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+        ::apache::thrift::TApplicationException x;
+        x.read(iprot_);
+        iprot_->readMessageEnd();
+        iprot_->getTransport()->readEnd();
+        sentry.commit();
+        throw x;
+      }
+      if (mtype != ::apache::thrift::protocol::T_REPLY) {
+        iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+        iprot_->readMessageEnd();
+        iprot_->getTransport()->readEnd();
+      }
+      if (fname.compare("waitForChanges") != 0) {
+        iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+        iprot_->readMessageEnd();
+        iprot_->getTransport()->readEnd();
+
+        // in a bad state, don't commit
+        using ::apache::thrift::protocol::TProtocolException;
+        throw TProtocolException(TProtocolException::INVALID_DATA);
+      }
+      ThriftRWService_waitForChanges_presult result;
+      result.success = &_return;
+      result.read(iprot_);
+      iprot_->readMessageEnd();
+      iprot_->getTransport()->readEnd();
+
+      if (result.__isset.success) {
+        // _return pointer has now been filled
+        sentry.commit();
+        return;
+      }
+      if (result.__isset.e) {
+        sentry.commit();
+        throw result.e;
+      }
+      // in a bad state, don't commit
+      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "waitForChanges failed: unknown result");
+    }
+    // seqid != rseqid
+    this->sync_.updatePending(fname, mtype, rseqid);
+
+    // this will temporarily unlock the readMutex, and let other clients get work done
+    this->sync_.waitForWork(seqid);
+  } // end while(true)
+}
+
+int64_t ThriftRWServiceConcurrentClient::writeThriftMessageDelta(const ThriftMessage& _delta, const int64_t _base_hash)
+{
+  int32_t seqid = send_writeThriftMessageDelta(_delta, _base_hash);
+  return recv_writeThriftMessageDelta(seqid);
+}
+
+int32_t ThriftRWServiceConcurrentClient::send_writeThriftMessageDelta(const ThriftMessage& _delta, const int64_t _base_hash)
+{
+  int32_t cseqid = this->sync_.generateSeqId();
+  ::apache::thrift::async::TConcurrentSendSentry sentry(&this->sync_);
+  oprot_->writeMessageBegin("writeThriftMessageDelta", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  ThriftRWService_writeThriftMessageDelta_pargs args;
+  args._delta = &_delta;
+  args._base_hash = &_base_hash;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+
+  sentry.commit();
+  return cseqid;
+}
+
+int64_t ThriftRWServiceConcurrentClient::recv_writeThriftMessageDelta(const int32_t seqid)
+{
+
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
+
+  // the read mutex gets dropped and reacquired as part of waitForWork()
+  // The destructor of this sentry wakes up other clients
+  ::apache::thrift::async::TConcurrentRecvSentry sentry(&this->sync_, seqid);
+
+  while(true) {
+    if(!this->sync_.getPending(fname, mtype, rseqid)) {
+      iprot_->readMessageBegin(fname, mtype, rseqid);
+    }
+    if(seqid == rseqid) {
+      if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+        ::apache::thrift::TApplicationException x;
+        x.read(iprot_);
+        iprot_->readMessageEnd();
+        iprot_->getTransport()->readEnd();
+        sentry.commit();
+        throw x;
+      }
+      if (mtype != ::apache::thrift::protocol::T_REPLY) {
+        iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+        iprot_->readMessageEnd();
+        iprot_->getTransport()->readEnd();
+      }
+      if (fname.compare("writeThriftMessageDelta") != 0) {
+        iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+        iprot_->readMessageEnd();
+        iprot_->getTransport()->readEnd();
+
+        // in a bad state, don't commit
+        using ::apache::thrift::protocol::TProtocolException;
+        throw TProtocolException(TProtocolException::INVALID_DATA);
+      }
+      int64_t _return;
+      ThriftRWService_writeThriftMessageDelta_presult result;
+      result.success = &_return;
+      result.read(iprot_);
+      iprot_->readMessageEnd();
+      iprot_->getTransport()->readEnd();
+
+      if (result.__isset.success) {
+        sentry.commit();
+        return _return;
+      }
+      if (result.__isset.e) {
+        sentry.commit();
+        throw result.e;
+      }
+      // in a bad state, don't commit
+      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "writeThriftMessageDelta failed: unknown result");
+    }
+    // seqid != rseqid
+    this->sync_.updatePending(fname, mtype, rseqid);
+
+    // this will temporarily unlock the readMutex, and let other clients get work done
+    this->sync_.waitForWork(seqid);
+  } // end while(true)
+}
+
 } // namespace
 
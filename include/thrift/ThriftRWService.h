@@ -38,6 +38,9 @@ class ThriftRWServiceIf {
   virtual void readString(std::string& _return, const std::string& _id) = 0;
   virtual bool writeId(const std::string& _id) = 0;
   virtual void readId(std::vector<std::string> & _return) = 0;
+  virtual void scanIds(std::vector<std::string> & _return, const std::string& _cursor, const std::string& _prefix, const int32_t _limit) = 0;
+  virtual void waitForChanges(std::vector<ThriftMessage> & _return, const std::vector<std::string> & _ids, const int64_t _since_version, const int32_t _timeout_ms) = 0;
+  virtual int64_t writeThriftMessageDelta(const ThriftMessage& _delta, const int64_t _base_hash) = 0;
 };
 
 class ThriftRWServiceIfFactory {
@@ -125,6 +128,16 @@ class ThriftRWServiceNull : virtual public ThriftRWServiceIf {
   void readId(std::vector<std::string> & /* _return */) {
     return;
   }
+  void scanIds(std::vector<std::string> & /* _return */, const std::string& /* _cursor */, const std::string& /* _prefix */, const int32_t /* _limit */) {
+    return;
+  }
+  void waitForChanges(std::vector<ThriftMessage> & /* _return */, const std::vector<std::string> & /* _ids */, const int64_t /* _since_version */, const int32_t /* _timeout_ms */) {
+    return;
+  }
+  int64_t writeThriftMessageDelta(const ThriftMessage& /* _delta */, const int64_t /* _base_hash */) {
+    int64_t _return = 0;
+    return _return;
+  }
 };
 
 
@@ -2049,6 +2062,377 @@ class ThriftRWService_readId_presult {
 
 };
 
+typedef struct _ThriftRWService_scanIds_args__isset {
+  _ThriftRWService_scanIds_args__isset() : _cursor(false), _prefix(false), _limit(false) {}
+  bool _cursor :1;
+  bool _prefix :1;
+  bool _limit :1;
+} _ThriftRWService_scanIds_args__isset;
+
+class ThriftRWService_scanIds_args {
+ public:
+
+  ThriftRWService_scanIds_args(const ThriftRWService_scanIds_args&);
+  ThriftRWService_scanIds_args& operator=(const ThriftRWService_scanIds_args&);
+  ThriftRWService_scanIds_args() : _cursor(), _prefix(), _limit(0) {
+  }
+
+  virtual ~ThriftRWService_scanIds_args() throw();
+  std::string _cursor;
+  std::string _prefix;
+  int32_t _limit;
+
+  _ThriftRWService_scanIds_args__isset __isset;
+
+  void __set__cursor(const std::string& val);
+
+  void __set__prefix(const std::string& val);
+
+  void __set__limit(const int32_t val);
+
+  bool operator == (const ThriftRWService_scanIds_args & rhs) const
+  {
+    if (!(_cursor == rhs._cursor))
+      return false;
+    if (!(_prefix == rhs._prefix))
+      return false;
+    if (!(_limit == rhs._limit))
+      return false;
+    return true;
+  }
+  bool operator != (const ThriftRWService_scanIds_args &rhs) const {
+    return !(*this == rhs);
+  }
+
+  bool operator < (const ThriftRWService_scanIds_args & ) const;
+
+  uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
+  uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
+
+};
+
+
+class ThriftRWService_scanIds_pargs {
+ public:
+
+
+  virtual ~ThriftRWService_scanIds_pargs() throw();
+  const std::string* _cursor;
+  const std::string* _prefix;
+  const int32_t* _limit;
+
+  uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
+
+};
+
+typedef struct _ThriftRWService_scanIds_result__isset {
+  _ThriftRWService_scanIds_result__isset() : success(false), e(false) {}
+  bool success :1;
+  bool e :1;
+} _ThriftRWService_scanIds_result__isset;
+
+class ThriftRWService_scanIds_result {
+ public:
+
+  ThriftRWService_scanIds_result(const ThriftRWService_scanIds_result&);
+  ThriftRWService_scanIds_result& operator=(const ThriftRWService_scanIds_result&);
+  ThriftRWService_scanIds_result() {
+  }
+
+  virtual ~ThriftRWService_scanIds_result() throw();
+  std::vector<std::string>  success;
+  InvalidOperationException e;
+
+  _ThriftRWService_scanIds_result__isset __isset;
+
+  void __set_success(const std::vector<std::string> & val);
+
+  void __set_e(const InvalidOperationException& val);
+
+  bool operator == (const ThriftRWService_scanIds_result & rhs) const
+  {
+    if (!(success == rhs.success))
+      return false;
+    if (!(e == rhs.e))
+      return false;
+    return true;
+  }
+  bool operator != (const ThriftRWService_scanIds_result &rhs) const {
+    return !(*this == rhs);
+  }
+
+  bool operator < (const ThriftRWService_scanIds_result & ) const;
+
+  uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
+  uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
+
+};
+
+typedef struct _ThriftRWService_scanIds_presult__isset {
+  _ThriftRWService_scanIds_presult__isset() : success(false), e(false) {}
+  bool success :1;
+  bool e :1;
+} _ThriftRWService_scanIds_presult__isset;
+
+class ThriftRWService_scanIds_presult {
+ public:
+
+
+  virtual ~ThriftRWService_scanIds_presult() throw();
+  std::vector<std::string> * success;
+  InvalidOperationException e;
+
+  _ThriftRWService_scanIds_presult__isset __isset;
+
+  uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
+
+};
+
+typedef struct _ThriftRWService_waitForChanges_args__isset {
+  _ThriftRWService_waitForChanges_args__isset() : _ids(false), _since_version(false), _timeout_ms(false) {}
+  bool _ids :1;
+  bool _since_version :1;
+  bool _timeout_ms :1;
+} _ThriftRWService_waitForChanges_args__isset;
+
+class ThriftRWService_waitForChanges_args {
+ public:
+
+  ThriftRWService_waitForChanges_args(const ThriftRWService_waitForChanges_args&);
+  ThriftRWService_waitForChanges_args& operator=(const ThriftRWService_waitForChanges_args&);
+  ThriftRWService_waitForChanges_args() : _since_version(0), _timeout_ms(0) {
+  }
+
+  virtual ~ThriftRWService_waitForChanges_args() throw();
+  std::vector<std::string>  _ids;
+  int64_t _since_version;
+  int32_t _timeout_ms;
+
+  _ThriftRWService_waitForChanges_args__isset __isset;
+
+  void __set__ids(const std::vector<std::string> & val);
+
+  void __set__since_version(const int64_t val);
+
+  void __set__timeout_ms(const int32_t val);
+
+  bool operator == (const ThriftRWService_waitForChanges_args & rhs) const
+  {
+    if (!(_ids == rhs._ids))
+      return false;
+    if (!(_since_version == rhs._since_version))
+      return false;
+    if (!(_timeout_ms == rhs._timeout_ms))
+      return false;
+    return true;
+  }
+  bool operator != (const ThriftRWService_waitForChanges_args &rhs) const {
+    return !(*this == rhs);
+  }
+
+  bool operator < (const ThriftRWService_waitForChanges_args & ) const;
+
+  uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
+  uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
+
+};
+
+
+class ThriftRWService_waitForChanges_pargs {
+ public:
+
+
+  virtual ~ThriftRWService_waitForChanges_pargs() throw();
+  const std::vector<std::string> * _ids;
+  const int64_t* _since_version;
+  const int32_t* _timeout_ms;
+
+  uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
+
+};
+
+typedef struct _ThriftRWService_waitForChanges_result__isset {
+  _ThriftRWService_waitForChanges_result__isset() : success(false), e(false) {}
+  bool success :1;
+  bool e :1;
+} _ThriftRWService_waitForChanges_result__isset;
+
+class ThriftRWService_waitForChanges_result {
+ public:
+
+  ThriftRWService_waitForChanges_result(const ThriftRWService_waitForChanges_result&);
+  ThriftRWService_waitForChanges_result& operator=(const ThriftRWService_waitForChanges_result&);
+  ThriftRWService_waitForChanges_result() {
+  }
+
+  virtual ~ThriftRWService_waitForChanges_result() throw();
+  std::vector<ThriftMessage>  success;
+  InvalidOperationException e;
+
+  _ThriftRWService_waitForChanges_result__isset __isset;
+
+  void __set_success(const std::vector<ThriftMessage> & val);
+
+  void __set_e(const InvalidOperationException& val);
+
+  bool operator == (const ThriftRWService_waitForChanges_result & rhs) const
+  {
+    if (!(success == rhs.success))
+      return false;
+    if (!(e == rhs.e))
+      return false;
+    return true;
+  }
+  bool operator != (const ThriftRWService_waitForChanges_result &rhs) const {
+    return !(*this == rhs);
+  }
+
+  bool operator < (const ThriftRWService_waitForChanges_result & ) const;
+
+  uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
+  uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
+
+};
+
+typedef struct _ThriftRWService_waitForChanges_presult__isset {
+  _ThriftRWService_waitForChanges_presult__isset() : success(false), e(false) {}
+  bool success :1;
+  bool e :1;
+} _ThriftRWService_waitForChanges_presult__isset;
+
+class ThriftRWService_waitForChanges_presult {
+ public:
+
+
+  virtual ~ThriftRWService_waitForChanges_presult() throw();
+  std::vector<ThriftMessage> * success;
+  InvalidOperationException e;
+
+  _ThriftRWService_waitForChanges_presult__isset __isset;
+
+  uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
+
+};
+
+typedef struct _ThriftRWService_writeThriftMessageDelta_args__isset {
+  _ThriftRWService_writeThriftMessageDelta_args__isset() : _delta(false), _base_hash(false) {}
+  bool _delta :1;
+  bool _base_hash :1;
+} _ThriftRWService_writeThriftMessageDelta_args__isset;
+
+class ThriftRWService_writeThriftMessageDelta_args {
+ public:
+
+  ThriftRWService_writeThriftMessageDelta_args(const ThriftRWService_writeThriftMessageDelta_args&);
+  ThriftRWService_writeThriftMessageDelta_args& operator=(const ThriftRWService_writeThriftMessageDelta_args&);
+  ThriftRWService_writeThriftMessageDelta_args() : _base_hash(0) {
+  }
+
+  virtual ~ThriftRWService_writeThriftMessageDelta_args() throw();
+  ThriftMessage _delta;
+  int64_t _base_hash;
+
+  _ThriftRWService_writeThriftMessageDelta_args__isset __isset;
+
+  void __set__delta(const ThriftMessage& val);
+
+  void __set__base_hash(const int64_t val);
+
+  bool operator == (const ThriftRWService_writeThriftMessageDelta_args & rhs) const
+  {
+    if (!(_delta == rhs._delta))
+      return false;
+    if (!(_base_hash == rhs._base_hash))
+      return false;
+    return true;
+  }
+  bool operator != (const ThriftRWService_writeThriftMessageDelta_args &rhs) const {
+    return !(*this == rhs);
+  }
+
+  bool operator < (const ThriftRWService_writeThriftMessageDelta_args & ) const;
+
+  uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
+  uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
+
+};
+
+
+class ThriftRWService_writeThriftMessageDelta_pargs {
+ public:
+
+
+  virtual ~ThriftRWService_writeThriftMessageDelta_pargs() throw();
+  const ThriftMessage* _delta;
+  const int64_t* _base_hash;
+
+  uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
+
+};
+
+typedef struct _ThriftRWService_writeThriftMessageDelta_result__isset {
+  _ThriftRWService_writeThriftMessageDelta_result__isset() : success(false), e(false) {}
+  bool success :1;
+  bool e :1;
+} _ThriftRWService_writeThriftMessageDelta_result__isset;
+
+class ThriftRWService_writeThriftMessageDelta_result {
+ public:
+
+  ThriftRWService_writeThriftMessageDelta_result(const ThriftRWService_writeThriftMessageDelta_result&);
+  ThriftRWService_writeThriftMessageDelta_result& operator=(const ThriftRWService_writeThriftMessageDelta_result&);
+  ThriftRWService_writeThriftMessageDelta_result() : success(0) {
+  }
+
+  virtual ~ThriftRWService_writeThriftMessageDelta_result() throw();
+  int64_t success;
+  InvalidOperationException e;
+
+  _ThriftRWService_writeThriftMessageDelta_result__isset __isset;
+
+  void __set_success(const int64_t val);
+
+  void __set_e(const InvalidOperationException& val);
+
+  bool operator == (const ThriftRWService_writeThriftMessageDelta_result & rhs) const
+  {
+    if (!(success == rhs.success))
+      return false;
+    if (!(e == rhs.e))
+      return false;
+    return true;
+  }
+  bool operator != (const ThriftRWService_writeThriftMessageDelta_result &rhs) const {
+    return !(*this == rhs);
+  }
+
+  bool operator < (const ThriftRWService_writeThriftMessageDelta_result & ) const;
+
+  uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
+  uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
+
+};
+
+typedef struct _ThriftRWService_writeThriftMessageDelta_presult__isset {
+  _ThriftRWService_writeThriftMessageDelta_presult__isset() : success(false), e(false) {}
+  bool success :1;
+  bool e :1;
+} _ThriftRWService_writeThriftMessageDelta_presult__isset;
+
+class ThriftRWService_writeThriftMessageDelta_presult {
+ public:
+
+
+  virtual ~ThriftRWService_writeThriftMessageDelta_presult() throw();
+  int64_t* success;
+  InvalidOperationException e;
+
+  _ThriftRWService_writeThriftMessageDelta_presult__isset __isset;
+
+  uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
+
+};
+
 class ThriftRWServiceClient : virtual public ThriftRWServiceIf {
  public:
   ThriftRWServiceClient(apache::thrift::stdcxx::shared_ptr< ::apache::thrift::protocol::TProtocol> prot) {
@@ -2125,6 +2509,15 @@ class ThriftRWServiceClient : virtual public ThriftRWServiceIf {
   void readId(std::vector<std::string> & _return);
   void send_readId();
   void recv_readId(std::vector<std::string> & _return);
+  void scanIds(std::vector<std::string> & _return, const std::string& _cursor, const std::string& _prefix, const int32_t _limit);
+  void send_scanIds(const std::string& _cursor, const std::string& _prefix, const int32_t _limit);
+  void recv_scanIds(std::vector<std::string> & _return);
+  void waitForChanges(std::vector<ThriftMessage> & _return, const std::vector<std::string> & _ids, const int64_t _since_version, const int32_t _timeout_ms);
+  void send_waitForChanges(const std::vector<std::string> & _ids, const int64_t _since_version, const int32_t _timeout_ms);
+  void recv_waitForChanges(std::vector<ThriftMessage> & _return);
+  int64_t writeThriftMessageDelta(const ThriftMessage& _delta, const int64_t _base_hash);
+  void send_writeThriftMessageDelta(const ThriftMessage& _delta, const int64_t _base_hash);
+  int64_t recv_writeThriftMessageDelta();
  protected:
   apache::thrift::stdcxx::shared_ptr< ::apache::thrift::protocol::TProtocol> piprot_;
   apache::thrift::stdcxx::shared_ptr< ::apache::thrift::protocol::TProtocol> poprot_;
@@ -2157,6 +2550,9 @@ class ThriftRWServiceProcessor : public ::apache::thrift::TDispatchProcessor {
   void process_readString(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext);
   void process_writeId(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext);
   void process_readId(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext);
+  void process_scanIds(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext);
+  void process_waitForChanges(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext);
+  void process_writeThriftMessageDelta(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext);
  public:
   ThriftRWServiceProcessor(::apache::thrift::stdcxx::shared_ptr<ThriftRWServiceIf> iface) :
     iface_(iface) {
@@ -2177,6 +2573,9 @@ class ThriftRWServiceProcessor : public ::apache::thrift::TDispatchProcessor {
     processMap_["readString"] = &ThriftRWServiceProcessor::process_readString;
     processMap_["writeId"] = &ThriftRWServiceProcessor::process_writeId;
     processMap_["readId"] = &ThriftRWServiceProcessor::process_readId;
+    processMap_["scanIds"] = &ThriftRWServiceProcessor::process_scanIds;
+    processMap_["waitForChanges"] = &ThriftRWServiceProcessor::process_waitForChanges;
+    processMap_["writeThriftMessageDelta"] = &ThriftRWServiceProcessor::process_writeThriftMessageDelta;
   }
 
   virtual ~ThriftRWServiceProcessor() {}
@@ -2368,6 +2767,35 @@ class ThriftRWServiceMultiface : virtual public ThriftRWServiceIf {
     return;
   }
 
+  void scanIds(std::vector<std::string> & _return, const std::string& _cursor, const std::string& _prefix, const int32_t _limit) {
+    size_t sz = ifaces_.size();
+    size_t i = 0;
+    for (; i < (sz - 1); ++i) {
+      ifaces_[i]->scanIds(_return, _cursor, _prefix, _limit);
+    }
+    ifaces_[i]->scanIds(_return, _cursor, _prefix, _limit);
+    return;
+  }
+
+  void waitForChanges(std::vector<ThriftMessage> & _return, const std::vector<std::string> & _ids, const int64_t _since_version, const int32_t _timeout_ms) {
+    size_t sz = ifaces_.size();
+    size_t i = 0;
+    for (; i < (sz - 1); ++i) {
+      ifaces_[i]->waitForChanges(_return, _ids, _since_version, _timeout_ms);
+    }
+    ifaces_[i]->waitForChanges(_return, _ids, _since_version, _timeout_ms);
+    return;
+  }
+
+  int64_t writeThriftMessageDelta(const ThriftMessage& _delta, const int64_t _base_hash) {
+    size_t sz = ifaces_.size();
+    size_t i = 0;
+    for (; i < (sz - 1); ++i) {
+      ifaces_[i]->writeThriftMessageDelta(_delta, _base_hash);
+    }
+    return ifaces_[i]->writeThriftMessageDelta(_delta, _base_hash);
+  }
+
 };
 
 // The 'concurrent' client is a thread safe client that correctly handles
@@ -2449,6 +2877,15 @@ class ThriftRWServiceConcurrentClient : virtual public ThriftRWServiceIf {
   void readId(std::vector<std::string> & _return);
   int32_t send_readId();
   void recv_readId(std::vector<std::string> & _return, const int32_t seqid);
+  void scanIds(std::vector<std::string> & _return, const std::string& _cursor, const std::string& _prefix, const int32_t _limit);
+  int32_t send_scanIds(const std::string& _cursor, const std::string& _prefix, const int32_t _limit);
+  void recv_scanIds(std::vector<std::string> & _return, const int32_t seqid);
+  void waitForChanges(std::vector<ThriftMessage> & _return, const std::vector<std::string> & _ids, const int64_t _since_version, const int32_t _timeout_ms);
+  int32_t send_waitForChanges(const std::vector<std::string> & _ids, const int64_t _since_version, const int32_t _timeout_ms);
+  void recv_waitForChanges(std::vector<ThriftMessage> & _return, const int32_t seqid);
+  int64_t writeThriftMessageDelta(const ThriftMessage& _delta, const int64_t _base_hash);
+  int32_t send_writeThriftMessageDelta(const ThriftMessage& _delta, const int64_t _base_hash);
+  int64_t recv_writeThriftMessageDelta(const int32_t seqid);
  protected:
   apache::thrift::stdcxx::shared_ptr< ::apache::thrift::protocol::TProtocol> piprot_;
   apache::thrift::stdcxx::shared_ptr< ::apache::thrift::protocol::TProtocol> poprot_;
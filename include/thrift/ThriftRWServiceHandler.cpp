@@ -0,0 +1,292 @@
+#include "ThriftRWServiceHandler.h"
+#include "messenger_delta.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace thrift_gen {
+
+const int32_t ThriftRWServiceHandler::kUnknownId;
+const int32_t ThriftRWServiceHandler::kInvalidLimit;
+const int32_t ThriftRWServiceHandler::kInvalidTimeout;
+const int32_t ThriftRWServiceHandler::kStaleBase;
+const int32_t ThriftRWServiceHandler::kMaxScanLimit;
+const int32_t ThriftRWServiceHandler::kMaxChangeBatch;
+const int32_t ThriftRWServiceHandler::kMaxWaitTimeoutMs;
+
+ThriftRWServiceHandler::ThriftRWServiceHandler() : version_(0) {
+}
+
+template <typename T>
+void ThriftRWServiceHandler::write(std::unordered_map<std::string, T>& store, std::string& _return,
+                                   const std::string& _id, const T& _v) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  store[_id] = _v;
+  ids_.insert(_id);
+  touch(_id);
+  _return = _id;
+}
+
+template <typename T>
+void ThriftRWServiceHandler::read(const std::unordered_map<std::string, T>& store, T& _return,
+                                  const std::string& _id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  typename std::unordered_map<std::string, T>::const_iterator it = store.find(_id);
+  if (it == store.end()) {
+    InvalidOperationException e;
+    e.code = kUnknownId;
+    e.description = "unknown id: " + _id;
+    throw e;
+  }
+  _return = it->second;
+}
+
+bool ThriftRWServiceHandler::ping() {
+  return true;
+}
+
+void ThriftRWServiceHandler::writeThriftMessage(std::string& _return, const ThriftMessage& _v) {
+  int64_t hash = contentHash(_v);
+  std::lock_guard<std::mutex> lock(mutex_);
+  _return = _v._sender_id;
+  std::unordered_map<std::string, int64_t>::const_iterator stored = messageHashes_.find(_v._sender_id);
+  if (stored != messageHashes_.end() && stored->second == hash && messages_[_v._sender_id] == _v)
+    return;
+  messages_[_v._sender_id] = _v;
+  messageHashes_[_v._sender_id] = hash;
+  ids_.insert(_v._sender_id);
+  touch(_v._sender_id);
+}
+
+/**
+ * Merges the set fields of _delta into the message stored under its
+ * _sender_id and returns the content hash of the result. _base_hash must be
+ * the hash of the stored message the delta was computed against, otherwise
+ * kStaleBase is thrown and the client has to write the full message.
+ */
+int64_t ThriftRWServiceHandler::writeThriftMessageDelta(const ThriftMessage& _delta, const int64_t _base_hash) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::unordered_map<std::string, ThriftMessage>::iterator stored = messages_.find(_delta._sender_id);
+  if (stored == messages_.end()) {
+    InvalidOperationException e;
+    e.code = kUnknownId;
+    e.description = "unknown id: " + _delta._sender_id;
+    throw e;
+  }
+  int64_t& hash = messageHashes_[_delta._sender_id];
+  if (hash != _base_hash) {
+    InvalidOperationException e;
+    e.code = kStaleBase;
+    e.description = "stale base for id: " + _delta._sender_id;
+    throw e;
+  }
+
+  ThriftMessage merged = stored->second;
+  applyDelta(merged, _delta);
+  int64_t mergedHash = contentHash(merged);
+  if (mergedHash == hash && merged == stored->second)
+    return hash;
+  swap(stored->second, merged);
+  hash = mergedHash;
+  touch(_delta._sender_id);
+  return hash;
+}
+
+void ThriftRWServiceHandler::writeBool(std::string& _return, const std::string& _id, const bool _v) {
+  write(bools_, _return, _id, _v);
+}
+
+void ThriftRWServiceHandler::writeI16(std::string& _return, const std::string& _id, const int16_t _v) {
+  write(i16s_, _return, _id, _v);
+}
+
+void ThriftRWServiceHandler::writeI32(std::string& _return, const std::string& _id, const int32_t _v) {
+  write(i32s_, _return, _id, _v);
+}
+
+void ThriftRWServiceHandler::writeI64(std::string& _return, const std::string& _id, const int64_t _v) {
+  write(i64s_, _return, _id, _v);
+}
+
+void ThriftRWServiceHandler::writeDouble(std::string& _return, const std::string& _id, const double _v) {
+  write(doubles_, _return, _id, _v);
+}
+
+void ThriftRWServiceHandler::writeString(std::string& _return, const std::string& _id, const std::string& _v) {
+  write(strings_, _return, _id, _v);
+}
+
+void ThriftRWServiceHandler::readThriftMessage(ThriftMessage& _return, const std::string& _id) {
+  read(messages_, _return, _id);
+}
+
+bool ThriftRWServiceHandler::readBool(const std::string& _id) {
+  bool _return = false;
+  read(bools_, _return, _id);
+  return _return;
+}
+
+int16_t ThriftRWServiceHandler::readI16(const std::string& _id) {
+  int16_t _return = 0;
+  read(i16s_, _return, _id);
+  return _return;
+}
+
+int32_t ThriftRWServiceHandler::readI32(const std::string& _id) {
+  int32_t _return = 0;
+  read(i32s_, _return, _id);
+  return _return;
+}
+
+int64_t ThriftRWServiceHandler::readI64(const std::string& _id) {
+  int64_t _return = 0;
+  read(i64s_, _return, _id);
+  return _return;
+}
+
+double ThriftRWServiceHandler::readDouble(const std::string& _id) {
+  double _return = 0;
+  read(doubles_, _return, _id);
+  return _return;
+}
+
+void ThriftRWServiceHandler::readString(std::string& _return, const std::string& _id) {
+  read(strings_, _return, _id);
+}
+
+bool ThriftRWServiceHandler::writeId(const std::string& _id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return ids_.insert(_id).second;
+}
+
+void ThriftRWServiceHandler::readId(std::vector<std::string> & _return) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  _return.assign(ids_.begin(), ids_.end());
+}
+
+/**
+ * Returns up to _limit ids that start with _prefix and sort after _cursor.
+ * An empty cursor starts at the first matching id; passing the last id of a
+ * page as the next cursor continues the scan. A page shorter than _limit is
+ * the last one. The empty id, if it was ever written, is returned first and
+ * cannot itself be used as a cursor.
+ */
+void ThriftRWServiceHandler::scanIds(std::vector<std::string> & _return, const std::string& _cursor,
+                                     const std::string& _prefix, const int32_t _limit) {
+  if (_limit <= 0 || _limit > kMaxScanLimit) {
+    InvalidOperationException e;
+    e.code = kInvalidLimit;
+    e.description = "limit out of range: " + std::to_string(_limit);
+    throw e;
+  }
+  _return.clear();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::set<std::string>::const_iterator it;
+  if (_cursor.empty() || _cursor < _prefix)
+    it = ids_.lower_bound(_prefix);
+  else
+    it = ids_.upper_bound(_cursor);
+  for (; it != ids_.end() && _return.size() < static_cast<size_t>(_limit); ++it) {
+    if (it->compare(0, _prefix.size(), _prefix) != 0)
+      break;
+    _return.push_back(*it);
+  }
+}
+
+/**
+ * Returns the watched ids whose version is newer than _since_version, ordered
+ * by version. Each change carries the id in _sender_id, its version in
+ * _sequence_no and every value stored under the id as a one element
+ * _list_bool/_list_i16/.../_list_message. An empty _ids watches all ids.
+ * If nothing changed yet the call waits up to _timeout_ms for a write and
+ * returns an empty list on timeout. Passing the largest _sequence_no seen as
+ * the next _since_version continues without gaps; at most kMaxChangeBatch
+ * changes are returned per call.
+ */
+void ThriftRWServiceHandler::waitForChanges(std::vector<ThriftMessage> & _return, const std::vector<std::string> & _ids,
+                                            const int64_t _since_version, const int32_t _timeout_ms) {
+  if (_timeout_ms < 0 || _timeout_ms > kMaxWaitTimeoutMs) {
+    InvalidOperationException e;
+    e.code = kInvalidTimeout;
+    e.description = "timeout out of range: " + std::to_string(_timeout_ms);
+    throw e;
+  }
+  _return.clear();
+
+  std::chrono::steady_clock::time_point deadline =
+      std::chrono::steady_clock::now() + std::chrono::milliseconds(_timeout_ms);
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (!collectChanges(_return, _ids, _since_version)) {
+    if (changed_.wait_until(lock, deadline) == std::cv_status::timeout) {
+      collectChanges(_return, _ids, _since_version);
+      return;
+    }
+  }
+}
+
+void ThriftRWServiceHandler::touch(const std::string& _id) {
+  int64_t& version = versions_[_id];
+  if (version != 0)
+    changes_.erase(version);
+  version = ++version_;
+  changes_[version] = _id;
+  changed_.notify_all();
+}
+
+bool ThriftRWServiceHandler::collectChanges(std::vector<ThriftMessage>& _return, const std::vector<std::string>& _ids,
+                                            int64_t _since_version) const {
+  if (version_ <= _since_version)
+    return false;
+
+  std::vector<std::pair<int64_t, const std::string*> > changed;
+  if (_ids.empty()) {
+    std::map<int64_t, std::string>::const_iterator it = changes_.upper_bound(_since_version);
+    for (; it != changes_.end() && changed.size() < static_cast<size_t>(kMaxChangeBatch); ++it)
+      changed.push_back(std::make_pair(it->first, &it->second));
+  } else {
+    for (size_t i = 0; i < _ids.size(); ++i) {
+      std::unordered_map<std::string, int64_t>::const_iterator it = versions_.find(_ids[i]);
+      if (it != versions_.end() && it->second > _since_version)
+        changed.push_back(std::make_pair(it->second, &it->first));
+    }
+    std::sort(changed.begin(), changed.end());
+    changed.erase(std::unique(changed.begin(), changed.end()), changed.end());
+    if (changed.size() > static_cast<size_t>(kMaxChangeBatch))
+      changed.resize(kMaxChangeBatch);
+  }
+
+  _return.resize(changed.size());
+  for (size_t i = 0; i < changed.size(); ++i)
+    fillChange(_return[i], *changed[i].second, changed[i].first);
+  return !_return.empty();
+}
+
+void ThriftRWServiceHandler::fillChange(ThriftMessage& change, const std::string& _id, int64_t version) const {
+  change.__set__sender_id(_id);
+  change.__set__sequence_no(version);
+
+  std::unordered_map<std::string, ThriftMessage>::const_iterator message = messages_.find(_id);
+  if (message != messages_.end())
+    change.__set__list_message(std::vector<ThriftMessage>(1, message->second));
+  std::unordered_map<std::string, bool>::const_iterator b = bools_.find(_id);
+  if (b != bools_.end())
+    change.__set__list_bool(std::vector<bool>(1, b->second));
+  std::unordered_map<std::string, int16_t>::const_iterator i16 = i16s_.find(_id);
+  if (i16 != i16s_.end())
+    change.__set__list_i16(std::vector<int16_t>(1, i16->second));
+  std::unordered_map<std::string, int32_t>::const_iterator i32 = i32s_.find(_id);
+  if (i32 != i32s_.end())
+    change.__set__list_i32(std::vector<int32_t>(1, i32->second));
+  std::unordered_map<std::string, int64_t>::const_iterator i64 = i64s_.find(_id);
+  if (i64 != i64s_.end())
+    change.__set__list_i64(std::vector<int64_t>(1, i64->second));
+  std::unordered_map<std::string, double>::const_iterator d = doubles_.find(_id);
+  if (d != doubles_.end())
+    change.__set__list_double(std::vector<double>(1, d->second));
+  std::unordered_map<std::string, std::string>::const_iterator str = strings_.find(_id);
+  if (str != strings_.end())
+    change.__set__list_string(std::vector<std::string>(1, str->second));
+}
+
+} // namespace
@@ -0,0 +1,108 @@
+/**
+ * In-memory implementation of ThriftRWServiceIf.
+ *
+ * Values are kept per type and per id; every write also registers its id so
+ * that readId() and scanIds() report it. Reading an id that was never written
+ * with the matching write* call throws InvalidOperationException. All calls
+ * are serialized by one mutex, which makes the handler safe to share between
+ * the worker threads of TThreadedServer/TThreadPoolServer.
+ *
+ * Ids are kept in lexicographic order so scanIds() can seek to a cursor or a
+ * prefix in O(log n) and hold the mutex only for the page it returns. readId()
+ * copies the whole id set into one response and is kept for old clients only.
+ *
+ * Every value write stamps its id with the next store version, and
+ * waitForChanges() blocks until one of the watched ids carries a version newer
+ * than the caller's, so clients can long-poll instead of re-reading values.
+ * A waiting call occupies its server thread, which suits TThreadedServer.
+ *
+ * Messages are stored with their contentHash(). Writing a message that is
+ * equal to the stored one is acknowledged without touching the store or its
+ * version, and writeThriftMessageDelta() merges only the fields a client
+ * changed on top of the stored message.
+ */
+#ifndef ThriftRWServiceHandler_H
+#define ThriftRWServiceHandler_H
+
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+
+#include "ThriftRWService.h"
+
+namespace thrift_gen {
+
+class ThriftRWServiceHandler : virtual public ThriftRWServiceIf {
+ public:
+  // InvalidOperationException::code values
+  static const int32_t kUnknownId = 1;
+  static const int32_t kInvalidLimit = 2;
+  static const int32_t kInvalidTimeout = 3;
+  static const int32_t kStaleBase = 4;
+
+  // upper bound for the _limit argument of scanIds()
+  static const int32_t kMaxScanLimit = 10000;
+
+  // upper bounds for the batch size and _timeout_ms of waitForChanges()
+  static const int32_t kMaxChangeBatch = 10000;
+  static const int32_t kMaxWaitTimeoutMs = 300000;
+
+  ThriftRWServiceHandler();
+  virtual ~ThriftRWServiceHandler() {}
+
+  bool ping();
+  void writeThriftMessage(std::string& _return, const ThriftMessage& _v);
+  void writeBool(std::string& _return, const std::string& _id, const bool _v);
+  void writeI16(std::string& _return, const std::string& _id, const int16_t _v);
+  void writeI32(std::string& _return, const std::string& _id, const int32_t _v);
+  void writeI64(std::string& _return, const std::string& _id, const int64_t _v);
+  void writeDouble(std::string& _return, const std::string& _id, const double _v);
+  void writeString(std::string& _return, const std::string& _id, const std::string& _v);
+  void readThriftMessage(ThriftMessage& _return, const std::string& _id);
+  bool readBool(const std::string& _id);
+  int16_t readI16(const std::string& _id);
+  int32_t readI32(const std::string& _id);
+  int64_t readI64(const std::string& _id);
+  double readDouble(const std::string& _id);
+  void readString(std::string& _return, const std::string& _id);
+  bool writeId(const std::string& _id);
+  void readId(std::vector<std::string> & _return);
+  void scanIds(std::vector<std::string> & _return, const std::string& _cursor, const std::string& _prefix, const int32_t _limit);
+  void waitForChanges(std::vector<ThriftMessage> & _return, const std::vector<std::string> & _ids, const int64_t _since_version, const int32_t _timeout_ms);
+  int64_t writeThriftMessageDelta(const ThriftMessage& _delta, const int64_t _base_hash);
+
+ private:
+  template <typename T>
+  void write(std::unordered_map<std::string, T>& store, std::string& _return,
+             const std::string& _id, const T& _v);
+
+  template <typename T>
+  void read(const std::unordered_map<std::string, T>& store, T& _return, const std::string& _id);
+
+  void touch(const std::string& _id);
+  bool collectChanges(std::vector<ThriftMessage>& _return, const std::vector<std::string>& _ids,
+                      int64_t _since_version) const;
+  void fillChange(ThriftMessage& change, const std::string& _id, int64_t version) const;
+
+  std::mutex mutex_;
+  std::condition_variable changed_;
+  std::set<std::string> ids_;
+  int64_t version_;
+  std::unordered_map<std::string, int64_t> versions_;
+  std::map<int64_t, std::string> changes_;  // latest version of every written id
+  std::unordered_map<std::string, ThriftMessage> messages_;
+  std::unordered_map<std::string, int64_t> messageHashes_;
+  std::unordered_map<std::string, bool> bools_;
+  std::unordered_map<std::string, int16_t> i16s_;
+  std::unordered_map<std::string, int32_t> i32s_;
+  std::unordered_map<std::string, int64_t> i64s_;
+  std::unordered_map<std::string, double> doubles_;
+  std::unordered_map<std::string, std::string> strings_;
+};
+
+} // namespace
+
+#endif
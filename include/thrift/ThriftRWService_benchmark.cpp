@@ -0,0 +1,490 @@
+/**
+ * End to end load generator for ThriftRWService.
+ *
+ * Starts a TThreadedServer backed by ThriftRWServiceHandler on loopback and
+ * drives it with N concurrent clients issuing a weighted mix of calls. Every
+ * transport/protocol combination is run for every payload shape and the
+ * throughput, p50/p99/p999 latency and server CPU time per request are
+ * reported. Server CPU is the thread CPU time spent inside
+ * TProcessor::process(), so it excludes the clients running in the same
+ * process.
+ *
+ * Build:
+ *   g++ -O2 -std=c++11 -I.. ThriftRWService_benchmark.cpp ThriftRWServiceHandler.cpp \
+ *       ThriftRWService.cpp messenger_delta.cpp messenger_types.cpp -lthrift -lpthread -o ThriftRWService_benchmark
+ *
+ * Options:
+ *   --clients N          concurrent client connections (default 8)
+ *   --seconds S          measured duration of each run (default 5)
+ *   --ids K              distinct ids per value type (default 1000)
+ *   --scan-limit L       page size of scanIds calls (default 100)
+ *   --mix SPEC           call weights, e.g. write=40,read=40,message=10,readmessage=5,scanids=5
+ *                        (readid fetches every id at once, scanids one page of --scan-limit,
+ *                        delta rewrites a message with one changed field via
+ *                        ThriftMessageDeltaWriter)
+ *   --list-sizes A,B,..  sizes of _list_double in written messages (default 16,1024)
+ *   --depths A,B,..      _list_message nesting depths (default 0,2)
+ *   --transports LIST    buffered,framed (default both)
+ *   --protocols LIST     binary,compact,json (default all)
+ *   --port P             loopback port (default 19090)
+ */
+#include "ThriftRWServiceHandler.h"
+#include "messenger_delta.h"
+
+#include <time.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <sstream>
+#include <thread>
+
+#include <thrift/protocol/TBinaryProtocol.h>
+#include <thrift/protocol/TCompactProtocol.h>
+#include <thrift/protocol/TJSONProtocol.h>
+#include <thrift/server/TThreadedServer.h>
+#include <thrift/transport/TBufferTransports.h>
+#include <thrift/transport/TServerSocket.h>
+#include <thrift/transport/TSocket.h>
+
+using namespace ::apache::thrift;
+using namespace ::apache::thrift::protocol;
+using namespace ::apache::thrift::transport;
+using namespace ::apache::thrift::server;
+
+using namespace  ::thrift_gen;
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+enum Op {
+  OP_WRITE,
+  OP_READ,
+  OP_WRITE_MESSAGE,
+  OP_READ_MESSAGE,
+  OP_READ_ID,
+  OP_SCAN_IDS,
+  OP_WRITE_DELTA,
+  OP_COUNT
+};
+
+const char* const kOpNames[OP_COUNT] = { "write", "read", "message", "readmessage", "readid", "scanids", "delta" };
+
+struct Options {
+  Options() : clients(8), seconds(5), ids(1000), scanLimit(100), port(19090) {
+    weights[OP_WRITE] = 40;
+    weights[OP_READ] = 40;
+    weights[OP_WRITE_MESSAGE] = 10;
+    weights[OP_READ_MESSAGE] = 5;
+    weights[OP_READ_ID] = 0;
+    weights[OP_SCAN_IDS] = 5;
+    weights[OP_WRITE_DELTA] = 0;
+    listSizes.push_back(16);
+    listSizes.push_back(1024);
+    depths.push_back(0);
+    depths.push_back(2);
+    transports.push_back("buffered");
+    transports.push_back("framed");
+    protocols.push_back("binary");
+    protocols.push_back("compact");
+    protocols.push_back("json");
+  }
+  int clients;
+  int seconds;
+  int ids;
+  int scanLimit;
+  int port;
+  int weights[OP_COUNT];
+  std::vector<int> listSizes;
+  std::vector<int> depths;
+  std::vector<std::string> transports;
+  std::vector<std::string> protocols;
+};
+
+struct Shape {
+  int listSize;
+  int depth;
+};
+
+std::vector<std::string> split(const std::string& s) {
+  std::vector<std::string> parts;
+  std::stringstream ss(s);
+  std::string part;
+  while (std::getline(ss, part, ','))
+    if (!part.empty())
+      parts.push_back(part);
+  return parts;
+}
+
+std::vector<int> splitInts(const std::string& s) {
+  std::vector<int> values;
+  std::vector<std::string> parts = split(s);
+  for (size_t i = 0; i < parts.size(); ++i)
+    values.push_back(atoi(parts[i].c_str()));
+  return values;
+}
+
+bool parseMix(const std::string& spec, int* weights) {
+  std::fill(weights, weights + OP_COUNT, 0);
+  std::vector<std::string> parts = split(spec);
+  for (size_t i = 0; i < parts.size(); ++i) {
+    size_t eq = parts[i].find('=');
+    std::string name = parts[i].substr(0, eq);
+    int* w = NULL;
+    for (int op = 0; op < OP_COUNT; ++op)
+      if (name == kOpNames[op])
+        w = &weights[op];
+    if (w == NULL || eq == std::string::npos)
+      return false;
+    *w = atoi(parts[i].c_str() + eq + 1);
+  }
+  return true;
+}
+
+bool parseOptions(int argc, char** argv, Options& o) {
+  for (int i = 1; i + 1 < argc; i += 2) {
+    std::string key = argv[i];
+    std::string value = argv[i + 1];
+    if (key == "--clients") o.clients = atoi(value.c_str());
+    else if (key == "--seconds") o.seconds = atoi(value.c_str());
+    else if (key == "--ids") o.ids = atoi(value.c_str());
+    else if (key == "--scan-limit") o.scanLimit = atoi(value.c_str());
+    else if (key == "--port") o.port = atoi(value.c_str());
+    else if (key == "--list-sizes") o.listSizes = splitInts(value);
+    else if (key == "--depths") o.depths = splitInts(value);
+    else if (key == "--transports") o.transports = split(value);
+    else if (key == "--protocols") o.protocols = split(value);
+    else if (key == "--mix") {
+      if (!parseMix(value, o.weights))
+        return false;
+    } else {
+      return false;
+    }
+  }
+  return (argc % 2) == 1;
+}
+
+std::string makeId(char type, int i) {
+  char buf[32];
+  snprintf(buf, sizeof(buf), "%c:%08d", type, i);
+  return buf;
+}
+
+ThriftMessage makeMessage(const std::string& id, int listSize, int depth) {
+  ThriftMessage msg;
+  msg.__set__sender_id(id);
+  msg.__set__subject("benchmark");
+  msg.__set__sequence_no(depth);
+  msg._list_double.reserve(listSize);
+  for (int i = 0; i < listSize; ++i)
+    msg._list_double.push_back(i * 0.25);
+  msg.__isset._list_double = true;
+  if (depth > 0) {
+    msg._list_message.push_back(makeMessage(id + "/child", listSize, depth - 1));
+    msg.__isset._list_message = true;
+  }
+  return msg;
+}
+
+/**
+ * Accounts the thread CPU time spent processing each request.
+ */
+class CpuAccountingProcessor : public TProcessor {
+ public:
+  explicit CpuAccountingProcessor(stdcxx::shared_ptr<TProcessor> processor)
+    : processor_(processor), cpuNs_(0), requests_(0) {}
+
+  bool process(stdcxx::shared_ptr<TProtocol> in, stdcxx::shared_ptr<TProtocol> out, void* connectionContext) {
+    int64_t start = threadCpuNs();
+    bool result = processor_->process(in, out, connectionContext);
+    cpuNs_ += threadCpuNs() - start;
+    ++requests_;
+    return result;
+  }
+
+  void reset() {
+    cpuNs_ = 0;
+    requests_ = 0;
+  }
+
+  int64_t cpuNs() const { return cpuNs_; }
+  int64_t requests() const { return requests_; }
+
+ private:
+  static int64_t threadCpuNs() {
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+  }
+
+  stdcxx::shared_ptr<TProcessor> processor_;
+  std::atomic<int64_t> cpuNs_;
+  std::atomic<int64_t> requests_;
+};
+
+/**
+ * Signals once the server socket is listening.
+ */
+class ReadyEventHandler : public TServerEventHandler {
+ public:
+  ReadyEventHandler() : ready_(false) {}
+
+  void preServe() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ready_ = true;
+    cond_.notify_all();
+  }
+
+  void wait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!ready_)
+      cond_.wait(lock);
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  bool ready_;
+};
+
+stdcxx::shared_ptr<TTransportFactory> makeTransportFactory(const std::string& name) {
+  if (name == "framed")
+    return stdcxx::shared_ptr<TTransportFactory>(new TFramedTransportFactory());
+  return stdcxx::shared_ptr<TTransportFactory>(new TBufferedTransportFactory());
+}
+
+stdcxx::shared_ptr<TProtocolFactory> makeProtocolFactory(const std::string& name) {
+  if (name == "compact")
+    return stdcxx::shared_ptr<TProtocolFactory>(new TCompactProtocolFactory());
+  if (name == "json")
+    return stdcxx::shared_ptr<TProtocolFactory>(new TJSONProtocolFactory());
+  return stdcxx::shared_ptr<TProtocolFactory>(new TBinaryProtocolFactory());
+}
+
+struct Connection {
+  stdcxx::shared_ptr<TTransport> transport;
+  stdcxx::shared_ptr<ThriftRWServiceClient> client;
+};
+
+Connection connect(int port, const std::string& transport, const std::string& protocol) {
+  stdcxx::shared_ptr<TSocket> socket(new TSocket("127.0.0.1", port));
+  socket->setNoDelay(true);
+  Connection c;
+  if (transport == "framed")
+    c.transport.reset(new TFramedTransport(socket));
+  else
+    c.transport.reset(new TBufferedTransport(socket));
+  c.client.reset(new ThriftRWServiceClient(makeProtocolFactory(protocol)->getProtocol(c.transport)));
+  c.transport->open();
+  return c;
+}
+
+void populate(ThriftRWServiceClient& client, int ids, const Shape& shape) {
+  std::string ret;
+  for (int i = 0; i < ids; ++i) {
+    client.writeBool(ret, makeId('b', i), (i & 1) != 0);
+    client.writeI16(ret, makeId('s', i), static_cast<int16_t>(i));
+    client.writeI32(ret, makeId('i', i), i);
+    client.writeI64(ret, makeId('l', i), i);
+    client.writeDouble(ret, makeId('d', i), i * 0.5);
+    client.writeString(ret, makeId('t', i), makeId('t', i));
+    client.writeThriftMessage(ret, makeMessage(makeId('m', i), shape.listSize, shape.depth));
+  }
+}
+
+struct ClientStats {
+  std::vector<int64_t> latencyNs; // successful calls only
+  int64_t errors;
+};
+
+// A transport or protocol failure leaves the connection unusable, so every
+// later call on it would fail too. Returns false if it cannot be reopened.
+bool reconnect(const Connection& c) {
+  try {
+    c.transport->close();
+    c.transport->open();
+  } catch (const TException&) {
+    return false;
+  }
+  return true;
+}
+
+void runClient(const Options& o, const Connection& c, const Shape& shape, int seed,
+               Clock::time_point deadline, ClientStats& stats) {
+  std::mt19937 rng(seed);
+  int totalWeight = 0;
+  for (int op = 0; op < OP_COUNT; ++op)
+    totalWeight += o.weights[op];
+  std::uniform_int_distribution<int> pickOp(0, std::max(totalWeight - 1, 0));
+  std::uniform_int_distribution<int> pickId(0, o.ids - 1);
+  std::uniform_int_distribution<int> pickType(0, 5);
+  ThriftRWServiceClient& client = *c.client;
+  std::vector<ThriftMessage> messages;
+  for (int i = 0; i < 16; ++i)
+    messages.push_back(makeMessage(makeId('m', i), shape.listSize, shape.depth));
+  std::string str;
+  ThriftMessage msg;
+  std::vector<std::string> ids;
+  ThriftMessageDeltaWriter deltaWriter(client);
+  stats.errors = 0;
+
+  while (Clock::now() < deadline) {
+    int r = pickOp(rng);
+    int op = 0;
+    while (op < OP_COUNT - 1 && r >= o.weights[op])
+      r -= o.weights[op++];
+    int i = pickId(rng);
+    Clock::time_point start = Clock::now();
+    try {
+      switch (op) {
+        case OP_WRITE:
+          switch (pickType(rng)) {
+            case 0: client.writeBool(str, makeId('b', i), (i & 1) != 0); break;
+            case 1: client.writeI16(str, makeId('s', i), static_cast<int16_t>(i)); break;
+            case 2: client.writeI32(str, makeId('i', i), i); break;
+            case 3: client.writeI64(str, makeId('l', i), i); break;
+            case 4: client.writeDouble(str, makeId('d', i), i * 0.5); break;
+            default: client.writeString(str, makeId('t', i), makeId('t', i)); break;
+          }
+          break;
+        case OP_READ:
+          switch (pickType(rng)) {
+            case 0: client.readBool(makeId('b', i)); break;
+            case 1: client.readI16(makeId('s', i)); break;
+            case 2: client.readI32(makeId('i', i)); break;
+            case 3: client.readI64(makeId('l', i)); break;
+            case 4: client.readDouble(makeId('d', i)); break;
+            default: client.readString(str, makeId('t', i)); break;
+          }
+          break;
+        case OP_WRITE_MESSAGE: {
+          ThriftMessage& m = messages[i % messages.size()];
+          m._sender_id = makeId('m', i);
+          client.writeThriftMessage(str, m);
+          break;
+        }
+        case OP_READ_MESSAGE:
+          client.readThriftMessage(msg, makeId('m', i));
+          break;
+        case OP_READ_ID:
+          client.readId(ids);
+          break;
+        case OP_SCAN_IDS:
+          client.scanIds(ids, makeId('t', i), "t:", o.scanLimit);
+          break;
+        default: {
+          ThriftMessage& m = messages[i % messages.size()];
+          m._sender_id = makeId('m', i);
+          m.__set__sequence_no(m._sequence_no + 1);
+          deltaWriter.write(m);
+          break;
+        }
+      }
+      stats.latencyNs.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+    } catch (const InvalidOperationException&) {
+      ++stats.errors;
+    } catch (const TTransportException&) {
+      ++stats.errors;
+      if (!reconnect(c))
+        return;
+    } catch (const TProtocolException&) {
+      ++stats.errors;
+      if (!reconnect(c))
+        return;
+    } catch (const TException&) {
+      ++stats.errors;
+    }
+  }
+}
+
+double percentileUs(std::vector<int64_t>& v, double p) {
+  if (v.empty())
+    return 0;
+  size_t k = static_cast<size_t>(p * (v.size() - 1));
+  std::nth_element(v.begin(), v.begin() + k, v.end());
+  return v[k] / 1000.0;
+}
+
+void runCombination(const Options& o, const std::string& transport, const std::string& protocol,
+                    const Shape& shape) {
+  stdcxx::shared_ptr<ThriftRWServiceHandler> handler(new ThriftRWServiceHandler());
+  stdcxx::shared_ptr<CpuAccountingProcessor> processor(
+      new CpuAccountingProcessor(stdcxx::shared_ptr<TProcessor>(new ThriftRWServiceProcessor(handler))));
+  stdcxx::shared_ptr<TServerTransport> serverTransport(new TServerSocket("127.0.0.1", o.port));
+  stdcxx::shared_ptr<ReadyEventHandler> ready(new ReadyEventHandler());
+  TThreadedServer server(processor, serverTransport,
+                         makeTransportFactory(transport), makeProtocolFactory(protocol));
+  server.setServerEventHandler(ready);
+  std::thread serverThread(&TThreadedServer::serve, &server);
+  ready->wait();
+
+  std::vector<Connection> connections;
+  for (int i = 0; i < o.clients; ++i)
+    connections.push_back(connect(o.port, transport, protocol));
+  populate(*connections[0].client, o.ids, shape);
+  processor->reset();
+
+  std::vector<ClientStats> stats(o.clients);
+  std::vector<std::thread> clients;
+  Clock::time_point start = Clock::now();
+  Clock::time_point deadline = start + std::chrono::seconds(o.seconds);
+  for (int i = 0; i < o.clients; ++i)
+    clients.push_back(std::thread(runClient, std::cref(o), std::cref(connections[i]), std::cref(shape),
+                                  i + 1, deadline, std::ref(stats[i])));
+  for (size_t i = 0; i < clients.size(); ++i)
+    clients[i].join();
+  double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+  for (size_t i = 0; i < connections.size(); ++i)
+    connections[i].transport->close();
+  server.stop();
+  serverThread.join();
+
+  std::vector<int64_t> latency;
+  int64_t errors = 0;
+  for (size_t i = 0; i < stats.size(); ++i) {
+    latency.insert(latency.end(), stats[i].latencyNs.begin(), stats[i].latencyNs.end());
+    errors += stats[i].errors;
+  }
+  // errors are reported separately and do not count as requests
+  double requests = static_cast<double>(latency.size());
+  int64_t served = processor->requests();
+  printf("%-8s %-7s %6d %5d %12.0f %9.1f %9.1f %9.1f %12.2f %7lld\n",
+         transport.c_str(), protocol.c_str(), shape.listSize, shape.depth,
+         requests / elapsed,
+         percentileUs(latency, 0.50), percentileUs(latency, 0.99), percentileUs(latency, 0.999),
+         served > 0 ? processor->cpuNs() / 1000.0 / served : 0.0,
+         static_cast<long long>(errors));
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  Options o;
+  if (!parseOptions(argc, argv, o) || o.clients <= 0 || o.ids <= 0 || o.scanLimit <= 0) {
+    fprintf(stderr, "usage: %s [--clients N] [--seconds S] [--ids K] [--scan-limit L] [--mix SPEC]"
+                    " [--list-sizes A,B] [--depths A,B] [--transports buffered,framed] [--protocols binary,compact,json]"
+                    " [--port P]\n", argv[0]);
+    return 1;
+  }
+
+  printf("clients=%d seconds=%d ids=%d mix=", o.clients, o.seconds, o.ids);
+  for (int op = 0; op < OP_COUNT; ++op)
+    printf("%s%s=%d", op ? "," : "", kOpNames[op], o.weights[op]);
+  printf("\n%-8s %-7s %6s %5s %12s %9s %9s %9s %12s %7s\n",
+         "trans", "proto", "list", "depth", "req/s", "p50(us)", "p99(us)", "p999(us)", "srv_cpu(us)", "errors");
+
+  for (size_t t = 0; t < o.transports.size(); ++t)
+    for (size_t p = 0; p < o.protocols.size(); ++p)
+      for (size_t l = 0; l < o.listSizes.size(); ++l)
+        for (size_t d = 0; d < o.depths.size(); ++d) {
+          Shape shape = { o.listSizes[l], o.depths[d] };
+          runCombination(o, o.transports[t], o.protocols[p], shape);
+        }
+  return 0;
+}
@@ -105,6 +105,21 @@ class ThriftRWServiceHandler : virtual public ThriftRWServiceIf {
     printf("readId\n");
   }
 
+  void scanIds(std::vector<std::string> & _return, const std::string& _cursor, const std::string& _prefix, const int32_t _limit) {
+    // Your implementation goes here
+    printf("scanIds\n");
+  }
+
+  void waitForChanges(std::vector<ThriftMessage> & _return, const std::vector<std::string> & _ids, const int64_t _since_version, const int32_t _timeout_ms) {
+    // Your implementation goes here
+    printf("waitForChanges\n");
+  }
+
+  int64_t writeThriftMessageDelta(const ThriftMessage& _delta, const int64_t _base_hash) {
+    // Your implementation goes here
+    printf("writeThriftMessageDelta\n");
+  }
+
 };
 
 int main(int argc, char **argv) {
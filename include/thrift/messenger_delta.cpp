@@ -0,0 +1,112 @@
+#include "messenger_delta.h"
+
+#include <thrift/protocol/TBinaryProtocol.h>
+#include <thrift/protocol/TVirtualProtocol.h>
+#include <thrift/transport/TBufferTransports.h>
+
+namespace thrift_gen {
+
+namespace {
+
+#define THRIFT_MESSAGE_OPTIONAL_FIELDS(F) \
+  F(_receiver_id) F(_timestamp) F(_subject) F(_sequence_no) F(_total_count) \
+  F(_binary) F(_payload) \
+  F(_list_bool) F(_list_i16) F(_list_i32) F(_list_i64) F(_list_double) F(_list_string) \
+  F(_set_bool) F(_set_i16) F(_set_i32) F(_set_i64) F(_set_double) F(_set_string) \
+  F(_map_bool) F(_map_i16) F(_map_i32) F(_map_i64) F(_map_double) F(_map_string) \
+  F(_list_message) F(_set_message) F(_map_message)
+
+const uint64_t kFnvOffsetBasis = 14695981039346656037ULL;
+const uint64_t kFnvPrime = 1099511628211ULL;
+
+/**
+ * TBinaryProtocol that writes -0.0 as 0.0. The two compare equal, so
+ * messages that differ only in the sign of a zero get the same hash.
+ */
+class CanonicalBinaryProtocol
+    : public ::apache::thrift::protocol::TVirtualProtocol<CanonicalBinaryProtocol,
+                                                           ::apache::thrift::protocol::TBinaryProtocol> {
+ public:
+  explicit CanonicalBinaryProtocol(::apache::thrift::stdcxx::shared_ptr< ::apache::thrift::transport::TTransport> trans)
+    : ::apache::thrift::protocol::TVirtualProtocol<CanonicalBinaryProtocol,
+                                                   ::apache::thrift::protocol::TBinaryProtocol>(trans) {
+  }
+
+  uint32_t writeDouble(const double dub) {
+    return ::apache::thrift::protocol::TBinaryProtocol::writeDouble(dub == 0.0 ? 0.0 : dub);
+  }
+};
+
+} // namespace
+
+int64_t contentHash(const ThriftMessage& msg) {
+  using namespace ::apache::thrift;
+  stdcxx::shared_ptr<transport::TMemoryBuffer> buffer(new transport::TMemoryBuffer());
+  CanonicalBinaryProtocol protocol(buffer);
+  msg.write(&protocol);
+
+  uint8_t* data;
+  uint32_t size;
+  buffer->getBuffer(&data, &size);
+  uint64_t hash = kFnvOffsetBasis;
+  for (uint32_t i = 0; i < size; ++i)
+    hash = (hash ^ data[i]) * kFnvPrime;
+  return static_cast<int64_t>(hash);
+}
+
+bool makeDelta(ThriftMessage& delta, const ThriftMessage& base, const ThriftMessage& next) {
+  delta = ThriftMessage();
+  delta.__set__sender_id(next._sender_id);
+#define THRIFT_MESSAGE_DIFF(name) \
+  if (next.__isset.name) { \
+    if (!base.__isset.name || !(base.name == next.name)) \
+      delta.__set_##name(next.name); \
+  } else if (base.__isset.name) { \
+    return false; \
+  }
+  THRIFT_MESSAGE_OPTIONAL_FIELDS(THRIFT_MESSAGE_DIFF)
+#undef THRIFT_MESSAGE_DIFF
+  return true;
+}
+
+void applyDelta(ThriftMessage& base, const ThriftMessage& delta) {
+  base._sender_id = delta._sender_id;
+#define THRIFT_MESSAGE_APPLY(name) \
+  if (delta.__isset.name) \
+    base.__set_##name(delta.name);
+  THRIFT_MESSAGE_OPTIONAL_FIELDS(THRIFT_MESSAGE_APPLY)
+#undef THRIFT_MESSAGE_APPLY
+}
+
+ThriftMessageDeltaWriter::ThriftMessageDeltaWriter(ThriftRWServiceIf& service) : service_(service) {
+}
+
+void ThriftMessageDeltaWriter::write(const ThriftMessage& msg) {
+  std::unordered_map<std::string, Entry>::iterator it = sent_.find(msg._sender_id);
+  ThriftMessage delta;
+  if (it == sent_.end() || !makeDelta(delta, it->second.message, msg)) {
+    writeFull(msg);
+    return;
+  }
+
+  try {
+    it->second.hash = service_.writeThriftMessageDelta(delta, it->second.hash);
+    it->second.message = msg;
+  } catch (const InvalidOperationException&) {
+    writeFull(msg);
+  }
+}
+
+void ThriftMessageDeltaWriter::forget(const std::string& id) {
+  sent_.erase(id);
+}
+
+void ThriftMessageDeltaWriter::writeFull(const ThriftMessage& msg) {
+  std::string id;
+  service_.writeThriftMessage(id, msg);
+  Entry& entry = sent_[msg._sender_id];
+  entry.message = msg;
+  entry.hash = contentHash(msg);
+}
+
+} // namespace
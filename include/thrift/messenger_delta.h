@@ -0,0 +1,64 @@
+/**
+ * Content hashing and top-level delta encoding for ThriftMessage.
+ *
+ * A delta is a ThriftMessage that carries _sender_id plus only the optional
+ * fields whose value differs from a base message; everything else is left
+ * unset. applyDelta() copies the set fields over the base, which is how
+ * ThriftRWService::writeThriftMessageDelta() merges it on the server.
+ *
+ * contentHash() is FNV-1a over the TBinaryProtocol encoding with -0.0 written
+ * as 0.0, so client and server compute the same value on every platform, and
+ * two messages that compare equal with operator== always hash equally.
+ */
+#ifndef messenger_DELTA_H
+#define messenger_DELTA_H
+
+#include <string>
+#include <unordered_map>
+
+#include "ThriftRWService.h"
+#include "messenger_types.h"
+
+namespace thrift_gen {
+
+int64_t contentHash(const ThriftMessage& msg);
+
+/**
+ * Fills delta with the fields of next that are set and differ from base.
+ * Returns false when next clears a field that base has set; a delta cannot
+ * express that and the full message has to be written instead.
+ */
+bool makeDelta(ThriftMessage& delta, const ThriftMessage& base, const ThriftMessage& next);
+
+void applyDelta(ThriftMessage& base, const ThriftMessage& delta);
+
+/**
+ * Client side helper that remembers the last message written for each id
+ * and sends later versions of it through writeThriftMessageDelta(). Falls
+ * back to writeThriftMessage() for new ids, cleared fields and when the
+ * server rejects the delta, e.g. because another client wrote the id in
+ * between. Keeps one copy of every message written; use forget() to drop
+ * ids that will not be written again. Not thread safe.
+ */
+class ThriftMessageDeltaWriter {
+ public:
+  explicit ThriftMessageDeltaWriter(ThriftRWServiceIf& service);
+
+  void write(const ThriftMessage& msg);
+  void forget(const std::string& id);
+
+ private:
+  struct Entry {
+    ThriftMessage message;
+    int64_t hash;
+  };
+
+  void writeFull(const ThriftMessage& msg);
+
+  ThriftRWServiceIf& service_;
+  std::unordered_map<std::string, Entry> sent_;
+};
+
+} // namespace
+
+#endif
@@ -0,0 +1,795 @@
+/**
+ * JSON codec for ThriftMessage built on rapidjson's SAX Writer and Reader.
+ * See messenger_json.h for the JSON shape.
+ */
+#include "messenger_json.h"
+
+#include <cstring>
+#include <deque>
+#include <limits>
+
+#include <thrift/TToString.h>
+
+#include <rapidjson/error/en.h>
+#include <rapidjson/memorystream.h>
+#include <rapidjson/reader.h>
+
+namespace thrift_gen {
+
+namespace {
+
+using ::apache::thrift::protocol::TProtocolException;
+using rapidjson::SizeType;
+
+// Same limit as the default TInputRecursionTracker depth of the protocols.
+const size_t kMaxMessageDepth = 64;
+
+enum Field {
+  F_UNKNOWN,
+  F_SENDER_ID,
+  F_RECEIVER_ID,
+  F_TIMESTAMP,
+  F_SUBJECT,
+  F_SEQUENCE_NO,
+  F_TOTAL_COUNT,
+  F_BINARY,
+  F_PAYLOAD,
+  F_LIST_BOOL,
+  F_LIST_I16,
+  F_LIST_I32,
+  F_LIST_I64,
+  F_LIST_DOUBLE,
+  F_LIST_STRING,
+  F_SET_BOOL,
+  F_SET_I16,
+  F_SET_I32,
+  F_SET_I64,
+  F_SET_DOUBLE,
+  F_SET_STRING,
+  F_MAP_BOOL,
+  F_MAP_I16,
+  F_MAP_I32,
+  F_MAP_I64,
+  F_MAP_DOUBLE,
+  F_MAP_STRING,
+  F_LIST_MESSAGE,
+  F_SET_MESSAGE,
+  F_MAP_MESSAGE
+};
+
+struct FieldName {
+  const char* name;
+  SizeType length;
+  Field field;
+};
+
+#define MESSENGER_JSON_FIELD(name, field) { name, static_cast<SizeType>(sizeof(name) - 1), field }
+
+const FieldName kFieldNames[] = {
+  MESSENGER_JSON_FIELD("sender_id", F_SENDER_ID),
+  MESSENGER_JSON_FIELD("receiver_id", F_RECEIVER_ID),
+  MESSENGER_JSON_FIELD("timestamp", F_TIMESTAMP),
+  MESSENGER_JSON_FIELD("subject", F_SUBJECT),
+  MESSENGER_JSON_FIELD("sequence_no", F_SEQUENCE_NO),
+  MESSENGER_JSON_FIELD("total_count", F_TOTAL_COUNT),
+  MESSENGER_JSON_FIELD("binary", F_BINARY),
+  MESSENGER_JSON_FIELD("payload", F_PAYLOAD),
+  MESSENGER_JSON_FIELD("list_bool", F_LIST_BOOL),
+  MESSENGER_JSON_FIELD("list_i16", F_LIST_I16),
+  MESSENGER_JSON_FIELD("list_i32", F_LIST_I32),
+  MESSENGER_JSON_FIELD("list_i64", F_LIST_I64),
+  MESSENGER_JSON_FIELD("list_double", F_LIST_DOUBLE),
+  MESSENGER_JSON_FIELD("list_string", F_LIST_STRING),
+  MESSENGER_JSON_FIELD("set_bool", F_SET_BOOL),
+  MESSENGER_JSON_FIELD("set_i16", F_SET_I16),
+  MESSENGER_JSON_FIELD("set_i32", F_SET_I32),
+  MESSENGER_JSON_FIELD("set_i64", F_SET_I64),
+  MESSENGER_JSON_FIELD("set_double", F_SET_DOUBLE),
+  MESSENGER_JSON_FIELD("set_string", F_SET_STRING),
+  MESSENGER_JSON_FIELD("map_bool", F_MAP_BOOL),
+  MESSENGER_JSON_FIELD("map_i16", F_MAP_I16),
+  MESSENGER_JSON_FIELD("map_i32", F_MAP_I32),
+  MESSENGER_JSON_FIELD("map_i64", F_MAP_I64),
+  MESSENGER_JSON_FIELD("map_double", F_MAP_DOUBLE),
+  MESSENGER_JSON_FIELD("map_string", F_MAP_STRING),
+  MESSENGER_JSON_FIELD("list_message", F_LIST_MESSAGE),
+  MESSENGER_JSON_FIELD("set_message", F_SET_MESSAGE),
+  MESSENGER_JSON_FIELD("map_message", F_MAP_MESSAGE)
+};
+
+#undef MESSENGER_JSON_FIELD
+
+const char* fieldName(Field field) {
+  return kFieldNames[field - F_SENDER_ID].name;
+}
+
+SizeType fieldNameLength(Field field) {
+  return kFieldNames[field - F_SENDER_ID].length;
+}
+
+Field lookupField(const char* str, SizeType length) {
+  for (size_t i = 0; i < sizeof(kFieldNames) / sizeof(kFieldNames[0]); ++i) {
+    const FieldName& f = kFieldNames[i];
+    if (f.length == length && std::memcmp(f.name, str, length) == 0)
+      return f.field;
+  }
+  return F_UNKNOWN;
+}
+
+bool isListField(Field field) {
+  return (field >= F_LIST_BOOL && field <= F_SET_STRING)
+      || field == F_LIST_MESSAGE || field == F_SET_MESSAGE;
+}
+
+bool isMapField(Field field) {
+  return (field >= F_MAP_BOOL && field <= F_MAP_STRING) || field == F_MAP_MESSAGE;
+}
+
+/*
+ * base64 (RFC 4648, with padding) for the _binary field.
+ */
+
+const char kBase64Chars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+void base64Encode(std::string& out, const std::string& in) {
+  out.clear();
+  out.reserve(((in.size() + 2) / 3) * 4);
+  const unsigned char* p = reinterpret_cast<const unsigned char*>(in.data());
+  size_t n = in.size();
+  size_t i = 0;
+  for (; i + 3 <= n; i += 3) {
+    uint32_t v = (uint32_t(p[i]) << 16) | (uint32_t(p[i + 1]) << 8) | p[i + 2];
+    out += kBase64Chars[(v >> 18) & 0x3F];
+    out += kBase64Chars[(v >> 12) & 0x3F];
+    out += kBase64Chars[(v >> 6) & 0x3F];
+    out += kBase64Chars[v & 0x3F];
+  }
+  if (i < n) {
+    uint32_t v = uint32_t(p[i]) << 16;
+    if (i + 1 < n)
+      v |= uint32_t(p[i + 1]) << 8;
+    out += kBase64Chars[(v >> 18) & 0x3F];
+    out += kBase64Chars[(v >> 12) & 0x3F];
+    out += (i + 1 < n) ? kBase64Chars[(v >> 6) & 0x3F] : '=';
+    out += '=';
+  }
+}
+
+int base64Value(char c) {
+  if (c >= 'A' && c <= 'Z') return c - 'A';
+  if (c >= 'a' && c <= 'z') return c - 'a' + 26;
+  if (c >= '0' && c <= '9') return c - '0' + 52;
+  if (c == '+') return 62;
+  if (c == '/') return 63;
+  return -1;
+}
+
+bool base64Decode(std::string& out, const char* in, size_t n) {
+  out.clear();
+  if (n % 4 != 0)
+    return false;
+  out.reserve((n / 4) * 3);
+  for (size_t i = 0; i < n; i += 4) {
+    int a = base64Value(in[i]);
+    int b = base64Value(in[i + 1]);
+    if (a < 0 || b < 0)
+      return false;
+    bool last = (i + 4 == n);
+    if (last && in[i + 2] == '=') {
+      if (in[i + 3] != '=')
+        return false;
+      out += static_cast<char>((a << 2) | (b >> 4));
+      break;
+    }
+    int c = base64Value(in[i + 2]);
+    if (c < 0)
+      return false;
+    if (last && in[i + 3] == '=') {
+      out += static_cast<char>((a << 2) | (b >> 4));
+      out += static_cast<char>(((b & 0xF) << 4) | (c >> 2));
+      break;
+    }
+    int d = base64Value(in[i + 3]);
+    if (d < 0)
+      return false;
+    out += static_cast<char>((a << 2) | (b >> 4));
+    out += static_cast<char>(((b & 0xF) << 4) | (c >> 2));
+    out += static_cast<char>(((c & 0x3) << 6) | d);
+  }
+  return true;
+}
+
+/*
+ * Encoding
+ */
+
+inline void writeKey(ThriftMessageJsonWriter& writer, Field field) {
+  writer.Key(fieldName(field), fieldNameLength(field));
+}
+
+inline void writeString(ThriftMessageJsonWriter& writer, const std::string& s) {
+  writer.String(s.data(), static_cast<SizeType>(s.size()));
+}
+
+inline void writeElement(ThriftMessageJsonWriter& writer, bool v) { writer.Bool(v); }
+inline void writeElement(ThriftMessageJsonWriter& writer, int16_t v) { writer.Int(v); }
+inline void writeElement(ThriftMessageJsonWriter& writer, int32_t v) { writer.Int(v); }
+inline void writeElement(ThriftMessageJsonWriter& writer, int64_t v) { writer.Int64(v); }
+inline void writeElement(ThriftMessageJsonWriter& writer, double v) { writer.Double(v); }
+inline void writeElement(ThriftMessageJsonWriter& writer, const std::string& v) { writeString(writer, v); }
+inline void writeElement(ThriftMessageJsonWriter& writer, const ThriftMessage& v) { writeJson(writer, v); }
+
+template <typename Container>
+void writeArray(ThriftMessageJsonWriter& writer, Field field, const Container& c) {
+  writeKey(writer, field);
+  writer.StartArray();
+  for (typename Container::const_iterator it = c.begin(); it != c.end(); ++it)
+    writeElement(writer, *it);
+  writer.EndArray();
+}
+
+template <typename Map>
+void writeObject(ThriftMessageJsonWriter& writer, Field field, const Map& m) {
+  writeKey(writer, field);
+  writer.StartObject();
+  for (typename Map::const_iterator it = m.begin(); it != m.end(); ++it) {
+    writer.Key(it->first.data(), static_cast<SizeType>(it->first.size()));
+    writeElement(writer, it->second);
+  }
+  writer.EndObject();
+}
+
+/*
+ * Decoding
+ */
+
+class ThriftMessageJsonHandler {
+ public:
+  explicit ThriftMessageJsonHandler(ThriftMessage& root) : root_(root), skipDepth_(0) {}
+
+  const std::string& error() const { return error_; }
+
+  bool Null() {
+    if (skipping())
+      return true;
+    if (frames_.empty())
+      return fail("expected an object");
+    Frame& f = top();
+    if (f.state == kValue) {
+      // null leaves an optional field unset
+      if (f.field == F_SENDER_ID)
+        return fail("sender_id must not be null");
+      f.state = kKey;
+      return true;
+    }
+    return fail("unexpected null");
+  }
+
+  bool Bool(bool b) {
+    if (skipping())
+      return true;
+    if (frames_.empty())
+      return fail("expected an object");
+    Frame& f = top();
+    if (f.state == kValue && f.field == F_UNKNOWN)
+      return endValue(f);
+    switch (f.field) {
+      case F_LIST_BOOL:
+        if (f.state != kArray) break;
+        f.msg->_list_bool.push_back(b);
+        return true;
+      case F_SET_BOOL:
+        if (f.state != kArray) break;
+        f.msg->_set_bool.insert(b);
+        return true;
+      case F_MAP_BOOL:
+        if (f.state != kMapValue) break;
+        f.msg->_map_bool[f.mapKey] = b;
+        f.state = kMap;
+        return true;
+      default:
+        break;
+    }
+    return typeMismatch(f);
+  }
+
+  bool Int(int i) { return Integer(i); }
+  bool Uint(unsigned u) { return Integer(u); }
+  bool Int64(int64_t i) { return Integer(i); }
+
+  bool Uint64(uint64_t u) {
+    if (u <= static_cast<uint64_t>(std::numeric_limits<int64_t>::max()))
+      return Integer(static_cast<int64_t>(u));
+    if (skipping() || (!frames_.empty() && top().state == kValue && top().field == F_UNKNOWN))
+      return Integer(0);
+    return fail("integer out of range");
+  }
+
+  bool Double(double d) {
+    if (skipping())
+      return true;
+    if (frames_.empty())
+      return fail("expected an object");
+    Frame& f = top();
+    if (f.state == kValue && f.field == F_UNKNOWN)
+      return endValue(f);
+    switch (f.field) {
+      case F_LIST_DOUBLE:
+        if (f.state != kArray) break;
+        f.msg->_list_double.push_back(d);
+        return true;
+      case F_SET_DOUBLE:
+        if (f.state != kArray) break;
+        f.msg->_set_double.insert(d);
+        return true;
+      case F_MAP_DOUBLE:
+        if (f.state != kMapValue) break;
+        f.msg->_map_double[f.mapKey] = d;
+        f.state = kMap;
+        return true;
+      default:
+        break;
+    }
+    return typeMismatch(f);
+  }
+
+  bool RawNumber(const char*, SizeType, bool) { return fail("unexpected raw number"); }
+
+  bool String(const char* str, SizeType length, bool) {
+    if (skipping())
+      return true;
+    if (frames_.empty())
+      return fail("expected an object");
+    Frame& f = top();
+    if (f.state == kValue) {
+      ThriftMessage& m = *f.msg;
+      switch (f.field) {
+        case F_UNKNOWN:
+          break;
+        case F_SENDER_ID:
+          m._sender_id.assign(str, length);
+          f.sawSenderId = true;
+          break;
+        case F_RECEIVER_ID:
+          m._receiver_id.assign(str, length);
+          m.__isset._receiver_id = true;
+          break;
+        case F_TIMESTAMP:
+          m._timestamp.assign(str, length);
+          m.__isset._timestamp = true;
+          break;
+        case F_SUBJECT:
+          m._subject.assign(str, length);
+          m.__isset._subject = true;
+          break;
+        case F_BINARY:
+          if (!base64Decode(m._binary, str, length))
+            return fail("binary is not valid base64");
+          m.__isset._binary = true;
+          break;
+        case F_PAYLOAD:
+          m._payload.assign(str, length);
+          m.__isset._payload = true;
+          break;
+        default:
+          return typeMismatch(f);
+      }
+      return endValue(f);
+    }
+    if (f.state == kArray) {
+      if (f.field == F_LIST_STRING) {
+        f.msg->_list_string.push_back(std::string(str, length));
+        return true;
+      }
+      if (f.field == F_SET_STRING) {
+        f.msg->_set_string.insert(std::string(str, length));
+        return true;
+      }
+    } else if (f.state == kMapValue && f.field == F_MAP_STRING) {
+      f.msg->_map_string[f.mapKey].assign(str, length);
+      f.state = kMap;
+      return true;
+    }
+    return typeMismatch(f);
+  }
+
+  bool Key(const char* str, SizeType length, bool) {
+    if (skipping())
+      return true;
+    if (frames_.empty())
+      return fail("expected an object");
+    Frame& f = top();
+    if (f.state == kKey) {
+      f.field = lookupField(str, length);
+      f.state = kValue;
+      return true;
+    }
+    if (f.state == kMap) {
+      f.mapKey.assign(str, length);
+      f.state = kMapValue;
+      return true;
+    }
+    return fail("unexpected key");
+  }
+
+  bool StartObject() {
+    if (skipping()) {
+      ++skipDepth_;
+      return true;
+    }
+    if (frames_.empty()) {
+      root_ = ThriftMessage();
+      pushFrame(&root_);
+      return true;
+    }
+    Frame& f = top();
+    if (f.state == kValue) {
+      if (f.field == F_UNKNOWN) {
+        skipDepth_ = 1;
+        f.state = kKey;
+        return true;
+      }
+      if (!isMapField(f.field))
+        return typeMismatch(f);
+      clearContainer(*f.msg, f.field);
+      f.state = kMap;
+      return true;
+    }
+    if (frames_.size() >= kMaxMessageDepth)
+      return fail("message nesting too deep");
+    if (f.state == kArray && f.field == F_LIST_MESSAGE) {
+      f.msg->_list_message.push_back(ThriftMessage());
+      pushFrame(&f.msg->_list_message.back());
+      return true;
+    }
+    if (f.state == kArray && f.field == F_SET_MESSAGE) {
+      f.setEntry = ThriftMessage();
+      pushFrame(&f.setEntry);
+      return true;
+    }
+    if (f.state == kMapValue && f.field == F_MAP_MESSAGE) {
+      ThriftMessage* child = &f.msg->_map_message[f.mapKey];
+      *child = ThriftMessage();
+      f.state = kMap;
+      pushFrame(child);
+      return true;
+    }
+    return typeMismatch(f);
+  }
+
+  bool EndObject(SizeType) {
+    if (skipping()) {
+      --skipDepth_;
+      return true;
+    }
+    Frame& f = top();
+    if (f.state == kMap) {
+      f.state = kKey;
+      return true;
+    }
+    if (!f.sawSenderId)
+      return fail("missing required field sender_id");
+    frames_.pop_back();
+    if (frames_.empty())
+      return true;
+    Frame& parent = top();
+    if (parent.field == F_SET_MESSAGE)
+      parent.msg->_set_message.insert(parent.setEntry);
+    return true;
+  }
+
+  bool StartArray() {
+    if (skipping()) {
+      ++skipDepth_;
+      return true;
+    }
+    if (frames_.empty())
+      return fail("expected an object");
+    Frame& f = top();
+    if (f.state != kValue)
+      return typeMismatch(f);
+    if (f.field == F_UNKNOWN) {
+      skipDepth_ = 1;
+      f.state = kKey;
+      return true;
+    }
+    if (!isListField(f.field))
+      return typeMismatch(f);
+    clearContainer(*f.msg, f.field);
+    f.state = kArray;
+    return true;
+  }
+
+  bool EndArray(SizeType) {
+    if (skipping()) {
+      --skipDepth_;
+      return true;
+    }
+    top().state = kKey;
+    return true;
+  }
+
+ private:
+  enum State {
+    kKey,       // inside a message, expecting a field name
+    kValue,     // field name read, expecting its value
+    kArray,     // inside the array of a list/set field
+    kMap,       // inside the object of a map field, expecting a key
+    kMapValue   // map key read, expecting its value
+  };
+
+  struct Frame {
+    Frame() : msg(NULL), state(kKey), field(F_UNKNOWN), sawSenderId(false) {}
+    ThriftMessage* msg;
+    State state;
+    Field field;
+    bool sawSenderId;
+    std::string mapKey;
+    ThriftMessage setEntry;  // element of _set_message being decoded
+  };
+
+  bool skipping() const { return skipDepth_ > 0; }
+
+  Frame& top() { return frames_.back(); }
+
+  void pushFrame(ThriftMessage* msg) {
+    frames_.push_back(Frame());
+    frames_.back().msg = msg;
+  }
+
+  bool endValue(Frame& f) {
+    f.state = kKey;
+    return true;
+  }
+
+  bool fail(const char* what) {
+    error_ = what;
+    return false;
+  }
+
+  bool typeMismatch(const Frame& f) {
+    error_ = "unexpected value type";
+    if (f.field != F_UNKNOWN) {
+      error_ += " for field ";
+      error_ += fieldName(f.field);
+    }
+    return false;
+  }
+
+  bool Integer(int64_t i) {
+    if (skipping())
+      return true;
+    if (frames_.empty())
+      return fail("expected an object");
+    Frame& f = top();
+    ThriftMessage& m = *f.msg;
+    if (f.state == kValue) {
+      switch (f.field) {
+        case F_UNKNOWN:
+          break;
+        case F_SEQUENCE_NO:
+          m._sequence_no = i;
+          m.__isset._sequence_no = true;
+          break;
+        case F_TOTAL_COUNT:
+          m._total_count = i;
+          m.__isset._total_count = true;
+          break;
+        default:
+          return typeMismatch(f);
+      }
+      return endValue(f);
+    }
+    if (f.state == kArray) {
+      switch (f.field) {
+        case F_LIST_I16:
+          if (!inRange<int16_t>(i)) break;
+          m._list_i16.push_back(static_cast<int16_t>(i));
+          return true;
+        case F_LIST_I32:
+          if (!inRange<int32_t>(i)) break;
+          m._list_i32.push_back(static_cast<int32_t>(i));
+          return true;
+        case F_LIST_I64:
+          m._list_i64.push_back(i);
+          return true;
+        case F_SET_I16:
+          if (!inRange<int16_t>(i)) break;
+          m._set_i16.insert(static_cast<int16_t>(i));
+          return true;
+        case F_SET_I32:
+          if (!inRange<int32_t>(i)) break;
+          m._set_i32.insert(static_cast<int32_t>(i));
+          return true;
+        case F_SET_I64:
+          m._set_i64.insert(i);
+          return true;
+        case F_LIST_DOUBLE:
+        case F_SET_DOUBLE:
+          return Double(static_cast<double>(i));
+        default:
+          return typeMismatch(f);
+      }
+      return fail("integer out of range");
+    }
+    if (f.state == kMapValue) {
+      switch (f.field) {
+        case F_MAP_I16:
+          if (!inRange<int16_t>(i)) break;
+          m._map_i16[f.mapKey] = static_cast<int16_t>(i);
+          f.state = kMap;
+          return true;
+        case F_MAP_I32:
+          if (!inRange<int32_t>(i)) break;
+          m._map_i32[f.mapKey] = static_cast<int32_t>(i);
+          f.state = kMap;
+          return true;
+        case F_MAP_I64:
+          m._map_i64[f.mapKey] = i;
+          f.state = kMap;
+          return true;
+        case F_MAP_DOUBLE:
+          return Double(static_cast<double>(i));
+        default:
+          return typeMismatch(f);
+      }
+      return fail("integer out of range");
+    }
+    return typeMismatch(f);
+  }
+
+  template <typename T>
+  static bool inRange(int64_t i) {
+    return i >= std::numeric_limits<T>::min() && i <= std::numeric_limits<T>::max();
+  }
+
+  static void clearContainer(ThriftMessage& m, Field field) {
+    switch (field) {
+      case F_LIST_BOOL: m._list_bool.clear(); m.__isset._list_bool = true; break;
+      case F_LIST_I16: m._list_i16.clear(); m.__isset._list_i16 = true; break;
+      case F_LIST_I32: m._list_i32.clear(); m.__isset._list_i32 = true; break;
+      case F_LIST_I64: m._list_i64.clear(); m.__isset._list_i64 = true; break;
+      case F_LIST_DOUBLE: m._list_double.clear(); m.__isset._list_double = true; break;
+      case F_LIST_STRING: m._list_string.clear(); m.__isset._list_string = true; break;
+      case F_SET_BOOL: m._set_bool.clear(); m.__isset._set_bool = true; break;
+      case F_SET_I16: m._set_i16.clear(); m.__isset._set_i16 = true; break;
+      case F_SET_I32: m._set_i32.clear(); m.__isset._set_i32 = true; break;
+      case F_SET_I64: m._set_i64.clear(); m.__isset._set_i64 = true; break;
+      case F_SET_DOUBLE: m._set_double.clear(); m.__isset._set_double = true; break;
+      case F_SET_STRING: m._set_string.clear(); m.__isset._set_string = true; break;
+      case F_MAP_BOOL: m._map_bool.clear(); m.__isset._map_bool = true; break;
+      case F_MAP_I16: m._map_i16.clear(); m.__isset._map_i16 = true; break;
+      case F_MAP_I32: m._map_i32.clear(); m.__isset._map_i32 = true; break;
+      case F_MAP_I64: m._map_i64.clear(); m.__isset._map_i64 = true; break;
+      case F_MAP_DOUBLE: m._map_double.clear(); m.__isset._map_double = true; break;
+      case F_MAP_STRING: m._map_string.clear(); m.__isset._map_string = true; break;
+      case F_LIST_MESSAGE: m._list_message.clear(); m.__isset._list_message = true; break;
+      case F_SET_MESSAGE: m._set_message.clear(); m.__isset._set_message = true; break;
+      case F_MAP_MESSAGE: m._map_message.clear(); m.__isset._map_message = true; break;
+      default: break;
+    }
+  }
+
+  ThriftMessage& root_;
+  // std::deque keeps references to outer frames (and their setEntry) valid
+  // while nested frames are pushed.
+  std::deque<Frame> frames_;
+  int skipDepth_;
+  std::string error_;
+};
+
+} // namespace
+
+
+void writeJson(ThriftMessageJsonWriter& writer, const ThriftMessage& msg) {
+  writer.StartObject();
+  writeKey(writer, F_SENDER_ID);
+  writeString(writer, msg._sender_id);
+  if (msg.__isset._receiver_id) {
+    writeKey(writer, F_RECEIVER_ID);
+    writeString(writer, msg._receiver_id);
+  }
+  if (msg.__isset._timestamp) {
+    writeKey(writer, F_TIMESTAMP);
+    writeString(writer, msg._timestamp);
+  }
+  if (msg.__isset._subject) {
+    writeKey(writer, F_SUBJECT);
+    writeString(writer, msg._subject);
+  }
+  if (msg.__isset._sequence_no) {
+    writeKey(writer, F_SEQUENCE_NO);
+    writer.Int64(msg._sequence_no);
+  }
+  if (msg.__isset._total_count) {
+    writeKey(writer, F_TOTAL_COUNT);
+    writer.Int64(msg._total_count);
+  }
+  if (msg.__isset._binary) {
+    std::string encoded;
+    base64Encode(encoded, msg._binary);
+    writeKey(writer, F_BINARY);
+    writeString(writer, encoded);
+  }
+  if (msg.__isset._payload) {
+    writeKey(writer, F_PAYLOAD);
+    writeString(writer, msg._payload);
+  }
+  if (msg.__isset._list_bool)
+    writeArray(writer, F_LIST_BOOL, msg._list_bool);
+  if (msg.__isset._list_i16)
+    writeArray(writer, F_LIST_I16, msg._list_i16);
+  if (msg.__isset._list_i32)
+    writeArray(writer, F_LIST_I32, msg._list_i32);
+  if (msg.__isset._list_i64)
+    writeArray(writer, F_LIST_I64, msg._list_i64);
+  if (msg.__isset._list_double)
+    writeArray(writer, F_LIST_DOUBLE, msg._list_double);
+  if (msg.__isset._list_string)
+    writeArray(writer, F_LIST_STRING, msg._list_string);
+  if (msg.__isset._set_bool)
+    writeArray(writer, F_SET_BOOL, msg._set_bool);
+  if (msg.__isset._set_i16)
+    writeArray(writer, F_SET_I16, msg._set_i16);
+  if (msg.__isset._set_i32)
+    writeArray(writer, F_SET_I32, msg._set_i32);
+  if (msg.__isset._set_i64)
+    writeArray(writer, F_SET_I64, msg._set_i64);
+  if (msg.__isset._set_double)
+    writeArray(writer, F_SET_DOUBLE, msg._set_double);
+  if (msg.__isset._set_string)
+    writeArray(writer, F_SET_STRING, msg._set_string);
+  if (msg.__isset._map_bool)
+    writeObject(writer, F_MAP_BOOL, msg._map_bool);
+  if (msg.__isset._map_i16)
+    writeObject(writer, F_MAP_I16, msg._map_i16);
+  if (msg.__isset._map_i32)
+    writeObject(writer, F_MAP_I32, msg._map_i32);
+  if (msg.__isset._map_i64)
+    writeObject(writer, F_MAP_I64, msg._map_i64);
+  if (msg.__isset._map_double)
+    writeObject(writer, F_MAP_DOUBLE, msg._map_double);
+  if (msg.__isset._map_string)
+    writeObject(writer, F_MAP_STRING, msg._map_string);
+  if (msg.__isset._list_message)
+    writeArray(writer, F_LIST_MESSAGE, msg._list_message);
+  if (msg.__isset._set_message)
+    writeArray(writer, F_SET_MESSAGE, msg._set_message);
+  if (msg.__isset._map_message)
+    writeObject(writer, F_MAP_MESSAGE, msg._map_message);
+  writer.EndObject();
+}
+
+std::string toJson(const ThriftMessage& msg) {
+  rapidjson::StringBuffer buffer;
+  std::string json;
+  toJson(json, msg, buffer);
+  return json;
+}
+
+void toJson(std::string& _return, const ThriftMessage& msg, rapidjson::StringBuffer& buffer) {
+  buffer.Clear();
+  ThriftMessageJsonWriter writer(buffer);
+  writeJson(writer, msg);
+  _return.assign(buffer.GetString(), buffer.GetSize());
+}
+
+void fromJson(ThriftMessage& msg, const char* json, size_t length) {
+  ThriftMessageJsonHandler handler(msg);
+  rapidjson::MemoryStream is(json, length);
+  rapidjson::Reader reader;
+  rapidjson::ParseResult ok = reader.Parse<rapidjson::kParseNanAndInfFlag | rapidjson::kParseFullPrecisionFlag>(is, handler);
+  if (!ok) {
+    std::string what = handler.error().empty()
+        ? rapidjson::GetParseError_En(ok.Code()) : handler.error();
+    what += " at offset ";
+    what += ::apache::thrift::to_string(ok.Offset());
+    throw TProtocolException(TProtocolException::INVALID_DATA, what);
+  }
+}
+
+void fromJson(ThriftMessage& msg, const std::string& json) {
+  fromJson(msg, json.data(), json.size());
+}
+
+} // namespace
@@ -0,0 +1,58 @@
+/**
+ * JSON codec for ThriftMessage built on rapidjson's SAX Writer and Reader.
+ *
+ * Unlike TJSONProtocol, which encodes field ids and wire types, this codec
+ * produces plain JSON objects keyed by field name (without the leading
+ * underscore), e.g.
+ *
+ *   {"sender_id":"a","sequence_no":3,"list_double":[1.5,2.0],
+ *    "map_message":{"k":{"sender_id":"b"}}}
+ *
+ * Optional fields are emitted only when their __isset flag is set, lists and
+ * sets become arrays, maps become objects, _binary is base64 encoded and
+ * non-finite doubles are written as NaN/Infinity. Both directions stream
+ * directly between ThriftMessage and text; no rapidjson::Document is built.
+ */
+#ifndef messenger_JSON_H
+#define messenger_JSON_H
+
+#include <string>
+
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+#include "messenger_types.h"
+
+namespace thrift_gen {
+
+typedef rapidjson::Writer<rapidjson::StringBuffer,
+                          rapidjson::UTF8<>,
+                          rapidjson::UTF8<>,
+                          rapidjson::CrtAllocator,
+                          rapidjson::kWriteNanAndInfFlag> ThriftMessageJsonWriter;
+
+/**
+ * Emits msg as a single JSON object into writer. Can be used to embed a
+ * message inside a larger JSON document that the caller is writing.
+ */
+void writeJson(ThriftMessageJsonWriter& writer, const ThriftMessage& msg);
+
+/**
+ * Serializes msg into a JSON string. buffer is reused between calls when
+ * provided, which avoids reallocating the output on hot paths.
+ */
+std::string toJson(const ThriftMessage& msg);
+void toJson(std::string& _return, const ThriftMessage& msg, rapidjson::StringBuffer& buffer);
+
+/**
+ * Replaces the content of msg with the message encoded in json.
+ * Unknown keys are skipped. Throws TProtocolException(INVALID_DATA) on
+ * malformed JSON, type mismatches, out-of-range integers or a missing
+ * sender_id, like ThriftMessage::read() does for the binary protocols.
+ */
+void fromJson(ThriftMessage& msg, const char* json, size_t length);
+void fromJson(ThriftMessage& msg, const std::string& json);
+
+} // namespace
+
+#endif
@@ -0,0 +1,162 @@
+/**
+ * Compares the rapidjson based ThriftMessage codec (messenger_json.h) with
+ * Thrift's TJSONProtocol for encoding and decoding the same messages.
+ *
+ * Build:
+ *   g++ -O2 -std=c++11 -I.. messenger_json_benchmark.cpp messenger_json.cpp \
+ *       messenger_types.cpp -lthrift -o messenger_json_benchmark
+ *
+ * Usage:
+ *   messenger_json_benchmark [iterations] [list_size] [depth]
+ *
+ * list_size is the number of elements put into each typed list, set and map
+ * and depth the number of nested _list_message/_map_message levels.
+ */
+#include "messenger_json.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include <thrift/protocol/TJSONProtocol.h>
+#include <thrift/transport/TBufferTransports.h>
+
+using namespace ::apache::thrift;
+using namespace ::apache::thrift::protocol;
+using namespace ::apache::thrift::transport;
+
+using namespace  ::thrift_gen;
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+ThriftMessage makeMessage(int listSize, int depth) {
+  ThriftMessage msg;
+  msg.__set__sender_id("sender-" + std::to_string(depth));
+  msg.__set__receiver_id("receiver");
+  msg.__set__timestamp("2019-01-01T00:00:00.000Z");
+  msg.__set__subject("benchmark");
+  msg.__set__sequence_no(depth);
+  msg.__set__total_count(listSize);
+  msg.__set__payload("{\"embedded\":\"payload text\"}");
+  msg.__set__binary(std::string(64, '\x5a'));
+  for (int i = 0; i < listSize; ++i) {
+    std::string key = "key" + std::to_string(i);
+    msg._list_bool.push_back(i % 2 == 0);
+    msg._list_i16.push_back(static_cast<int16_t>(i));
+    msg._list_i32.push_back(i * 1000);
+    msg._list_i64.push_back(static_cast<int64_t>(i) << 33);
+    msg._list_double.push_back(i * 0.001 + 1.0 / 3.0);
+    msg._list_string.push_back(key);
+    msg._set_i32.insert(i);
+    msg._set_double.insert(i * 0.5);
+    msg._set_string.insert(key);
+    msg._map_i64[key] = i;
+    msg._map_double[key] = i * 2.5;
+    msg._map_string[key] = "value" + std::to_string(i);
+  }
+  msg.__isset._list_bool = msg.__isset._list_i16 = msg.__isset._list_i32 = true;
+  msg.__isset._list_i64 = msg.__isset._list_double = msg.__isset._list_string = true;
+  msg.__isset._set_i32 = msg.__isset._set_double = msg.__isset._set_string = true;
+  msg.__isset._map_i64 = msg.__isset._map_double = msg.__isset._map_string = true;
+  if (depth > 0) {
+    ThriftMessage child = makeMessage(listSize / 2, depth - 1);
+    msg._list_message.push_back(child);
+    msg._list_message.push_back(child);
+    msg._map_message["child"] = child;
+    msg.__isset._list_message = msg.__isset._map_message = true;
+  }
+  return msg;
+}
+
+struct Result {
+  double encodeNs;
+  double decodeNs;
+  size_t bytes;
+};
+
+void report(const char* name, const Result& r) {
+  double mb = static_cast<double>(r.bytes) / (1024.0 * 1024.0);
+  printf("%-14s %10zu bytes  encode %10.0f ns (%7.1f MB/s)  decode %10.0f ns (%7.1f MB/s)\n",
+         name, r.bytes,
+         r.encodeNs, mb / (r.encodeNs * 1e-9),
+         r.decodeNs, mb / (r.decodeNs * 1e-9));
+}
+
+double nsPerOp(Clock::time_point start, int iterations) {
+  return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / iterations;
+}
+
+Result benchRapidJson(const ThriftMessage& msg, int iterations) {
+  Result r;
+  rapidjson::StringBuffer buffer;
+  std::string json;
+
+  Clock::time_point start = Clock::now();
+  for (int i = 0; i < iterations; ++i)
+    toJson(json, msg, buffer);
+  r.encodeNs = nsPerOp(start, iterations);
+  r.bytes = json.size();
+
+  ThriftMessage decoded;
+  start = Clock::now();
+  for (int i = 0; i < iterations; ++i)
+    fromJson(decoded, json);
+  r.decodeNs = nsPerOp(start, iterations);
+
+  if (decoded != msg)
+    fprintf(stderr, "messenger_json: round trip mismatch\n");
+  return r;
+}
+
+Result benchTJSONProtocol(const ThriftMessage& msg, int iterations) {
+  Result r;
+  stdcxx::shared_ptr<TMemoryBuffer> buffer(new TMemoryBuffer());
+  TJSONProtocol protocol(buffer);
+
+  Clock::time_point start = Clock::now();
+  for (int i = 0; i < iterations; ++i) {
+    buffer->resetBuffer();
+    msg.write(&protocol);
+  }
+  r.encodeNs = nsPerOp(start, iterations);
+  std::string json = buffer->getBufferAsString();
+  r.bytes = json.size();
+
+  ThriftMessage decoded;
+  start = Clock::now();
+  for (int i = 0; i < iterations; ++i) {
+    buffer->resetBuffer(reinterpret_cast<uint8_t*>(&json[0]), static_cast<uint32_t>(json.size()));
+    decoded.read(&protocol);
+  }
+  r.decodeNs = nsPerOp(start, iterations);
+
+  if (decoded != msg)
+    fprintf(stderr, "TJSONProtocol: round trip mismatch\n");
+  return r;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  int iterations = argc > 1 ? atoi(argv[1]) : 2000;
+  int listSize = argc > 2 ? atoi(argv[2]) : 64;
+  int depth = argc > 3 ? atoi(argv[3]) : 2;
+
+  ThriftMessage msg = makeMessage(listSize, depth);
+  printf("iterations=%d list_size=%d depth=%d\n", iterations, listSize, depth);
+
+  // warm up caches and allocators before timing
+  benchRapidJson(msg, iterations / 10 + 1);
+  benchTJSONProtocol(msg, iterations / 10 + 1);
+
+  Result fast = benchRapidJson(msg, iterations);
+  Result slow = benchTJSONProtocol(msg, iterations);
+  report("messenger_json", fast);
+  report("TJSONProtocol", slow);
+  printf("speedup        encode x%.2f  decode x%.2f\n",
+         slow.encodeNs / fast.encodeNs, slow.decodeNs / fast.decodeNs);
+  return 0;
+}
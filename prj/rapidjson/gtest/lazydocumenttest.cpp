@@ -0,0 +1,34 @@
+#include "rapidjson/lazydocument.h"
+#include "rapidjson/document.h"
+#include <gtest/gtest.h>
+#include <cstring>
+
+using namespace rapidjson;
+
+static void TestScalarRoot(const char* json, ParseErrorCode code, size_t offset) {
+    Document d;
+    d.Parse(json);
+    EXPECT_TRUE(d.HasParseError()) << json;
+
+    LazyDocument lazy;
+    lazy.Parse(json, std::strlen(json));
+    EXPECT_TRUE(lazy.HasParseError()) << json;
+    EXPECT_EQ(code, lazy.GetParseError()) << json;
+    EXPECT_EQ(offset, lazy.GetErrorOffset()) << json;
+}
+
+TEST(LazyDocument, ScalarRootTrailingCharacters) {
+    TestScalarRoot("1rue", kParseErrorDocumentRootNotSingular, 1);
+    TestScalarRoot("truex", kParseErrorDocumentRootNotSingular, 4);
+    TestScalarRoot("nullnull", kParseErrorDocumentRootNotSingular, 4);
+    TestScalarRoot("123abc", kParseErrorDocumentRootNotSingular, 3);
+    TestScalarRoot("  false  0", kParseErrorDocumentRootNotSingular, 9);
+}
+
+TEST(LazyDocument, ScalarRoot) {
+    const char* json = " 123 \n";
+    LazyDocument lazy;
+    lazy.Parse(json, std::strlen(json));
+    ASSERT_FALSE(lazy.HasParseError());
+    EXPECT_EQ(123, lazy.GetRoot().GetInt());
+}
@@ -0,0 +1,28 @@
+#include "rapidjson/reader.h"
+#include "rapidjson/memorystream.h"
+#include "rapidjson/encodedstream.h"
+#include <gtest/gtest.h>
+
+using namespace rapidjson;
+
+template <unsigned parseFlags>
+static ParseResult ParseMemory(const char* json, size_t length) {
+    MemoryStream ms(json, length);
+    EncodedInputStream<UTF8<>, MemoryStream> is(ms);
+    BaseReaderHandler<> handler;
+    Reader reader;
+    return reader.Parse<parseFlags>(is, handler);
+}
+
+TEST(Reader, StructuralIndexEmptyMemoryStream) {
+    ParseResult r = ParseMemory<kParseStructuralIndexFlag>(0, 0);
+    EXPECT_EQ(kParseErrorDocumentEmpty, r.Code());
+    EXPECT_EQ(0u, r.Offset());
+
+    const char json[] = "[1]";
+    r = ParseMemory<kParseStructuralIndexFlag>(json, 0);
+    EXPECT_EQ(kParseErrorDocumentEmpty, r.Code());
+
+    r = ParseMemory<kParseStructuralIndexFlag>(json, 3);
+    EXPECT_FALSE(r.IsError());
+}
@@ -0,0 +1,60 @@
+#include "rapidjson/threadcachingallocator.h"
+#include "rapidjson/document.h"
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <new>
+
+using namespace rapidjson;
+
+static size_t g_newCount = 0;
+
+void* operator new(std::size_t size) {
+    g_newCount++;
+    if (void* p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+typedef MemoryPoolAllocator<ThreadCachingAllocator> CachedPoolAllocator;
+typedef GenericDocument<UTF8<>, CachedPoolAllocator, ThreadCachingAllocator> CachedDocument;
+
+static const char kJson[] = "{\"id\":42,\"name\":\"rapidjson\",\"tags\":[\"a\",\"b\",\"c\"],\"nested\":{\"x\":1.5,\"y\":[1,2,3]}}";
+
+static void ParseWithCallerAllocators() {
+    ThreadCachingAllocator baseAllocator;
+    CachedPoolAllocator poolAllocator(RAPIDJSON_ALLOCATOR_DEFAULT_CHUNK_CAPACITY, &baseAllocator);
+    CachedDocument d(&poolAllocator, 1024, &baseAllocator);
+    d.Parse(kJson);
+    ASSERT_FALSE(d.HasParseError());
+    EXPECT_EQ(42, d["id"].GetInt());
+}
+
+TEST(ThreadCachingAllocator, SteadyStateWithoutGlobalHeap) {
+    ParseWithCallerAllocators();    // warms up the cache of the thread
+
+    const ThreadCacheStats before = ThreadCachingAllocator::GetThreadStats();
+    const size_t newCount = g_newCount;
+    for (int i = 0; i < 100; i++)
+        ParseWithCallerAllocators();
+    const ThreadCacheStats after = ThreadCachingAllocator::GetThreadStats();
+
+    EXPECT_EQ(0u, g_newCount - newCount);
+    EXPECT_EQ(before.heapAllocations, after.heapAllocations);
+    EXPECT_LT(before.cacheHits, after.cacheHits);
+}
+
+TEST(ThreadCachingAllocator, DefaultAllocatorsUseGlobalHeap) {
+    CachedDocument warmup;
+    warmup.Parse(kJson);
+
+    const size_t newCount = g_newCount;
+    {
+        CachedDocument d;
+        d.Parse(kJson);
+        ASSERT_FALSE(d.HasParseError());
+    }
+    EXPECT_LT(0u, g_newCount - newCount);
+}